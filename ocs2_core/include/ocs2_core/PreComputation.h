@@ -31,6 +31,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <ocs2_core/ComputationRequest.h>
 #include <ocs2_core/Types.h>
+#include <ocs2_core/reference/ReferenceSampler.h>
 
 namespace ocs2 {
 
@@ -44,6 +45,9 @@ namespace ocs2 {
  * dynamics, cost and constraint terms, which can make use of the shared pre-computation.
  *
  * If pre-computation is not used, a default constructed PreComputation() can be passed to the getters.
+ *
+ * The base class also gives the cost and constraint terms cursor-based access to the references. During a solve,
+ * the solvers can set a ReferenceSampler which holds the references sampled on their time grid.
  */
 class PreComputation {
  public:
@@ -65,9 +69,53 @@ class PreComputation {
   /** Request callback at final time */
   virtual void requestFinal(RequestSet request, scalar_t t, const vector_t& x) {}
 
+  /**
+   * Sets the references sampled on the time grid of the solver. It should only be set on the PreComputation of a single
+   * thread and be reset to nullptr at the end of the solve.
+   */
+  void setReferenceSampler(const ReferenceSampler* referenceSamplerPtr) { referenceSamplerPtr_ = referenceSamplerPtr; }
+
+  /** Gets the sampled references if set by the solver, otherwise nullptr. */
+  const ReferenceSampler* getReferenceSampler() const { return referenceSamplerPtr_; }
+
+  /** Gets the cursor of the reference lookups. */
+  ReferenceSampler::Cursor& getReferenceCursor() const { return referenceCursor_; }
+
+  /**
+   * Gets the desired state of targetTrajectories. The sampled references are used if they are sampled from
+   * targetTrajectories, see ReferenceSampler::isSampledFrom().
+   * @note The returned reference is valid until the next reference lookup on this PreComputation.
+   */
+  const vector_t& getDesiredState(scalar_t time, const TargetTrajectories& targetTrajectories) const {
+    if (referenceSamplerPtr_ != nullptr && referenceSamplerPtr_->isSampledFrom(targetTrajectories)) {
+      return referenceSamplerPtr_->getDesiredState(time, referenceCursor_);
+    } else {
+      targetTrajectories.getDesiredState(time, referenceCursor_.targetTrajectoriesIndex, referenceCursor_.desiredState);
+      return referenceCursor_.desiredState;
+    }
+  }
+
+  /**
+   * Gets the desired input of targetTrajectories. The sampled references are used if they are sampled from
+   * targetTrajectories, see ReferenceSampler::isSampledFrom().
+   * @note The returned reference is valid until the next reference lookup on this PreComputation.
+   */
+  const vector_t& getDesiredInput(scalar_t time, const TargetTrajectories& targetTrajectories) const {
+    if (referenceSamplerPtr_ != nullptr && referenceSamplerPtr_->isSampledFrom(targetTrajectories)) {
+      return referenceSamplerPtr_->getDesiredInput(time, referenceCursor_);
+    } else {
+      targetTrajectories.getDesiredInput(time, referenceCursor_.targetTrajectoriesIndex, referenceCursor_.desiredInput);
+      return referenceCursor_.desiredInput;
+    }
+  }
+
  protected:
   /** Copy constructor */
   PreComputation(const PreComputation& other) = default;
+
+ private:
+  const ReferenceSampler* referenceSamplerPtr_ = nullptr;
+  mutable ReferenceSampler::Cursor referenceCursor_;
 };
 
 /** Helper to cast to const reference of derived class. */
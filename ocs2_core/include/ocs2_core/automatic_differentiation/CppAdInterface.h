@@ -41,6 +41,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 // CppAD helpers
 #include <ocs2_core/Types.h>
 #include <ocs2_core/automatic_differentiation/CppAdSparsity.h>
+#include <ocs2_core/automatic_differentiation/GaussNewtonHessianAssembler.h>
 #include <ocs2_core/automatic_differentiation/Types.h>
 
 namespace ocs2 {
@@ -233,6 +234,9 @@ class CppAdInterface {
   size_t nnzJacobian_ = 0;
   size_t nnzHessian_ = 0;
 
+  // Assembly of the Gauss-Newton Hessian for the Jacobian sparsity pattern
+  GaussNewtonHessianAssembler gaussNewtonHessianAssembler_;
+
   // Names
   std::string modelName_;
   std::string folderName_;
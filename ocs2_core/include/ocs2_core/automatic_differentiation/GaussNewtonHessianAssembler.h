@@ -0,0 +1,101 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <ocs2_core/Types.h>
+
+namespace ocs2 {
+
+/**
+ * Assembles the Gauss-Newton Hessian H = J' * J from the nonzeros of a Jacobian with a fixed sparsity pattern.
+ *
+ * Two strategies are available:
+ *  - Sparse: scatters the products of the nonzero pairs of each row into H. Efficient for very sparse Jacobians.
+ *  - Dense: copies the nonzeros into a dense Jacobian of the nonzero columns and performs a symmetric rank update
+ *           (SYRK) with it. Efficient when the rows share many columns.
+ * The strategy is chosen once from the sparsity pattern by comparing the number of multiplications of both strategies.
+ *
+ * The dense strategy reuses its workspace between the calls. Therefore, an instance should not be used by several threads concurrently.
+ */
+class GaussNewtonHessianAssembler {
+ public:
+  enum class Strategy { Sparse, Dense };
+
+  /** Default constructor for an empty Jacobian */
+  GaussNewtonHessianAssembler() = default;
+
+  /**
+   * Constructor which chooses the strategy from the sparsity pattern.
+   *
+   * @param [in] rangeDim : Number of rows of the Jacobian.
+   * @param [in] variableDim : Number of columns of the Jacobian.
+   * @param [in] rows : Row indices of the nonzeros, sorted first by row and then by column.
+   * @param [in] cols : Column indices of the nonzeros.
+   */
+  GaussNewtonHessianAssembler(size_t rangeDim, size_t variableDim, size_array_t rows, size_array_t cols);
+
+  /** Same as above, but with a given strategy. */
+  GaussNewtonHessianAssembler(size_t rangeDim, size_t variableDim, size_array_t rows, size_array_t cols, Strategy strategy);
+
+  /** Gets the assembly strategy */
+  Strategy getStrategy() const { return strategy_; }
+
+  /** Gets the row indices of the nonzeros of the Jacobian */
+  const size_array_t& getRows() const { return rows_; }
+
+  /** Gets the column indices of the nonzeros of the Jacobian */
+  const size_array_t& getCols() const { return cols_; }
+
+  /**
+   * Computes H = J' * J.
+   *
+   * @param [in] values : Values of the nonzeros of J in the order of the sparsity pattern.
+   * @param [out] hessian : The Gauss-Newton Hessian of size variableDim x variableDim.
+   */
+  void assemble(const scalar_t* values, matrix_t& hessian) const;
+
+ private:
+  void assembleSparse(const scalar_t* values, matrix_t& hessian) const;
+  void assembleDense(const scalar_t* values, matrix_t& hessian) const;
+
+  size_t rangeDim_ = 0;
+  size_t variableDim_ = 0;
+  size_array_t rows_;
+  size_array_t cols_;
+  Strategy strategy_ = Strategy::Sparse;
+
+  // Dense strategy: column of each nonzero in the compressed Jacobian, and the nonzero columns of the Jacobian
+  size_array_t compressedCols_;
+  size_array_t nonZeroCols_;
+  mutable matrix_t compressedJacobian_;
+  mutable matrix_t compressedHessian_;
+};
+
+}  // namespace ocs2
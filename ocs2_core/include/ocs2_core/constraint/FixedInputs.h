@@ -0,0 +1,58 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <ocs2_core/Types.h>
+
+namespace ocs2 {
+
+/**
+ * Input components which are fixed to a known value for the active mode, e.g. the contact forces of the swing legs of a legged robot.
+ * Solvers which support it eliminate these components from the LQ subproblem and reinsert them afterwards, instead of handling them as
+ * state-input equality constraints. The state-input equality constraints which only act on the fixed components become trivial and are
+ * ignored by these solvers, so the problem can keep them for the solvers which do not support the elimination.
+ */
+class FixedInputs {
+ public:
+  virtual ~FixedInputs() = default;
+  virtual FixedInputs* clone() const = 0;
+
+  /** Get the indices of the fixed input components in ascending order at given time */
+  virtual size_array_t getIndices(scalar_t time) const = 0;
+
+  /** Get the values of the fixed input components at given time. The default values are zero. */
+  virtual vector_t getValues(scalar_t time) const { return vector_t::Zero(getIndices(time).size()); }
+
+ protected:
+  FixedInputs() = default;
+  FixedInputs(const FixedInputs& rhs) = default;
+};
+
+}  // namespace ocs2
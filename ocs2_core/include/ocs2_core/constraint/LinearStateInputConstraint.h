@@ -58,6 +58,13 @@ class LinearStateInputConstraint : public StateInputConstraint {
   VectorFunctionLinearApproximation getLinearApproximation(scalar_t t, const vector_t& x, const vector_t& u,
                                                            const PreComputation& /* preComputation */) const final;
 
+  /**
+   * Writes the linear approximation into the rows [row, row + getNumConstraints(t)) of the given approximation without creating
+   * temporaries. It is used by StaticStateInputConstraintCollection to fuse the evaluation of its terms.
+   */
+  void fillLinearApproximation(scalar_t t, const vector_t& x, const vector_t& u, const PreComputation& /* preComputation */,
+                               VectorFunctionLinearApproximation& linearApproximation, size_t row) const;
+
  public:
   vector_t e_; /**< State input constraint */
   matrix_t C_; /**< State input constraint derivative wrt. state */
@@ -59,6 +59,13 @@ class StateInputConstraintCollection : public Collection<StateInputConstraint> {
   virtual VectorFunctionLinearApproximation getLinearApproximation(scalar_t time, const vector_t& state, const vector_t& input,
                                                                    const PreComputation& preComp) const;
 
+  /**
+   * Writes the constraint linear approximation into the given approximation, e.g. the LQ buffer of a node. By default, it is assigned
+   * from getLinearApproximation(). Derived collections can override it to reuse the storage of the given approximation.
+   */
+  virtual void fillLinearApproximation(scalar_t time, const vector_t& state, const vector_t& input, const PreComputation& preComp,
+                                       VectorFunctionLinearApproximation& linearApproximation) const;
+
   /** Get the constraint quadratic approximation */
   virtual VectorFunctionQuadraticApproximation getQuadraticApproximation(scalar_t time, const vector_t& state, const vector_t& input,
                                                                          const PreComputation& preComp) const;
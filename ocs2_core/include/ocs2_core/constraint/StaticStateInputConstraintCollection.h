@@ -0,0 +1,283 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <memory>
+#include <tuple>
+#include <type_traits>
+
+#include <ocs2_core/constraint/StateInputConstraintCollection.h>
+#include <ocs2_core/misc/StaticCollection.h>
+
+namespace ocs2 {
+namespace static_collection {
+
+/** Detects whether Term writes its linear approximation in place through fillLinearApproximation(). */
+template <typename Term, typename = void>
+struct HasFillLinearApproximation : std::false_type {};
+
+template <typename Term>
+struct HasFillLinearApproximation<Term, decltype(std::declval<const Term&>().fillLinearApproximation(
+                                            std::declval<scalar_t>(), std::declval<const vector_t&>(), std::declval<const vector_t&>(),
+                                            std::declval<const PreComputation&>(), std::declval<VectorFunctionLinearApproximation&>(),
+                                            std::declval<size_t>()))> : std::true_type {};
+
+}  // namespace static_collection
+
+/**
+ * State-input constraint collection with a fixed list of terms known at compile time. The static terms are evaluated in one pass
+ * with non-virtual calls. Terms that provide an in-place fillLinearApproximation() (e.g. LinearStateInputConstraint) write their rows
+ * directly into the stacked linear approximation, e.g. the LQ buffer of a node, the others are copied from their
+ * getLinearApproximation(). Terms added by the Collection API are stacked after the static ones.
+ *
+ * @tparam Terms : The concrete types of the static terms. The dynamic type of each term must be exactly the given type.
+ */
+template <typename... Terms>
+class StaticStateInputConstraintCollection final : public StateInputConstraintCollection {
+ public:
+  template <size_t I>
+  using term_t = typename std::tuple_element<I, std::tuple<Terms...>>::type;
+
+  /** Constructor which takes the ownership of the static terms. */
+  explicit StaticStateInputConstraintCollection(std::unique_ptr<Terms>... terms)
+      : staticTerms_(static_collection::checkTermType(std::move(terms))...) {}
+
+  ~StaticStateInputConstraintCollection() override = default;
+  StaticStateInputConstraintCollection* clone() const override { return new StaticStateInputConstraintCollection(*this); }
+
+  bool empty() const override { return sizeof...(Terms) == 0 && StateInputConstraintCollection::empty(); }
+
+  /** Use to modify the I-th static term. */
+  template <size_t I>
+  term_t<I>& getStaticTerm() {
+    return *std::get<I>(staticTerms_);
+  }
+
+  /** Returns the number of active constraints at given time. */
+  size_t getNumConstraints(scalar_t time) const override {
+    return getStaticNumConstraints<0>(time) + StateInputConstraintCollection::getNumConstraints(time);
+  }
+
+  /** Get the constraint vector value */
+  vector_t getValue(scalar_t time, const vector_t& state, const vector_t& input, const PreComputation& preComp) const override {
+    vector_t constraintValues(getNumConstraints(time));
+
+    size_t i = 0;
+    getStaticValue<0>(time, state, input, preComp, constraintValues, i);
+    for (const auto& constraintTerm : this->terms_) {
+      if (constraintTerm->isActive(time)) {
+        const auto constraintTermValues = constraintTerm->getValue(time, state, input, preComp);
+        constraintValues.segment(i, constraintTermValues.rows()) = constraintTermValues;
+        i += constraintTermValues.rows();
+      }
+    }
+
+    return constraintValues;
+  }
+
+  /** Get the constraint linear approximation */
+  VectorFunctionLinearApproximation getLinearApproximation(scalar_t time, const vector_t& state, const vector_t& input,
+                                                           const PreComputation& preComp) const override {
+    VectorFunctionLinearApproximation linearApproximation;
+    fillLinearApproximation(time, state, input, preComp, linearApproximation);
+    return linearApproximation;
+  }
+
+  /**
+   * Writes the constraint linear approximation into the given approximation, e.g. the LQ buffer of a node. Its storage is only
+   * reallocated when the number of active constraints changes.
+   */
+  void fillLinearApproximation(scalar_t time, const vector_t& state, const vector_t& input, const PreComputation& preComp,
+                               VectorFunctionLinearApproximation& linearApproximation) const override {
+    linearApproximation.resize(getNumConstraints(time), state.rows(), input.rows());
+
+    size_t i = 0;
+    fillStaticLinearApproximation<0>(time, state, input, preComp, linearApproximation, i);
+    for (const auto& constraintTerm : this->terms_) {
+      if (constraintTerm->isActive(time)) {
+        const auto constraintTermApproximation = constraintTerm->getLinearApproximation(time, state, input, preComp);
+        const size_t nc = constraintTermApproximation.f.rows();
+        linearApproximation.f.segment(i, nc) = constraintTermApproximation.f;
+        linearApproximation.dfdx.middleRows(i, nc) = constraintTermApproximation.dfdx;
+        linearApproximation.dfdu.middleRows(i, nc) = constraintTermApproximation.dfdu;
+        i += nc;
+      }
+    }
+  }
+
+  /** Get the constraint quadratic approximation */
+  VectorFunctionQuadraticApproximation getQuadraticApproximation(scalar_t time, const vector_t& state, const vector_t& input,
+                                                                 const PreComputation& preComp) const override {
+    const size_t numConstraints = getNumConstraints(time);
+
+    VectorFunctionQuadraticApproximation quadraticApproximation;
+    quadraticApproximation.f.resize(numConstraints);
+    quadraticApproximation.dfdx.resize(numConstraints, state.rows());
+    quadraticApproximation.dfdu.resize(numConstraints, input.rows());
+    quadraticApproximation.dfdxx.reserve(numConstraints);  // Use reserve instead of resize to avoid unnecessary allocations.
+    quadraticApproximation.dfdux.reserve(numConstraints);
+    quadraticApproximation.dfduu.reserve(numConstraints);
+
+    size_t i = 0;
+    getStaticQuadraticApproximation<0>(time, state, input, preComp, quadraticApproximation, i);
+    for (const auto& constraintTerm : this->terms_) {
+      if (constraintTerm->isActive(time)) {
+        auto constraintTermApproximation = constraintTerm->getQuadraticApproximation(time, state, input, preComp);
+        const size_t nc = constraintTermApproximation.f.rows();
+        quadraticApproximation.f.segment(i, nc) = constraintTermApproximation.f;
+        quadraticApproximation.dfdx.middleRows(i, nc) = constraintTermApproximation.dfdx;
+        quadraticApproximation.dfdu.middleRows(i, nc) = constraintTermApproximation.dfdu;
+        appendVectorToVectorByMoving(quadraticApproximation.dfdxx, std::move(constraintTermApproximation.dfdxx));
+        appendVectorToVectorByMoving(quadraticApproximation.dfdux, std::move(constraintTermApproximation.dfdux));
+        appendVectorToVectorByMoving(quadraticApproximation.dfduu, std::move(constraintTermApproximation.dfduu));
+        i += nc;
+      }
+    }
+
+    return quadraticApproximation;
+  }
+
+ private:
+  /** Copy constructor */
+  StaticStateInputConstraintCollection(const StaticStateInputConstraintCollection& other) : StateInputConstraintCollection(other) {
+    cloneStaticTerms<0>(other);
+  }
+
+  template <size_t I>
+  typename std::enable_if<I == sizeof...(Terms)>::type cloneStaticTerms(const StaticStateInputConstraintCollection&) {}
+
+  template <size_t I>
+  typename std::enable_if<(I < sizeof...(Terms))>::type cloneStaticTerms(const StaticStateInputConstraintCollection& other) {
+    // fails to compile if term_t<I> does not override clone() with its own type
+    std::get<I>(staticTerms_).reset(std::get<I>(other.staticTerms_)->clone());
+    cloneStaticTerms<I + 1>(other);
+  }
+
+  template <size_t I>
+  typename std::enable_if<I == sizeof...(Terms), size_t>::type getStaticNumConstraints(scalar_t) const {
+    return 0;
+  }
+
+  template <size_t I>
+  typename std::enable_if<(I < sizeof...(Terms)), size_t>::type getStaticNumConstraints(scalar_t time) const {
+    using term_type = term_t<I>;
+    const term_type& term = *std::get<I>(staticTerms_);
+    const size_t nc = term.term_type::isActive(time) ? term.term_type::getNumConstraints(time) : 0;
+    return nc + getStaticNumConstraints<I + 1>(time);
+  }
+
+  template <size_t I>
+  typename std::enable_if<I == sizeof...(Terms)>::type getStaticValue(scalar_t, const vector_t&, const vector_t&, const PreComputation&,
+                                                                       vector_t&, size_t&) const {}
+
+  template <size_t I>
+  typename std::enable_if<(I < sizeof...(Terms))>::type getStaticValue(scalar_t time, const vector_t& state, const vector_t& input,
+                                                                        const PreComputation& preComp, vector_t& constraintValues,
+                                                                        size_t& i) const {
+    using term_type = term_t<I>;
+    const term_type& term = *std::get<I>(staticTerms_);
+    if (term.term_type::isActive(time)) {
+      const auto termValues = term.term_type::getValue(time, state, input, preComp);
+      constraintValues.segment(i, termValues.rows()) = termValues;
+      i += termValues.rows();
+    }
+    getStaticValue<I + 1>(time, state, input, preComp, constraintValues, i);
+  }
+
+  template <size_t I>
+  typename std::enable_if<I == sizeof...(Terms)>::type fillStaticLinearApproximation(scalar_t, const vector_t&, const vector_t&,
+                                                                                      const PreComputation&,
+                                                                                      VectorFunctionLinearApproximation&, size_t&) const {}
+
+  template <size_t I>
+  typename std::enable_if<(I < sizeof...(Terms))>::type fillStaticLinearApproximation(
+      scalar_t time, const vector_t& state, const vector_t& input, const PreComputation& preComp,
+      VectorFunctionLinearApproximation& linearApproximation, size_t& i) const {
+    using term_type = term_t<I>;
+    const term_type& term = *std::get<I>(staticTerms_);
+    if (term.term_type::isActive(time)) {
+      i += fillTermLinearApproximation(term, time, state, input, preComp, linearApproximation, i,
+                                       static_collection::HasFillLinearApproximation<term_type>());
+    }
+    fillStaticLinearApproximation<I + 1>(time, state, input, preComp, linearApproximation, i);
+  }
+
+  /** Writes in place and returns the number of written rows. */
+  template <typename Term>
+  static size_t fillTermLinearApproximation(const Term& term, scalar_t time, const vector_t& state, const vector_t& input,
+                                            const PreComputation& preComp, VectorFunctionLinearApproximation& linearApproximation,
+                                            size_t row, std::true_type) {
+    term.Term::fillLinearApproximation(time, state, input, preComp, linearApproximation, row);
+    return term.Term::getNumConstraints(time);
+  }
+
+  /** Copies the term's approximation and returns the number of written rows. */
+  template <typename Term>
+  static size_t fillTermLinearApproximation(const Term& term, scalar_t time, const vector_t& state, const vector_t& input,
+                                            const PreComputation& preComp, VectorFunctionLinearApproximation& linearApproximation,
+                                            size_t row, std::false_type) {
+    const auto termApproximation = term.Term::getLinearApproximation(time, state, input, preComp);
+    const size_t nc = termApproximation.f.rows();
+    linearApproximation.f.segment(row, nc) = termApproximation.f;
+    linearApproximation.dfdx.middleRows(row, nc) = termApproximation.dfdx;
+    linearApproximation.dfdu.middleRows(row, nc) = termApproximation.dfdu;
+    return nc;
+  }
+
+  template <size_t I>
+  typename std::enable_if<I == sizeof...(Terms)>::type getStaticQuadraticApproximation(scalar_t, const vector_t&, const vector_t&,
+                                                                                        const PreComputation&,
+                                                                                        VectorFunctionQuadraticApproximation&,
+                                                                                        size_t&) const {}
+
+  template <size_t I>
+  typename std::enable_if<(I < sizeof...(Terms))>::type getStaticQuadraticApproximation(
+      scalar_t time, const vector_t& state, const vector_t& input, const PreComputation& preComp,
+      VectorFunctionQuadraticApproximation& quadraticApproximation, size_t& i) const {
+    using term_type = term_t<I>;
+    const term_type& term = *std::get<I>(staticTerms_);
+    if (term.term_type::isActive(time)) {
+      auto termApproximation = term.term_type::getQuadraticApproximation(time, state, input, preComp);
+      const size_t nc = termApproximation.f.rows();
+      quadraticApproximation.f.segment(i, nc) = termApproximation.f;
+      quadraticApproximation.dfdx.middleRows(i, nc) = termApproximation.dfdx;
+      quadraticApproximation.dfdu.middleRows(i, nc) = termApproximation.dfdu;
+      appendVectorToVectorByMoving(quadraticApproximation.dfdxx, std::move(termApproximation.dfdxx));
+      appendVectorToVectorByMoving(quadraticApproximation.dfdux, std::move(termApproximation.dfdux));
+      appendVectorToVectorByMoving(quadraticApproximation.dfduu, std::move(termApproximation.dfduu));
+      i += nc;
+    }
+    getStaticQuadraticApproximation<I + 1>(time, state, input, preComp, quadraticApproximation, i);
+  }
+
+  std::tuple<std::unique_ptr<Terms>...> staticTerms_;
+};
+
+}  // namespace ocs2
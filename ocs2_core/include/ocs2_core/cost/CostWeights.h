@@ -0,0 +1,73 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <ocs2_core/Types.h>
+#include <ocs2_core/thread_support/BufferedValue.h>
+
+namespace ocs2 {
+
+/**
+ * Runtime-tunable weights of parameterized cost terms. The cost terms share this object through a std::shared_ptr, so all their
+ * clones read the same weights.
+ *
+ * New weights can be set from any thread. They are buffered and become active only when updateWeights() is called, which should
+ * happen between two solver runs (e.g. by CostWeightsSynchronizedModule). The active weights are therefore constant during a solver
+ * run and are read without locking.
+ */
+class CostWeights {
+ public:
+  /**
+   * Constructor.
+   * @param [in] weights: The initial weights.
+   */
+  explicit CostWeights(vector_t weights);
+
+  /** The number of weights. */
+  size_t size() const { return size_; }
+
+  /** Sets new weights to the buffer. They become active at the next call to updateWeights(). This method is thread-safe. */
+  void setWeights(vector_t weights);
+
+  /**
+   * Activates the buffered weights. It is NOT thread-safe w.r.t. getWeights().
+   * @return True if the active weights were updated.
+   */
+  bool updateWeights() { return weights_.updateFromBuffer(); }
+
+  /** Gets the active weights. */
+  const vector_t& getWeights() const { return weights_.get(); }
+
+ private:
+  const size_t size_;
+  BufferedValue<vector_t> weights_;
+};
+
+}  // namespace ocs2
@@ -60,6 +60,11 @@ class QuadraticStateCost : public StateCost {
    * This method can be overwritten if desiredTrajectory has a different dimensions. */
   virtual vector_t getStateDeviation(scalar_t time, const vector_t& state, const TargetTrajectories& targetTrajectories) const;
 
+  /** Same as above with access to the PreComputation, e.g. for its cursor-based reference lookups.
+   * By default, it calls the above method. */
+  virtual vector_t getStateDeviation(scalar_t time, const vector_t& state, const TargetTrajectories& targetTrajectories,
+                                     const PreComputation& preComp) const;
+
  private:
   matrix_t Q_;
 };
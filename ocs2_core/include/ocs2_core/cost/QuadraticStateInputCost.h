@@ -58,6 +58,13 @@ class QuadraticStateInputCost : public StateInputCost {
                                                                  const TargetTrajectories& targetTrajectories,
                                                                  const PreComputation&) const final;
 
+  /**
+   * Adds the cost term quadratic approximation to the given approximation without creating temporaries. It is used by
+   * StaticStateInputCostCollection to fuse the evaluation of its terms.
+   */
+  void addQuadraticApproximation(scalar_t time, const vector_t& state, const vector_t& input, const TargetTrajectories& targetTrajectories,
+                                 const PreComputation& preComp, ScalarFunctionQuadraticApproximation& cost) const;
+
  protected:
   QuadraticStateInputCost(const QuadraticStateInputCost& rhs) = default;
 
@@ -66,6 +73,12 @@ class QuadraticStateInputCost : public StateInputCost {
   virtual std::pair<vector_t, vector_t> getStateInputDeviation(scalar_t time, const vector_t& state, const vector_t& input,
                                                                const TargetTrajectories& targetTrajectories) const;
 
+  /** Same as above with access to the PreComputation, e.g. for its cursor-based reference lookups.
+   * By default, it calls the above method. */
+  virtual std::pair<vector_t, vector_t> getStateInputDeviation(scalar_t time, const vector_t& state, const vector_t& input,
+                                                               const TargetTrajectories& targetTrajectories,
+                                                               const PreComputation& preComp) const;
+
  private:
   matrix_t Q_;
   matrix_t R_;
@@ -59,6 +59,11 @@ class StateInputCostCollection : public Collection<StateInputCost> {
                                                                          const TargetTrajectories& targetTrajectories,
                                                                          const PreComputation& preComp) const;
 
+  /** Adds the state-input cost quadratic approximation to the given approximation, e.g. the LQ buffer of a node. */
+  virtual void addQuadraticApproximation(scalar_t time, const vector_t& state, const vector_t& input,
+                                         const TargetTrajectories& targetTrajectories, const PreComputation& preComp,
+                                         ScalarFunctionQuadraticApproximation& cost) const;
+
  protected:
   /** Copy constructor */
   StateInputCostCollection(const StateInputCostCollection& other);
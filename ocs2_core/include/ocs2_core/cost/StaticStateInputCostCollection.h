@@ -0,0 +1,188 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <memory>
+#include <tuple>
+#include <type_traits>
+
+#include <ocs2_core/cost/StateInputCostCollection.h>
+#include <ocs2_core/misc/StaticCollection.h>
+
+namespace ocs2 {
+namespace static_collection {
+
+/** Detects whether Term accumulates its quadratic approximation in place through addQuadraticApproximation(). */
+template <typename Term, typename = void>
+struct HasAddQuadraticApproximation : std::false_type {};
+
+template <typename Term>
+struct HasAddQuadraticApproximation<Term, decltype(std::declval<const Term&>().addQuadraticApproximation(
+                                              std::declval<scalar_t>(), std::declval<const vector_t&>(), std::declval<const vector_t&>(),
+                                              std::declval<const TargetTrajectories&>(), std::declval<const PreComputation&>(),
+                                              std::declval<ScalarFunctionQuadraticApproximation&>()))> : std::true_type {};
+
+}  // namespace static_collection
+
+/**
+ * State-input cost collection with a fixed list of terms known at compile time. The static terms are evaluated in one pass with
+ * non-virtual calls. Terms that provide an in-place addQuadraticApproximation() (e.g. QuadraticStateInputCost) accumulate directly
+ * into the output approximation, the others are added through their getQuadraticApproximation().
+ *
+ * The collection remains a StateInputCostCollection: terms added by the Collection API are evaluated after the static ones.
+ * Example:
+ *   using cost_collection_t = StaticStateInputCostCollection<QuadraticStateInputCost, StateInputSoftConstraint>;
+ *   problem.costPtr.reset(new cost_collection_t(std::move(quadraticCostPtr), std::move(softConstraintPtr)));
+ *
+ * @tparam Terms : The concrete types of the static terms. The dynamic type of each term must be exactly the given type.
+ */
+template <typename... Terms>
+class StaticStateInputCostCollection final : public StateInputCostCollection {
+ public:
+  template <size_t I>
+  using term_t = typename std::tuple_element<I, std::tuple<Terms...>>::type;
+
+  /** Constructor which takes the ownership of the static terms. */
+  explicit StaticStateInputCostCollection(std::unique_ptr<Terms>... terms)
+      : staticTerms_(static_collection::checkTermType(std::move(terms))...) {}
+
+  ~StaticStateInputCostCollection() override = default;
+  StaticStateInputCostCollection* clone() const override { return new StaticStateInputCostCollection(*this); }
+
+  bool empty() const override { return sizeof...(Terms) == 0 && StateInputCostCollection::empty(); }
+
+  /** Use to modify the I-th static term. */
+  template <size_t I>
+  term_t<I>& getStaticTerm() {
+    return *std::get<I>(staticTerms_);
+  }
+
+  /** Get state-input cost value */
+  scalar_t getValue(scalar_t time, const vector_t& state, const vector_t& input, const TargetTrajectories& targetTrajectories,
+                    const PreComputation& preComp) const override {
+    scalar_t cost = getStaticValue<0>(time, state, input, targetTrajectories, preComp);
+    if (!terms_.empty()) {
+      cost += StateInputCostCollection::getValue(time, state, input, targetTrajectories, preComp);
+    }
+    return cost;
+  }
+
+  /** Get state-input cost quadratic approximation */
+  ScalarFunctionQuadraticApproximation getQuadraticApproximation(scalar_t time, const vector_t& state, const vector_t& input,
+                                                                 const TargetTrajectories& targetTrajectories,
+                                                                 const PreComputation& preComp) const override {
+    auto cost = ScalarFunctionQuadraticApproximation::Zero(state.rows(), input.rows());
+    addQuadraticApproximation(time, state, input, targetTrajectories, preComp, cost);
+    return cost;
+  }
+
+  /** Adds the state-input cost quadratic approximation to the given approximation, e.g. the LQ buffer of a node. */
+  void addQuadraticApproximation(scalar_t time, const vector_t& state, const vector_t& input, const TargetTrajectories& targetTrajectories,
+                                 const PreComputation& preComp, ScalarFunctionQuadraticApproximation& cost) const override {
+    addStaticQuadraticApproximation<0>(time, state, input, targetTrajectories, preComp, cost);
+    if (!terms_.empty()) {
+      StateInputCostCollection::addQuadraticApproximation(time, state, input, targetTrajectories, preComp, cost);
+    }
+  }
+
+ private:
+  /** Copy constructor */
+  StaticStateInputCostCollection(const StaticStateInputCostCollection& other) : StateInputCostCollection(other) {
+    cloneStaticTerms<0>(other);
+  }
+
+  template <size_t I>
+  typename std::enable_if<I == sizeof...(Terms)>::type cloneStaticTerms(const StaticStateInputCostCollection&) {}
+
+  template <size_t I>
+  typename std::enable_if<(I < sizeof...(Terms))>::type cloneStaticTerms(const StaticStateInputCostCollection& other) {
+    // fails to compile if term_t<I> does not override clone() with its own type
+    std::get<I>(staticTerms_).reset(std::get<I>(other.staticTerms_)->clone());
+    cloneStaticTerms<I + 1>(other);
+  }
+
+  template <size_t I>
+  typename std::enable_if<I == sizeof...(Terms), scalar_t>::type getStaticValue(scalar_t, const vector_t&, const vector_t&,
+                                                                                 const TargetTrajectories&, const PreComputation&) const {
+    return 0.0;
+  }
+
+  template <size_t I>
+  typename std::enable_if<(I < sizeof...(Terms)), scalar_t>::type getStaticValue(scalar_t time, const vector_t& state,
+                                                                                  const vector_t& input,
+                                                                                  const TargetTrajectories& targetTrajectories,
+                                                                                  const PreComputation& preComp) const {
+    using term_type = term_t<I>;
+    const term_type& term = *std::get<I>(staticTerms_);
+    const scalar_t termCost =
+        term.term_type::isActive(time) ? term.term_type::getValue(time, state, input, targetTrajectories, preComp) : 0.0;
+    return termCost + getStaticValue<I + 1>(time, state, input, targetTrajectories, preComp);
+  }
+
+  template <size_t I>
+  typename std::enable_if<I == sizeof...(Terms)>::type addStaticQuadraticApproximation(scalar_t, const vector_t&, const vector_t&,
+                                                                                        const TargetTrajectories&, const PreComputation&,
+                                                                                        ScalarFunctionQuadraticApproximation&) const {}
+
+  template <size_t I>
+  typename std::enable_if<(I < sizeof...(Terms))>::type addStaticQuadraticApproximation(scalar_t time, const vector_t& state,
+                                                                                         const vector_t& input,
+                                                                                         const TargetTrajectories& targetTrajectories,
+                                                                                         const PreComputation& preComp,
+                                                                                         ScalarFunctionQuadraticApproximation& cost) const {
+    using term_type = term_t<I>;
+    const term_type& term = *std::get<I>(staticTerms_);
+    if (term.term_type::isActive(time)) {
+      addTermQuadraticApproximation(term, time, state, input, targetTrajectories, preComp, cost,
+                                    static_collection::HasAddQuadraticApproximation<term_type>());
+    }
+    addStaticQuadraticApproximation<I + 1>(time, state, input, targetTrajectories, preComp, cost);
+  }
+
+  /** Accumulates in place. */
+  template <typename Term>
+  static void addTermQuadraticApproximation(const Term& term, scalar_t time, const vector_t& state, const vector_t& input,
+                                            const TargetTrajectories& targetTrajectories, const PreComputation& preComp,
+                                            ScalarFunctionQuadraticApproximation& cost, std::true_type) {
+    term.Term::addQuadraticApproximation(time, state, input, targetTrajectories, preComp, cost);
+  }
+
+  /** Accumulates through the term's approximation. */
+  template <typename Term>
+  static void addTermQuadraticApproximation(const Term& term, scalar_t time, const vector_t& state, const vector_t& input,
+                                            const TargetTrajectories& targetTrajectories, const PreComputation& preComp,
+                                            ScalarFunctionQuadraticApproximation& cost, std::false_type) {
+    cost += term.Term::getQuadraticApproximation(time, state, input, targetTrajectories, preComp);
+  }
+
+  std::tuple<std::unique_ptr<Terms>...> staticTerms_;
+};
+
+}  // namespace ocs2
@@ -0,0 +1,73 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+
+#pragma once
+
+#include <ocs2_core/cost/WeightedStateInputCostCppAd.h>
+
+namespace ocs2 {
+
+/**
+ * Quadratic state-input cost with diagonal weights which can be tuned at runtime:
+ * cost = 0.5 * (x - x_ref)' diag(q) (x - x_ref) + 0.5 * (u - u_ref)' diag(r) (u - u_ref)
+ *
+ * The weights are [q; r]. The reference state and input are appended to them as the extra CppAD parameters.
+ */
+class WeightedQuadraticStateInputCost final : public WeightedStateInputCostCppAd {
+ public:
+  /**
+   * Constructor.
+   * @param [in] weightsPtr: The weights [q; r] of size stateDim + inputDim.
+   * @param [in] stateDim : state vector dimension.
+   * @param [in] inputDim : input vector dimension.
+   * @param [in] modelName : Name of the generate model library.
+   * @param [in] modelFolder : Folder where the model library files are saved.
+   * @param [in] recompileLibraries : If true, always compile the model library, else try to load existing library if available.
+   * @param [in] verbose : Print information.
+   */
+  WeightedQuadraticStateInputCost(std::shared_ptr<const CostWeights> weightsPtr, size_t stateDim, size_t inputDim,
+                                  const std::string& modelName, const std::string& modelFolder = "/tmp/ocs2",
+                                  bool recompileLibraries = true, bool verbose = true);
+  ~WeightedQuadraticStateInputCost() override = default;
+  WeightedQuadraticStateInputCost* clone() const override;
+
+  vector_t getParameters(scalar_t time, const TargetTrajectories& targetTrajectories, const PreComputation& preComputation) const override;
+
+ private:
+  WeightedQuadraticStateInputCost(const WeightedQuadraticStateInputCost& rhs) = default;
+
+  ad_scalar_t costFunction(ad_scalar_t time, const ad_vector_t& state, const ad_vector_t& input,
+                           const ad_vector_t& parameters) const override;
+
+  size_t stateDim_;
+  size_t inputDim_;
+};
+
+}  // namespace ocs2
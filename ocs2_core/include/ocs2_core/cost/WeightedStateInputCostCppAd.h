@@ -0,0 +1,85 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <memory>
+
+#include <ocs2_core/cost/CostWeights.h>
+#include <ocs2_core/cost/StateInputCostCppAd.h>
+
+namespace ocs2 {
+
+/**
+ * CppAD state-input cost with runtime-tunable weights. The weights are the leading CppAD parameters of the cost, hence they can be
+ * changed through CostWeights without regenerating or recompiling the model library. Derived classes define the cost as a function of
+ * the parameters in costFunction(). A derived class which needs further parameters declares their number in initialize() and appends
+ * them to getWeights() in its own getParameters().
+ */
+class WeightedStateInputCostCppAd : public StateInputCostCppAd {
+ public:
+  /**
+   * Constructor.
+   * @param [in] weightsPtr: The weights which are shared between all clones of the cost.
+   */
+  explicit WeightedStateInputCostCppAd(std::shared_ptr<const CostWeights> weightsPtr);
+  ~WeightedStateInputCostCppAd() override = default;
+
+  /** Initialize the CppAd interface
+   * @param stateDim : state vector dimension.
+   * @param inputDim : input vector dimension.
+   * @param extraParameterDim : number of the parameters which follow the weights in the parameter vector.
+   * @param modelName : Name of the generate model library.
+   * @param modelFolder : Folder where the model library files are saved.
+   * @param recompileLibraries : If true, always compile the model library, else try to load existing library if available.
+   * @param verbose : Print information.
+   */
+  void initialize(size_t stateDim, size_t inputDim, size_t extraParameterDim, const std::string& modelName,
+                  const std::string& modelFolder = "/tmp/ocs2", bool recompileLibraries = true, bool verbose = true);
+
+  /** Gets the parameter vector. By default these are the active weights only. */
+  vector_t getParameters(scalar_t time, const TargetTrajectories& targetTrajectories, const PreComputation& preComputation) const override {
+    return getWeights();
+  }
+
+ protected:
+  WeightedStateInputCostCppAd(const WeightedStateInputCostCppAd& rhs) = default;
+
+  /** Gets the active weights, i.e. the leading entries of the parameter vector */
+  const vector_t& getWeights() const { return weightsPtr_->getWeights(); }
+
+  /** The CppAD cost function where the parameters start with the weights */
+  ad_scalar_t costFunction(ad_scalar_t time, const ad_vector_t& state, const ad_vector_t& input,
+                           const ad_vector_t& parameters) const override = 0;
+
+ private:
+  std::shared_ptr<const CostWeights> weightsPtr_;
+};
+
+}  // namespace ocs2
@@ -31,6 +31,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <ocs2_core/Types.h>
 #include <ocs2_core/dynamics/ControlledSystemBase.h>
+#include <ocs2_core/model_data/DynamicsStructure.h>
 
 namespace ocs2 {
 
@@ -113,6 +114,14 @@ class SystemDynamicsBase : public ControlledSystemBase {
    */
   virtual matrix_t dynamicsCovariance(scalar_t t, const vector_t& x, const vector_t& u);
 
+  /**
+   * Get the block structure of the flow map state Jacobian which holds for all operating points. The solvers use this
+   * information to skip the known zero and diagonal blocks. The default implementation reports a dense Jacobian.
+   *
+   * @return The block structure of the flow map state Jacobian.
+   */
+  virtual DynamicsStructure getDynamicsStructure() const { return DynamicsStructure(); }
+
   /**
    * Computes the flow map linear approximation.
    *
@@ -55,6 +55,8 @@ class LoopshapingDynamics : public SystemDynamicsBase {
   vector_t jumpMapDerivativeTime(scalar_t t, const vector_t& x, const vector_t& u) final;
   vector_t guardSurfacesDerivativeTime(scalar_t t, const vector_t& x, const vector_t& u) final;
 
+  DynamicsStructure getDynamicsStructure() const final;
+
  protected:
   LoopshapingDynamics(const LoopshapingDynamics& other)
       : SystemDynamicsBase(other), systemDynamics_(other.systemDynamics_->clone()), loopshapingDefinition_(other.loopshapingDefinition_) {}
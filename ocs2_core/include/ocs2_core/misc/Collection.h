@@ -49,8 +49,8 @@ class Collection {
   virtual ~Collection() = default;
   virtual Collection* clone() const { return new Collection(*this); }
 
-  /** Checks if the collection has no elements */
-  bool empty() const { return terms_.empty(); }
+  /** Checks if the collection has no elements. Collections holding terms outside of terms_ should override it. */
+  virtual bool empty() const { return terms_.empty(); }
 
   /** Erases all elements from the Collection. */
   void clear();
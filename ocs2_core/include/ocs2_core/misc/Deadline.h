@@ -0,0 +1,90 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <chrono>
+#include <limits>
+
+#include "ocs2_core/Types.h"
+
+namespace ocs2 {
+
+/**
+ * A wall-clock deadline for anytime algorithms. The deadline is inactive, i.e. it never expires, unless it is started with a
+ * positive time budget.
+ */
+class Deadline {
+ public:
+  /**
+   * Starts the deadline from now.
+   *
+   * @param [in] timeBudget: The time budget in seconds. A non-positive value deactivates the deadline.
+   */
+  void start(scalar_t timeBudget) {
+    startTime_ = std::chrono::steady_clock::now();
+    isActive_ = timeBudget > 0.0;
+    if (isActive_) {
+      endTime_ = startTime_ + std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<scalar_t>(timeBudget));
+    }
+  }
+
+  /** Whether the deadline is active. */
+  bool isActive() const { return isActive_; }
+
+  /** Elapsed time since the start. */
+  scalar_t getElapsedInMilliseconds() const {
+    return std::chrono::duration<scalar_t, std::milli>(std::chrono::steady_clock::now() - startTime_).count();
+  }
+
+  /** Remaining time to the deadline. It is negative if the deadline has passed and infinite if the deadline is inactive. */
+  scalar_t getRemainingInMilliseconds() const {
+    if (!isActive_) {
+      return std::numeric_limits<scalar_t>::infinity();
+    }
+    return std::chrono::duration<scalar_t, std::milli>(endTime_ - std::chrono::steady_clock::now()).count();
+  }
+
+  /** Whether the deadline has passed. */
+  bool hasExpired() const { return isActive_ && std::chrono::steady_clock::now() >= endTime_; }
+
+  /**
+   * Whether a task with the given (predicted) duration can be completed before the deadline.
+   *
+   * @param [in] durationInMilliseconds: The duration of the task.
+   */
+  bool canFit(scalar_t durationInMilliseconds) const { return !isActive_ || durationInMilliseconds < getRemainingInMilliseconds(); }
+
+ private:
+  bool isActive_ = false;
+  std::chrono::steady_clock::time_point startTime_;
+  std::chrono::steady_clock::time_point endTime_;
+};
+
+}  // namespace ocs2
@@ -134,13 +134,31 @@ void makePsdCholesky(Eigen::MatrixBase<Derived>& A, scalar_t minEigenvalue = num
  * @tparam Derived type.
  * @param [in] Am: A symmetric square positive definite matrix
  * @param [out] AmInvUmUmT: The upper-triangular matrix associated to the UUT decomposition of inv(Am) matrix.
+ * @return False if the Cholesky factorization of Am failed, i.e. Am is not numerically positive definite.
  */
 template <typename Derived>
-void computeInverseMatrixUUT(const Derived& Am, Derived& AmInvUmUmT) {
+bool computeInverseMatrixUUT(const Derived& Am, Derived& AmInvUmUmT) {
   // Am = Lm Lm^T --> inv(Am) = inv(Lm^T) inv(Lm) where Lm^T is upper triangular
   Eigen::LLT<Derived> lltOfA(Am);
   AmInvUmUmT.setIdentity(Am.rows(), Am.cols());  // for dynamic size matrices
   lltOfA.matrixU().solveInPlace(AmInvUmUmT);
+  return lltOfA.info() == Eigen::Success;
+}
+
+/**
+ * Checks whether the smallest eigenvalue of a symmetric matrix is not smaller than -tolerance through a Cholesky factorization
+ * of (A + tolerance * I). This is several times cheaper than an eigenvalue decomposition. However, close to the threshold the
+ * factorization may fail due to round-off. Therefore a negative answer should be confirmed by symmetricEigenvalues().
+ *
+ * @param [in] A: A symmetric square matrix.
+ * @param [in] tolerance: The tolerance on the smallest eigenvalue.
+ * @return True if the matrix is PSD up to the tolerance.
+ */
+template <typename Derived>
+bool isPsdByCholesky(const Derived& A, scalar_t tolerance) {
+  matrix_t shiftedA = A;
+  shiftedA.diagonal().array() += tolerance;
+  return shiftedA.llt().info() == Eigen::Success;
 }
 
 /**
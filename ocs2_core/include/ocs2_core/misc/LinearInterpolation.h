@@ -53,6 +53,17 @@ using remove_cvref_t = typename std::remove_cv<typename std::remove_reference<T>
  */
 index_alpha_t timeSegment(scalar_t enquiryTime, const std::vector<scalar_t>& timeArray);
 
+/**
+ * Same as timeSegment, but the lookup of the interval starts from a cursor, e.g. the result of the previous query.
+ * This makes consecutive queries at non-decreasing times cheap.
+ *
+ * @param [in] enquiryTime: The enquiry time for interpolation.
+ * @param [in] timeArray: interpolation time array.
+ * @param [in, out] cursor: The cursor of the lookup, see lookup::findIndexInTimeArray.
+ * @return {index, alpha}
+ */
+index_alpha_t timeSegment(scalar_t enquiryTime, const std::vector<scalar_t>& timeArray, int& cursor);
+
 /**
  * Directly uses the index and interpolation coefficient provided by the user
  * @note If sizes in data array are not equal, the interpolation will snap to the data
@@ -91,6 +91,33 @@ int findIndexInTimeArray(const std::vector<SCALAR>& timeArray, SCALAR time) {
   return static_cast<int>(firstLargerValueIterator - timeArray.begin());
 }
 
+/**
+ * Same as findIndexInTimeArray, but the search starts from a cursor, e.g. the result of the previous query. Queries
+ * that fall into the same or the next index are resolved in constant time. Other queries fall back to a binary search.
+ *
+ * @tparam SCALAR : numerical type of time
+ * @param timeArray : sorted time array to perform the lookup in
+ * @param time : enquiry time
+ * @param [in, out] cursor : index to start the search from. It is set to the returned index.
+ * @return index between [0, size(timeArray)]
+ */
+template <typename SCALAR = double>
+int findIndexInTimeArray(const std::vector<SCALAR>& timeArray, SCALAR time, int& cursor) {
+  const int size = static_cast<int>(timeArray.size());
+  const auto isIndexOfTime = [&](int index) {
+    return (index == 0 || timeArray[index - 1] < time) && (index == size || time <= timeArray[index]);
+  };
+
+  if (0 <= cursor && cursor <= size && isIndexOfTime(cursor)) {
+    return cursor;
+  } else if (0 <= cursor && cursor < size && isIndexOfTime(cursor + 1)) {
+    return ++cursor;
+  } else {
+    cursor = findIndexInTimeArray(timeArray, time);
+    return cursor;
+  }
+}
+
 /**
  *  Find interval into a sorted time Array
  *
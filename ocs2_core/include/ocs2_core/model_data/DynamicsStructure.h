@@ -0,0 +1,83 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include "ocs2_core/Types.h"
+
+namespace ocs2 {
+
+/**
+ * The block structure of the flow map linearization of a cascaded system with state x = [x_1; x_2], where the trailing states x_2
+ * are not affected by the leading states x_1. The state Jacobian of such a system has the form
+ *
+ *    dfdx = [A11, A12;
+ *              0, A22]
+ *
+ * Loopshaping-augmented systems have this structure where x_2 are the filter states. The default value describes a dense Jacobian.
+ */
+struct DynamicsStructure {
+  /** The dimension of the trailing state block x_2. Zero means that no structure is known. */
+  int trailingStateDim = 0;
+  /** Whether A22 is a diagonal matrix. */
+  bool diagonalTrailingBlock = false;
+  /** Whether A12 is zero, i.e. the leading states are also not affected by the trailing states. */
+  bool zeroUpperCoupling = false;
+
+  /** Whether the Jacobian should be treated as a dense matrix. */
+  bool isDense() const { return trailingStateDim == 0; }
+
+  bool operator==(const DynamicsStructure& other) const {
+    return trailingStateDim == other.trailingStateDim && diagonalTrailingBlock == other.diagonalTrailingBlock &&
+           zeroUpperCoupling == other.zeroUpperCoupling;
+  }
+  bool operator!=(const DynamicsStructure& other) const { return !(*this == other); }
+};
+
+/**
+ * Computes out = M * dfdx by skipping the known zero and diagonal blocks of dfdx.
+ *
+ * @param [in] M: The left-hand side matrix.
+ * @param [in] dfdx: The state Jacobian of the flow map.
+ * @param [in] structure: The block structure of dfdx.
+ * @param [out] out: The product. It should not alias any of the inputs.
+ */
+void multiplyStateJacobian(const matrix_t& M, const matrix_t& dfdx, const DynamicsStructure& structure, matrix_t& out);
+
+/**
+ * Computes out = dfdx^T * M by skipping the known zero and diagonal blocks of dfdx.
+ *
+ * @param [in] dfdx: The state Jacobian of the flow map.
+ * @param [in] M: The right-hand side matrix.
+ * @param [in] structure: The block structure of dfdx.
+ * @param [out] out: The product. It should not alias any of the inputs.
+ */
+void multiplyStateJacobianTranspose(const matrix_t& dfdx, const matrix_t& M, const DynamicsStructure& structure, matrix_t& out);
+
+}  // namespace ocs2
@@ -34,6 +34,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <vector>
 
 #include "ocs2_core/Types.h"
+#include "ocs2_core/model_data/DynamicsStructure.h"
 
 namespace ocs2 {
 
@@ -49,6 +50,7 @@ struct ModelData {
   vector_t dynamicsBias;
   matrix_t dynamicsCovariance;
   VectorFunctionLinearApproximation dynamics;
+  DynamicsStructure dynamicsStructure;
 
   // Cost
   ScalarFunctionQuadraticApproximation cost;
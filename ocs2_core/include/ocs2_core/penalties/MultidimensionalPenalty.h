@@ -92,6 +92,16 @@ class MultidimensionalPenalty final {
   ScalarFunctionQuadraticApproximation getQuadraticApproximation(scalar_t t, const VectorFunctionLinearApproximation& h,
                                                                  const vector_t* l = nullptr) const;
 
+  /**
+   * Adds the penalty cost quadratic approximation of getQuadraticApproximation() to the given approximation.
+   *
+   * @param [in] t: The time that the constraint is evaluated.
+   * @param [in] h: The constraint linear approximation.
+   * @param [in, out] penaltyApproximation: The quadratic approximation to which the penalty cost is added.
+   */
+  void addQuadraticApproximation(scalar_t t, const VectorFunctionLinearApproximation& h,
+                                 ScalarFunctionQuadraticApproximation& penaltyApproximation, const vector_t* l = nullptr) const;
+
   /**
    * Get the derivative of the penalty cost.
    * Implements the chain rule between the inequality constraint and penalty function.
@@ -66,6 +66,16 @@ struct ModeSchedule {
    */
   size_t modeAtTime(scalar_t time) const;
 
+  /**
+   *  Same as modeAtTime, but the lookup starts from the cursor, which makes consecutive queries at non-decreasing
+   *  times cheap. Each thread should use its own cursor.
+   *
+   *  @param [in] time: The inquiry time.
+   *  @param [in, out] cursor: The cursor of the lookup, see lookup::findIndexInTimeArray.
+   *  @return the associated mode for the input time.
+   */
+  size_t modeAtTime(scalar_t time, int& cursor) const;
+
   /** Clears modeSchedule */
   void clear() {
     eventTimes.clear();
@@ -0,0 +1,116 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <ocs2_core/Types.h>
+#include <ocs2_core/reference/ModeSchedule.h>
+#include <ocs2_core/reference/TargetTrajectories.h>
+
+namespace ocs2 {
+
+/**
+ * Samples the target trajectories and the mode schedule on the time grid of a solver. The solver updates the samples
+ * once per solve, after which the desired state, input and mode at the grid times are looked up without interpolation
+ * or allocation. Queries off the grid are interpolated into the buffers of the cursor.
+ *
+ * The sampler is read-only during the solve and can be shared between threads, while each thread should use its
+ * own Cursor.
+ */
+class ReferenceSampler {
+ public:
+  /** The cursor of the lookups and the buffers for the queries off the time grid. */
+  struct Cursor {
+    int timeGridIndex = 0;
+    int targetTrajectoriesIndex = 0;
+    int eventTimesIndex = 0;
+    vector_t desiredState;
+    vector_t desiredInput;
+  };
+
+  /** Default constructor */
+  ReferenceSampler() = default;
+
+  /**
+   * Samples the references on the given time grid. The storage of the previous samples is reused.
+   *
+   * @param [in] timeGrid: The sorted time grid. Lookups match the grid times exactly.
+   * @param [in] targetTrajectories: The target trajectories.
+   * @param [in] modeSchedule: The mode schedule.
+   */
+  void update(const scalar_array_t& timeGrid, const TargetTrajectories& targetTrajectories, const ModeSchedule& modeSchedule);
+
+  /** Clears the samples */
+  void clear();
+
+  /** Gets the time grid of the samples */
+  const scalar_array_t& getTimeGrid() const { return timeGrid_; }
+
+  /** Gets the sampled target trajectories */
+  const TargetTrajectories& getTargetTrajectories() const { return targetTrajectories_; }
+
+  /**
+   * Whether the samples are taken from the given target trajectories, i.e. the object which has been passed to the last
+   * update(). The samples are a copy, hence only the identity of the object is compared and not its values.
+   */
+  bool isSampledFrom(const TargetTrajectories& targetTrajectories) const { return &targetTrajectories == sourceTargetTrajectoriesPtr_; }
+
+  /** Gets the sampled mode schedule */
+  const ModeSchedule& getModeSchedule() const { return modeSchedule_; }
+
+  /**
+   * Gets the desired state, same as TargetTrajectories::getDesiredState.
+   * @note The returned reference is valid until the next query with the same cursor or the next update.
+   */
+  const vector_t& getDesiredState(scalar_t time, Cursor& cursor) const;
+
+  /**
+   * Gets the desired input, same as TargetTrajectories::getDesiredInput.
+   * @note The returned reference is valid until the next query with the same cursor or the next update.
+   */
+  const vector_t& getDesiredInput(scalar_t time, Cursor& cursor) const;
+
+  /** Gets the mode, same as ModeSchedule::modeAtTime. */
+  size_t getMode(scalar_t time, Cursor& cursor) const;
+
+ private:
+  /** Finds the time in the time grid. Returns -1 if it is not a grid time. */
+  int findInTimeGrid(scalar_t time, Cursor& cursor) const;
+
+  scalar_array_t timeGrid_;
+  vector_array_t desiredStates_;
+  vector_array_t desiredInputs_;
+  size_array_t modes_;
+
+  TargetTrajectories targetTrajectories_;
+  ModeSchedule modeSchedule_;
+  const TargetTrajectories* sourceTargetTrajectoriesPtr_ = nullptr;
+};
+
+}  // namespace ocs2
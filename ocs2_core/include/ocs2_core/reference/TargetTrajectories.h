@@ -52,6 +52,17 @@ struct TargetTrajectories {
   vector_t getDesiredState(scalar_t time) const;
   vector_t getDesiredInput(scalar_t time) const;
 
+  /**
+   * Allocation-free versions of getDesiredState and getDesiredInput. The lookup starts from the cursor, which makes
+   * consecutive queries at non-decreasing times cheap. Each thread should use its own cursor.
+   *
+   * @param [in] time: The inquiry time.
+   * @param [in, out] cursor: The cursor of the lookup, see lookup::findIndexInTimeArray.
+   * @param [out] desiredState/desiredInput: The interpolated reference.
+   */
+  void getDesiredState(scalar_t time, int& cursor, vector_t& desiredState) const;
+  void getDesiredInput(scalar_t time, int& cursor, vector_t& desiredInput) const;
+
   scalar_array_t timeTrajectory;
   vector_array_t stateTrajectory;
   vector_array_t inputTrajectory;
@@ -93,6 +93,13 @@ class StateInputSoftBoxConstraint final : public StateInputCost {
                                                                  const TargetTrajectories& /* targetTrajectories */,
                                                                  const PreComputation& preComp) const override;
 
+  /**
+   * Adds the cost term quadratic approximation to the given approximation without creating temporaries. It is used by
+   * StaticStateInputCostCollection to fuse the evaluation of its terms.
+   */
+  void addQuadraticApproximation(scalar_t time, const vector_t& state, const vector_t& input, const TargetTrajectories& targetTrajectories,
+                                 const PreComputation& preComp, ScalarFunctionQuadraticApproximation& cost) const;
+
  private:
   StateInputSoftBoxConstraint(const StateInputSoftBoxConstraint& other) = default;
 
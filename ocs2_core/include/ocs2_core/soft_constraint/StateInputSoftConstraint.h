@@ -89,6 +89,13 @@ class StateInputSoftConstraint final : public StateInputCost {
                                                                  const TargetTrajectories& /* targetTrajectories */,
                                                                  const PreComputation& preComp) const override;
 
+  /**
+   * Adds the cost term quadratic approximation to the given approximation. For a linear constraint, the penalty is accumulated without
+   * creating the approximation of the term. It is used by StaticStateInputCostCollection to fuse the evaluation of its terms.
+   */
+  void addQuadraticApproximation(scalar_t time, const vector_t& state, const vector_t& input, const TargetTrajectories& targetTrajectories,
+                                 const PreComputation& preComp, ScalarFunctionQuadraticApproximation& cost) const;
+
  private:
   StateInputSoftConstraint(const StateInputSoftConstraint& other);
 
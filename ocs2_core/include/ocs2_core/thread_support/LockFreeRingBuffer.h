@@ -0,0 +1,124 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+namespace ocs2 {
+
+/**
+ * A bounded, lock-free ring buffer for a single producer thread and a single consumer thread. The slots are allocated once
+ * at construction and reused afterwards: the producer writes into a free slot in place and publishes it with commitWrite(),
+ * the consumer reads the oldest published slot in place and releases it with commitRead(). Therefore, for types with dynamic
+ * storage (e.g. Eigen matrices or std::vector), copying into a slot does not allocate once the slot has its final size.
+ *
+ * Only one thread may call the producer methods (beginWrite/commitWrite) and only one thread may call the consumer
+ * methods (beginRead/commitRead).
+ *
+ * @tparam T : type of the stored elements.
+ */
+template <typename T>
+class LockFreeRingBuffer {
+ public:
+  /**
+   * Constructor.
+   *
+   * @param [in] capacity: The maximum number of elements in the buffer.
+   * @param [in] prototype: The value which all the slots are initialized with.
+   */
+  explicit LockFreeRingBuffer(size_t capacity, const T& prototype = T()) : slots_(capacity, prototype), writeCount_(0), readCount_(0) {
+    if (capacity == 0) {
+      throw std::runtime_error("[LockFreeRingBuffer] capacity should be at least 1!");
+    }
+  }
+
+  /** The maximum number of elements in the buffer. */
+  size_t capacity() const { return slots_.size(); }
+
+  /** The number of published elements which are not read yet. The value is only a snapshot if other threads are active. */
+  size_t size() const { return writeCount_.load(std::memory_order_acquire) - readCount_.load(std::memory_order_acquire); }
+
+  /** Whether there is no published element. */
+  bool empty() const { return size() == 0; }
+
+  /**
+   * Gets the next free slot for writing. Producer only.
+   * @return A pointer to the slot, or nullptr if the buffer is full.
+   */
+  T* beginWrite() {
+    const auto writeCount = writeCount_.load(std::memory_order_relaxed);
+    if (writeCount - readCount_.load(std::memory_order_acquire) == slots_.size()) {
+      return nullptr;
+    }
+    return &slots_[writeCount % slots_.size()];
+  }
+
+  /** Publishes the slot returned by the last beginWrite() to the consumer. Producer only. */
+  void commitWrite() { writeCount_.store(writeCount_.load(std::memory_order_relaxed) + 1, std::memory_order_release); }
+
+  /**
+   * Copies a value into the next free slot and publishes it. Producer only.
+   * @return False if the buffer is full and the value is dropped.
+   */
+  bool tryPush(const T& value) {
+    T* slotPtr = beginWrite();
+    if (slotPtr == nullptr) {
+      return false;
+    }
+    *slotPtr = value;
+    commitWrite();
+    return true;
+  }
+
+  /**
+   * Gets the oldest published slot for reading. Consumer only.
+   * @return A pointer to the slot, or nullptr if the buffer is empty.
+   */
+  T* beginRead() {
+    const auto readCount = readCount_.load(std::memory_order_relaxed);
+    if (writeCount_.load(std::memory_order_acquire) == readCount) {
+      return nullptr;
+    }
+    return &slots_[readCount % slots_.size()];
+  }
+
+  /** Releases the slot returned by the last beginRead() back to the producer. Consumer only. */
+  void commitRead() { readCount_.store(readCount_.load(std::memory_order_relaxed) + 1, std::memory_order_release); }
+
+ private:
+  std::vector<T> slots_;
+  std::atomic<size_t> writeCount_;
+  std::atomic<size_t> readCount_;
+};
+
+}  // namespace ocs2
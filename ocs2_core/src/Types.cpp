@@ -125,10 +125,12 @@ std::string checkBeingPSD(const matrix_t& data, const std::string& dataName) {
       errorDescription << dataName << " is not self-adjoint.\n";
     }
 
-    // check for being psd
-    const auto minEigenvalue = LinearAlgebra::symmetricEigenvalues(data).minCoeff();
-    if (minEigenvalue < -Eigen::NumTraits<scalar_t>::epsilon()) {
-      errorDescription << dataName << " is not PSD. It's smallest eigenvalue is " + std::to_string(minEigenvalue) + ".\n";
+    // check for being psd: the Cholesky test settles the common case and the eigenvalues are only computed to confirm a failure
+    if (!LinearAlgebra::isPsdByCholesky(data, Eigen::NumTraits<scalar_t>::epsilon())) {
+      const auto minEigenvalue = LinearAlgebra::symmetricEigenvalues(data).minCoeff();
+      if (minEigenvalue < -Eigen::NumTraits<scalar_t>::epsilon()) {
+        errorDescription << dataName << " is not PSD. It's smallest eigenvalue is " + std::to_string(minEigenvalue) + ".\n";
+      }
     }
   }
 
@@ -29,6 +29,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <ocs2_core/automatic_differentiation/CppAdInterface.h>
 
+#include <algorithm>
+
 #include <boost/filesystem.hpp>
 
 namespace ocs2 {
@@ -215,28 +217,11 @@ ScalarFunctionQuadraticApproximation CppAdInterface::getGaussNewtonApproximation
     gnApprox.dfdx(cols[i]) += sparseJacobian[i] * valueVector(rows[i]);
   }
 
-  /*
-   * Sparse construction of the GN matrix, H = J' * J.
-   * H(i, j) = sum_rows { J(row, i) * J(row, j) }
-   * Because the sparse elements are ordered first by row, then by column, we process J row-by-row.
-   * For each row of J, we add the non-zero pairs (i, j) to H(i, j).
-   */
-  gnApprox.dfdxx.setZero(variableDim_, variableDim_);
-  for (size_t i = 0; i < nnzJacobian_; ++i) {
-    const size_t row_i = rows[i];
-    const size_t col_i = cols[i];
-    const scalar_t v_i = sparseJacobian[i];
-    // Diagonal element always exists:
-    gnApprox.dfdxx(col_i, col_i) += v_i * v_i;
-    // Process off-diagonals
-    size_t j = i + 1;
-    while (rows[j] == row_i) {
-      const size_t col_j = cols[j];
-      gnApprox.dfdxx(col_j, col_i) += v_i * sparseJacobian[j];
-      gnApprox.dfdxx(col_i, col_j) = gnApprox.dfdxx(col_j, col_i);  // Maintain symmetry as we go.
-      ++j;
-    }
-  }
+  // Construction of the GN matrix, H = J' * J, with the strategy chosen for the sparsity pattern
+  assert(gaussNewtonHessianAssembler_.getRows().size() == nnzJacobian_);
+  assert(std::equal(rows, rows + nnzJacobian_, gaussNewtonHessianAssembler_.getRows().begin()));
+  assert(std::equal(cols, cols + nnzJacobian_, gaussNewtonHessianAssembler_.getCols().begin()));
+  gaussNewtonHessianAssembler_.assemble(sparseJacobian.data(), gnApprox.dfdxx);
 
   assert(gnApprox.dfdx.allFinite());
   assert(gnApprox.dfdxx.allFinite());
@@ -369,6 +354,9 @@ void CppAdInterface::setApproximationOrder(ApproximationOrder approximationOrder
 void CppAdInterface::setSparsityNonzeros() {
   if (model_->isJacobianSparsityAvailable()) {
     nnzJacobian_ = cppad_sparsity::getNumberOfNonZeros(model_->JacobianSparsitySet());
+    size_array_t rows, cols;
+    model_->JacobianSparsity(rows, cols);
+    gaussNewtonHessianAssembler_ = GaussNewtonHessianAssembler(rangeDim_, variableDim_, std::move(rows), std::move(cols));
   }
   if (model_->isHessianSparsityAvailable()) {
     nnzHessian_ = cppad_sparsity::getNumberOfNonZeros(model_->HessianSparsitySet());
@@ -0,0 +1,171 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include "ocs2_core/automatic_differentiation/GaussNewtonHessianAssembler.h"
+
+#include <algorithm>
+
+namespace ocs2 {
+
+namespace {
+
+/** Relative cost of a scattered multiply-add to a multiply-add of the dense symmetric rank update. */
+constexpr scalar_t sparseToDenseCostRatio = 4.0;
+
+}  // namespace
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+GaussNewtonHessianAssembler::GaussNewtonHessianAssembler(size_t rangeDim, size_t variableDim, size_array_t rows, size_array_t cols)
+    : GaussNewtonHessianAssembler(rangeDim, variableDim, std::move(rows), std::move(cols), Strategy::Sparse) {
+  // Multiplications of the sparse strategy: the nonzero pairs of each row
+  scalar_t sparseCost = 0.0;
+  size_t rowBegin = 0;
+  while (rowBegin < rows_.size()) {
+    size_t rowEnd = rowBegin;
+    while (rowEnd < rows_.size() && rows_[rowEnd] == rows_[rowBegin]) {
+      ++rowEnd;
+    }
+    const auto rowNonZeros = static_cast<scalar_t>(rowEnd - rowBegin);
+    sparseCost += 0.5 * rowNonZeros * (rowNonZeros + 1.0);
+    rowBegin = rowEnd;
+  }
+
+  // Multiplications of the dense strategy: the lower triangle of the compressed Hessian for each row
+  const auto numNonZeroCols = static_cast<scalar_t>(nonZeroCols_.size());
+  const scalar_t denseCost = 0.5 * rangeDim_ * numNonZeroCols * (numNonZeroCols + 1.0);
+
+  strategy_ = (denseCost < sparseToDenseCostRatio * sparseCost) ? Strategy::Dense : Strategy::Sparse;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+GaussNewtonHessianAssembler::GaussNewtonHessianAssembler(size_t rangeDim, size_t variableDim, size_array_t rows, size_array_t cols,
+                                                         Strategy strategy)
+    : rangeDim_(rangeDim), variableDim_(variableDim), rows_(std::move(rows)), cols_(std::move(cols)), strategy_(strategy) {
+  if (rows_.size() != cols_.size()) {
+    throw std::runtime_error("[GaussNewtonHessianAssembler] The number of row and column indices must be equal!");
+  }
+  for (size_t i = 0; i < rows_.size(); i++) {
+    if (rows_[i] >= rangeDim_ || cols_[i] >= variableDim_) {
+      throw std::runtime_error("[GaussNewtonHessianAssembler] Nonzero indices exceed the Jacobian dimensions!");
+    }
+    if (i > 0 && (rows_[i] < rows_[i - 1] || (rows_[i] == rows_[i - 1] && cols_[i] <= cols_[i - 1]))) {
+      throw std::runtime_error("[GaussNewtonHessianAssembler] Nonzeros must be sorted first by row and then by column!");
+    }
+  }
+
+  // Compression of the columns for the dense strategy
+  nonZeroCols_ = cols_;
+  std::sort(nonZeroCols_.begin(), nonZeroCols_.end());
+  nonZeroCols_.erase(std::unique(nonZeroCols_.begin(), nonZeroCols_.end()), nonZeroCols_.end());
+  compressedCols_.resize(cols_.size());
+  for (size_t i = 0; i < cols_.size(); i++) {
+    compressedCols_[i] = std::lower_bound(nonZeroCols_.begin(), nonZeroCols_.end(), cols_[i]) - nonZeroCols_.begin();
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void GaussNewtonHessianAssembler::assemble(const scalar_t* values, matrix_t& hessian) const {
+  switch (strategy_) {
+    case Strategy::Sparse:
+      assembleSparse(values, hessian);
+      break;
+    case Strategy::Dense:
+      assembleDense(values, hessian);
+      break;
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void GaussNewtonHessianAssembler::assembleSparse(const scalar_t* values, matrix_t& hessian) const {
+  /*
+   * H(i, j) = sum_rows { J(row, i) * J(row, j) }
+   * Because the sparse elements are ordered first by row, then by column, we process J row-by-row.
+   * For each row of J, we add the non-zero pairs (i, j) to H(i, j).
+   */
+  const size_t nnz = rows_.size();
+  hessian.setZero(variableDim_, variableDim_);
+  for (size_t i = 0; i < nnz; ++i) {
+    const size_t row_i = rows_[i];
+    const size_t col_i = cols_[i];
+    const scalar_t v_i = values[i];
+    // Diagonal element always exists:
+    hessian(col_i, col_i) += v_i * v_i;
+    // Process off-diagonals
+    for (size_t j = i + 1; j < nnz && rows_[j] == row_i; ++j) {
+      hessian(cols_[j], col_i) += v_i * values[j];
+    }
+  }
+
+  // Copy the strictly lower triangle to the upper triangle
+  for (size_t j = 1; j < variableDim_; ++j) {
+    hessian.col(j).head(j) = hessian.row(j).head(j).transpose();
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void GaussNewtonHessianAssembler::assembleDense(const scalar_t* values, matrix_t& hessian) const {
+  const size_t numNonZeroCols = nonZeroCols_.size();
+  // setZero() only allocates on the first call
+  compressedJacobian_.setZero(rangeDim_, numNonZeroCols);
+  for (size_t i = 0; i < rows_.size(); ++i) {
+    compressedJacobian_(rows_[i], compressedCols_[i]) = values[i];
+  }
+
+  if (numNonZeroCols == variableDim_) {
+    // All columns are nonzero: the compressed Hessian is the Hessian
+    hessian.setZero(variableDim_, variableDim_);
+    hessian.selfadjointView<Eigen::Lower>().rankUpdate(compressedJacobian_.transpose());
+  } else {
+    compressedHessian_.setZero(numNonZeroCols, numNonZeroCols);
+    compressedHessian_.selfadjointView<Eigen::Lower>().rankUpdate(compressedJacobian_.transpose());
+    hessian.setZero(variableDim_, variableDim_);
+    for (size_t j = 0; j < numNonZeroCols; ++j) {
+      for (size_t i = j; i < numNonZeroCols; ++i) {
+        hessian(nonZeroCols_[i], nonZeroCols_[j]) = compressedHessian_(i, j);
+      }
+    }
+  }
+
+  // Copy the strictly lower triangle to the upper triangle
+  for (size_t j = 1; j < variableDim_; ++j) {
+    hessian.col(j).head(j) = hessian.row(j).head(j).transpose();
+  }
+}
+
+}  // namespace ocs2
@@ -75,4 +75,18 @@ VectorFunctionLinearApproximation LinearStateInputConstraint::getLinearApproxima
   return g;
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void LinearStateInputConstraint::fillLinearApproximation(scalar_t t, const vector_t& x, const vector_t& u, const PreComputation&,
+                                                         VectorFunctionLinearApproximation& linearApproximation, size_t row) const {
+  const size_t nc = e_.rows();
+  auto g = linearApproximation.f.segment(row, nc);
+  g = e_;
+  g.noalias() += C_ * x;
+  g.noalias() += D_ * u;
+  linearApproximation.dfdx.middleRows(row, nc) = C_;
+  linearApproximation.dfdu.middleRows(row, nc) = D_;
+}
+
 }  // namespace ocs2
@@ -105,6 +105,15 @@ VectorFunctionLinearApproximation StateInputConstraintCollection::getLinearAppro
   return linearApproximation;
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void StateInputConstraintCollection::fillLinearApproximation(scalar_t time, const vector_t& state, const vector_t& input,
+                                                             const PreComputation& preComp,
+                                                             VectorFunctionLinearApproximation& linearApproximation) const {
+  linearApproximation = getLinearApproximation(time, state, input, preComp);
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -53,9 +53,9 @@ QuadraticStateInputCost* QuadraticStateInputCost::clone() const {
 /******************************************************************************************************/
 /******************************************************************************************************/
 scalar_t QuadraticStateInputCost::getValue(scalar_t time, const vector_t& state, const vector_t& input,
-                                           const TargetTrajectories& targetTrajectories, const PreComputation&) const {
+                                           const TargetTrajectories& targetTrajectories, const PreComputation& preComp) const {
   vector_t stateDeviation, inputDeviation;
-  std::tie(stateDeviation, inputDeviation) = getStateInputDeviation(time, state, input, targetTrajectories);
+  std::tie(stateDeviation, inputDeviation) = getStateInputDeviation(time, state, input, targetTrajectories, preComp);
 
   if (P_.size() == 0) {
     return 0.5 * stateDeviation.dot(Q_ * stateDeviation) + 0.5 * inputDeviation.dot(R_ * inputDeviation);
@@ -71,9 +71,9 @@ scalar_t QuadraticStateInputCost::getValue(scalar_t time, const vector_t& state,
 ScalarFunctionQuadraticApproximation QuadraticStateInputCost::getQuadraticApproximation(scalar_t time, const vector_t& state,
                                                                                         const vector_t& input,
                                                                                         const TargetTrajectories& targetTrajectories,
-                                                                                        const PreComputation&) const {
+                                                                                        const PreComputation& preComp) const {
   vector_t stateDeviation, inputDeviation;
-  std::tie(stateDeviation, inputDeviation) = getStateInputDeviation(time, state, input, targetTrajectories);
+  std::tie(stateDeviation, inputDeviation) = getStateInputDeviation(time, state, input, targetTrajectories, preComp);
 
   ScalarFunctionQuadraticApproximation L;
   L.dfdxx = Q_;
@@ -96,6 +96,31 @@ ScalarFunctionQuadraticApproximation QuadraticStateInputCost::getQuadraticApprox
   return L;
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void QuadraticStateInputCost::addQuadraticApproximation(scalar_t time, const vector_t& state, const vector_t& input,
+                                                        const TargetTrajectories& targetTrajectories, const PreComputation& preComp,
+                                                        ScalarFunctionQuadraticApproximation& cost) const {
+  vector_t stateDeviation, inputDeviation;
+  std::tie(stateDeviation, inputDeviation) = getStateInputDeviation(time, state, input, targetTrajectories, preComp);
+
+  vector_t qDeviation = Q_ * stateDeviation;
+  vector_t rDeviation = R_ * inputDeviation;
+  if (P_.size() > 0) {
+    qDeviation.noalias() += P_.transpose() * inputDeviation;
+    rDeviation.noalias() += P_ * stateDeviation;
+    cost.dfdux += P_;
+  }
+
+  // with P, the cross term is split equally between the two inner products
+  cost.f += 0.5 * stateDeviation.dot(qDeviation) + 0.5 * inputDeviation.dot(rDeviation);
+  cost.dfdx += qDeviation;
+  cost.dfdu += rDeviation;
+  cost.dfdxx += Q_;
+  cost.dfduu += R_;
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -106,4 +131,13 @@ std::pair<vector_t, vector_t> QuadraticStateInputCost::getStateInputDeviation(sc
   return {stateDeviation, inputDeviation};
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+std::pair<vector_t, vector_t> QuadraticStateInputCost::getStateInputDeviation(scalar_t time, const vector_t& state, const vector_t& input,
+                                                                              const TargetTrajectories& targetTrajectories,
+                                                                              const PreComputation& preComp) const {
+  return getStateInputDeviation(time, state, input, targetTrajectories);
+}
+
 }  // namespace ocs2
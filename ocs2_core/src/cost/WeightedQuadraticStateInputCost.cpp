@@ -0,0 +1,81 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+
+#include <ocs2_core/cost/WeightedQuadraticStateInputCost.h>
+
+namespace ocs2 {
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+WeightedQuadraticStateInputCost::WeightedQuadraticStateInputCost(std::shared_ptr<const CostWeights> weightsPtr, size_t stateDim,
+                                                                 size_t inputDim, const std::string& modelName,
+                                                                 const std::string& modelFolder, bool recompileLibraries, bool verbose)
+    : WeightedStateInputCostCppAd(std::move(weightsPtr)), stateDim_(stateDim), inputDim_(inputDim) {
+  if (static_cast<size_t>(getWeights().size()) != stateDim + inputDim) {
+    throw std::runtime_error("[WeightedQuadraticStateInputCost] Expected " + std::to_string(stateDim + inputDim) + " weights, but got " +
+                             std::to_string(getWeights().size()) + "!");
+  }
+  initialize(stateDim, inputDim, stateDim + inputDim, modelName, modelFolder, recompileLibraries, verbose);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+WeightedQuadraticStateInputCost* WeightedQuadraticStateInputCost::clone() const {
+  return new WeightedQuadraticStateInputCost(*this);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+vector_t WeightedQuadraticStateInputCost::getParameters(scalar_t time, const TargetTrajectories& targetTrajectories,
+                                                        const PreComputation& preComputation) const {
+  const auto& weights = getWeights();
+  vector_t parameters(weights.size() + stateDim_ + inputDim_);
+  parameters << weights, targetTrajectories.getDesiredState(time), targetTrajectories.getDesiredInput(time);
+  return parameters;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+ad_scalar_t WeightedQuadraticStateInputCost::costFunction(ad_scalar_t time, const ad_vector_t& state, const ad_vector_t& input,
+                                                          const ad_vector_t& parameters) const {
+  const size_t numWeights = stateDim_ + inputDim_;
+  const ad_vector_t stateWeights = parameters.head(stateDim_);
+  const ad_vector_t inputWeights = parameters.segment(stateDim_, inputDim_);
+  const ad_vector_t stateDeviation = state - parameters.segment(numWeights, stateDim_);
+  const ad_vector_t inputDeviation = input - parameters.segment(numWeights + stateDim_, inputDim_);
+  return ad_scalar_t(0.5) * (stateWeights.cwiseProduct(stateDeviation).dot(stateDeviation) +
+                             inputWeights.cwiseProduct(inputDeviation).dot(inputDeviation));
+}
+
+}  // namespace ocs2
@@ -118,6 +118,16 @@ vector_t LoopshapingDynamics::guardSurfacesDerivativeTime(scalar_t t, const vect
   throw std::runtime_error("[LoopshapingDynamics] Guard surfaces not implemented");
 }
 
+DynamicsStructure LoopshapingDynamics::getDynamicsStructure() const {
+  // The filter states are driven only by the filter and the inputs. In the output pattern, the system states are
+  // moreover independent of the filter states.
+  DynamicsStructure structure;
+  structure.trailingStateDim = loopshapingDefinition_->getInputFilter().getNumStates();
+  structure.diagonalTrailingBlock = loopshapingDefinition_->isDiagonal();
+  structure.zeroUpperCoupling = loopshapingDefinition_->getType() == LoopshapingType::outputpattern;
+  return structure;
+}
+
 std::unique_ptr<LoopshapingDynamics> LoopshapingDynamics::create(const SystemDynamicsBase& systemDynamics,
                                                                  std::shared_ptr<LoopshapingDefinition> loopshapingDefinition) {
   // wrap the system pre-computation
@@ -0,0 +1,84 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include "ocs2_core/model_data/DynamicsStructure.h"
+
+namespace ocs2 {
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void multiplyStateJacobian(const matrix_t& M, const matrix_t& dfdx, const DynamicsStructure& structure, matrix_t& out) {
+  if (structure.isDense()) {
+    out.noalias() = M * dfdx;
+    return;
+  }
+
+  const int n2 = structure.trailingStateDim;
+  const int n1 = dfdx.cols() - n2;
+  out.resize(M.rows(), dfdx.cols());
+
+  // [M1, M2] * [A11, A12; 0, A22] = [M1 * A11, M1 * A12 + M2 * A22]
+  out.leftCols(n1).noalias() = M.leftCols(n1) * dfdx.topLeftCorner(n1, n1);
+  if (structure.diagonalTrailingBlock) {
+    out.rightCols(n2).noalias() = M.rightCols(n2) * dfdx.bottomRightCorner(n2, n2).diagonal().asDiagonal();
+  } else {
+    out.rightCols(n2).noalias() = M.rightCols(n2) * dfdx.bottomRightCorner(n2, n2);
+  }
+  if (!structure.zeroUpperCoupling) {
+    out.rightCols(n2).noalias() += M.leftCols(n1) * dfdx.topRightCorner(n1, n2);
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void multiplyStateJacobianTranspose(const matrix_t& dfdx, const matrix_t& M, const DynamicsStructure& structure, matrix_t& out) {
+  if (structure.isDense()) {
+    out.noalias() = dfdx.transpose() * M;
+    return;
+  }
+
+  const int n2 = structure.trailingStateDim;
+  const int n1 = dfdx.cols() - n2;
+  out.resize(dfdx.cols(), M.cols());
+
+  // [A11^T, 0; A12^T, A22^T] * [M1; M2] = [A11^T * M1; A12^T * M1 + A22^T * M2]
+  out.topRows(n1).noalias() = dfdx.topLeftCorner(n1, n1).transpose() * M.topRows(n1);
+  if (structure.diagonalTrailingBlock) {
+    out.bottomRows(n2).noalias() = dfdx.bottomRightCorner(n2, n2).diagonal().asDiagonal() * M.bottomRows(n2);
+  } else {
+    out.bottomRows(n2).noalias() = dfdx.bottomRightCorner(n2, n2).transpose() * M.bottomRows(n2);
+  }
+  if (!structure.zeroUpperCoupling) {
+    out.bottomRows(n2).noalias() += dfdx.topRightCorner(n1, n2).transpose() * M.topRows(n1);
+  }
+}
+
+}  // namespace ocs2
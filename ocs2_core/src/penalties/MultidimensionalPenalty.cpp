@@ -163,6 +163,29 @@ ScalarFunctionQuadraticApproximation MultidimensionalPenalty::getQuadraticApprox
   return penaltyApproximation;
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void MultidimensionalPenalty::addQuadraticApproximation(scalar_t t, const VectorFunctionLinearApproximation& h,
+                                                        ScalarFunctionQuadraticApproximation& penaltyApproximation,
+                                                        const vector_t* l) const {
+  const auto inputDim = h.dfdu.cols();
+
+  scalar_t penaltyValue = 0.0;
+  vector_t penaltyDerivative, penaltySecondDerivative;
+  std::tie(penaltyValue, penaltyDerivative, penaltySecondDerivative) = getPenaltyValue1stDev2ndDev(t, h.f, l);
+  const matrix_t penaltySecondDev_dhdx = penaltySecondDerivative.asDiagonal() * h.dfdx;
+
+  penaltyApproximation.f += penaltyValue;
+  penaltyApproximation.dfdx.noalias() += h.dfdx.transpose() * penaltyDerivative;
+  penaltyApproximation.dfdxx.noalias() += h.dfdx.transpose() * penaltySecondDev_dhdx;
+  if (inputDim > 0) {
+    penaltyApproximation.dfdu.noalias() += h.dfdu.transpose() * penaltyDerivative;
+    penaltyApproximation.dfdux.noalias() += h.dfdu.transpose() * penaltySecondDev_dhdx;
+    penaltyApproximation.dfduu.noalias() += h.dfdu.transpose() * penaltySecondDerivative.asDiagonal() * h.dfdu;
+  }
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -52,6 +52,14 @@ size_t ModeSchedule::modeAtTime(scalar_t time) const {
   return modeSequence[ind];
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+size_t ModeSchedule::modeAtTime(scalar_t time, int& cursor) const {
+  const auto ind = lookup::findIndexInTimeArray(eventTimes, time, cursor);
+  return modeSequence[ind];
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -0,0 +1,127 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include "ocs2_core/reference/ReferenceSampler.h"
+
+#include <ocs2_core/misc/Lookup.h>
+
+namespace ocs2 {
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void ReferenceSampler::update(const scalar_array_t& timeGrid, const TargetTrajectories& targetTrajectories,
+                              const ModeSchedule& modeSchedule) {
+  timeGrid_ = timeGrid;
+  targetTrajectories_ = targetTrajectories;
+  modeSchedule_ = modeSchedule;
+  sourceTargetTrajectoriesPtr_ = &targetTrajectories;
+
+  const size_t N = timeGrid_.size();
+  desiredStates_.resize(targetTrajectories_.empty() ? 0 : N);
+  desiredInputs_.resize((targetTrajectories_.empty() || targetTrajectories_.inputTrajectory.empty()) ? 0 : N);
+  modes_.resize(N);
+
+  int targetTrajectoriesIndex = 0;
+  int eventTimesIndex = 0;
+  for (size_t i = 0; i < N; i++) {
+    if (!desiredStates_.empty()) {
+      targetTrajectories_.getDesiredState(timeGrid_[i], targetTrajectoriesIndex, desiredStates_[i]);
+    }
+    if (!desiredInputs_.empty()) {
+      targetTrajectories_.getDesiredInput(timeGrid_[i], targetTrajectoriesIndex, desiredInputs_[i]);
+    }
+    modes_[i] = modeSchedule_.modeAtTime(timeGrid_[i], eventTimesIndex);
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void ReferenceSampler::clear() {
+  timeGrid_.clear();
+  desiredStates_.clear();
+  desiredInputs_.clear();
+  modes_.clear();
+  targetTrajectories_.clear();
+  modeSchedule_ = ModeSchedule();
+  sourceTargetTrajectoriesPtr_ = nullptr;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+const vector_t& ReferenceSampler::getDesiredState(scalar_t time, Cursor& cursor) const {
+  const int index = findInTimeGrid(time, cursor);
+  if (index >= 0 && !desiredStates_.empty()) {
+    return desiredStates_[index];
+  } else {
+    targetTrajectories_.getDesiredState(time, cursor.targetTrajectoriesIndex, cursor.desiredState);
+    return cursor.desiredState;
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+const vector_t& ReferenceSampler::getDesiredInput(scalar_t time, Cursor& cursor) const {
+  const int index = findInTimeGrid(time, cursor);
+  if (index >= 0 && !desiredInputs_.empty()) {
+    return desiredInputs_[index];
+  } else {
+    targetTrajectories_.getDesiredInput(time, cursor.targetTrajectoriesIndex, cursor.desiredInput);
+    return cursor.desiredInput;
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+size_t ReferenceSampler::getMode(scalar_t time, Cursor& cursor) const {
+  const int index = findInTimeGrid(time, cursor);
+  if (index >= 0) {
+    return modes_[index];
+  } else {
+    return modeSchedule_.modeAtTime(time, cursor.eventTimesIndex);
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+int ReferenceSampler::findInTimeGrid(scalar_t time, Cursor& cursor) const {
+  const int index = lookup::findIndexInTimeArray(timeGrid_, time, cursor.timeGridIndex);
+  if (index < static_cast<int>(timeGrid_.size()) && timeGrid_[index] == time) {
+    return index;
+  } else {
+    return -1;
+  }
+}
+
+}  // namespace ocs2
@@ -34,6 +34,26 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 namespace ocs2 {
 
+namespace {
+
+/** Same as LinearInterpolation::interpolate, but writes to the preallocated result. */
+void interpolateInPlace(const LinearInterpolation::index_alpha_t& indexAlpha, const vector_array_t& dataArray, vector_t& result) {
+  if (dataArray.size() > 1) {
+    const auto& lhs = dataArray[indexAlpha.first];
+    const auto& rhs = dataArray[indexAlpha.first + 1];
+    const scalar_t alpha = indexAlpha.second;
+    if (lhs.size() == rhs.size()) {
+      result = alpha * lhs + (1.0 - alpha) * rhs;
+    } else {
+      result = (alpha > 0.5) ? lhs : rhs;
+    }
+  } else {
+    result = dataArray.front();
+  }
+}
+
+}  // namespace
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /***************************************************************************************************** */
@@ -94,6 +114,30 @@ vector_t TargetTrajectories::getDesiredInput(scalar_t time) const {
   }
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/***************************************************************************************************** */
+void TargetTrajectories::getDesiredState(scalar_t time, int& cursor, vector_t& desiredState) const {
+  if (this->empty()) {
+    throw std::runtime_error("[TargetTrajectories] TargetTrajectories is empty!");
+  } else {
+    interpolateInPlace(LinearInterpolation::timeSegment(time, timeTrajectory, cursor), stateTrajectory, desiredState);
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/***************************************************************************************************** */
+void TargetTrajectories::getDesiredInput(scalar_t time, int& cursor, vector_t& desiredInput) const {
+  if (this->empty()) {
+    throw std::runtime_error("[TargetTrajectories] TargetTrajectories is empty!");
+  } else if (inputTrajectory.empty()) {
+    throw std::runtime_error("[TargetTrajectories] TargetTrajectories does not have inputTrajectory!");
+  } else {
+    interpolateInPlace(LinearInterpolation::timeSegment(time, timeTrajectory, cursor), inputTrajectory, desiredInput);
+  }
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /***************************************************************************************************** */
@@ -109,6 +109,17 @@ ScalarFunctionQuadraticApproximation StateInputSoftBoxConstraint::getQuadraticAp
   return cost;
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void StateInputSoftBoxConstraint::addQuadraticApproximation(scalar_t time, const vector_t& state, const vector_t& input,
+                                                            const TargetTrajectories&, const PreComputation&,
+                                                            ScalarFunctionQuadraticApproximation& cost) const {
+  fillQuadraticApproximation(time, state, stateBoxConstraints_, cost.f, cost.dfdx, cost.dfdxx);
+  fillQuadraticApproximation(time, input, inputBoxConstraints_, cost.f, cost.dfdu, cost.dfduu);
+  cost.f += offset_;
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
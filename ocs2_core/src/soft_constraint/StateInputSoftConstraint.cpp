@@ -89,4 +89,17 @@ ScalarFunctionQuadraticApproximation StateInputSoftConstraint::getQuadraticAppro
   }
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void StateInputSoftConstraint::addQuadraticApproximation(scalar_t time, const vector_t& state, const vector_t& input,
+                                                         const TargetTrajectories& targetTrajectories, const PreComputation& preComp,
+                                                         ScalarFunctionQuadraticApproximation& cost) const {
+  if (constraintPtr_->getOrder() == ConstraintOrder::Linear) {
+    penalty_.addQuadraticApproximation(time, constraintPtr_->getLinearApproximation(time, state, input, preComp), cost);
+  } else {
+    cost += getQuadraticApproximation(time, state, input, targetTrajectories, preComp);
+  }
+}
+
 }  // namespace ocs2
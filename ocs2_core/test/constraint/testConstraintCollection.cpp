@@ -29,8 +29,12 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <gtest/gtest.h>
 
+#include <ocs2_core/constraint/LinearStateInputConstraint.h>
 #include <ocs2_core/constraint/StateConstraintCollection.h>
 #include <ocs2_core/constraint/StateInputConstraintCollection.h>
+#include <ocs2_core/constraint/StaticStateInputConstraintCollection.h>
+#include <ocs2_core/test/testTools.h>
+
 #include "testConstraints.h"
 
 TEST(TestConstraintCollection, add) {
@@ -187,3 +191,70 @@ TEST(TestConstraintCollection, getQuadraticApproximation) {
   EXPECT_EQ(quadraticApproximation.dfduu[1].sum(), 2 * 2);
   EXPECT_EQ(quadraticApproximation.dfdux[1].sum(), 2 * 3);
 }
+
+TEST(TestConstraintCollection, staticCollection) {
+  using static_collection_t = ocs2::StaticStateInputConstraintCollection<TestDummyConstraint, TestDummyConstraint, TestDummyConstraint>;
+
+  // evaluation point
+  const double t = 0.0;
+  const ocs2::vector_t x = ocs2::vector_t::Random(3);
+  const ocs2::vector_t u = ocs2::vector_t::Random(2);
+
+  // static terms followed by a dynamically added term
+  static_collection_t staticCollection(std::unique_ptr<TestDummyConstraint>(new TestDummyConstraint()),
+                                       std::unique_ptr<TestDummyConstraint>(new TestDummyConstraint()),
+                                       std::unique_ptr<TestDummyConstraint>(new TestDummyConstraint()));
+  staticCollection.add("Constraint4", std::unique_ptr<TestDummyConstraint>(new TestDummyConstraint()));
+  staticCollection.getStaticTerm<2>().setActivity(false);
+
+  ocs2::StateInputConstraintCollection dynamicCollection;
+  dynamicCollection.add("Constraint1", std::unique_ptr<TestDummyConstraint>(new TestDummyConstraint()));
+  dynamicCollection.add("Constraint2", std::unique_ptr<TestDummyConstraint>(new TestDummyConstraint()));
+  dynamicCollection.add("Constraint4", std::unique_ptr<TestDummyConstraint>(new TestDummyConstraint()));
+
+  std::unique_ptr<ocs2::StateInputConstraintCollection> clonePtr(staticCollection.clone());
+  for (const ocs2::StateInputConstraintCollection* collectionPtr : {static_cast<ocs2::StateInputConstraintCollection*>(&staticCollection),
+                                                                    clonePtr.get()}) {
+    EXPECT_FALSE(collectionPtr->empty());
+    ASSERT_EQ(collectionPtr->getNumConstraints(t), 6);
+    EXPECT_TRUE(collectionPtr->getValue(t, x, u, ocs2::PreComputation()) == dynamicCollection.getValue(t, x, u, ocs2::PreComputation()));
+    EXPECT_TRUE(ocs2::isApprox(collectionPtr->getLinearApproximation(t, x, u, ocs2::PreComputation()),
+                               dynamicCollection.getLinearApproximation(t, x, u, ocs2::PreComputation())));
+    EXPECT_TRUE(ocs2::isApprox(collectionPtr->getQuadraticApproximation(t, x, u, ocs2::PreComputation()),
+                               dynamicCollection.getQuadraticApproximation(t, x, u, ocs2::PreComputation())));
+  }
+}
+
+TEST(TestConstraintCollection, staticCollectionFillLinearApproximation) {
+  using static_collection_t = ocs2::StaticStateInputConstraintCollection<ocs2::LinearStateInputConstraint, TestDummyConstraint>;
+
+  // evaluation point
+  const double t = 0.0;
+  const ocs2::vector_t x = ocs2::vector_t::Random(3);
+  const ocs2::vector_t u = ocs2::vector_t::Random(2);
+
+  // the linear term writes its rows in place, the dummy term is copied
+  const ocs2::vector_t e = ocs2::vector_t::Random(2);
+  const ocs2::matrix_t C = ocs2::matrix_t::Random(2, 3);
+  const ocs2::matrix_t D = ocs2::matrix_t::Random(2, 2);
+  static_collection_t staticCollection(std::unique_ptr<ocs2::LinearStateInputConstraint>(new ocs2::LinearStateInputConstraint(e, C, D)),
+                                       std::unique_ptr<TestDummyConstraint>(new TestDummyConstraint()));
+
+  ocs2::StateInputConstraintCollection dynamicCollection;
+  dynamicCollection.add("Constraint1", std::unique_ptr<ocs2::LinearStateInputConstraint>(new ocs2::LinearStateInputConstraint(e, C, D)));
+  dynamicCollection.add("Constraint2", std::unique_ptr<TestDummyConstraint>(new TestDummyConstraint()));
+  const auto expectedApproximation = dynamicCollection.getLinearApproximation(t, x, u, ocs2::PreComputation());
+
+  // the storage of the node buffer is reused
+  auto linearApproximation = ocs2::VectorFunctionLinearApproximation::Zero(4, 3, 2);
+  const auto* const dfdxData = linearApproximation.dfdx.data();
+  const ocs2::StateInputConstraintCollection& collection = staticCollection;
+  collection.fillLinearApproximation(t, x, u, ocs2::PreComputation(), linearApproximation);
+  EXPECT_TRUE(ocs2::isApprox(linearApproximation, expectedApproximation));
+  EXPECT_EQ(linearApproximation.dfdx.data(), dfdxData);
+
+  // through the default implementation of the dynamic collection
+  ocs2::VectorFunctionLinearApproximation dynamicApproximation;
+  dynamicCollection.fillLinearApproximation(t, x, u, ocs2::PreComputation(), dynamicApproximation);
+  EXPECT_TRUE(ocs2::isApprox(dynamicApproximation, expectedApproximation));
+}
@@ -0,0 +1,241 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <iostream>
+
+#include <ocs2_core/cost/CostWeights.h>
+#include <ocs2_core/cost/QuadraticStateInputCost.h>
+#include <ocs2_core/cost/WeightedQuadraticStateInputCost.h>
+#include <ocs2_core/cost/WeightedStateInputCostCppAd.h>
+#include <ocs2_core/misc/Benchmark.h>
+
+namespace {
+
+/** cost = 0.5 * (w0 * x0^2 + w1 * x1^2 + w2 * u0^2) */
+template <typename SCALAR_T>
+SCALAR_T diagonalQuadraticCost(const Eigen::Matrix<SCALAR_T, -1, 1>& state, const Eigen::Matrix<SCALAR_T, -1, 1>& input,
+                               const Eigen::Matrix<SCALAR_T, -1, 1>& weights) {
+  return SCALAR_T(0.5) * (weights(0) * state(0) * state(0) + weights(1) * state(1) * state(1) + weights(2) * input(0) * input(0));
+}
+
+class TestWeightedCost : public ocs2::WeightedStateInputCostCppAd {
+ public:
+  explicit TestWeightedCost(std::shared_ptr<const ocs2::CostWeights> weightsPtr)
+      : ocs2::WeightedStateInputCostCppAd(std::move(weightsPtr)) {
+    initialize(2, 1, 0, "TestWeightedCost", "/tmp/ocs2", true, false);
+  }
+  ~TestWeightedCost() override = default;
+  TestWeightedCost* clone() const override { return new TestWeightedCost(*this); }
+
+  ocs2::ad_scalar_t costFunction(ocs2::ad_scalar_t time, const ocs2::ad_vector_t& state, const ocs2::ad_vector_t& input,
+                                 const ocs2::ad_vector_t& weights) const override {
+    return diagonalQuadraticCost(state, input, weights);
+  }
+
+ private:
+  TestWeightedCost(const TestWeightedCost& other) = default;
+};
+
+/** The same cost on the deviation of the state from its reference. The reference state is appended to the weights. */
+class TestWeightedTrackingCost : public ocs2::WeightedStateInputCostCppAd {
+ public:
+  explicit TestWeightedTrackingCost(std::shared_ptr<const ocs2::CostWeights> weightsPtr)
+      : ocs2::WeightedStateInputCostCppAd(std::move(weightsPtr)) {
+    initialize(2, 1, 2, "TestWeightedTrackingCost", "/tmp/ocs2", true, false);
+  }
+  ~TestWeightedTrackingCost() override = default;
+  TestWeightedTrackingCost* clone() const override { return new TestWeightedTrackingCost(*this); }
+
+  ocs2::vector_t getParameters(ocs2::scalar_t time, const ocs2::TargetTrajectories& targetTrajectories,
+                               const ocs2::PreComputation& preComputation) const override {
+    ocs2::vector_t parameters(getWeights().size() + 2);
+    parameters << getWeights(), targetTrajectories.getDesiredState(time);
+    return parameters;
+  }
+
+  ocs2::ad_scalar_t costFunction(ocs2::ad_scalar_t time, const ocs2::ad_vector_t& state, const ocs2::ad_vector_t& input,
+                                 const ocs2::ad_vector_t& parameters) const override {
+    const ocs2::ad_vector_t stateDeviation = state - parameters.tail(2);
+    return diagonalQuadraticCost(stateDeviation, input, ocs2::ad_vector_t(parameters.head(3)));
+  }
+
+ private:
+  TestWeightedTrackingCost(const TestWeightedTrackingCost& other) = default;
+};
+
+/** The same cost with weights which are fixed at code generation. */
+class TestFixedWeightCost : public ocs2::StateInputCostCppAd {
+ public:
+  explicit TestFixedWeightCost(ocs2::vector_t weights) : weights_(std::move(weights)) {
+    initialize(2, 1, 0, "TestFixedWeightCost", "/tmp/ocs2", true, false);
+  }
+  ~TestFixedWeightCost() override = default;
+  TestFixedWeightCost* clone() const override { return new TestFixedWeightCost(*this); }
+
+  ocs2::ad_scalar_t costFunction(ocs2::ad_scalar_t time, const ocs2::ad_vector_t& state, const ocs2::ad_vector_t& input,
+                                 const ocs2::ad_vector_t& parameters) const override {
+    return diagonalQuadraticCost(state, input, ocs2::ad_vector_t(weights_.cast<ocs2::ad_scalar_t>()));
+  }
+
+ private:
+  TestFixedWeightCost(const TestFixedWeightCost& other) = default;
+
+  ocs2::vector_t weights_;
+};
+
+}  // unnamed namespace
+
+TEST(testCostWeights, weightsAreBuffered) {
+  ocs2::CostWeights costWeights(ocs2::vector_t::Ones(3));
+  EXPECT_FALSE(costWeights.updateWeights());
+
+  const ocs2::vector_t newWeights = (ocs2::vector_t(3) << 1.0, 2.0, 3.0).finished();
+  costWeights.setWeights(newWeights);
+  EXPECT_TRUE(costWeights.getWeights().isApprox(ocs2::vector_t::Ones(3)));
+  EXPECT_TRUE(costWeights.updateWeights());
+  EXPECT_TRUE(costWeights.getWeights().isApprox(newWeights));
+
+  EXPECT_THROW(costWeights.setWeights(ocs2::vector_t::Ones(2)), std::runtime_error);
+}
+
+TEST(testCostWeights, updateWithoutRegeneration) {
+  auto costWeightsPtr = std::make_shared<ocs2::CostWeights>(ocs2::vector_t::Ones(3));
+  const TestWeightedCost cost(costWeightsPtr);
+  std::unique_ptr<TestWeightedCost> clonedCostPtr(cost.clone());
+
+  const ocs2::TargetTrajectories targetTrajectories;
+  const ocs2::vector_t x = ocs2::vector_t::Ones(2);
+  const ocs2::vector_t u = ocs2::vector_t::Ones(1);
+
+  auto approx = cost.getQuadraticApproximation(0.0, x, u, targetTrajectories, ocs2::PreComputation());
+  EXPECT_NEAR(approx.f, 1.5, 1e-9);
+  EXPECT_TRUE(approx.dfdxx.isApprox(ocs2::matrix_t::Identity(2, 2)));
+
+  const ocs2::vector_t newWeights = (ocs2::vector_t(3) << 1.0, 2.0, 3.0).finished();
+  costWeightsPtr->setWeights(newWeights);
+  costWeightsPtr->updateWeights();
+
+  // the clones share the weights
+  for (const TestWeightedCost* costPtr : {&cost, static_cast<const TestWeightedCost*>(clonedCostPtr.get())}) {
+    approx = costPtr->getQuadraticApproximation(0.0, x, u, targetTrajectories, ocs2::PreComputation());
+    EXPECT_NEAR(approx.f, 3.0, 1e-9);
+    EXPECT_TRUE(approx.dfdxx.isApprox(newWeights.head(2).asDiagonal().toDenseMatrix()));
+    EXPECT_TRUE(approx.dfduu.isApprox(newWeights.tail(1)));
+  }
+}
+
+TEST(testCostWeights, extraParameters) {
+  auto costWeightsPtr = std::make_shared<ocs2::CostWeights>(ocs2::vector_t::Ones(3));
+  const TestWeightedTrackingCost cost(costWeightsPtr);
+
+  const ocs2::vector_t xRef = (ocs2::vector_t(2) << 1.0, -1.0).finished();
+  const ocs2::TargetTrajectories targetTrajectories({0.0}, {xRef}, {ocs2::vector_t::Zero(1)});
+  const ocs2::vector_t x = ocs2::vector_t::Zero(2);
+  const ocs2::vector_t u = ocs2::vector_t::Ones(1);
+
+  const ocs2::vector_t newWeights = (ocs2::vector_t(3) << 1.0, 2.0, 3.0).finished();
+  costWeightsPtr->setWeights(newWeights);
+  costWeightsPtr->updateWeights();
+
+  const auto approx = cost.getQuadraticApproximation(0.0, x, u, targetTrajectories, ocs2::PreComputation());
+  EXPECT_NEAR(approx.f, 3.0, 1e-9);
+  EXPECT_TRUE(approx.dfdx.isApprox(-newWeights.head(2).cwiseProduct(xRef)));
+}
+
+TEST(testCostWeights, weightedQuadraticCost) {
+  const ocs2::vector_t q = (ocs2::vector_t(2) << 1.0, 2.0).finished();
+  const ocs2::vector_t r = (ocs2::vector_t(1) << 3.0).finished();
+  ocs2::vector_t weights(3);
+  weights << q, r;
+  auto costWeightsPtr = std::make_shared<ocs2::CostWeights>(ocs2::vector_t::Ones(3));
+  const ocs2::WeightedQuadraticStateInputCost weightedCost(costWeightsPtr, 2, 1, "WeightedQuadraticStateInputCost", "/tmp/ocs2", true,
+                                                           false);
+  costWeightsPtr->setWeights(weights);
+  costWeightsPtr->updateWeights();
+  const ocs2::QuadraticStateInputCost quadraticCost(q.asDiagonal(), r.asDiagonal());
+
+  const ocs2::TargetTrajectories targetTrajectories({0.0, 1.0}, {ocs2::vector_t::Zero(2), ocs2::vector_t::Ones(2)},
+                                                    {ocs2::vector_t::Zero(1), -ocs2::vector_t::Ones(1)});
+  const ocs2::vector_t x = (ocs2::vector_t(2) << 0.3, -0.2).finished();
+  const ocs2::vector_t u = (ocs2::vector_t(1) << 0.1).finished();
+  const ocs2::scalar_t t = 0.4;
+
+  const auto weightedApprox = weightedCost.getQuadraticApproximation(t, x, u, targetTrajectories, ocs2::PreComputation());
+  const auto quadraticApprox = quadraticCost.getQuadraticApproximation(t, x, u, targetTrajectories, ocs2::PreComputation());
+  EXPECT_NEAR(weightedApprox.f, quadraticApprox.f, 1e-9);
+  EXPECT_TRUE(weightedApprox.dfdx.isApprox(quadraticApprox.dfdx));
+  EXPECT_TRUE(weightedApprox.dfdu.isApprox(quadraticApprox.dfdu));
+  EXPECT_TRUE(weightedApprox.dfdxx.isApprox(quadraticApprox.dfdxx));
+  EXPECT_TRUE(weightedApprox.dfduu.isApprox(quadraticApprox.dfduu));
+  EXPECT_TRUE(weightedApprox.dfdux.isZero());
+
+  EXPECT_THROW(ocs2::WeightedQuadraticStateInputCost(costWeightsPtr, 3, 1, "WeightedQuadraticStateInputCost"), std::runtime_error);
+}
+
+TEST(testCostWeights, DISABLED_benchmark) {
+  constexpr size_t numCycles = 1000;
+  constexpr size_t numRebuilds = 2;
+
+  const ocs2::TargetTrajectories targetTrajectories;
+  const ocs2::vector_t x = ocs2::vector_t::Ones(2);
+  const ocs2::vector_t u = ocs2::vector_t::Ones(1);
+
+  // weight update per MPC cycle
+  auto costWeightsPtr = std::make_shared<ocs2::CostWeights>(ocs2::vector_t::Ones(3));
+  const TestWeightedCost weightedCost(costWeightsPtr);
+  ocs2::benchmark::RepeatedTimer updateTimer;
+  ocs2::scalar_t weightedCostValue = 0.0;
+  for (size_t i = 0; i < numCycles; i++) {
+    const ocs2::vector_t weights = ocs2::vector_t::Constant(3, 1.0 + i);
+    updateTimer.startTimer();
+    costWeightsPtr->setWeights(weights);
+    costWeightsPtr->updateWeights();
+    weightedCostValue = weightedCost.getValue(0.0, x, u, targetTrajectories, ocs2::PreComputation());
+    updateTimer.endTimer();
+  }
+
+  // regenerating the cost with fixed weights
+  ocs2::benchmark::RepeatedTimer rebuildTimer;
+  ocs2::scalar_t fixedCostValue = 0.0;
+  for (size_t i = 0; i < numRebuilds; i++) {
+    rebuildTimer.startTimer();
+    const TestFixedWeightCost fixedWeightCost(ocs2::vector_t::Constant(3, numCycles));
+    fixedCostValue = fixedWeightCost.getValue(0.0, x, u, targetTrajectories, ocs2::PreComputation());
+    rebuildTimer.endTimer();
+  }
+
+  EXPECT_NEAR(weightedCostValue, fixedCostValue, 1e-9);
+
+  std::cerr << "\n########################################################################\n";
+  std::cerr << "Changing the weights of a CppAD cost\n";
+  std::cerr << "Weight update:  " << updateTimer.getAverageInMilliseconds() << " [ms]\n";
+  std::cerr << "Regeneration:   " << rebuildTimer.getAverageInMilliseconds() << " [ms]\n";
+}
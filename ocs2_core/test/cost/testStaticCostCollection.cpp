@@ -0,0 +1,315 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <iostream>
+#include <string>
+
+#include <ocs2_core/constraint/LinearStateInputConstraint.h>
+#include <ocs2_core/cost/QuadraticStateInputCost.h>
+#include <ocs2_core/cost/StaticStateInputCostCollection.h>
+#include <ocs2_core/misc/Benchmark.h>
+#include <ocs2_core/penalties/Penalties.h>
+#include <ocs2_core/soft_constraint/StateInputSoftBoxConstraint.h>
+#include <ocs2_core/soft_constraint/StateInputSoftConstraint.h>
+#include <ocs2_core/test/testTools.h>
+
+namespace {
+
+/** A cost without the in-place addQuadraticApproximation(): cost = 0.5 * |x|^2 + g' * u */
+class TestLinearInputCost final : public ocs2::StateInputCost {
+ public:
+  explicit TestLinearInputCost(ocs2::vector_t g) : g_(std::move(g)) {}
+  ~TestLinearInputCost() override = default;
+  TestLinearInputCost* clone() const override { return new TestLinearInputCost(*this); }
+
+  bool isActive(ocs2::scalar_t time) const override { return active_; }
+
+  ocs2::scalar_t getValue(ocs2::scalar_t t, const ocs2::vector_t& x, const ocs2::vector_t& u, const ocs2::TargetTrajectories&,
+                          const ocs2::PreComputation&) const override {
+    return 0.5 * x.squaredNorm() + g_.dot(u);
+  }
+
+  ocs2::ScalarFunctionQuadraticApproximation getQuadraticApproximation(ocs2::scalar_t t, const ocs2::vector_t& x, const ocs2::vector_t& u,
+                                                                       const ocs2::TargetTrajectories&,
+                                                                       const ocs2::PreComputation&) const override {
+    auto quadraticApproximation = ocs2::ScalarFunctionQuadraticApproximation::Zero(x.rows(), u.rows());
+    quadraticApproximation.f = 0.5 * x.squaredNorm() + g_.dot(u);
+    quadraticApproximation.dfdx = x;
+    quadraticApproximation.dfdu = g_;
+    quadraticApproximation.dfdxx.setIdentity();
+    return quadraticApproximation;
+  }
+
+  bool active_ = true;
+
+ private:
+  ocs2::vector_t g_;
+};
+
+/** A derived type of QuadraticStateInputCost which cannot be used as a QuadraticStateInputCost static term. */
+class TestDerivedQuadraticCost final : public ocs2::QuadraticStateInputCost {
+ public:
+  TestDerivedQuadraticCost(ocs2::matrix_t Q, ocs2::matrix_t R) : ocs2::QuadraticStateInputCost(std::move(Q), std::move(R)) {}
+  TestDerivedQuadraticCost* clone() const override { return new TestDerivedQuadraticCost(*this); }
+};
+
+ocs2::matrix_t randomPositiveDefinite(size_t n) {
+  const ocs2::matrix_t A = ocs2::matrix_t::Random(n, n);
+  return A * A.transpose() + ocs2::matrix_t::Identity(n, n);
+}
+
+std::unique_ptr<ocs2::QuadraticStateInputCost> randomQuadraticCost(size_t stateDim, size_t inputDim) {
+  return std::unique_ptr<ocs2::QuadraticStateInputCost>(new ocs2::QuadraticStateInputCost(
+      randomPositiveDefinite(stateDim), randomPositiveDefinite(inputDim), ocs2::matrix_t::Random(inputDim, stateDim)));
+}
+
+/** Soft constraint on a linear combination of the inputs u[3 * leg, 3 * leg + 3), as the friction cone of a foot */
+std::unique_ptr<ocs2::StateInputSoftConstraint> linearSoftConstraint(size_t stateDim, size_t inputDim, size_t leg) {
+  ocs2::matrix_t D = ocs2::matrix_t::Zero(1, inputDim);
+  D.middleCols<3>(3 * leg).setRandom();
+  std::unique_ptr<ocs2::StateInputConstraint> constraintPtr(
+      new ocs2::LinearStateInputConstraint(ocs2::vector_t::Constant(1, 10.0), ocs2::matrix_t::Zero(1, stateDim), std::move(D)));
+  std::unique_ptr<ocs2::PenaltyBase> penaltyPtr(new ocs2::RelaxedBarrierPenalty(ocs2::RelaxedBarrierPenalty::Config(0.1, 5.0)));
+  return std::unique_ptr<ocs2::StateInputSoftConstraint>(
+      new ocs2::StateInputSoftConstraint(std::move(constraintPtr), std::move(penaltyPtr)));
+}
+
+/** Soft box constraints on all inputs, as the joint velocity limits of a manipulator */
+std::unique_ptr<ocs2::StateInputSoftBoxConstraint> inputSoftBoxConstraint(size_t inputDim) {
+  std::vector<ocs2::StateInputSoftBoxConstraint::BoxConstraint> inputBoxConstraints(inputDim);
+  for (size_t i = 0; i < inputDim; i++) {
+    inputBoxConstraints[i].index = i;
+    inputBoxConstraints[i].lowerBound = -2.0;
+    inputBoxConstraints[i].upperBound = 2.0;
+    inputBoxConstraints[i].penaltyPtr.reset(new ocs2::RelaxedBarrierPenalty(ocs2::RelaxedBarrierPenalty::Config(0.1, 1e-3)));
+  }
+  return std::unique_ptr<ocs2::StateInputSoftBoxConstraint>(new ocs2::StateInputSoftBoxConstraint({}, std::move(inputBoxConstraints)));
+}
+
+/**
+ * Times the quadratic approximation of the same cost set in a dynamic collection, which returns a new approximation, and in a static
+ * collection, which accumulates into the reused approximation of a node.
+ */
+template <typename StaticCollection>
+void benchmarkCostCollections(const std::string& description, const ocs2::StateInputCostCollection& dynamicCollection,
+                              const StaticCollection& staticCollection, size_t stateDim, size_t inputDim) {
+  constexpr size_t numEvaluations = 10000;
+  const ocs2::TargetTrajectories targetTrajectories({0.0}, {ocs2::vector_t::Random(stateDim)}, {ocs2::vector_t::Random(inputDim)});
+  const ocs2::vector_t x = ocs2::vector_t::Random(stateDim);
+  const ocs2::vector_t u = ocs2::vector_t::Random(inputDim);
+
+  ocs2::benchmark::RepeatedTimer staticTimer;
+  ocs2::benchmark::RepeatedTimer dynamicTimer;
+  ocs2::ScalarFunctionQuadraticApproximation staticCost, dynamicCost;
+  for (size_t i = 0; i < numEvaluations; i++) {
+    dynamicTimer.startTimer();
+    dynamicCost = dynamicCollection.getQuadraticApproximation(0.0, x, u, targetTrajectories, {});
+    dynamicTimer.endTimer();
+
+    staticTimer.startTimer();
+    staticCost.setZero(stateDim, inputDim);
+    staticCollection.addQuadraticApproximation(0.0, x, u, targetTrajectories, {}, staticCost);
+    staticTimer.endTimer();
+  }
+
+  EXPECT_TRUE(ocs2::isApprox(staticCost, dynamicCost, 1e-9));
+
+  std::cerr << "\n########################################################################\n";
+  std::cerr << description << " (nx = " << stateDim << ", nu = " << inputDim << ")\n";
+  std::cerr << "Dynamic collection:  " << dynamicTimer.getAverageInMilliseconds() << " [ms]\n";
+  std::cerr << "Static collection:   " << staticTimer.getAverageInMilliseconds() << " [ms]\n";
+}
+
+}  // unnamed namespace
+
+class StaticStateInputCostCollection_TestFixture : public ::testing::Test {
+ public:
+  using static_collection_t =
+      ocs2::StaticStateInputCostCollection<ocs2::QuadraticStateInputCost, TestLinearInputCost, ocs2::QuadraticStateInputCost>;
+
+  static constexpr size_t STATE_DIM = 4;
+  static constexpr size_t INPUT_DIM = 2;
+  static constexpr ocs2::scalar_t tol = 1e-9;
+
+  StaticStateInputCostCollection_TestFixture()
+      : targetTrajectories({0.0}, {ocs2::vector_t::Random(STATE_DIM)}, {ocs2::vector_t::Random(INPUT_DIM)}),
+        x(ocs2::vector_t::Random(STATE_DIM)),
+        u(ocs2::vector_t::Random(INPUT_DIM)) {
+    auto cost1 = randomQuadraticCost(STATE_DIM, INPUT_DIM);
+    auto cost2 = std::unique_ptr<TestLinearInputCost>(new TestLinearInputCost(ocs2::vector_t::Random(INPUT_DIM)));
+    auto cost3 = randomQuadraticCost(STATE_DIM, INPUT_DIM);
+    auto dynamicCost = randomQuadraticCost(STATE_DIM, INPUT_DIM);
+
+    staticCollectionPtr.reset(new static_collection_t(std::unique_ptr<ocs2::QuadraticStateInputCost>(cost1->clone()),
+                                                      std::unique_ptr<TestLinearInputCost>(cost2->clone()),
+                                                      std::unique_ptr<ocs2::QuadraticStateInputCost>(cost3->clone())));
+    staticCollectionPtr->add("dynamicCost", std::unique_ptr<ocs2::StateInputCost>(dynamicCost->clone()));
+
+    dynamicCollection.add("cost1", std::move(cost1));
+    dynamicCollection.add("cost2", std::move(cost2));
+    dynamicCollection.add("cost3", std::move(cost3));
+    dynamicCollection.add("dynamicCost", std::move(dynamicCost));
+  }
+
+  const ocs2::TargetTrajectories targetTrajectories;
+  const ocs2::vector_t x;
+  const ocs2::vector_t u;
+  const ocs2::scalar_t t = 0.0;
+
+  std::unique_ptr<static_collection_t> staticCollectionPtr;
+  ocs2::StateInputCostCollection dynamicCollection;
+};
+
+constexpr ocs2::scalar_t StaticStateInputCostCollection_TestFixture::tol;
+
+TEST_F(StaticStateInputCostCollection_TestFixture, matchesDynamicCollection) {
+  EXPECT_NEAR(staticCollectionPtr->getValue(t, x, u, targetTrajectories, {}), dynamicCollection.getValue(t, x, u, targetTrajectories, {}),
+              tol);
+  EXPECT_TRUE(ocs2::isApprox(staticCollectionPtr->getQuadraticApproximation(t, x, u, targetTrajectories, {}),
+                             dynamicCollection.getQuadraticApproximation(t, x, u, targetTrajectories, {}), tol));
+}
+
+TEST_F(StaticStateInputCostCollection_TestFixture, addQuadraticApproximation) {
+  // accumulate on top of an existing approximation through the base class interface
+  const ocs2::StateInputCostCollection& collection = *staticCollectionPtr;
+  auto cost = dynamicCollection.getQuadraticApproximation(t, x, u, targetTrajectories, {});
+  collection.addQuadraticApproximation(t, x, u, targetTrajectories, {}, cost);
+
+  auto expectedCost = dynamicCollection.getQuadraticApproximation(t, x, u, targetTrajectories, {});
+  expectedCost *= 2.0;
+  EXPECT_TRUE(ocs2::isApprox(cost, expectedCost, tol));
+}
+
+TEST_F(StaticStateInputCostCollection_TestFixture, activity) {
+  staticCollectionPtr->getStaticTerm<1>().active_ = false;
+  dynamicCollection.get<TestLinearInputCost>("cost2").active_ = false;
+
+  EXPECT_NEAR(staticCollectionPtr->getValue(t, x, u, targetTrajectories, {}), dynamicCollection.getValue(t, x, u, targetTrajectories, {}),
+              tol);
+  EXPECT_TRUE(ocs2::isApprox(staticCollectionPtr->getQuadraticApproximation(t, x, u, targetTrajectories, {}),
+                             dynamicCollection.getQuadraticApproximation(t, x, u, targetTrajectories, {}), tol));
+}
+
+TEST_F(StaticStateInputCostCollection_TestFixture, cloneAndEmpty) {
+  std::unique_ptr<ocs2::StateInputCostCollection> clonePtr(staticCollectionPtr->clone());
+  EXPECT_NEAR(clonePtr->getValue(t, x, u, targetTrajectories, {}), dynamicCollection.getValue(t, x, u, targetTrajectories, {}), tol);
+
+  // without dynamic terms the collection is not empty
+  clonePtr->erase("dynamicCost");
+  EXPECT_FALSE(clonePtr->empty());
+
+  ocs2::StaticStateInputCostCollection<> emptyCollection;
+  EXPECT_TRUE(emptyCollection.empty());
+  EXPECT_EQ(emptyCollection.getValue(t, x, u, targetTrajectories, {}), 0.0);
+}
+
+TEST(testStaticStateInputCostCollection, softConstraintTerms) {
+  // soft constraints accumulate in place through their addQuadraticApproximation()
+  constexpr size_t stateDim = 4;
+  constexpr size_t inputDim = 6;
+  const ocs2::TargetTrajectories targetTrajectories({0.0}, {ocs2::vector_t::Random(stateDim)}, {ocs2::vector_t::Random(inputDim)});
+  const ocs2::vector_t x = ocs2::vector_t::Random(stateDim);
+  const ocs2::vector_t u = ocs2::vector_t::Random(inputDim);
+
+  ocs2::StaticStateInputCostCollection<ocs2::StateInputSoftConstraint, ocs2::StateInputSoftConstraint, ocs2::StateInputSoftBoxConstraint>
+      staticCollection(linearSoftConstraint(stateDim, inputDim, 0), linearSoftConstraint(stateDim, inputDim, 1),
+                       inputSoftBoxConstraint(inputDim));
+  ocs2::StateInputCostCollection dynamicCollection;
+  dynamicCollection.add("softConstraint0", std::unique_ptr<ocs2::StateInputCost>(staticCollection.getStaticTerm<0>().clone()));
+  dynamicCollection.add("softConstraint1", std::unique_ptr<ocs2::StateInputCost>(staticCollection.getStaticTerm<1>().clone()));
+  dynamicCollection.add("softBoxConstraint", std::unique_ptr<ocs2::StateInputCost>(staticCollection.getStaticTerm<2>().clone()));
+
+  EXPECT_TRUE(ocs2::isApprox(staticCollection.getQuadraticApproximation(0.0, x, u, targetTrajectories, {}),
+                             dynamicCollection.getQuadraticApproximation(0.0, x, u, targetTrajectories, {}), 1e-9));
+}
+
+TEST(testStaticStateInputCostCollection, wrongTermType) {
+  using static_collection_t = ocs2::StaticStateInputCostCollection<ocs2::QuadraticStateInputCost>;
+  std::unique_ptr<ocs2::QuadraticStateInputCost> derivedCostPtr(
+      new TestDerivedQuadraticCost(ocs2::matrix_t::Identity(2, 2), ocs2::matrix_t::Identity(1, 1)));
+  EXPECT_THROW(static_collection_t{std::move(derivedCostPtr)}, std::runtime_error);
+  EXPECT_THROW(static_collection_t{nullptr}, std::runtime_error);
+}
+
+TEST(testStaticStateInputCostCollection, DISABLED_benchmark) {
+  constexpr size_t stateDim = 24;
+  constexpr size_t inputDim = 24;
+
+  ocs2::StaticStateInputCostCollection<ocs2::QuadraticStateInputCost, ocs2::QuadraticStateInputCost, ocs2::QuadraticStateInputCost,
+                                       ocs2::QuadraticStateInputCost>
+      staticCollection(randomQuadraticCost(stateDim, inputDim), randomQuadraticCost(stateDim, inputDim),
+                       randomQuadraticCost(stateDim, inputDim), randomQuadraticCost(stateDim, inputDim));
+  ocs2::StateInputCostCollection dynamicCollection;
+  dynamicCollection.add("cost0", std::unique_ptr<ocs2::StateInputCost>(staticCollection.getStaticTerm<0>().clone()));
+  dynamicCollection.add("cost1", std::unique_ptr<ocs2::StateInputCost>(staticCollection.getStaticTerm<1>().clone()));
+  dynamicCollection.add("cost2", std::unique_ptr<ocs2::StateInputCost>(staticCollection.getStaticTerm<2>().clone()));
+  dynamicCollection.add("cost3", std::unique_ptr<ocs2::StateInputCost>(staticCollection.getStaticTerm<3>().clone()));
+
+  benchmarkCostCollections("Quadratic approximation of 4 quadratic state-input costs", dynamicCollection, staticCollection, stateDim,
+                           inputDim);
+}
+
+TEST(testStaticStateInputCostCollection, DISABLED_benchmarkLeggedRobotCostSet) {
+  // the cost set of the legged robot: a tracking cost and the friction cone soft constraints of the four feet
+  constexpr size_t stateDim = 24;
+  constexpr size_t inputDim = 24;
+  ocs2::StaticStateInputCostCollection<ocs2::QuadraticStateInputCost, ocs2::StateInputSoftConstraint, ocs2::StateInputSoftConstraint,
+                                       ocs2::StateInputSoftConstraint, ocs2::StateInputSoftConstraint>
+      staticCollection(std::unique_ptr<ocs2::QuadraticStateInputCost>(new ocs2::QuadraticStateInputCost(
+                           randomPositiveDefinite(stateDim), randomPositiveDefinite(inputDim))),
+                       linearSoftConstraint(stateDim, inputDim, 0), linearSoftConstraint(stateDim, inputDim, 1),
+                       linearSoftConstraint(stateDim, inputDim, 2), linearSoftConstraint(stateDim, inputDim, 3));
+  ocs2::StateInputCostCollection dynamicCollection;
+  dynamicCollection.add("trackingCost", std::unique_ptr<ocs2::StateInputCost>(staticCollection.getStaticTerm<0>().clone()));
+  dynamicCollection.add("frictionCone0", std::unique_ptr<ocs2::StateInputCost>(staticCollection.getStaticTerm<1>().clone()));
+  dynamicCollection.add("frictionCone1", std::unique_ptr<ocs2::StateInputCost>(staticCollection.getStaticTerm<2>().clone()));
+  dynamicCollection.add("frictionCone2", std::unique_ptr<ocs2::StateInputCost>(staticCollection.getStaticTerm<3>().clone()));
+  dynamicCollection.add("frictionCone3", std::unique_ptr<ocs2::StateInputCost>(staticCollection.getStaticTerm<4>().clone()));
+
+  benchmarkCostCollections("Legged robot tracking cost and friction cone soft constraints", dynamicCollection, staticCollection, stateDim,
+                           inputDim);
+}
+
+TEST(testStaticStateInputCostCollection, DISABLED_benchmarkMobileManipulatorCostSet) {
+  // the cost set of the mobile manipulator: a quadratic input cost and the soft joint velocity limits
+  constexpr size_t stateDim = 10;
+  constexpr size_t inputDim = 10;
+  ocs2::StaticStateInputCostCollection<ocs2::QuadraticStateInputCost, ocs2::StateInputSoftBoxConstraint> staticCollection(
+      std::unique_ptr<ocs2::QuadraticStateInputCost>(
+          new ocs2::QuadraticStateInputCost(ocs2::matrix_t::Zero(stateDim, stateDim), randomPositiveDefinite(inputDim))),
+      inputSoftBoxConstraint(inputDim));
+  ocs2::StateInputCostCollection dynamicCollection;
+  dynamicCollection.add("inputCost", std::unique_ptr<ocs2::StateInputCost>(staticCollection.getStaticTerm<0>().clone()));
+  dynamicCollection.add("jointLimits", std::unique_ptr<ocs2::StateInputCost>(staticCollection.getStaticTerm<1>().clone()));
+
+  benchmarkCostCollections("Mobile manipulator input cost and joint velocity limits", dynamicCollection, staticCollection, stateDim,
+                           inputDim);
+}
@@ -0,0 +1,142 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <iostream>
+#include <random>
+
+#include <gtest/gtest.h>
+
+#include <ocs2_core/automatic_differentiation/GaussNewtonHessianAssembler.h>
+#include <ocs2_core/misc/Benchmark.h>
+
+using namespace ocs2;
+
+namespace {
+
+/** Random sparse Jacobian, the nonzeros are sorted by row and then by column */
+void getRandomSparseJacobian(size_t rangeDim, size_t variableDim, scalar_t density, size_array_t& rows, size_array_t& cols,
+                             vector_t& values) {
+  std::mt19937 generator(0);
+  std::uniform_real_distribution<scalar_t> distribution(0.0, 1.0);
+  rows.clear();
+  cols.clear();
+  for (size_t r = 0; r < rangeDim; r++) {
+    for (size_t c = 0; c < variableDim; c++) {
+      if (distribution(generator) < density) {
+        rows.push_back(r);
+        cols.push_back(c);
+      }
+    }
+  }
+  values = vector_t::Random(rows.size());
+}
+
+matrix_t toDense(size_t rangeDim, size_t variableDim, const size_array_t& rows, const size_array_t& cols, const vector_t& values) {
+  matrix_t jacobian = matrix_t::Zero(rangeDim, variableDim);
+  for (size_t i = 0; i < rows.size(); i++) {
+    jacobian(rows[i], cols[i]) = values(i);
+  }
+  return jacobian;
+}
+
+}  // namespace
+
+TEST(testGaussNewtonHessianAssembler, strategies) {
+  using Strategy = GaussNewtonHessianAssembler::Strategy;
+  const size_t rangeDim = 20;
+  const size_t variableDim = 15;
+
+  for (const scalar_t density : {0.0, 0.1, 0.5, 1.0}) {
+    size_array_t rows, cols;
+    vector_t values;
+    getRandomSparseJacobian(rangeDim, variableDim, density, rows, cols, values);
+    const matrix_t jacobian = toDense(rangeDim, variableDim, rows, cols, values);
+    const matrix_t expectedHessian = jacobian.transpose() * jacobian;
+
+    for (const auto strategy : {Strategy::Sparse, Strategy::Dense}) {
+      const GaussNewtonHessianAssembler assembler(rangeDim, variableDim, rows, cols, strategy);
+      matrix_t hessian;
+      assembler.assemble(values.data(), hessian);
+      EXPECT_TRUE(hessian.isApprox(expectedHessian) || (expectedHessian.isZero() && hessian.isZero())) << "density: " << density;
+
+      // the reused workspace does not carry over the previous values
+      const vector_t scaledValues = 2.0 * values;
+      assembler.assemble(scaledValues.data(), hessian);
+      EXPECT_TRUE(hessian.isApprox(4.0 * expectedHessian) || (expectedHessian.isZero() && hessian.isZero())) << "density: " << density;
+    }
+  }
+
+  // Chosen strategies for the extreme cases
+  size_array_t rows, cols;
+  vector_t values;
+  getRandomSparseJacobian(rangeDim, variableDim, 1.0, rows, cols, values);
+  EXPECT_EQ(GaussNewtonHessianAssembler(rangeDim, variableDim, rows, cols).getStrategy(), Strategy::Dense);
+
+  const size_array_t diagonalRows{0, 1, 2, 3}, diagonalCols{0, 1, 2, 3};
+  EXPECT_EQ(GaussNewtonHessianAssembler(4, 4, diagonalRows, diagonalCols).getStrategy(), Strategy::Sparse);
+
+  // Unsorted pattern
+  EXPECT_THROW(GaussNewtonHessianAssembler(4, 4, {1, 0}, {0, 0}), std::runtime_error);
+}
+
+TEST(testGaussNewtonHessianAssembler, DISABLED_benchmark) {
+  using Strategy = GaussNewtonHessianAssembler::Strategy;
+  const size_t variableDim = 60;
+  const size_t numRepeats = 1000;
+
+  std::cerr << "[testGaussNewtonHessianAssembler] variableDim = " << variableDim << "\n";
+  for (const size_t rangeDim : {5, 20, 50, 100}) {
+    for (const scalar_t density : {0.05, 0.2, 0.5, 1.0}) {
+      size_array_t rows, cols;
+      vector_t values;
+      getRandomSparseJacobian(rangeDim, variableDim, density, rows, cols, values);
+
+      const GaussNewtonHessianAssembler sparseAssembler(rangeDim, variableDim, rows, cols, Strategy::Sparse);
+      const GaussNewtonHessianAssembler denseAssembler(rangeDim, variableDim, rows, cols, Strategy::Dense);
+      const GaussNewtonHessianAssembler adaptiveAssembler(rangeDim, variableDim, rows, cols);
+
+      matrix_t sparseHessian, denseHessian;
+      benchmark::RepeatedTimer sparseTimer, denseTimer;
+      for (size_t i = 0; i < numRepeats; i++) {
+        sparseTimer.startTimer();
+        sparseAssembler.assemble(values.data(), sparseHessian);
+        sparseTimer.endTimer();
+
+        denseTimer.startTimer();
+        denseAssembler.assemble(values.data(), denseHessian);
+        denseTimer.endTimer();
+      }
+      EXPECT_TRUE(denseHessian.isApprox(sparseHessian));
+
+      std::cerr << "  rangeDim = " << rangeDim << ", density = " << density << ", sparse: " << 1e3 * sparseTimer.getAverageInMilliseconds()
+                << " [us], dense: " << 1e3 * denseTimer.getAverageInMilliseconds() << " [us], chosen: "
+                << (adaptiveAssembler.getStrategy() == Strategy::Dense ? "dense" : "sparse") << "\n";
+    }
+  }
+}
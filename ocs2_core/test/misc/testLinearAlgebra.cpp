@@ -133,3 +133,35 @@ TEST(makePsdCholesky, makePsdCholesky) {
 
   ASSERT_GE(lambdaSparseMatCorr.minCoeff(), minDesiredEigenvalue);
 }
+
+TEST(isPsdByCholesky, agreesWithEigenvalues) {
+  const size_t n = 12;               // matrix size
+  const size_t numSamples = 1000;    // number of random matrices
+  const scalar_t tolerance = 1e-9;   // tolerance on the smallest eigenvalue
+  const scalar_t borderline = 1e-6;  // skip the matrices that are too close to the threshold
+
+  size_t numPsd = 0;
+  size_t numIndefinite = 0;
+  for (size_t i = 0; i < numSamples; i++) {
+    // a random symmetric matrix which is shifted around the PSD threshold
+    const matrix_t B = matrix_t::Random(n, n);
+    matrix_t A = B * B.transpose();
+    const scalar_t lambdaMin = symmetricEigenvalues(A).minCoeff();
+    A.diagonal().array() -= lambdaMin + 0.5 * vector_t::Random(1)(0);
+
+    const scalar_t shiftedLambdaMin = symmetricEigenvalues(A).minCoeff();
+    if (std::abs(shiftedLambdaMin + tolerance) < borderline) {
+      continue;
+    }
+    const bool isPsd = shiftedLambdaMin >= -tolerance;
+    isPsd ? numPsd++ : numIndefinite++;
+    ASSERT_EQ(isPsdByCholesky(A, tolerance), isPsd) << "smallest eigenvalue: " << shiftedLambdaMin;
+  }
+  EXPECT_GT(numPsd, 0);
+  EXPECT_GT(numIndefinite, 0);
+
+  // semi-definite matrix
+  const vector_t v = vector_t::Random(n);
+  EXPECT_TRUE(isPsdByCholesky(matrix_t(v * v.transpose()), tolerance));
+  EXPECT_TRUE(isPsdByCholesky(matrix_t::Zero(n, n), tolerance));
+}
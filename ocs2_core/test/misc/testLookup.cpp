@@ -163,3 +163,30 @@ TEST(testLookup, findBoundedActiveIntervalInTimeArray) {
   ASSERT_ANY_THROW(findBoundedActiveIntervalInTimeArray(timeArrayEmpty, 0.0));
   ASSERT_ANY_THROW(findBoundedActiveIntervalInTimeArray(timeArrayEmpty, 1.0));
 }
+
+TEST(testLookup, findIndexInTimeArray_cursor) {
+  std::vector<double> timeArray{-1.0, 0.0, 0.5, 2.0, 2.0, 2.0, 3.0};
+  std::vector<double> queries{-2.0, -1.0, -0.5, 0.0, 0.5, 1.0, 2.0, 2.5, 3.0, 4.0};
+
+  // Increasing queries
+  int cursor = 0;
+  for (const auto t : queries) {
+    ASSERT_EQ(findIndexInTimeArray(timeArray, t, cursor), findIndexInTimeArray(timeArray, t));
+    ASSERT_EQ(cursor, findIndexInTimeArray(timeArray, t));
+  }
+
+  // Decreasing queries
+  for (auto it = queries.rbegin(); it != queries.rend(); ++it) {
+    ASSERT_EQ(findIndexInTimeArray(timeArray, *it, cursor), findIndexInTimeArray(timeArray, *it));
+  }
+
+  // Invalid cursor
+  cursor = 100;
+  ASSERT_EQ(findIndexInTimeArray(timeArray, 1.0, cursor), 3);
+  cursor = -1;
+  ASSERT_EQ(findIndexInTimeArray(timeArray, 1.0, cursor), 3);
+
+  // empty time
+  std::vector<double> timeArrayEmpty;
+  ASSERT_EQ(findIndexInTimeArray(timeArrayEmpty, 1.0, cursor), 0);
+}
@@ -0,0 +1,197 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <iostream>
+
+#include <gtest/gtest.h>
+
+#include <ocs2_core/misc/Benchmark.h>
+#include <ocs2_core/misc/LinearAlgebra.h>
+#include <ocs2_core/misc/randomMatrices.h>
+#include <ocs2_core/model_data/ModelData.h>
+
+using namespace ocs2;
+
+namespace {
+
+/** The eigenvalue-based check of the cost properties as it was done before the Cholesky-based test. */
+std::string checkCostPropertiesByEigenvalues(const ModelData& data) {
+  const auto isPsd = [](const matrix_t& A) {
+    return A.allFinite() && A.isApprox(A.transpose(), 1e-6) &&
+           LinearAlgebra::symmetricEigenvalues(A).minCoeff() >= -Eigen::NumTraits<scalar_t>::epsilon();
+  };
+
+  std::string errorDescription;
+  if (!isPsd(data.cost.dfdxx)) {
+    errorDescription += "Q is not PSD.\n";
+  }
+  if (!isPsd(data.cost.dfduu)) {
+    errorDescription += "R is not PSD.\n";
+  }
+  if (data.cost.dfduu.ldlt().rcond() < Eigen::NumTraits<scalar_t>::epsilon()) {
+    errorDescription += "R is not invertible.\n";
+  } else {
+    matrix_t UofUUT;
+    LinearAlgebra::computeInverseMatrixUUT(data.cost.dfduu, UofUUT);
+    const matrix_t UT_P = UofUUT.transpose() * data.cost.dfdux;
+    const matrix_t schurComplement = data.cost.dfdxx - UT_P.transpose() * UT_P;
+    if (!isPsd(schurComplement)) {
+      errorDescription += "Schur complement is not PSD.\n";
+    }
+  }
+  return errorDescription;
+}
+
+ModelData getWellPosedData(size_t stateDim, size_t inputDim) {
+  ModelData data;
+  data.stateDim = stateDim;
+  data.inputDim = inputDim;
+  data.cost.f = 1.0;
+  data.cost.dfdx = vector_t::Random(stateDim);
+  data.cost.dfdu = vector_t::Random(inputDim);
+  data.cost.dfdxx = LinearAlgebra::generateSPDmatrix<matrix_t>(stateDim);
+  data.cost.dfduu = LinearAlgebra::generateSPDmatrix<matrix_t>(inputDim);
+  data.cost.dfdux = matrix_t::Zero(inputDim, stateDim);
+  return data;
+}
+
+}  // unnamed namespace
+
+class CostPropertiesTest : public ::testing::Test {
+ protected:
+  static constexpr size_t STATE_DIM = 12;
+  static constexpr size_t INPUT_DIM = 12;
+
+  CostPropertiesTest() : data(getWellPosedData(STATE_DIM, INPUT_DIM)) {}
+
+  /** Makes the given matrix indefinite by shifting its smallest eigenvalue to -1e-3. */
+  static void makeIndefinite(matrix_t& A) {
+    const scalar_t lambdaMin = LinearAlgebra::symmetricEigenvalues(A).minCoeff();
+    A.diagonal().array() -= lambdaMin + 1e-3;
+  }
+
+  ModelData data;
+};
+
+constexpr size_t CostPropertiesTest::STATE_DIM;
+constexpr size_t CostPropertiesTest::INPUT_DIM;
+
+TEST_F(CostPropertiesTest, wellPosed) {
+  EXPECT_TRUE(checkCostProperties(data).empty());
+  EXPECT_TRUE(checkCostPropertiesByEigenvalues(data).empty());
+
+  // semi-definite state Hessian
+  const vector_t v = vector_t::Random(STATE_DIM);
+  data.cost.dfdxx = v * v.transpose();
+  EXPECT_TRUE(checkCostProperties(data).empty());
+}
+
+TEST_F(CostPropertiesTest, indefiniteStateHessian) {
+  makeIndefinite(data.cost.dfdxx);
+  EXPECT_FALSE(checkCostProperties(data).empty());
+  EXPECT_FALSE(checkCostPropertiesByEigenvalues(data).empty());
+}
+
+TEST_F(CostPropertiesTest, indefiniteInputHessian) {
+  makeIndefinite(data.cost.dfduu);
+  EXPECT_FALSE(checkCostProperties(data).empty());
+  EXPECT_FALSE(checkCostPropertiesByEigenvalues(data).empty());
+}
+
+TEST_F(CostPropertiesTest, singularInputHessian) {
+  const vector_t v = vector_t::Random(INPUT_DIM);
+  data.cost.dfduu = v * v.transpose();
+  EXPECT_FALSE(checkCostProperties(data).empty());
+  EXPECT_FALSE(checkCostPropertiesByEigenvalues(data).empty());
+}
+
+TEST_F(CostPropertiesTest, indefiniteSchurComplement) {
+  // Q - P' R^{-1} P = -I
+  data.cost.dfduu.setIdentity();
+  data.cost.dfdux = matrix_t::Identity(INPUT_DIM, STATE_DIM);
+  data.cost.dfdxx.setZero();
+  EXPECT_FALSE(checkCostProperties(data).empty());
+  EXPECT_FALSE(checkCostPropertiesByEigenvalues(data).empty());
+}
+
+TEST_F(CostPropertiesTest, notFinite) {
+  data.cost.dfdxx(0, 0) = std::numeric_limits<scalar_t>::quiet_NaN();
+  EXPECT_FALSE(checkCostProperties(data).empty());
+}
+
+TEST_F(CostPropertiesTest, notSelfAdjoint) {
+  data.cost.dfdxx(0, 1) += 1.0;
+  EXPECT_FALSE(checkCostProperties(data).empty());
+}
+
+TEST_F(CostPropertiesTest, agreesWithEigenvalues) {
+  const size_t numSamples = 200;
+  for (size_t i = 0; i < numSamples; i++) {
+    data = getWellPosedData(STATE_DIM, INPUT_DIM);
+    data.cost.dfdux = 0.1 * matrix_t::Random(INPUT_DIM, STATE_DIM);
+    if (i % 2 == 0) {
+      makeIndefinite(i % 4 == 0 ? data.cost.dfdxx : data.cost.dfduu);
+    }
+    EXPECT_EQ(checkCostProperties(data).empty(), checkCostPropertiesByEigenvalues(data).empty()) << "sample: " << i;
+  }
+}
+
+TEST_F(CostPropertiesTest, DISABLED_benchmark) {
+  const size_t numNodes = 100;
+  const size_t numRepeats = 20;
+
+  std::vector<ModelData> dataTrajectory;
+  dataTrajectory.reserve(numNodes);
+  for (size_t i = 0; i < numNodes; i++) {
+    dataTrajectory.push_back(getWellPosedData(2 * STATE_DIM, INPUT_DIM));
+  }
+
+  benchmark::RepeatedTimer eigenvalueTimer;
+  benchmark::RepeatedTimer choleskyTimer;
+  size_t numErrors = 0;
+  for (size_t j = 0; j < numRepeats; j++) {
+    eigenvalueTimer.startTimer();
+    for (const auto& d : dataTrajectory) {
+      numErrors += checkCostPropertiesByEigenvalues(d).size();
+    }
+    eigenvalueTimer.endTimer();
+
+    choleskyTimer.startTimer();
+    for (const auto& d : dataTrajectory) {
+      numErrors += checkCostProperties(d).size();
+    }
+    choleskyTimer.endTimer();
+  }
+  EXPECT_EQ(numErrors, 0);
+
+  std::cerr << "\n########################################################################\n";
+  std::cerr << "Checking the cost properties of " << numNodes << " nodes with " << 2 * STATE_DIM << " states:\n";
+  std::cerr << "Eigenvalues  [ms]: " << eigenvalueTimer.getAverageInMilliseconds() << "\n";
+  std::cerr << "Cholesky     [ms]: " << choleskyTimer.getAverageInMilliseconds() << "\n";
+}
@@ -0,0 +1,133 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <iostream>
+
+#include <gtest/gtest.h>
+
+#include <ocs2_core/misc/Benchmark.h>
+#include <ocs2_core/model_data/DynamicsStructure.h>
+
+using namespace ocs2;
+
+namespace {
+DynamicsStructure getDynamicsStructure(int trailingStateDim, bool diagonalTrailingBlock, bool zeroUpperCoupling) {
+  DynamicsStructure structure;
+  structure.trailingStateDim = trailingStateDim;
+  structure.diagonalTrailingBlock = diagonalTrailingBlock;
+  structure.zeroUpperCoupling = zeroUpperCoupling;
+  return structure;
+}
+
+matrix_t getStructuredJacobian(int n1, const DynamicsStructure& structure) {
+  const int n2 = structure.trailingStateDim;
+  matrix_t dfdx = matrix_t::Random(n1 + n2, n1 + n2);
+  dfdx.bottomLeftCorner(n2, n1).setZero();
+  if (structure.zeroUpperCoupling) {
+    dfdx.topRightCorner(n1, n2).setZero();
+  }
+  if (structure.diagonalTrailingBlock) {
+    const vector_t diagonal = dfdx.bottomRightCorner(n2, n2).diagonal();
+    dfdx.bottomRightCorner(n2, n2) = diagonal.asDiagonal();
+  }
+  return dfdx;
+}
+}  // unnamed namespace
+
+class DynamicsStructureTest : public testing::TestWithParam<DynamicsStructure> {
+ protected:
+  static constexpr int n1 = 10;
+  static constexpr scalar_t tol = 1e-12;
+};
+
+constexpr int DynamicsStructureTest::n1;
+constexpr scalar_t DynamicsStructureTest::tol;
+
+TEST_P(DynamicsStructureTest, multiplyStateJacobian) {
+  const auto structure = GetParam();
+  const matrix_t dfdx = getStructuredJacobian(n1, structure);
+  const matrix_t M = matrix_t::Random(dfdx.cols() + 2, dfdx.rows());
+
+  matrix_t out;
+  multiplyStateJacobian(M, dfdx, structure, out);
+  EXPECT_TRUE(out.isApprox(M * dfdx, tol));
+}
+
+TEST_P(DynamicsStructureTest, multiplyStateJacobianTranspose) {
+  const auto structure = GetParam();
+  const matrix_t dfdx = getStructuredJacobian(n1, structure);
+  const matrix_t M = matrix_t::Random(dfdx.rows(), dfdx.cols() + 2);
+
+  matrix_t out;
+  multiplyStateJacobianTranspose(dfdx, M, structure, out);
+  EXPECT_TRUE(out.isApprox(dfdx.transpose() * M, tol));
+}
+
+INSTANTIATE_TEST_CASE_P(DynamicsStructureTestCase, DynamicsStructureTest,
+                        testing::Values(getDynamicsStructure(0, false, false),  // dense
+                                        getDynamicsStructure(3, false, false),  // loopshaping eliminate pattern
+                                        getDynamicsStructure(3, true, false),   // eliminate pattern with a diagonal filter
+                                        getDynamicsStructure(3, true, true)));  // output pattern with a diagonal filter
+
+/**
+ * Compares the structured and the dense evaluation of the dominant products of a Riccati step, Sm * Am and Am^T * (Sm * Am),
+ * for system sizes similar to the loopshaping examples.
+ */
+TEST(DynamicsStructureBenchmark, DISABLED_riccatiProducts) {
+  constexpr size_t numRepeats = 2000;
+  const std::vector<std::pair<int, int>> sizes{{10, 3}, {24, 12}, {24, 24}};  // (system states, filter states)
+
+  for (const auto& size : sizes) {
+    const auto structure = getDynamicsStructure(size.second, true, false);
+    const matrix_t dfdx = getStructuredJacobian(size.first, structure);
+    const int n = dfdx.rows();
+    matrix_t Sm = matrix_t::Random(n, n);
+    Sm = (Sm + Sm.transpose()).eval();
+
+    benchmark::RepeatedTimer denseTimer;
+    benchmark::RepeatedTimer structuredTimer;
+    matrix_t SmAm, denseResult, structuredResult;
+    for (size_t i = 0; i < numRepeats; i++) {
+      denseTimer.startTimer();
+      SmAm.noalias() = Sm * dfdx;
+      denseResult.noalias() = dfdx.transpose() * SmAm;
+      denseTimer.endTimer();
+
+      structuredTimer.startTimer();
+      multiplyStateJacobian(Sm, dfdx, structure, SmAm);
+      multiplyStateJacobianTranspose(dfdx, SmAm, structure, structuredResult);
+      structuredTimer.endTimer();
+    }
+
+    ASSERT_TRUE(structuredResult.isApprox(denseResult, 1e-12));
+    std::cerr << "[DynamicsStructureBenchmark] nx = " << size.first << " + " << size.second
+              << "\n  dense:      " << denseTimer.getAverageInMilliseconds() << " [ms]"
+              << "\n  structured: " << structuredTimer.getAverageInMilliseconds() << " [ms]\n";
+  }
+}
@@ -0,0 +1,200 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <algorithm>
+#include <iostream>
+
+#include <gtest/gtest.h>
+
+#include <ocs2_core/PreComputation.h>
+#include <ocs2_core/misc/Benchmark.h>
+#include <ocs2_core/reference/ReferenceSampler.h>
+
+using namespace ocs2;
+
+namespace {
+
+TargetTrajectories getRandomTargetTrajectories(size_t numPoints, size_t stateDim, size_t inputDim) {
+  TargetTrajectories targetTrajectories(numPoints);
+  for (size_t i = 0; i < numPoints; i++) {
+    targetTrajectories.timeTrajectory[i] = 0.1 * i;
+    targetTrajectories.stateTrajectory[i] = vector_t::Random(stateDim);
+    targetTrajectories.inputTrajectory[i] = vector_t::Random(inputDim);
+  }
+  return targetTrajectories;
+}
+
+ModeSchedule getModeSchedule(size_t numEvents) {
+  scalar_array_t eventTimes(numEvents);
+  size_array_t modeSequence(numEvents + 1);
+  for (size_t i = 0; i < numEvents; i++) {
+    eventTimes[i] = 0.05 + 0.2 * i;
+    modeSequence[i] = i % 4;
+  }
+  modeSequence.back() = numEvents % 4;
+  return {eventTimes, modeSequence};
+}
+
+scalar_array_t getTimeGrid(scalar_t initTime, scalar_t finalTime, size_t N) {
+  scalar_array_t timeGrid(N + 1);
+  for (size_t i = 0; i <= N; i++) {
+    timeGrid[i] = initTime + (finalTime - initTime) * i / N;
+  }
+  return timeGrid;
+}
+
+}  // namespace
+
+TEST(testReferenceSampler, cursorLookups) {
+  const auto targetTrajectories = getRandomTargetTrajectories(10, 3, 2);
+  const auto modeSchedule = getModeSchedule(5);
+
+  // increasing, repeated and random query times
+  scalar_array_t queryTimes = getTimeGrid(-0.1, 1.1, 100);
+  queryTimes.insert(queryTimes.end(), queryTimes.begin(), queryTimes.end());
+  for (size_t i = 0; i < 100; i++) {
+    queryTimes.push_back(0.6 * (vector_t::Random(1)(0) + 1.0));
+  }
+
+  int stateCursor = 0, inputCursor = 0, modeCursor = 0;
+  vector_t desiredState, desiredInput;
+  for (const auto t : queryTimes) {
+    targetTrajectories.getDesiredState(t, stateCursor, desiredState);
+    targetTrajectories.getDesiredInput(t, inputCursor, desiredInput);
+    EXPECT_TRUE(desiredState.isApprox(targetTrajectories.getDesiredState(t)));
+    EXPECT_TRUE(desiredInput.isApprox(targetTrajectories.getDesiredInput(t)));
+    EXPECT_EQ(modeSchedule.modeAtTime(t, modeCursor), modeSchedule.modeAtTime(t));
+  }
+}
+
+TEST(testReferenceSampler, sampledReferences) {
+  const auto targetTrajectories = getRandomTargetTrajectories(10, 3, 2);
+  const auto modeSchedule = getModeSchedule(5);
+
+  // grid including an event time
+  auto timeGrid = getTimeGrid(0.0, 1.0, 20);
+  timeGrid.push_back(modeSchedule.eventTimes[2]);
+  std::sort(timeGrid.begin(), timeGrid.end());
+
+  ReferenceSampler referenceSampler;
+  referenceSampler.update(timeGrid, targetTrajectories, modeSchedule);
+
+  // on and off the grid
+  scalar_array_t queryTimes = timeGrid;
+  for (size_t i = 0; i < 50; i++) {
+    queryTimes.push_back(0.6 * (vector_t::Random(1)(0) + 1.0));
+  }
+
+  ReferenceSampler::Cursor cursor;
+  for (const auto t : queryTimes) {
+    EXPECT_TRUE(referenceSampler.getDesiredState(t, cursor).isApprox(targetTrajectories.getDesiredState(t)));
+    EXPECT_TRUE(referenceSampler.getDesiredInput(t, cursor).isApprox(targetTrajectories.getDesiredInput(t)));
+    EXPECT_EQ(referenceSampler.getMode(t, cursor), modeSchedule.modeAtTime(t));
+  }
+
+  // without input references
+  TargetTrajectories stateOnlyTargetTrajectories = targetTrajectories;
+  stateOnlyTargetTrajectories.inputTrajectory.clear();
+  referenceSampler.update(timeGrid, stateOnlyTargetTrajectories, modeSchedule);
+  EXPECT_TRUE(referenceSampler.getDesiredState(timeGrid[3], cursor).isApprox(targetTrajectories.getDesiredState(timeGrid[3])));
+  EXPECT_THROW(referenceSampler.getDesiredInput(timeGrid[3], cursor), std::runtime_error);
+
+  // empty references
+  referenceSampler.clear();
+  EXPECT_THROW(referenceSampler.getDesiredState(0.5, cursor), std::runtime_error);
+  EXPECT_EQ(referenceSampler.getMode(0.5, cursor), ModeSchedule().modeAtTime(0.5));
+}
+
+TEST(testReferenceSampler, preComputationLookups) {
+  const auto targetTrajectories = getRandomTargetTrajectories(10, 3, 2);
+  const auto otherTargetTrajectories = getRandomTargetTrajectories(10, 3, 2);
+  const auto timeGrid = getTimeGrid(0.0, 1.0, 20);
+
+  ReferenceSampler referenceSampler;
+  referenceSampler.update(timeGrid, targetTrajectories, getModeSchedule(5));
+  EXPECT_TRUE(referenceSampler.isSampledFrom(targetTrajectories));
+  EXPECT_FALSE(referenceSampler.isSampledFrom(otherTargetTrajectories));
+
+  PreComputation preComputation;
+  preComputation.setReferenceSampler(&referenceSampler);
+  for (const auto t : timeGrid) {
+    // the samples are only used for the target trajectories which they are sampled from
+    EXPECT_TRUE(preComputation.getDesiredState(t, targetTrajectories).isApprox(targetTrajectories.getDesiredState(t)));
+    EXPECT_TRUE(preComputation.getDesiredInput(t, targetTrajectories).isApprox(targetTrajectories.getDesiredInput(t)));
+    EXPECT_TRUE(preComputation.getDesiredState(t, otherTargetTrajectories).isApprox(otherTargetTrajectories.getDesiredState(t)));
+    EXPECT_TRUE(preComputation.getDesiredInput(t, otherTargetTrajectories).isApprox(otherTargetTrajectories.getDesiredInput(t)));
+  }
+
+  referenceSampler.clear();
+  EXPECT_FALSE(referenceSampler.isSampledFrom(targetTrajectories));
+}
+
+TEST(testReferenceSampler, DISABLED_benchmark) {
+  // A horizon of 100 nodes with 3 tracking terms per node, evaluated for 5 iterations with 3 line-search trials each
+  const size_t N = 100;
+  const size_t numTerms = 3;
+  const size_t numEvaluations = 5 * (1 + 3);
+  const auto targetTrajectories = getRandomTargetTrajectories(50, 24, 24);
+  const auto modeSchedule = getModeSchedule(20);
+  const auto timeGrid = getTimeGrid(0.0, 1.0, N);
+
+  scalar_t lookupSum = 0.0;
+  scalar_t samplerSum = 0.0;
+  benchmark::RepeatedTimer lookupTimer, samplerTimer;
+  for (size_t repeat = 0; repeat < 100; repeat++) {
+    lookupTimer.startTimer();
+    for (size_t k = 0; k < numEvaluations; k++) {
+      for (const auto t : timeGrid) {
+        for (size_t j = 0; j < numTerms; j++) {
+          lookupSum += targetTrajectories.getDesiredState(t)(j) + targetTrajectories.getDesiredInput(t)(j) + modeSchedule.modeAtTime(t);
+        }
+      }
+    }
+    lookupTimer.endTimer();
+
+    samplerTimer.startTimer();
+    ReferenceSampler referenceSampler;
+    referenceSampler.update(timeGrid, targetTrajectories, modeSchedule);
+    ReferenceSampler::Cursor cursor;
+    for (size_t k = 0; k < numEvaluations; k++) {
+      for (const auto t : timeGrid) {
+        for (size_t j = 0; j < numTerms; j++) {
+          samplerSum += referenceSampler.getDesiredState(t, cursor)(j) + referenceSampler.getDesiredInput(t, cursor)(j) +
+                        referenceSampler.getMode(t, cursor);
+        }
+      }
+    }
+    samplerTimer.endTimer();
+  }
+
+  EXPECT_NEAR(lookupSum, samplerSum, 1e-6 * std::abs(lookupSum));
+  std::cerr << "[testReferenceSampler] N = " << N << ", terms per node = " << numTerms << ", evaluations = " << numEvaluations << "\n";
+  std::cerr << "  lookups:   " << lookupTimer.getAverageInMilliseconds() << " [ms]\n";
+  std::cerr << "  sampler:   " << samplerTimer.getAverageInMilliseconds() << " [ms] (including the sampling)\n";
+}
@@ -0,0 +1,78 @@
+#include <gtest/gtest.h>
+#include <ocs2_core/Types.h>
+#include <ocs2_core/thread_support/LockFreeRingBuffer.h>
+
+#include <thread>
+
+using namespace ocs2;
+
+TEST(testLockFreeRingBuffer, fillAndEmpty) {
+  LockFreeRingBuffer<int> buffer(3);
+  ASSERT_EQ(buffer.capacity(), 3);
+  ASSERT_TRUE(buffer.empty());
+  ASSERT_EQ(buffer.beginRead(), nullptr);
+
+  ASSERT_TRUE(buffer.tryPush(1));
+  ASSERT_TRUE(buffer.tryPush(2));
+  ASSERT_TRUE(buffer.tryPush(3));
+  ASSERT_FALSE(buffer.tryPush(4));  // full
+  ASSERT_EQ(buffer.size(), 3);
+
+  // first in, first out
+  for (int i = 1; i <= 3; i++) {
+    const int* valuePtr = buffer.beginRead();
+    ASSERT_NE(valuePtr, nullptr);
+    ASSERT_EQ(*valuePtr, i);
+    buffer.commitRead();
+  }
+  ASSERT_TRUE(buffer.empty());
+
+  // wraps around
+  ASSERT_TRUE(buffer.tryPush(5));
+  ASSERT_EQ(*buffer.beginRead(), 5);
+}
+
+TEST(testLockFreeRingBuffer, reusesSlots) {
+  const size_t n = 10;
+  LockFreeRingBuffer<vector_t> buffer(2, vector_t::Zero(n));
+
+  // writing a value of the same size into a slot does not reallocate
+  const scalar_t* slotData = buffer.beginWrite()->data();
+  *buffer.beginWrite() = vector_t::Ones(n);
+  ASSERT_EQ(buffer.beginWrite()->data(), slotData);
+  buffer.commitWrite();
+
+  ASSERT_EQ(buffer.beginRead()->data(), slotData);
+  ASSERT_TRUE(buffer.beginRead()->isApprox(vector_t::Ones(n)));
+}
+
+TEST(testLockFreeRingBuffer, producerConsumer) {
+  const size_t numValues = 100000;
+  LockFreeRingBuffer<size_t> buffer(4);
+
+  std::thread producer([&]() {
+    for (size_t i = 0; i < numValues;) {
+      if (buffer.tryPush(i)) {
+        i++;
+      } else {
+        std::this_thread::yield();
+      }
+    }
+  });
+
+  // the consumer sees all the values in order
+  size_t expected = 0;
+  while (expected < numValues) {
+    const size_t* valuePtr = buffer.beginRead();
+    if (valuePtr != nullptr) {
+      ASSERT_EQ(*valuePtr, expected);
+      buffer.commitRead();
+      expected++;
+    } else {
+      std::this_thread::yield();
+    }
+  }
+
+  producer.join();
+  ASSERT_TRUE(buffer.empty());
+}
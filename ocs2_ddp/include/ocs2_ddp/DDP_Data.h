@@ -29,6 +29,9 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #pragma once
 
+#include <utility>
+#include <vector>
+
 #include <ocs2_core/Types.h>
 #include <ocs2_core/model_data/Metrics.h>
 #include <ocs2_core/model_data/ModelData.h>
@@ -40,6 +43,33 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 namespace ocs2 {
 
+/**
+ * Resizes a node trajectory of the DDP data containers. In contrast to clear() followed by resize(), the retained nodes keep their
+ * dynamically allocated memory and the nodes beyond the new length are parked in spareNodes instead of being destroyed. Therefore, once
+ * the trajectory has reached the longest observed horizon, refilling it in place does not allocate.
+ *
+ * @param [in] length: The new length of the trajectory.
+ * @param [in, out] trajectory: The node trajectory.
+ * @param [in, out] spareNodes: The pool of spare nodes of this trajectory.
+ */
+template <typename Node>
+void resizeTrajectory(size_t length, std::vector<Node>& trajectory, std::vector<Node>& spareNodes) {
+  if (trajectory.size() > length) {
+    spareNodes.reserve(trajectory.capacity());
+    while (trajectory.size() > length) {
+      spareNodes.push_back(std::move(trajectory.back()));
+      trajectory.pop_back();
+    }
+  } else {
+    trajectory.reserve(length);
+    while (trajectory.size() < length && !spareNodes.empty()) {
+      trajectory.push_back(std::move(spareNodes.back()));
+      spareNodes.pop_back();
+    }
+    trajectory.resize(length);
+  }
+}
+
 /**
  * Primal data container
  *
@@ -60,6 +90,12 @@ struct PrimalDataContainer {
   std::vector<ModelData> modelDataEventTimes;
   // intermediate model data trajectory
   std::vector<ModelData> modelDataTrajectory;
+  // defects at the shooting nodes of a multiple-shooting rollout (empty for a single-shooting rollout)
+  vector_array_t shootingDefects;
+
+  // spare nodes of the model data trajectories (see resizeTrajectory)
+  std::vector<ModelData> spareModelDataEventTimes;
+  std::vector<ModelData> spareModelDataTrajectory;
 
   void swap(PrimalDataContainer& other) {
     primalSolution.swap(other.primalSolution);
@@ -67,6 +103,9 @@ struct PrimalDataContainer {
     std::swap(modelDataFinalTime, other.modelDataFinalTime);
     modelDataEventTimes.swap(other.modelDataEventTimes);
     modelDataTrajectory.swap(other.modelDataTrajectory);
+    shootingDefects.swap(other.shootingDefects);
+    spareModelDataEventTimes.swap(other.spareModelDataEventTimes);
+    spareModelDataTrajectory.swap(other.spareModelDataTrajectory);
   }
 
   void clear() {
@@ -74,6 +113,18 @@ struct PrimalDataContainer {
     problemMetrics.clear();
     modelDataEventTimes.clear();
     modelDataTrajectory.clear();
+    shootingDefects.clear();
+    spareModelDataEventTimes.clear();
+    spareModelDataTrajectory.clear();
+  }
+
+  /** Same as clear(), but the model data nodes are moved to the spare pools so that the next LQ approximation reuses their memory. */
+  void recycle() {
+    primalSolution.clear();
+    problemMetrics.clear();
+    resizeTrajectory(0, modelDataEventTimes, spareModelDataEventTimes);
+    resizeTrajectory(0, modelDataTrajectory, spareModelDataTrajectory);
+    shootingDefects.clear();
   }
 };
 
@@ -94,11 +145,19 @@ struct DualDataContainer {
   // Riccati solution coefficients
   std::vector<ScalarFunctionQuadraticApproximation> valueFunctionTrajectory;
 
+  // spare nodes of the above trajectories (see resizeTrajectory)
+  std::vector<ModelData> spareProjectedModelDataTrajectory;
+  std::vector<riccati_modification::Data> spareRiccatiModificationTrajectory;
+  std::vector<ScalarFunctionQuadraticApproximation> spareValueFunctionTrajectory;
+
   void swap(DualDataContainer& other) {
     dualSolution.swap(other.dualSolution);
     projectedModelDataTrajectory.swap(other.projectedModelDataTrajectory);
     riccatiModificationTrajectory.swap(other.riccatiModificationTrajectory);
     valueFunctionTrajectory.swap(other.valueFunctionTrajectory);
+    spareProjectedModelDataTrajectory.swap(other.spareProjectedModelDataTrajectory);
+    spareRiccatiModificationTrajectory.swap(other.spareRiccatiModificationTrajectory);
+    spareValueFunctionTrajectory.swap(other.spareValueFunctionTrajectory);
   }
 
   void clear() {
@@ -106,6 +165,9 @@ struct DualDataContainer {
     projectedModelDataTrajectory.clear();
     riccatiModificationTrajectory.clear();
     valueFunctionTrajectory.clear();
+    spareProjectedModelDataTrajectory.clear();
+    spareRiccatiModificationTrajectory.clear();
+    spareValueFunctionTrajectory.clear();
   }
 };
 
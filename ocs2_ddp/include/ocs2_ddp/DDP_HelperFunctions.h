@@ -29,10 +29,13 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #pragma once
 
+#include <functional>
+
 #include <ocs2_core/Types.h>
 #include <ocs2_core/control/LinearController.h>
 #include <ocs2_core/model_data/Metrics.h>
 #include <ocs2_core/penalties/MultidimensionalPenalty.h>
+#include <ocs2_core/thread_support/ThreadPool.h>
 #include <ocs2_oc/oc_data/DualSolution.h>
 #include <ocs2_oc/oc_problem/OptimalControlProblem.h>
 #include <ocs2_oc/oc_solver/PerformanceIndex.h>
@@ -53,15 +56,49 @@ namespace ocs2 {
 void computeRolloutMetrics(OptimalControlProblem& problem, const PrimalSolution& primalSolution, DualSolutionConstRef dualSolution,
                            ProblemMetrics& problemMetrics);
 
+/**
+ * Computes cost, soft constraints and constraints values of each point in the the primalSolution rollout. The time trajectory is
+ * split into chunks which are evaluated in parallel on the threadPool. Each parallel task uses its own copy of the optimal control
+ * problem, therefore problemRefStock should contain at least as many distinct problems as the number of workers.
+ *
+ * @note This function blocks the threadPool, therefore it should not be called from a task which is already running on it.
+ *
+ * @param [in] threadPool: The thread pool which is used for the parallel evaluation.
+ * @param [in] problemRefStock: An array of the optimal control problems, one per parallel task.
+ * @param [in] primalSolution: The primal solution.
+ * @param [in] dualSolution: Const reference view to the dual solution
+ * @param [out] problemMetrics: The cost, soft constraints and constraints values of the rollout.
+ */
+void computeRolloutMetrics(ThreadPool& threadPool, const std::vector<std::reference_wrapper<OptimalControlProblem>>& problemRefStock,
+                           const PrimalSolution& primalSolution, DualSolutionConstRef dualSolution, ProblemMetrics& problemMetrics);
+
+/**
+ * Updates in-place the dual solution and the penalties of ProblemMetrics. This is the parallel counterpart of ocs2::updateDualSolution
+ * where the intermediate time points are split into chunks which are updated in parallel on the threadPool.
+ *
+ * @note This function blocks the threadPool, therefore it should not be called from a task which is already running on it.
+ *
+ * @param [in] threadPool: The thread pool which is used for the parallel evaluation.
+ * @param [in] problemRefStock: An array of the optimal control problems, one per parallel task.
+ * @param [in] primalSolution: The primal solution.
+ * @param [in, out] problemMetrics: The problem metric. Its penalties will be updated based on the update of dualSolution.
+ * @param [out] dualSolution: The updated dual solution.
+ */
+void updateDualSolution(ThreadPool& threadPool, const std::vector<std::reference_wrapper<OptimalControlProblem>>& problemRefStock,
+                        const PrimalSolution& primalSolution, ProblemMetrics& problemMetrics, DualSolutionRef dualSolution);
+
 /**
  * Calculates the PerformanceIndex associated to the given ProblemMetrics.
  *
  * @param [in] timeTrajectory: Time stamp of the rollout.
  * @param [in] problemMetrics: The cost, soft constraints and constraints values of the rollout.
+ * @param [in] shootingDefects: The defects at the shooting nodes of a multiple-shooting rollout. Their SSE is reported as the
+ *                              dynamics violation.
  *
  * @return The PerformanceIndex of the trajectory.
  */
-PerformanceIndex computeRolloutPerformanceIndex(const scalar_array_t& timeTrajectory, const ProblemMetrics& problemMetrics);
+PerformanceIndex computeRolloutPerformanceIndex(const scalar_array_t& timeTrajectory, const ProblemMetrics& problemMetrics,
+                                                const vector_array_t& shootingDefects = vector_array_t());
 
 /**
  * Forward integrate the system dynamics with given controller. It uses the given control policies and initial state,
@@ -80,6 +117,43 @@ PerformanceIndex computeRolloutPerformanceIndex(const scalar_array_t& timeTrajec
 scalar_t rolloutTrajectory(RolloutBase& rollout, scalar_t initTime, const vector_t& initState, scalar_t finalTime,
                            PrimalSolution& primalSolution);
 
+/**
+ * Computes the times of the shooting nodes of a multiple-shooting rollout. The nodes are spread uniformly over [initTime, finalTime]
+ * and the first node is always at initTime. A node which is too close to an event time is dropped such that the segments are not
+ * split at the mode switches.
+ *
+ * @param [in] initTime: The initial time.
+ * @param [in] finalTime: The final time.
+ * @param [in] numSegments: The desired number of the shooting segments.
+ * @param [in] eventTimes: The event times of the mode schedule.
+ *
+ * @return The start times of the shooting segments.
+ */
+scalar_array_t computeShootingNodeTimes(scalar_t initTime, scalar_t finalTime, size_t numSegments, const scalar_array_t& eventTimes);
+
+/**
+ * Multiple-shooting forward rollout. The segment s is integrated from its shooting node (nodeTimes[s], nodeStates[s]) up to the next
+ * node time (finalTime for the last segment). The segments are independent, therefore they are rolled out in parallel. The resulting
+ * trajectory is the concatenation of the segments where the node of each segment replaces the final point of its previous segment.
+ *
+ * @note This function should not be called from a task which already runs on the threadPool.
+ *
+ * @param [in] threadPool: The thread pool which is used for the parallel rollouts.
+ * @param [in] rolloutRefStock: An array of rollouts, one per parallel task.
+ * @param [in] nodeTimes: The times of the shooting nodes. The first one is the initial time.
+ * @param [in] nodeStates: The states of the shooting nodes. The first one is the initial state.
+ * @param [in] finalTime: The final time.
+ * @param [in, out] primalSolution: The resulting primal solution. Similar to the single-shooting rollout, primalSolution::controllerPtr
+ *                                  and primalSolution::modeSchedule should be set.
+ * @param [out] shootingDefects: The defect of each node, i.e. the final state of the previous segment minus the node state. The defect
+ *                               of the first node is zero.
+ *
+ * @return average time step.
+ */
+scalar_t rolloutTrajectory(ThreadPool& threadPool, const std::vector<std::reference_wrapper<RolloutBase>>& rolloutRefStock,
+                           const scalar_array_t& nodeTimes, const vector_array_t& nodeStates, scalar_t finalTime,
+                           PrimalSolution& primalSolution, vector_array_t& shootingDefects);
+
 /**
  * Extract a primal solution for the range [initTime, finalTime] from a given primal solution. It assumes that the
  * given range is within the solution time of input primal solution.
@@ -108,6 +182,17 @@ scalar_t computeControllerUpdateIS(const LinearController& controller);
  */
 void incrementController(scalar_t stepLength, const LinearController& unoptimizedController, LinearController& controller);
 
+/**
+ * Projects the LQ approximation of a node without state-input equality constraints with the change of input variables
+ * u = Pu * tilde{u}, where Pu is the upper-triangular factor of inv(Hm) = Pu * Pu^T from the backward pass. Only the upper
+ * triangle of Pu is used. The dynamics, dynamics bias, and cost fields of projectedModelData are set.
+ *
+ * @param [in] modelData: The LQ approximation of the node.
+ * @param [in] Pu: The upper-triangular null-space projector.
+ * @param [out] projectedModelData: The projected LQ approximation.
+ */
+void projectUnconstrainedLQ(const ModelData& modelData, const matrix_t& Pu, ModelData& projectedModelData);
+
 /**
  * Retrieve time and post event trajectories of the current partition from the entire time and post event trajectories.
  * The resulting time and event indics are normalized to start integration from back.
@@ -155,6 +240,21 @@ void retrieveActiveNormalizedTime(const std::pair<int, int>& partitionInterval,
  */
 std::vector<std::pair<int, int>> computePartitionIntervals(const scalar_array_t& timeTrajectory, int numWorkers);
 
+/**
+ * Whether the numerical properties of the given node should be checked in the given iteration when only every stride-th node is
+ * checked. The checked nodes rotate with the iteration such that every node is checked within stride iterations. The final node
+ * and the nodes before and after the events are always checked.
+ *
+ * @param [in] timeIndex: The index of the node.
+ * @param [in] numNodes: The number of nodes of the trajectory.
+ * @param [in] postEventIndices: The post-event indices of the trajectory.
+ * @param [in] iteration: The iteration number which rotates the checked nodes.
+ * @param [in] stride: The stride of the checked nodes. It should be at least 1.
+ * @return true if the node should be checked.
+ */
+bool isNumericalStabilityCheckNode(size_t timeIndex, size_t numNodes, const size_array_t& postEventIndices, size_t iteration,
+                                   size_t stride);
+
 /**
  * Gets a reference to the linear controller from the given primal solution.
  */
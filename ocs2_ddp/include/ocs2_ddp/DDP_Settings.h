@@ -82,6 +82,9 @@ struct Settings {
   bool displayShortSummary_ = false;
   /** Check the numerical stability of the algorithms for debugging purpose. */
   bool checkNumericalStability_ = true;
+  /** If checkNumericalStability_ is true, only every n-th intermediate node is checked per iteration. The checked nodes rotate over the
+   * iterations, hence all nodes are covered every n iterations. Event and final nodes are always checked. */
+  size_t numericalStabilityCheckStride_ = 1;
   /** Printing rollout trajectory for debugging. */
   bool debugPrintRollout_ = false;
 
@@ -105,12 +108,23 @@ struct Settings {
   /** If true, terms of the Riccati equation will be precomputed before interpolation in the flow-map */
   bool preComputeRiccatiTerms_ = true;
 
+  /** ILQR only: If true, the discrete-time Riccati equations are solved by a parallel-in-time associative scan instead of the time
+   * partitions which are seeded from the previous iteration's value function. Only supported by the risk-neutral line-search strategy
+   * with the DIAGONAL_SHIFT Hessian correction, since the other corrections depend on the value function of the next time step. */
+  bool useRiccatiScan_ = false;
+
   /** Use either the optimized control policy (true) or the optimized state-input trajectory (false). */
   bool useFeedbackPolicy_ = false;
 
   /** The risk sensitivity coefficient for risk aware DDP. */
   scalar_t riskSensitiveCoeff_ = 0.0;
 
+  /** The number of shooting segments of the forward pass. For values larger than one, the horizon is split into segments which are
+   * rolled out in parallel from their shooting nodes and the defects between the segments are closed by the line search. Use one for
+   * the single-shooting forward pass. The multiple-shooting forward pass is only supported by the line-search strategy. Since the
+   * segments use the thread pool, the line search then tries the step lengths one at a time instead of concurrently. */
+  size_t numShootingSegments_ = 1;
+
   /** Determines the strategy for solving the subproblem. There are two choices line-search strategy and levenberg_marquardt strategy. */
   search_strategy::Type strategy_ = search_strategy::Type::LINE_SEARCH;
   /** The line-search strategy settings. */
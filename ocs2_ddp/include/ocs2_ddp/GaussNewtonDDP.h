@@ -48,6 +48,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <ocs2_oc/rollout/TimeTriggeredRollout.h>
 
 #include "ocs2_ddp/DDP_Data.h"
+#include "ocs2_ddp/DDP_HelperFunctions.h"
 #include "ocs2_ddp/DDP_Settings.h"
 #include "ocs2_ddp/riccati_equations/RiccatiModification.h"
 #include "ocs2_ddp/search_strategy/SearchStrategyBase.h"
@@ -123,6 +124,19 @@ class GaussNewtonDDP : public SolverBase {
    */
   void runParallel(std::function<void(void)> taskFunction, size_t N);
 
+  /** Gets the thread pool of the solver. */
+  ThreadPool& threadPool() { return threadPool_; }
+
+  /**
+   * Whether the numerical properties of the given node of the primal solution should be checked in the current iteration. It samples
+   * the nodes based on ddp::Settings::numericalStabilityCheckStride_, see isNumericalStabilityCheckNode().
+   */
+  bool checkNumericalStabilityAt(size_t timeIndex, const PrimalSolution& primalSolution) const {
+    return ddpSettings_.checkNumericalStability_ &&
+           isNumericalStabilityCheckNode(timeIndex, primalSolution.timeTrajectory_.size(), primalSolution.postEventIndices_,
+                                         totalNumIterations_, ddpSettings_.numericalStabilityCheckStride_);
+  }
+
   /**
    * Takes the following steps: (1) Computes the Hessian of the Hamiltonian (i.e., Hm) (2) Based on Hm, it calculates
    * the range space and the null space projections of the input-state equality constraints. (3) Based on these two
@@ -181,6 +195,12 @@ class GaussNewtonDDP : public SolverBase {
    */
   scalar_t solveSequentialRiccatiEquationsImpl(const ScalarFunctionQuadraticApproximation& finalValueFunction);
 
+  /**
+   * Checks the size and the positive semi-definiteness of the value function at the nodes selected by checkNumericalStabilityAt().
+   * It should be called after solving the Riccati equations if ddp::Settings::checkNumericalStability_ is set.
+   */
+  void checkValueFunctionNumericalStability() const;
+
   /**
    * Solves a Riccati equations and type_1 constraints error correction compensation for the partition in the given index.
    *
@@ -191,6 +211,26 @@ class GaussNewtonDDP : public SolverBase {
   virtual void riccatiEquationsWorker(size_t workerIndex, const std::pair<int, int>& partitionInterval,
                                       const ScalarFunctionQuadraticApproximation& finalValueFunction) = 0;
 
+  /**
+   * Adds the defect of a shooting node to the LQ model of the nominal trajectory such that the state transition from timeIndex to
+   * timeIndex+1 accumulates the defect. The backward pass then designs the controller for closing the gap.
+   *
+   * @param [in] timeIndex: The time index right before the shooting node.
+   * @param [in] defect: The defect of the shooting node.
+   * @param [in, out] modelData: The model data at timeIndex.
+   */
+  virtual void addShootingDefect(size_t timeIndex, const vector_t& defect, ModelData& modelData) const = 0;
+
+  /**
+   * Propagates the state increment of the nominal trajectory from timeIndex to timeIndex+1 under the unoptimized controller, i.e.
+   * u - u_nominal = K (x - x_nominal) + deltaBias, based on the LQ model of the dynamics (including the injected shooting defects).
+   *
+   * @param [in] timeIndex: The time index.
+   * @param [in] deltaState: The state increment at timeIndex.
+   * @return The state increment at timeIndex+1.
+   */
+  virtual vector_t propagateStateIncrement(size_t timeIndex, const vector_t& deltaState) const = 0;
+
  private:
   /**
    * Get the State Input Equality Constraint Lagrangian Impl object
@@ -240,6 +280,33 @@ class GaussNewtonDDP : public SolverBase {
    */
   void rolloutInitialTrajectory(PrimalSolution& primalSolution);
 
+  /**
+   * Whether the initial rollout can be a multiple-shooting one. It requires the controller to cover the horizon and the optimized
+   * state trajectory of the previous run to provide the shooting nodes.
+   */
+  bool canRolloutMultipleShooting() const;
+
+  /**
+   * Adds the shooting defects of the nominal trajectory to its LQ approximation.
+   */
+  void addShootingDefects();
+
+  /**
+   * Computes the shooting nodes of the nominal trajectory and their increments predicted by the unoptimized controller and the LQ
+   * model. The line search rollout with step length alpha starts the segments from the nodes plus alpha times the increments.
+   */
+  void computeShootingNodeIncrements();
+
+  /**
+   * The multiple-shooting rollout of a line-search candidate.
+   *
+   * @param [in] stepLength: The step length.
+   * @param [in, out] primalSolution: The primal solution with the incremented controller.
+   * @param [out] shootingDefects: The defects at the shooting nodes.
+   * @return average time step.
+   */
+  scalar_t rolloutMultipleShooting(scalar_t stepLength, PrimalSolution& primalSolution, vector_array_t& shootingDefects);
+
   /**
    * Calculates the controller. This method uses the following variables. The method modifies unoptimizedController_.
    */
@@ -344,13 +411,7 @@ class GaussNewtonDDP : public SolverBase {
 
   void runImpl(scalar_t initTime, const vector_t& initState, scalar_t finalTime, const ControllerBase* externalControllerPtr) override;
 
-  void runImpl(scalar_t initTime, const vector_t& initState, scalar_t finalTime, const PrimalSolution& primalSolution) override {
-    if (primalSolution.controllerPtr_ == nullptr) {
-      std::cerr
-          << "[GaussNewtonDDP] DDP cannot be warm started without a controller in the primal solution. Will revert to a cold start.\n";
-    }
-    runImpl(initTime, initState, finalTime, primalSolution.controllerPtr_.get());
-  }
+  void runImpl(scalar_t initTime, const vector_t& initState, scalar_t finalTime, const PrimalSolution& primalSolution) override;
 
  protected:
   // nominal data
@@ -370,6 +431,7 @@ class GaussNewtonDDP : public SolverBase {
 
   std::unique_ptr<SearchStrategyBase> searchStrategyPtr_;
   std::vector<OptimalControlProblem> optimalControlProblemStock_;
+  std::vector<std::reference_wrapper<OptimalControlProblem>> optimalControlProblemRefStock_;  // references to optimalControlProblemStock_
 
  private:
   const ddp::Settings ddpSettings_;
@@ -383,11 +445,18 @@ class GaussNewtonDDP : public SolverBase {
 
   std::unique_ptr<RolloutBase> initializerRolloutPtr_;
   std::vector<std::unique_ptr<RolloutBase>> dynamicsForwardRolloutPtrStock_;
+  std::vector<std::reference_wrapper<RolloutBase>> dynamicsForwardRolloutRefStock_;  // references to dynamicsForwardRolloutPtrStock_
+
+  // multiple shooting
+  scalar_array_t shootingNodeTimes_;
+  vector_array_t shootingNodeStates_;           // the shooting nodes of the nominal trajectory
+  vector_array_t shootingNodeStateIncrements_;  // the increments of the shooting nodes predicted by the LQ model
 
   // optimized data
   DualSolution optimizedDualSolution_;
   PrimalSolution optimizedPrimalSolution_;
   ProblemMetrics optimizedProblemMetrics_;
+  vector_array_t optimizedShootingDefects_;
 
   // cached data used for caching the nominal trajectories for which the LQ problem is
   // constructed and solved before terminating run()
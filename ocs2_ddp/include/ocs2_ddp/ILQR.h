@@ -34,6 +34,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "GaussNewtonDDP.h"
 #include "riccati_equations/DiscreteTimeRiccatiEquations.h"
+#include "riccati_equations/DiscreteTimeRiccatiScan.h"
 
 namespace ocs2 {
 
@@ -61,6 +62,16 @@ class ILQR : public GaussNewtonDDP {
  protected:
   scalar_t solveSequentialRiccatiEquations(const ScalarFunctionQuadraticApproximation& finalValueFunction) override;
 
+  /**
+   * Solves the discrete-time Riccati equations by a parallel-in-time associative scan. First, the Hessian and the gradient of the
+   * value function are computed for all time steps by riccati_scan::suffixScan. Then, the controller terms of each time step are
+   * computed in parallel. The result matches the sequential recursion up to the round-off error.
+   *
+   * @param [in] finalValueFunction: The final value function.
+   * @return average time step.
+   */
+  scalar_t solveRiccatiEquationsByScan(const ScalarFunctionQuadraticApproximation& finalValueFunction);
+
   void riccatiEquationsWorker(size_t workerIndex, const std::pair<int, int>& partitionInterval,
                               const ScalarFunctionQuadraticApproximation& finalValueFunction) override;
 
@@ -69,6 +80,10 @@ class ILQR : public GaussNewtonDDP {
 
   matrix_t computeHamiltonianHessian(const ModelData& modelData, const matrix_t& Sm) const override;
 
+  void addShootingDefect(size_t timeIndex, const vector_t& defect, ModelData& modelData) const override;
+
+  vector_t propagateStateIncrement(size_t timeIndex, const vector_t& deltaState) const override;
+
   void approximateIntermediateLQ(const DualSolution& dualSolution, PrimalDataContainer& primalData) override;
 
   /**
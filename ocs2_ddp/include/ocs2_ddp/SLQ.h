@@ -61,6 +61,10 @@ class SLQ final : public GaussNewtonDDP {
  protected:
   matrix_t computeHamiltonianHessian(const ModelData& modelData, const matrix_t& Sm) const override;
 
+  void addShootingDefect(size_t timeIndex, const vector_t& defect, ModelData& modelData) const override;
+
+  vector_t propagateStateIncrement(size_t timeIndex, const vector_t& deltaState) const override;
+
   void approximateIntermediateLQ(const DualSolution& dualSolution, PrimalDataContainer& primalData) override;
 
   void calculateControllerWorker(size_t timeIndex, const PrimalDataContainer& primalData, const DualDataContainer& dualData,
@@ -226,6 +226,12 @@ class ContinuousTimeRiccatiEquations final : public OdeBase {
   void computeFlowMapILEG(std::pair<int, scalar_t> indexAlpha, const matrix_t& Sm, const vector_t& Sv, const scalar_t& s,
                           ContinuousTimeRiccatiData& creCache, matrix_t& dSm, vector_t& dSv, scalar_t& ds) const;
 
+  /**
+   * Returns the structure of the interpolated state Jacobian. It falls back to the dense structure if the two ends of
+   * the interpolation interval do not share the same structure.
+   */
+  DynamicsStructure interpolateDynamicsStructure(std::pair<int, scalar_t> indexAlpha) const;
+
  private:
   bool reducedFormRiccati_;
   bool isRiskSensitive_;
@@ -45,6 +45,7 @@ namespace ocs2 {
 struct DiscreteTimeRiccatiData {
   vector_t Sm_projectedHv_;
   matrix_t Sm_projectedAm_;
+  matrix_t projectedAm_T_Sm_projectedAm_;
   matrix_t Sm_projectedBm_;
   vector_t Sv_plus_Sm_projectedHv_;
 
@@ -0,0 +1,110 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <vector>
+
+#include <ocs2_core/Types.h>
+#include <ocs2_core/model_data/ModelData.h>
+#include <ocs2_core/thread_support/ThreadPool.h>
+
+namespace ocs2 {
+namespace riccati_scan {
+
+/**
+ * An element of the parallel-in-time associative scan of the discrete-time Riccati recursion. It describes the conditional value
+ * function of the LQ problem between the time steps i and j, given both the start state x_i and the end state x_j:
+ *
+ * V_{i->j}(x_i, x_j) = 0.5 x_i^T J x_i + eta^T x_i + max_lambda { lambda^T (A x_i + b - x_j) - 0.5 lambda^T C lambda }
+ *
+ * The constant term is not tracked. The element of a single time step is defined by its stage cost and dynamics, and two neighbouring
+ * elements are merged by minimizing over their shared state. Since the merging is associative, the value function of every time step
+ * is obtained by a suffix scan with O(log N) depth.
+ *
+ * Reference: S. Särkkä and Á. F. García-Fernández, "Temporal Parallelization of Dynamic Programming and Linear Quadratic Control".
+ */
+struct Element {
+  matrix_t A;
+  vector_t b;
+  matrix_t C;
+  vector_t eta;
+  matrix_t J;
+};
+
+/**
+ * Creates the element of an intermediate time step from its projected discrete-time LQ model. The input cost Hessian of the model
+ * should be positive definite.
+ *
+ * @param [in] projectedModelData: The projected discrete-time model data.
+ * @param [in] deltaQm: The Riccati modification of the state cost Hessian.
+ * @return The element of the time step.
+ * @throws std::runtime_error if the input cost Hessian is not positive definite.
+ */
+Element createIntermediateElement(const ModelData& projectedModelData, const matrix_t& deltaQm);
+
+/**
+ * Creates the element of an event from its jump map and the event cost.
+ *
+ * @param [in] jumpModelData: The model data at the event time.
+ * @return The element of the event.
+ */
+Element createEventElement(const ModelData& jumpModelData);
+
+/**
+ * Creates the element of the final time from the final value function.
+ *
+ * @param [in] Sm: The Hessian of the final value function.
+ * @param [in] Sv: The gradient of the final value function.
+ * @return The element of the final time.
+ */
+Element createFinalElement(const matrix_t& Sm, const vector_t& Sv);
+
+/**
+ * Merges two consecutive elements, V_{i->k}(x_i, x_k) = min_{x_j} V_{i->j}(x_i, x_j) + V_{j->k}(x_j, x_k).
+ *
+ * @param [in] first: The element of the earlier interval, i.e. V_{i->j}.
+ * @param [in] second: The element of the later interval, i.e. V_{j->k}.
+ * @param [out] result: The merged element, V_{i->k}. It may alias the first element.
+ */
+void combine(const Element& first, const Element& second, Element& result);
+
+/**
+ * Computes the inclusive suffix scan of the elements in place, such that afterwards the k-th element is the combination of the
+ * elements k, k+1, ..., N-1. If the last element is the final element, J and eta of the k-th element are the Hessian and the gradient
+ * of the value function at the time step k. The scan has a depth of 2 log2(N) levels and the merges of each level run in parallel.
+ *
+ * @param [in] threadPool: The thread pool.
+ * @param [in] nThreads: The number of parallel tasks, including the calling thread.
+ * @param [in, out] elements: The elements of all time steps.
+ */
+void suffixScan(ThreadPool& threadPool, size_t nThreads, std::vector<Element>& elements);
+
+}  // namespace riccati_scan
+}  // namespace ocs2
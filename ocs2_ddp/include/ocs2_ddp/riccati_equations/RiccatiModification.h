@@ -48,10 +48,32 @@ struct Data {
   matrix_t hamiltonianHessian_;
   /** The right pseudo-inverse of \f$Dm\f$ */
   matrix_t constraintRangeProjector_;
-  /** \f$DmNull inv(DmNull^T * Hm * DmNull) * DmNull^T = (I - invHm * Dm^T * inv(Dm * invHm * Dm^T) * Dm) * invHm\f$ */
+  /**
+   * \f$DmNull inv(DmNull^T * Hm * DmNull) * DmNull^T = (I - invHm * Dm^T * inv(Dm * invHm * Dm^T) * Dm) * invHm\f$. Without
+   * state-input equality constraints, it is the upper-triangular factor of the Cholesky decomposition \f$invHm = U * U^T\f$.
+   */
   matrix_t constraintNullProjector_;
 };
 
+/**
+ * Whether constraintNullProjector_ is upper-triangular, which is the case when there is no state-input equality constraint.
+ */
+inline bool hasTriangularNullProjector(const Data& data) {
+  return data.constraintRangeProjector_.cols() == 0;
+}
+
+/**
+ * Computes dst += constraintNullProjector_ * src. If the projector is upper-triangular, only its upper triangle is used.
+ */
+template <typename SrcDerived, typename DstDerived>
+void addNullProjectorProduct(const Data& data, const Eigen::MatrixBase<SrcDerived>& src, Eigen::MatrixBase<DstDerived>& dst) {
+  if (hasTriangularNullProjector(data)) {
+    dst.noalias() += data.constraintNullProjector_.template triangularView<Eigen::Upper>() * src;
+  } else {
+    dst.noalias() += data.constraintNullProjector_ * src;
+  }
+}
+
 /**
  * Displays all variables
  */
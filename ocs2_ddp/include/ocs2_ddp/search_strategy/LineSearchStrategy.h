@@ -48,6 +48,10 @@ namespace ocs2 {
 /**
  * Line search strategy: The class computes the nominal controller and the nominal trajectories as well the corresponding performance
  * indices. It line-searches on the feedforward parts of the controller and chooses the largest acceptable step-size.
+ *
+ * By default, the step lengths are tried concurrently, one per worker of the thread pool. When a rollout function is set (see
+ * setRolloutFunction) or when there are fewer step lengths to try than workers, the step lengths are tried one at a time and each of
+ * them uses the whole thread pool for its metrics (and for its rollout in the former case).
  */
 class LineSearchStrategy final : public SearchStrategyBase {
  public:
@@ -70,6 +74,20 @@ class LineSearchStrategy final : public SearchStrategyBase {
   LineSearchStrategy(const LineSearchStrategy&) = delete;
   LineSearchStrategy& operator=(const LineSearchStrategy&) = delete;
 
+  /**
+   * The forward rollout of a line-search candidate. It gets the step length and the primal solution with the incremented controller,
+   * rolls out the trajectories into the primal solution, writes the shooting defects, and returns the average time step.
+   */
+  using rollout_function_t = std::function<scalar_t(scalar_t, PrimalSolution&, vector_array_t&)>;
+
+  /**
+   * Replaces the single-shooting rollout from the initial state by a custom rollout, e.g. a multiple-shooting one. Since such a
+   * rollout runs on the thread pool itself, the step lengths are then tried one after the other on the calling thread.
+   *
+   * @param [in] rolloutFunction: The rollout function. An empty function restores the single-shooting rollout.
+   */
+  void setRolloutFunction(rollout_function_t rolloutFunction) { rolloutFunction_ = std::move(rolloutFunction); }
+
   void reset() override {}
 
   bool run(const std::pair<scalar_t, scalar_t>& timePeriod, const vector_t& initState, const scalar_t expectedCost,
@@ -96,8 +114,16 @@ class LineSearchStrategy final : public SearchStrategyBase {
   /** number of line search iterations (the if statements order is important) */
   size_t maxNumOfSearches() const;
 
-  /** Computes the solution on a thread and a given stepLength  */
-  void computeSolution(size_t taskId, scalar_t stepLength, search_strategy::Solution& solution);
+  /**
+   * Computes the solution on a thread and a given stepLength.
+   *
+   * @param [in] taskId: The ID of the thread's resources.
+   * @param [in] stepLength: The step length.
+   * @param [out] solution: The resulting solution.
+   * @param [in] parallelMetrics: Whether the rollout metrics are computed on all the workers of the thread pool. It should be only
+   *                              set when the thread pool is idle.
+   */
+  void computeSolution(size_t taskId, scalar_t stepLength, search_strategy::Solution& solution, bool parallelMetrics = false);
 
   /**
    * Defines line search task on a thread with various learning rates and choose the largest acceptable step-size.
@@ -115,6 +141,7 @@ class LineSearchStrategy final : public SearchStrategyBase {
   std::vector<std::reference_wrapper<RolloutBase>> rolloutRefStock_;
   std::vector<std::reference_wrapper<OptimalControlProblem>> optimalControlProblemRefStock_;
   std::function<scalar_t(PerformanceIndex)> meritFunc_;
+  rollout_function_t rolloutFunction_;
 
   // input
   LineSearchInputRef lineSearchInputRef_;
@@ -130,6 +157,7 @@ class LineSearchStrategy final : public SearchStrategyBase {
   std::atomic_size_t nextTaskId_{0};
   std::atomic_size_t alphaExpNext_{0};
   std::vector<bool> alphaProcessed_;
+  bool isSequentialSearch_ = false;  // whether the step lengths are tried one by one with parallel metrics
   std::mutex lineSearchResultMutex_;
   mutable std::mutex outputDisplayGuardMutex_;
 };
@@ -35,6 +35,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <ocs2_core/Types.h>
 #include <ocs2_core/control/LinearController.h>
+#include <ocs2_core/misc/Deadline.h>
 #include <ocs2_core/model_data/Metrics.h>
 #include <ocs2_core/model_data/ModelData.h>
 #include <ocs2_core/reference/ModeSchedule.h>
@@ -74,6 +75,14 @@ class SearchStrategyBase {
    */
   virtual void reset() = 0;
 
+  /**
+   * Sets the deadline of the solver run. Once the deadline has expired, the search is stopped and the best candidate found so far
+   * is returned.
+   *
+   * @param [in] deadline: A reference to the solver's deadline. It should outlive this class.
+   */
+  void setDeadline(const Deadline& deadline) { deadlinePtr_ = &deadline; }
+
   /**
    * Finds the optimal trajectories, controller, and performance index based on the given controller and its increment.
    *
@@ -125,7 +134,13 @@ class SearchStrategyBase {
   virtual matrix_t augmentHamiltonianHessian(const ModelData& modelData, const matrix_t& Hm) const = 0;
 
  protected:
+  /** Whether the deadline of the solver run has expired. */
+  bool hasDeadlineExpired() const { return deadlinePtr_ != nullptr && deadlinePtr_->hasExpired(); }
+
   const search_strategy::Settings baseSettings_;
+
+ private:
+  const Deadline* deadlinePtr_ = nullptr;
 };
 
 }  // namespace ocs2
@@ -142,6 +157,7 @@ struct Solution {
   PrimalSolution primalSolution;
   ProblemMetrics problemMetrics;
   PerformanceIndex performanceIndex;
+  vector_array_t shootingDefects;  // empty for a single-shooting rollout
 };
 
 struct SolutionRef {
@@ -150,21 +166,24 @@ struct SolutionRef {
         dualSolution(s.dualSolution),
         primalSolution(s.primalSolution),
         problemMetrics(s.problemMetrics),
-        performanceIndex(s.performanceIndex) {}
+        performanceIndex(s.performanceIndex),
+        shootingDefects(s.shootingDefects) {}
 
   SolutionRef(scalar_t& avgTimeStepArg, DualSolution& dualSolutionArg, PrimalSolution& primalSolutionArg, ProblemMetrics& problemMetricsArg,
-              PerformanceIndex& performanceIndexArg)
+              PerformanceIndex& performanceIndexArg, vector_array_t& shootingDefectsArg)
       : avgTimeStep(avgTimeStepArg),
         dualSolution(dualSolutionArg),
         primalSolution(primalSolutionArg),
         problemMetrics(problemMetricsArg),
-        performanceIndex(performanceIndexArg) {}
+        performanceIndex(performanceIndexArg),
+        shootingDefects(shootingDefectsArg) {}
 
   scalar_t& avgTimeStep;
   DualSolution& dualSolution;
   PrimalSolution& primalSolution;
   ProblemMetrics& problemMetrics;
   PerformanceIndex& performanceIndex;
+  vector_array_t& shootingDefects;
 };
 
 inline void swap(SolutionRef lhs, SolutionRef rhs) {
@@ -173,6 +192,7 @@ inline void swap(SolutionRef lhs, SolutionRef rhs) {
   lhs.primalSolution.swap(rhs.primalSolution);
   lhs.problemMetrics.swap(rhs.problemMetrics);
   ocs2::swap(lhs.performanceIndex, rhs.performanceIndex);
+  lhs.shootingDefects.swap(rhs.shootingDefects);
 }
 
 }  // namespace search_strategy
@@ -30,12 +30,15 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "ocs2_ddp/DDP_HelperFunctions.h"
 
 #include <algorithm>
+#include <atomic>
+#include <exception>
 #include <iostream>
 
 #include <ocs2_core/PreComputation.h>
 #include <ocs2_core/integration/TrapezoidalIntegration.h>
 #include <ocs2_core/misc/LinearInterpolation.h>
 #include <ocs2_oc/approximate_model/LinearQuadraticApproximator.h>
+#include <ocs2_oc/oc_problem/OptimalControlProblemHelperFunction.h>
 
 namespace ocs2 {
 
@@ -55,41 +58,118 @@ void copySegment(const LinearInterpolation::index_alpha_t& indexAlpha0, const Li
     outputTrajectory.back() = LinearInterpolation::interpolate(indexAlpha1, inputTrajectory);
   }
 }
-}  // unnamed namespace
 
-/******************************************************************************************************/
-/******************************************************************************************************/
-/******************************************************************************************************/
-void computeRolloutMetrics(OptimalControlProblem& problem, const PrimalSolution& primalSolution, DualSolutionConstRef dualSolution,
-                           ProblemMetrics& problemMetrics) {
+/**
+ * Computes the intermediate and pre-jump metrics of the time indices in [beginIndex, endIndex). problemMetrics should be already
+ * resized to the length of the rollout.
+ */
+void computeRolloutMetricsSegment(OptimalControlProblem& problem, const PrimalSolution& primalSolution, DualSolutionConstRef dualSolution,
+                                  size_t beginIndex, size_t endIndex, ProblemMetrics& problemMetrics) {
   const auto& tTrajectory = primalSolution.timeTrajectory_;
   const auto& xTrajectory = primalSolution.stateTrajectory_;
   const auto& uTrajectory = primalSolution.inputTrajectory_;
   const auto& postEventIndices = primalSolution.postEventIndices_;
 
-  problemMetrics.clear();
-  problemMetrics.preJumps.reserve(postEventIndices.size());
-  problemMetrics.intermediates.reserve(tTrajectory.size());
-
-  auto nextPostEventIndexItr = postEventIndices.begin();
+  // the first event which its pre-event index (postEventIndex - 1) is in the segment
+  auto nextPostEventIndexItr = std::lower_bound(postEventIndices.begin(), postEventIndices.end(), beginIndex + 1);
   const auto request = Request::Cost + Request::Constraint + Request::SoftConstraint;
-  for (size_t k = 0; k < tTrajectory.size(); k++) {
+  for (size_t k = beginIndex; k < endIndex; k++) {
     // intermediate time cost and constraints
     problem.preComputationPtr->request(request, tTrajectory[k], xTrajectory[k], uTrajectory[k]);
-    problemMetrics.intermediates.push_back(
-        computeIntermediateMetrics(problem, tTrajectory[k], xTrajectory[k], uTrajectory[k], dualSolution.intermediates[k]));
+    problemMetrics.intermediates[k] =
+        computeIntermediateMetrics(problem, tTrajectory[k], xTrajectory[k], uTrajectory[k], dualSolution.intermediates[k]);
 
     // event time cost and constraints
     if (nextPostEventIndexItr != postEventIndices.end() && k + 1 == *nextPostEventIndexItr) {
-      const auto m = dualSolution.preJumps[std::distance(postEventIndices.begin(), nextPostEventIndexItr)];
+      const auto eventIndex = std::distance(postEventIndices.begin(), nextPostEventIndexItr);
       problem.preComputationPtr->requestPreJump(request, tTrajectory[k], xTrajectory[k]);
-      problemMetrics.preJumps.push_back(computePreJumpMetrics(problem, tTrajectory[k], xTrajectory[k], m));
+      problemMetrics.preJumps[eventIndex] =
+          computePreJumpMetrics(problem, tTrajectory[k], xTrajectory[k], dualSolution.preJumps[eventIndex]);
       nextPostEventIndexItr++;
     }
   }
+}
+
+/**
+ * Runs segmentTask(problem, beginIndex, endIndex) over the chunks of [0, numPoints) on the threadPool. Each parallel task is assigned
+ * a distinct problem from problemRefStock and it processes chunks until none is left.
+ */
+void runChunksParallel(ThreadPool& threadPool, const std::vector<std::reference_wrapper<OptimalControlProblem>>& problemRefStock,
+                       size_t numPoints, const std::function<void(OptimalControlProblem&, size_t, size_t)>& segmentTask) {
+  // a few chunks per task to balance the load between the workers
+  constexpr size_t numChunksPerTask = 4;
+  const size_t numTasks = std::min(threadPool.numThreads() + 1, problemRefStock.size());
+  const size_t numChunks = std::min(numTasks * numChunksPerTask, numPoints);
+
+  if (numTasks < 2 || numChunks < 2) {
+    segmentTask(problemRefStock.front(), 0, numPoints);
+    return;
+  }
+
+  std::atomic_size_t nextTaskId{0};
+  std::atomic_size_t nextChunkId{0};
+  auto task = [&](int) {
+    const size_t taskId = nextTaskId++;  // assign task ID (atomic)
+    size_t chunkId;
+    while ((chunkId = nextChunkId++) < numChunks) {
+      const size_t beginIndex = chunkId * numPoints / numChunks;
+      const size_t endIndex = (chunkId + 1) * numPoints / numChunks;
+      segmentTask(problemRefStock[taskId], beginIndex, endIndex);
+    }
+  };
+  threadPool.runParallel(task, numTasks);
+}
+}  // unnamed namespace
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void computeRolloutMetrics(OptimalControlProblem& problem, const PrimalSolution& primalSolution, DualSolutionConstRef dualSolution,
+                           ProblemMetrics& problemMetrics) {
+  const auto& tTrajectory = primalSolution.timeTrajectory_;
+  const auto& xTrajectory = primalSolution.stateTrajectory_;
+
+  problemMetrics.clear();
+  problemMetrics.preJumps.resize(primalSolution.postEventIndices_.size());
+  problemMetrics.intermediates.resize(tTrajectory.size());
+
+  // intermediate and event times cost and constraints
+  computeRolloutMetricsSegment(problem, primalSolution, dualSolution, 0, tTrajectory.size(), problemMetrics);
+
+  // final time cost and constraints
+  if (!tTrajectory.empty()) {
+    const auto request = Request::Cost + Request::Constraint + Request::SoftConstraint;
+    problem.preComputationPtr->requestFinal(request, tTrajectory.back(), xTrajectory.back());
+    problemMetrics.final = computeFinalMetrics(problem, tTrajectory.back(), xTrajectory.back(), dualSolution.final);
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void computeRolloutMetrics(ThreadPool& threadPool, const std::vector<std::reference_wrapper<OptimalControlProblem>>& problemRefStock,
+                           const PrimalSolution& primalSolution, DualSolutionConstRef dualSolution, ProblemMetrics& problemMetrics) {
+  if (problemRefStock.empty()) {
+    throw std::runtime_error("[computeRolloutMetrics] problemRefStock cannot be empty!");
+  }
+
+  const auto& tTrajectory = primalSolution.timeTrajectory_;
+  const auto& xTrajectory = primalSolution.stateTrajectory_;
+
+  problemMetrics.clear();
+  problemMetrics.preJumps.resize(primalSolution.postEventIndices_.size());
+  problemMetrics.intermediates.resize(tTrajectory.size());
+
+  // intermediate and event times cost and constraints
+  runChunksParallel(threadPool, problemRefStock, tTrajectory.size(),
+                    [&](OptimalControlProblem& problem, size_t beginIndex, size_t endIndex) {
+                      computeRolloutMetricsSegment(problem, primalSolution, dualSolution, beginIndex, endIndex, problemMetrics);
+                    });
 
   // final time cost and constraints
   if (!tTrajectory.empty()) {
+    auto& problem = problemRefStock.front().get();
+    const auto request = Request::Cost + Request::Constraint + Request::SoftConstraint;
     problem.preComputationPtr->requestFinal(request, tTrajectory.back(), xTrajectory.back());
     problemMetrics.final = computeFinalMetrics(problem, tTrajectory.back(), xTrajectory.back(), dualSolution.final);
   }
@@ -98,7 +178,49 @@ void computeRolloutMetrics(OptimalControlProblem& problem, const PrimalSolution&
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
-PerformanceIndex computeRolloutPerformanceIndex(const scalar_array_t& timeTrajectory, const ProblemMetrics& problemMetrics) {
+void updateDualSolution(ThreadPool& threadPool, const std::vector<std::reference_wrapper<OptimalControlProblem>>& problemRefStock,
+                        const PrimalSolution& primalSolution, ProblemMetrics& problemMetrics, DualSolutionRef dualSolution) {
+  if (problemRefStock.empty()) {
+    throw std::runtime_error("[updateDualSolution] problemRefStock cannot be empty!");
+  }
+
+  const auto& tTrajectory = primalSolution.timeTrajectory_;
+  const auto& xTrajectory = primalSolution.stateTrajectory_;
+  const auto& uTrajectory = primalSolution.inputTrajectory_;
+  const auto& postEventIndices = primalSolution.postEventIndices_;
+  const OptimalControlProblem& ocp = problemRefStock.front();
+
+  // final
+  if (!tTrajectory.empty()) {
+    updateFinalMultiplierCollection(ocp, tTrajectory.back(), xTrajectory.back(), problemMetrics.final, dualSolution.final);
+  }
+
+  // preJump
+  assert(dualSolution.preJumps.size() == postEventIndices.size());
+  assert(problemMetrics.preJumps.size() == postEventIndices.size());
+  for (size_t i = 0; i < postEventIndices.size(); i++) {
+    const auto timeIndex = postEventIndices[i] - 1;
+    updatePreJumpMultiplierCollection(ocp, tTrajectory[timeIndex], xTrajectory[timeIndex], problemMetrics.preJumps[i],
+                                      dualSolution.preJumps[i]);
+  }
+
+  // intermediates
+  assert(dualSolution.intermediates.size() == tTrajectory.size());
+  assert(problemMetrics.intermediates.size() == tTrajectory.size());
+  runChunksParallel(threadPool, problemRefStock, tTrajectory.size(),
+                    [&](OptimalControlProblem& problem, size_t beginIndex, size_t endIndex) {
+                      for (size_t k = beginIndex; k < endIndex; k++) {
+                        updateIntermediateMultiplierCollection(problem, tTrajectory[k], xTrajectory[k], uTrajectory[k],
+                                                               problemMetrics.intermediates[k], dualSolution.intermediates[k]);
+                      }
+                    });
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+PerformanceIndex computeRolloutPerformanceIndex(const scalar_array_t& timeTrajectory, const ProblemMetrics& problemMetrics,
+                                                const vector_array_t& shootingDefects) {
   assert(timeTrajectory.size() == problemMetrics.intermediates.size());
 
   PerformanceIndex performanceIndex;
@@ -117,8 +239,10 @@ PerformanceIndex computeRolloutPerformanceIndex(const scalar_array_t& timeTrajec
                  [](const MetricsCollection& m) { return m.cost; });
   performanceIndex.cost += trapezoidalIntegration(timeTrajectory, costTrajectory);
 
-  // Dynamics violation:
+  // Dynamics violation: the defects at the shooting nodes
   performanceIndex.dynamicsViolationSSE = 0.0;
+  std::for_each(shootingDefects.begin(), shootingDefects.end(),
+                [&](const vector_t& d) { performanceIndex.dynamicsViolationSSE += d.squaredNorm(); });
 
   // Equality constraints' SSE:
   // - Final: state equality constraints
@@ -184,6 +308,119 @@ scalar_t rolloutTrajectory(RolloutBase& rollout, scalar_t initTime, const vector
   return (finalTime - initTime) / static_cast<scalar_t>(primalSolution.timeTrajectory_.size());
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+scalar_array_t computeShootingNodeTimes(scalar_t initTime, scalar_t finalTime, size_t numSegments, const scalar_array_t& eventTimes) {
+  scalar_array_t nodeTimes{initTime};
+  if (numSegments < 2 || finalTime <= initTime) {
+    return nodeTimes;
+  }
+
+  const scalar_t segmentDuration = (finalTime - initTime) / static_cast<scalar_t>(numSegments);
+  const scalar_t minEventDistance = 0.1 * segmentDuration;
+  nodeTimes.reserve(numSegments);
+  for (size_t s = 1; s < numSegments; s++) {
+    const scalar_t nodeTime = initTime + static_cast<scalar_t>(s) * segmentDuration;
+    const bool isNearEvent = std::any_of(eventTimes.cbegin(), eventTimes.cend(),
+                                         [&](scalar_t eventTime) { return std::abs(eventTime - nodeTime) < minEventDistance; });
+    if (!isNearEvent) {
+      nodeTimes.push_back(nodeTime);
+    }
+  }
+
+  return nodeTimes;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+scalar_t rolloutTrajectory(ThreadPool& threadPool, const std::vector<std::reference_wrapper<RolloutBase>>& rolloutRefStock,
+                           const scalar_array_t& nodeTimes, const vector_array_t& nodeStates, scalar_t finalTime,
+                           PrimalSolution& primalSolution, vector_array_t& shootingDefects) {
+  struct Segment {
+    scalar_array_t timeTrajectory;
+    size_array_t postEventIndices;
+    vector_array_t stateTrajectory;
+    vector_array_t inputTrajectory;
+    vector_t finalState;
+    std::exception_ptr error;
+  };
+
+  if (nodeTimes.empty() || nodeTimes.size() != nodeStates.size()) {
+    throw std::runtime_error("[rolloutTrajectory] The shooting nodes' times and states should be non-empty and of the same size!");
+  }
+  if (rolloutRefStock.empty()) {
+    throw std::runtime_error("[rolloutTrajectory] rolloutRefStock should not be empty!");
+  }
+
+  const size_t numSegments = nodeTimes.size();
+  std::vector<Segment> segments(numSegments);
+
+  // rollout the segments in parallel
+  std::atomic_size_t nextTaskId{0};
+  std::atomic_size_t nextSegmentId{0};
+  auto task = [&](int) {
+    auto& rollout = rolloutRefStock[nextTaskId++].get();  // assign task ID (atomic)
+    size_t s;
+    while ((s = nextSegmentId++) < numSegments) {
+      auto& segment = segments[s];
+      const scalar_t segmentFinalTime = (s + 1 < numSegments) ? nodeTimes[s + 1] : finalTime;
+      try {
+        segment.finalState = rollout.run(nodeTimes[s], nodeStates[s], segmentFinalTime, primalSolution.controllerPtr_.get(),
+                                         primalSolution.modeSchedule_, segment.timeTrajectory, segment.postEventIndices,
+                                         segment.stateTrajectory, segment.inputTrajectory);
+      } catch (...) {
+        segment.error = std::current_exception();
+      }
+    }
+  };
+  const size_t numTasks = std::min({threadPool.numThreads() + 1, rolloutRefStock.size(), numSegments});
+  threadPool.runParallel(task, numTasks);
+
+  for (const auto& segment : segments) {
+    if (segment.error) {
+      std::rethrow_exception(segment.error);
+    }
+    if (!segment.finalState.allFinite()) {
+      throw std::runtime_error("[rolloutTrajectory] System became unstable during the rollout!");
+    }
+  }
+
+  // concatenate the segments: the final point of each segment is replaced by the node of the next one
+  auto& timeTrajectory = primalSolution.timeTrajectory_;
+  auto& postEventIndices = primalSolution.postEventIndices_;
+  auto& stateTrajectory = primalSolution.stateTrajectory_;
+  auto& inputTrajectory = primalSolution.inputTrajectory_;
+  timeTrajectory.clear();
+  postEventIndices.clear();
+  stateTrajectory.clear();
+  inputTrajectory.clear();
+  for (size_t s = 0; s < numSegments; s++) {
+    const auto& segment = segments[s];
+    const size_t offset = timeTrajectory.size();
+    const size_t length = (s + 1 < numSegments) ? segment.timeTrajectory.size() - 1 : segment.timeTrajectory.size();
+    timeTrajectory.insert(timeTrajectory.end(), segment.timeTrajectory.begin(), segment.timeTrajectory.begin() + length);
+    stateTrajectory.insert(stateTrajectory.end(), segment.stateTrajectory.begin(), segment.stateTrajectory.begin() + length);
+    inputTrajectory.insert(inputTrajectory.end(), segment.inputTrajectory.begin(), segment.inputTrajectory.begin() + length);
+    for (const auto index : segment.postEventIndices) {
+      if (index < length) {
+        postEventIndices.push_back(offset + index);
+      }
+    }
+  }
+
+  // defects at the shooting nodes
+  shootingDefects.resize(numSegments);
+  shootingDefects.front().setZero(nodeStates.front().size());
+  for (size_t s = 1; s < numSegments; s++) {
+    shootingDefects[s] = segments[s - 1].finalState - nodeStates[s];
+  }
+
+  // average time step
+  return (finalTime - nodeTimes.front()) / static_cast<scalar_t>(timeTrajectory.size());
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -276,6 +513,29 @@ void incrementController(scalar_t stepLength, const LinearController& unoptimize
   }
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void projectUnconstrainedLQ(const ModelData& modelData, const matrix_t& Pu, ModelData& projectedModelData) {
+  const auto PuUpper = Pu.triangularView<Eigen::Upper>();
+
+  // dynamics: B = B * Pu
+  projectedModelData.dynamics.f = modelData.dynamics.f;
+  projectedModelData.dynamics.dfdx = modelData.dynamics.dfdx;
+  projectedModelData.dynamics.dfdu.noalias() = modelData.dynamics.dfdu * PuUpper;
+  projectedModelData.dynamicsStructure = modelData.dynamicsStructure;
+  projectedModelData.dynamicsBias = modelData.dynamicsBias;
+
+  // cost: P = Pu' * P, R = Pu' * R * Pu, r = Pu' * r
+  projectedModelData.cost.f = modelData.cost.f;
+  projectedModelData.cost.dfdx = modelData.cost.dfdx;
+  projectedModelData.cost.dfdxx = modelData.cost.dfdxx;
+  projectedModelData.cost.dfdux.noalias() = PuUpper.transpose() * modelData.cost.dfdux;
+  const matrix_t R_Pu = modelData.cost.dfduu * PuUpper;
+  projectedModelData.cost.dfduu.noalias() = PuUpper.transpose() * R_Pu;
+  projectedModelData.cost.dfdu.noalias() = PuUpper.transpose() * modelData.cost.dfdu;
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -329,4 +589,17 @@ std::vector<std::pair<int, int>> computePartitionIntervals(const scalar_array_t&
   return partitionIntervals;
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+bool isNumericalStabilityCheckNode(size_t timeIndex, size_t numNodes, const size_array_t& postEventIndices, size_t iteration,
+                                   size_t stride) {
+  if (timeIndex + 1 == numNodes || (timeIndex + iteration) % stride == 0) {
+    return true;
+  }
+  // the nodes before and after the events
+  return std::binary_search(postEventIndices.cbegin(), postEventIndices.cend(), timeIndex) ||
+         std::binary_search(postEventIndices.cbegin(), postEventIndices.cend(), timeIndex + 1);
+}
+
 }  // namespace ocs2
@@ -77,6 +77,7 @@ Settings loadSettings(const std::string& filename, const std::string& fieldName,
   loadData::loadPtreeValue(pt, settings.displayInfo_, fieldName + ".displayInfo", verbose);
   loadData::loadPtreeValue(pt, settings.displayShortSummary_, fieldName + ".displayShortSummary", verbose);
   loadData::loadPtreeValue(pt, settings.checkNumericalStability_, fieldName + ".checkNumericalStability", verbose);
+  loadData::loadPtreeValue(pt, settings.numericalStabilityCheckStride_, fieldName + ".numericalStabilityCheckStride", verbose);
   loadData::loadPtreeValue(pt, settings.debugPrintRollout_, fieldName + ".debugPrintRollout", verbose);
 
   loadData::loadPtreeValue(pt, settings.absTolODE_, fieldName + ".AbsTolODE", verbose);
@@ -91,10 +92,12 @@ Settings loadSettings(const std::string& filename, const std::string& fieldName,
   loadData::loadPtreeValue(pt, settings.constraintPenaltyIncreaseRate_, fieldName + ".constraintPenaltyIncreaseRate", verbose);
 
   loadData::loadPtreeValue(pt, settings.preComputeRiccatiTerms_, fieldName + ".preComputeRiccatiTerms", verbose);
+  loadData::loadPtreeValue(pt, settings.useRiccatiScan_, fieldName + ".useRiccatiScan", verbose);
 
   loadData::loadPtreeValue(pt, settings.useFeedbackPolicy_, fieldName + ".useFeedbackPolicy", verbose);
 
   loadData::loadPtreeValue(pt, settings.riskSensitiveCoeff_, fieldName + ".riskSensitiveCoeff", verbose);
+  loadData::loadPtreeValue(pt, settings.numShootingSegments_, fieldName + ".numShootingSegments", verbose);
 
   std::string strategyName = search_strategy::toString(settings.strategy_);
   loadData::loadPtreeValue(pt, strategyName, fieldName + ".strategy", verbose);
@@ -35,6 +35,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <ocs2_core/control/FeedforwardController.h>
 #include <ocs2_core/integration/TrapezoidalIntegration.h>
 #include <ocs2_core/misc/LinearAlgebra.h>
+#include <ocs2_core/misc/LinearInterpolation.h>
 
 #include <ocs2_oc/approximate_model/ChangeOfInputVariables.h>
 #include <ocs2_oc/oc_problem/OptimalControlProblemHelperFunction.h>
@@ -71,6 +72,9 @@ GaussNewtonDDP::GaussNewtonDDP(ddp::Settings ddpSettings, const RolloutBase& rol
         "[GaussNewtonDDP] DDP does not support final equality constraints (a.k.a. finalEqualityConstraintPtr), instead use the Lagrangian "
         "method!");
   }
+  if (ddpSettings_.numericalStabilityCheckStride_ == 0) {
+    throw std::runtime_error("[GaussNewtonDDP] numericalStabilityCheckStride should be at least 1!");
+  }
 
   // initializer Rollout
   initializerRolloutPtr_.reset(new InitializerRollout(initializer, rollout.settings()));
@@ -82,6 +86,11 @@ GaussNewtonDDP::GaussNewtonDDP(ddp::Settings ddpSettings, const RolloutBase& rol
     optimalControlProblemStock_.push_back(optimalControlProblem);
     dynamicsForwardRolloutPtrStock_.emplace_back(rollout.clone());
   }  // end of i loop
+  optimalControlProblemRefStock_.assign(optimalControlProblemStock_.begin(), optimalControlProblemStock_.end());
+  dynamicsForwardRolloutRefStock_.reserve(ddpSettings_.nThreads_);
+  for (auto& rolloutPtr : dynamicsForwardRolloutPtrStock_) {
+    dynamicsForwardRolloutRefStock_.emplace_back(*rolloutPtr);
+  }
 
   // search strategy method
   const auto basicStrategySettings = [&]() {
@@ -95,17 +104,21 @@ GaussNewtonDDP::GaussNewtonDDP(ddp::Settings ddpSettings, const RolloutBase& rol
   auto meritFunc = [this](const PerformanceIndex& p) { return calculateRolloutMerit(p); };
   switch (ddpSettings_.strategy_) {
     case search_strategy::Type::LINE_SEARCH: {
-      std::vector<std::reference_wrapper<RolloutBase>> rolloutRefStock;
-      std::vector<std::reference_wrapper<OptimalControlProblem>> problemRefStock;
-      for (size_t i = 0; i < ddpSettings_.nThreads_; i++) {
-        rolloutRefStock.emplace_back(*dynamicsForwardRolloutPtrStock_[i]);
-        problemRefStock.emplace_back(optimalControlProblemStock_[i]);
-      }  // end of i loop
-      searchStrategyPtr_.reset(new LineSearchStrategy(basicStrategySettings, ddpSettings_.lineSearch_, threadPool_,
-                                                      std::move(rolloutRefStock), std::move(problemRefStock), meritFunc));
+      std::unique_ptr<LineSearchStrategy> lineSearchStrategyPtr(new LineSearchStrategy(basicStrategySettings, ddpSettings_.lineSearch_,
+                                                                                       threadPool_, dynamicsForwardRolloutRefStock_,
+                                                                                       optimalControlProblemRefStock_, meritFunc));
+      if (ddpSettings_.numShootingSegments_ > 1) {
+        lineSearchStrategyPtr->setRolloutFunction([this](scalar_t stepLength, PrimalSolution& primalSolution, vector_array_t& defects) {
+          return rolloutMultipleShooting(stepLength, primalSolution, defects);
+        });
+      }
+      searchStrategyPtr_ = std::move(lineSearchStrategyPtr);
       break;
     }
     case search_strategy::Type::LEVENBERG_MARQUARDT: {
+      if (ddpSettings_.numShootingSegments_ > 1) {
+        throw std::runtime_error("[GaussNewtonDDP] The multiple-shooting forward pass is only supported by the line-search strategy!");
+      }
       constexpr size_t threadID = 0;
       searchStrategyPtr_.reset(new LevenbergMarquardtStrategy(basicStrategySettings, ddpSettings_.levenbergMarquardt_,
                                                               *dynamicsForwardRolloutPtrStock_[threadID],
@@ -113,6 +126,7 @@ GaussNewtonDDP::GaussNewtonDDP(ddp::Settings ddpSettings, const RolloutBase& rol
       break;
     }
   }  // end of switch-case
+  searchStrategyPtr_->setDeadline(getDeadline());
 
   // initialize controller
   optimizedPrimalSolution_.controllerPtr_.reset(new LinearController);
@@ -181,6 +195,12 @@ void GaussNewtonDDP::reset() {
   optimizedDualSolution_.clear();
   optimizedPrimalSolution_.clear();
   optimizedProblemMetrics_.clear();
+  optimizedShootingDefects_.clear();
+
+  // multiple shooting
+  shootingNodeTimes_.clear();
+  shootingNodeStates_.clear();
+  shootingNodeStateIncrements_.clear();
 
   // performance measures
   avgTimeStepFP_ = 0.0;
@@ -459,6 +479,92 @@ void GaussNewtonDDP::rolloutInitialTrajectory(PrimalSolution& primalSolution) {
   }
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+bool GaussNewtonDDP::canRolloutMultipleShooting() const {
+  if (ddpSettings_.numShootingSegments_ < 2 || shootingNodeTimes_.size() < 2) {
+    return false;
+  }
+
+  // the controller should cover the whole horizon
+  const auto* controllerPtr = nominalPrimalData_.primalSolution.controllerPtr_.get();
+  if (controllerPtr->empty() || static_cast<const LinearController*>(controllerPtr)->timeStamp_.back() < finalTime_) {
+    return false;
+  }
+
+  // the previous solution should cover the shooting nodes
+  const auto& previousTimeTrajectory = optimizedPrimalSolution_.timeTrajectory_;
+  return !previousTimeTrajectory.empty() && previousTimeTrajectory.front() <= shootingNodeTimes_[1] &&
+         previousTimeTrajectory.back() >= shootingNodeTimes_.back();
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void GaussNewtonDDP::addShootingDefects() {
+  const auto& timeTrajectory = nominalPrimalData_.primalSolution.timeTrajectory_;
+  const auto& shootingDefects = nominalPrimalData_.shootingDefects;
+
+  // the first node is the initial state which has no defect
+  for (size_t s = 1; s < shootingDefects.size(); s++) {
+    const auto nodeIndex =
+        std::distance(timeTrajectory.begin(), std::lower_bound(timeTrajectory.begin(), timeTrajectory.end(), shootingNodeTimes_[s]));
+    if (nodeIndex > 0 && nodeIndex < timeTrajectory.size()) {
+      addShootingDefect(nodeIndex - 1, shootingDefects[s], nominalPrimalData_.modelDataTrajectory[nodeIndex - 1]);
+    }
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void GaussNewtonDDP::computeShootingNodeIncrements() {
+  const auto& primalSolution = nominalPrimalData_.primalSolution;
+  const auto& timeTrajectory = primalSolution.timeTrajectory_;
+  const auto& postEventIndices = primalSolution.postEventIndices_;
+  const size_t N = timeTrajectory.size();
+
+  // forward sweep of the state increment under the unoptimized controller
+  vector_array_t deltaStateTrajectory(N);
+  deltaStateTrajectory.front().setZero(initState_.size());
+  auto nextPostEventIndexItr = postEventIndices.cbegin();
+  for (size_t k = 0; k + 1 < N; k++) {
+    if (nextPostEventIndexItr != postEventIndices.cend() && k + 1 == *nextPostEventIndexItr) {
+      const auto eventIndex = std::distance(postEventIndices.cbegin(), nextPostEventIndexItr);
+      deltaStateTrajectory[k + 1].noalias() = nominalPrimalData_.modelDataEventTimes[eventIndex].dynamics.dfdx * deltaStateTrajectory[k];
+      nextPostEventIndexItr++;
+    } else {
+      deltaStateTrajectory[k + 1] = propagateStateIncrement(k, deltaStateTrajectory[k]);
+    }
+  }
+
+  // the shooting nodes and their increments. The first node is the initial state which is fixed.
+  const size_t numNodes = shootingNodeTimes_.size();
+  shootingNodeStates_.resize(numNodes);
+  shootingNodeStateIncrements_.resize(numNodes);
+  shootingNodeStates_.front() = initState_;
+  shootingNodeStateIncrements_.front().setZero(initState_.size());
+  for (size_t s = 1; s < numNodes; s++) {
+    const auto indexAlpha = LinearInterpolation::timeSegment(shootingNodeTimes_[s], timeTrajectory);
+    shootingNodeStates_[s] = LinearInterpolation::interpolate(indexAlpha, primalSolution.stateTrajectory_);
+    shootingNodeStateIncrements_[s] = LinearInterpolation::interpolate(indexAlpha, deltaStateTrajectory);
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+scalar_t GaussNewtonDDP::rolloutMultipleShooting(scalar_t stepLength, PrimalSolution& primalSolution, vector_array_t& shootingDefects) {
+  // the defects shrink by the factor (1 - stepLength) according to the LQ model
+  vector_array_t nodeStates = shootingNodeStates_;
+  for (size_t s = 0; s < nodeStates.size(); s++) {
+    nodeStates[s] += stepLength * shootingNodeStateIncrements_[s];
+  }
+  return ocs2::rolloutTrajectory(threadPool_, dynamicsForwardRolloutRefStock_, shootingNodeTimes_, nodeStates, finalTime_, primalSolution,
+                                 shootingDefects);
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -476,6 +582,8 @@ scalar_t GaussNewtonDDP::calculateRolloutMerit(const PerformanceIndex& performan
   scalar_t merit = performanceIndex.cost;
   // state/state-input equality constraints
   merit += constraintPenaltyCoefficients_.penaltyCoeff * std::sqrt(performanceIndex.equalityConstraintsSSE);
+  // shooting defects of the multiple-shooting rollout
+  merit += constraintPenaltyCoefficients_.penaltyCoeff * std::sqrt(performanceIndex.dynamicsViolationSSE);
   // state/state-input equality Lagrangian
   merit += performanceIndex.equalityLagrangian;
   // state/state-input inequality Lagrangian
@@ -490,8 +598,7 @@ scalar_t GaussNewtonDDP::calculateRolloutMerit(const PerformanceIndex& performan
 scalar_t GaussNewtonDDP::solveSequentialRiccatiEquationsImpl(const ScalarFunctionQuadraticApproximation& finalValueFunction) {
   // pre-allocate memory for dual solution
   const size_t outputN = nominalPrimalData_.primalSolution.timeTrajectory_.size();
-  nominalDualData_.valueFunctionTrajectory.clear();
-  nominalDualData_.valueFunctionTrajectory.resize(outputN);
+  resizeTrajectory(outputN, nominalDualData_.valueFunctionTrajectory, nominalDualData_.spareValueFunctionTrajectory);
 
   // the last index of the partition is excluded, namely [first, last), so the value function approximation of the end point of the end
   // partition is filled manually.
@@ -527,29 +634,7 @@ scalar_t GaussNewtonDDP::solveSequentialRiccatiEquationsImpl(const ScalarFunctio
 
   // testing the numerical stability of the Riccati equations
   if (ddpSettings_.checkNumericalStability_) {
-    const int N = nominalPrimalData_.primalSolution.timeTrajectory_.size();
-    for (int k = N - 1; k >= 0; k--) {
-      // check size
-      auto errorDescription = checkSize(nominalPrimalData_.primalSolution.stateTrajectory_[k].size(), 0,
-                                        nominalDualData_.valueFunctionTrajectory[k], "ValueFunction");
-      if (!errorDescription.empty()) {
-        throw std::runtime_error(errorDescription);
-      }
-      // check PSD
-      errorDescription = checkBeingPSD(nominalDualData_.valueFunctionTrajectory[k], "ValueFunction");
-      if (!errorDescription.empty()) {
-        std::stringstream throwMsg;
-        throwMsg << "at time " << nominalPrimalData_.primalSolution.timeTrajectory_[k] << ":\n";
-        throwMsg << errorDescription << "The error takes place in the following segment of trajectory:\n";
-        for (int kp = k; kp < std::min(k + 10, N); kp++) {
-          throwMsg << ">>> time: " << nominalPrimalData_.primalSolution.timeTrajectory_[kp] << "\n";
-          throwMsg << "|| Sm ||:\t" << nominalDualData_.valueFunctionTrajectory[kp].dfdxx.norm() << "\n";
-          throwMsg << "|| Sv ||:\t" << nominalDualData_.valueFunctionTrajectory[kp].dfdx.transpose().norm() << "\n";
-          throwMsg << "   s    :\t" << nominalDualData_.valueFunctionTrajectory[kp].f << "\n";
-        }
-        throw std::runtime_error(throwMsg.str());
-      }
-    }  // end of k loop
+    checkValueFunctionNumericalStability();
   }
 
   // average time step
@@ -562,7 +647,7 @@ scalar_t GaussNewtonDDP::solveSequentialRiccatiEquationsImpl(const ScalarFunctio
 void GaussNewtonDDP::calculateController() {
   const size_t N = nominalPrimalData_.primalSolution.timeTrajectory_.size();
 
-  unoptimizedController_.clear();
+  // the arrays are resized rather than cleared so that the gains and biases reuse their memory
   unoptimizedController_.timeStamp_ = nominalPrimalData_.primalSolution.timeTrajectory_;
   unoptimizedController_.gainArray_.resize(N);
   unoptimizedController_.biasArray_.resize(N);
@@ -630,14 +715,14 @@ void GaussNewtonDDP::approximateOptimalControlProblem() {
    */
   // perform the LQ approximation for intermediate times
   approximateIntermediateLQ(nominalDualData_.dualSolution, nominalPrimalData_);
+  addShootingDefects();
 
   /*
    * compute and augment the LQ approximation of the event times.
    * also call shiftHessian on the event time's cost 2nd order derivative.
    */
   const size_t NE = nominalPrimalData_.primalSolution.postEventIndices_.size();
-  nominalPrimalData_.modelDataEventTimes.clear();
-  nominalPrimalData_.modelDataEventTimes.resize(NE);
+  resizeTrajectory(NE, nominalPrimalData_.modelDataEventTimes, nominalPrimalData_.spareModelDataEventTimes);
   if (NE > 0) {
     nextTimeIndex_ = 0;
     nextTaskId_ = 0;
@@ -729,6 +814,38 @@ void GaussNewtonDDP::computeProjectionAndRiccatiModification(const ModelData& mo
                                                  riccatiModification.deltaGm_);
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void GaussNewtonDDP::checkValueFunctionNumericalStability() const {
+  const int N = nominalPrimalData_.primalSolution.timeTrajectory_.size();
+  for (int k = N - 1; k >= 0; k--) {
+    if (!checkNumericalStabilityAt(k, nominalPrimalData_.primalSolution)) {
+      continue;
+    }
+    // check size
+    auto errorDescription = checkSize(nominalPrimalData_.primalSolution.stateTrajectory_[k].size(), 0,
+                                      nominalDualData_.valueFunctionTrajectory[k], "ValueFunction");
+    if (!errorDescription.empty()) {
+      throw std::runtime_error(errorDescription);
+    }
+    // check PSD
+    errorDescription = checkBeingPSD(nominalDualData_.valueFunctionTrajectory[k], "ValueFunction");
+    if (!errorDescription.empty()) {
+      std::stringstream throwMsg;
+      throwMsg << "at time " << nominalPrimalData_.primalSolution.timeTrajectory_[k] << ":\n";
+      throwMsg << errorDescription << "The error takes place in the following segment of trajectory:\n";
+      for (int kp = k; kp < std::min(k + 10, N); kp++) {
+        throwMsg << ">>> time: " << nominalPrimalData_.primalSolution.timeTrajectory_[kp] << "\n";
+        throwMsg << "|| Sm ||:\t" << nominalDualData_.valueFunctionTrajectory[kp].dfdxx.norm() << "\n";
+        throwMsg << "|| Sv ||:\t" << nominalDualData_.valueFunctionTrajectory[kp].dfdx.transpose().norm() << "\n";
+        throwMsg << "   s    :\t" << nominalDualData_.valueFunctionTrajectory[kp].f << "\n";
+      }
+      throw std::runtime_error(throwMsg.str());
+    }
+  }  // end of k loop
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -736,7 +853,15 @@ void GaussNewtonDDP::computeProjections(const matrix_t& Hm, const matrix_t& Dm,
                                         matrix_t& constraintNullProjector) const {
   // UUT decomposition of inv(Hm)
   matrix_t HmInvUmUmT;
-  LinearAlgebra::computeInverseMatrixUUT(Hm, HmInvUmUmT);
+  const bool isHmPositiveDefinite = LinearAlgebra::computeInverseMatrixUUT(Hm, HmInvUmUmT);
+  if (ddpSettings_.checkNumericalStability_ && !isHmPositiveDefinite) {
+    // the factorization may fail due to round-off, hence the failure is confirmed by the eigenvalues
+    const scalar_t minEigenvalue = LinearAlgebra::symmetricEigenvalues(Hm).minCoeff();
+    if (minEigenvalue <= 0.0) {
+      throw std::runtime_error("[GaussNewtonDDP::computeProjections] Hm is not positive definite. It's smallest eigenvalue is " +
+                               std::to_string(minEigenvalue) + ".");
+    }
+  }
 
   // compute DmDagger, DmDaggerTHmDmDaggerUUT, HmInverseConstrainedLowRank
   if (Dm.rows() == 0) {
@@ -783,16 +908,8 @@ void GaussNewtonDDP::projectLQ(const ModelData& modelData, const matrix_t& const
     projectedModelData.stateInputEqConstraint.dfdx.setZero(projectedModelData.inputDim, projectedModelData.stateDim);
     projectedModelData.stateInputEqConstraint.dfdu.setZero(modelData.inputDim, modelData.inputDim);
 
-    // dynamics
-    projectedModelData.dynamics = modelData.dynamics;
-    changeOfInputVariables(projectedModelData.dynamics, constraintNullProjector);
-
-    // dynamics bias
-    projectedModelData.dynamicsBias = modelData.dynamicsBias;
-
-    // cost
-    projectedModelData.cost = modelData.cost;
-    changeOfInputVariables(projectedModelData.cost, constraintNullProjector);
+    // dynamics, dynamics bias, and cost (Pu is the upper-triangular factor of the Cholesky decomposition of inv(Hm))
+    projectUnconstrainedLQ(modelData, constraintNullProjector, projectedModelData);
 
   } else {
     // Change of variables u = Pu * tilde{u} + Px * x + u0
@@ -810,8 +927,9 @@ void GaussNewtonDDP::projectLQ(const ModelData& modelData, const matrix_t& const
     const matrix_t Px = -projectedModelData.stateInputEqConstraint.dfdx;
     const matrix_t u0 = -projectedModelData.stateInputEqConstraint.f;
 
-    // dynamics
+    // dynamics (the state feedback of the constraint, Bm * Px, couples all states)
     projectedModelData.dynamics = modelData.dynamics;
+    projectedModelData.dynamicsStructure = DynamicsStructure();
     changeOfInputVariables(projectedModelData.dynamics, Pu, Px, u0);
 
     // dynamics bias
@@ -877,8 +995,8 @@ void GaussNewtonDDP::runInit() {
     constexpr size_t taskId = 0;
     constexpr scalar_t stepLength = 0.0;
 
-    // clear before starting to fill nominalPrimalData_
-    nominalPrimalData_.clear();
+    // clear before starting to fill nominalPrimalData_ (the model data nodes are kept for reuse)
+    nominalPrimalData_.recycle();
 
     // for non-StateTriggeredRollout initialize modeSchedule
     nominalPrimalData_.primalSolution.modeSchedule_ = this->getReferenceManager().getModeSchedule();
@@ -886,7 +1004,19 @@ void GaussNewtonDDP::runInit() {
     // copied to optimized data container manually at the beginning of runImpl
     nominalPrimalData_.primalSolution.controllerPtr_.swap(optimizedPrimalSolution_.controllerPtr_);
     // perform a rollout
-    rolloutInitialTrajectory(nominalPrimalData_.primalSolution);
+    if (canRolloutMultipleShooting()) {
+      // the shooting nodes are initialized from the previous solution
+      vector_array_t nodeStates{initState_};
+      nodeStates.reserve(shootingNodeTimes_.size());
+      for (size_t s = 1; s < shootingNodeTimes_.size(); s++) {
+        nodeStates.push_back(LinearInterpolation::interpolate(shootingNodeTimes_[s], optimizedPrimalSolution_.timeTrajectory_,
+                                                              optimizedPrimalSolution_.stateTrajectory_));
+      }
+      std::ignore = ocs2::rolloutTrajectory(threadPool_, dynamicsForwardRolloutRefStock_, shootingNodeTimes_, nodeStates, finalTime_,
+                                            nominalPrimalData_.primalSolution, nominalPrimalData_.shootingDefects);
+    } else {
+      rolloutInitialTrajectory(nominalPrimalData_.primalSolution);
+    }
 
     // adjust dual solution
     totalDualSolutionTimer_.startTimer();
@@ -900,7 +1030,7 @@ void GaussNewtonDDP::runInit() {
                                  nominalDualData_.dualSolution);
     totalDualSolutionTimer_.endTimer();
 
-    computeRolloutMetrics(optimalControlProblemStock_[taskId], nominalPrimalData_.primalSolution, nominalDualData_.dualSolution,
+    computeRolloutMetrics(threadPool_, optimalControlProblemRefStock_, nominalPrimalData_.primalSolution, nominalDualData_.dualSolution,
                           nominalPrimalData_.problemMetrics);
 
     // update dual
@@ -910,8 +1040,8 @@ void GaussNewtonDDP::runInit() {
     totalDualSolutionTimer_.endTimer();
 
     // calculates rollout merit
-    performanceIndex_ =
-        computeRolloutPerformanceIndex(nominalPrimalData_.primalSolution.timeTrajectory_, nominalPrimalData_.problemMetrics);
+    performanceIndex_ = computeRolloutPerformanceIndex(nominalPrimalData_.primalSolution.timeTrajectory_, nominalPrimalData_.problemMetrics,
+                                                       nominalPrimalData_.shootingDefects);
     performanceIndex_.merit = calculateRolloutMerit(performanceIndex_);
 
     // display
@@ -946,6 +1076,9 @@ void GaussNewtonDDP::runInit() {
   // calculate controller. Result is stored in an intermediate variable. The optimized controller, the one after searching, will be
   // swapped back to corresponding primalDataContainer in the search stage
   calculateController();
+  if (ddpSettings_.numShootingSegments_ > 1) {
+    computeShootingNodeIncrements();
+  }
   computeControllerTimer_.endTimer();
 
   // display
@@ -976,7 +1109,7 @@ void GaussNewtonDDP::runIteration(scalar_t lqModelExpectedCost) {
   scalar_t avgTimeStep;
   const auto& modeSchedule = this->getReferenceManager().getModeSchedule();
   search_strategy::SolutionRef solution(avgTimeStep, nominalDualData_.dualSolution, nominalPrimalData_.primalSolution,
-                                        nominalPrimalData_.problemMetrics, performanceIndex_);
+                                        nominalPrimalData_.problemMetrics, performanceIndex_, nominalPrimalData_.shootingDefects);
   const bool success = searchStrategyPtr_->run({initTime_, finalTime_}, initState_, lqModelExpectedCost, unoptimizedController_,
                                                cachedDualData_.dualSolution, modeSchedule, solution);
 
@@ -994,9 +1127,10 @@ void GaussNewtonDDP::runIteration(scalar_t lqModelExpectedCost) {
 
   // update dual
   totalDualSolutionTimer_.startTimer();
-  ocs2::updateDualSolution(optimalControlProblemStock_[0], nominalPrimalData_.primalSolution, nominalPrimalData_.problemMetrics,
-                           nominalDualData_.dualSolution);
-  performanceIndex_ = computeRolloutPerformanceIndex(nominalPrimalData_.primalSolution.timeTrajectory_, nominalPrimalData_.problemMetrics);
+  ocs2::updateDualSolution(threadPool_, optimalControlProblemRefStock_, nominalPrimalData_.primalSolution,
+                           nominalPrimalData_.problemMetrics, nominalDualData_.dualSolution);
+  performanceIndex_ = computeRolloutPerformanceIndex(nominalPrimalData_.primalSolution.timeTrajectory_, nominalPrimalData_.problemMetrics,
+                                                     nominalPrimalData_.shootingDefects);
   performanceIndex_.merit = calculateRolloutMerit(performanceIndex_);
   totalDualSolutionTimer_.endTimer();
 
@@ -1018,6 +1152,9 @@ void GaussNewtonDDP::runIteration(scalar_t lqModelExpectedCost) {
   // calculate controller. Result is stored in an intermediate variable. The optimized controller, the one after searching, will be
   // swapped back to corresponding primalDataContainer in the search stage
   calculateController();
+  if (ddpSettings_.numShootingSegments_ > 1) {
+    computeShootingNodeIncrements();
+  }
   computeControllerTimer_.endTimer();
 
   // display
@@ -1030,6 +1167,35 @@ void GaussNewtonDDP::runIteration(scalar_t lqModelExpectedCost) {
   Eigen::setNbThreads(0);
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void GaussNewtonDDP::runImpl(scalar_t initTime, const vector_t& initState, scalar_t finalTime, const PrimalSolution& primalSolution) {
+  if (primalSolution.controllerPtr_ == nullptr) {
+    std::cerr << "[GaussNewtonDDP] DDP cannot be warm started without a controller in the primal solution. Will revert to a cold start.\n";
+    runImpl(initTime, initState, finalTime, static_cast<const ControllerBase*>(nullptr));
+    return;
+  }
+
+  // the controller is adjusted to the current mode schedule from the one of the primal solution
+  optimizedPrimalSolution_.modeSchedule_ = primalSolution.modeSchedule_;
+
+  // A feedforward policy (e.g., a DDP solution without the feedback policy) is warm started as a linear policy with zero gains.
+  const auto* feedforwardControllerPtr = dynamic_cast<const FeedforwardController*>(primalSolution.controllerPtr_.get());
+  if (feedforwardControllerPtr != nullptr) {
+    const auto& uffArray = feedforwardControllerPtr->uffArray_;
+    matrix_array_t gainArray;
+    gainArray.reserve(uffArray.size());
+    for (const auto& uff : uffArray) {
+      gainArray.emplace_back(matrix_t::Zero(uff.size(), initState.size()));
+    }
+    const LinearController linearController(feedforwardControllerPtr->timeStamp_, uffArray, std::move(gainArray));
+    runImpl(initTime, initState, finalTime, &linearController);
+  } else {
+    runImpl(initTime, initState, finalTime, primalSolution.controllerPtr_.get());
+  }
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -1044,7 +1210,7 @@ void GaussNewtonDDP::runImpl(scalar_t initTime, const vector_t& initState, scala
     if (linearControllerPtr == nullptr) {
       throw std::runtime_error("[GaussNewtonDDP::run] controller must be a LinearController type!");
     }
-    *optimizedPrimalSolution_.controllerPtr_ = *linearControllerPtr;
+    optimizedPrimalSolution_.controllerPtr_.reset(linearControllerPtr->clone());
   }
 
   runImpl(initTime, initState, finalTime);
@@ -1083,6 +1249,12 @@ void GaussNewtonDDP::runImpl(scalar_t initTime, const vector_t& initState, scala
     optimalControlProblemStock_[i].targetTrajectoriesPtr = &targetTrajectories;
   }
 
+  // the shooting nodes of the multiple-shooting forward pass
+  if (ddpSettings_.numShootingSegments_ > 1) {
+    shootingNodeTimes_ = computeShootingNodeTimes(initTime_, finalTime_, ddpSettings_.numShootingSegments_,
+                                                  this->getReferenceManager().getModeSchedule().eventTimes);
+  }
+
   // display
   if (ddpSettings_.displayInfo_) {
     std::cerr << "\n###################";
@@ -1098,10 +1270,16 @@ void GaussNewtonDDP::runImpl(scalar_t initTime, const vector_t& initState, scala
 
   // convergence variables of the main loop
   bool isConverged = false;
+  bool isTimeBudgetExhausted = false;
   std::string convergenceInfo;
 
+  // the duration of the iterations is used to predict whether another iteration fits in the time budget
+  benchmark::RepeatedTimer iterationTimer;
+
   // DDP main loop
-  while (!isConverged && (totalNumIterations_ - initIteration) < ddpSettings_.maxNumIterations_) {
+  while (!isConverged && !isTimeBudgetExhausted && (totalNumIterations_ - initIteration) < ddpSettings_.maxNumIterations_) {
+    iterationTimer.startTimer();
+
     // display the iteration's input update norm (before caching the old nominals)
     if (ddpSettings_.displayInfo_) {
       std::cerr << "\n###################";
@@ -1128,8 +1306,16 @@ void GaussNewtonDDP::runImpl(scalar_t initTime, const vector_t& initState, scala
     std::tie(isConverged, convergenceInfo) =
         searchStrategyPtr_->checkConvergence(unreliableControllerIncrement, performanceIndexHistory_.back(), performanceIndex_);
     unreliableControllerIncrement = false;
+
+    // stop if another iteration is not expected to fit in the time budget
+    iterationTimer.endTimer();
+    isTimeBudgetExhausted = !getDeadline().canFit(iterationTimer.getMaxIntervalInMilliseconds());
   }  // end of while loop
 
+  if (!isConverged && isTimeBudgetExhausted) {
+    reportTimeBudgetTermination();
+  }
+
   // display the final iteration's input update norm (before caching the old nominals)
   if (ddpSettings_.displayInfo_) {
     std::cerr << "\n###################";
@@ -1148,7 +1334,7 @@ void GaussNewtonDDP::runImpl(scalar_t initTime, const vector_t& initState, scala
   const auto& modeSchedule = this->getReferenceManager().getModeSchedule();
   const auto lqModelExpectedCost = nominalDualData_.valueFunctionTrajectory.front().f;
   search_strategy::SolutionRef solution(avgTimeStep, optimizedDualSolution_, optimizedPrimalSolution_, optimizedProblemMetrics_,
-                                        performanceIndex_);
+                                        performanceIndex_, optimizedShootingDefects_);
   const bool success = searchStrategyPtr_->run({initTime_, finalTime_}, initState_, lqModelExpectedCost, unoptimizedController_,
                                                nominalDualData_.dualSolution, modeSchedule, solution);
 
@@ -1160,6 +1346,7 @@ void GaussNewtonDDP::runImpl(scalar_t initTime, const vector_t& initState, scala
     optimizedDualSolution_ = nominalDualData_.dualSolution;
     optimizedPrimalSolution_ = nominalPrimalData_.primalSolution;
     optimizedProblemMetrics_ = nominalPrimalData_.problemMetrics;
+    optimizedShootingDefects_ = nominalPrimalData_.shootingDefects;
     performanceIndex_ = performanceIndexHistory_.back();
   }
 
@@ -1167,8 +1354,10 @@ void GaussNewtonDDP::runImpl(scalar_t initTime, const vector_t& initState, scala
 
   // update dual
   totalDualSolutionTimer_.startTimer();
-  ocs2::updateDualSolution(optimalControlProblemStock_[0], optimizedPrimalSolution_, optimizedProblemMetrics_, optimizedDualSolution_);
-  performanceIndex_ = computeRolloutPerformanceIndex(optimizedPrimalSolution_.timeTrajectory_, optimizedProblemMetrics_);
+  ocs2::updateDualSolution(threadPool_, optimalControlProblemRefStock_, optimizedPrimalSolution_, optimizedProblemMetrics_,
+                           optimizedDualSolution_);
+  performanceIndex_ = computeRolloutPerformanceIndex(optimizedPrimalSolution_.timeTrajectory_, optimizedProblemMetrics_,
+                                                     optimizedShootingDefects_);
   performanceIndex_.merit = calculateRolloutMerit(performanceIndex_);
   totalDualSolutionTimer_.endTimer();
 
@@ -1186,6 +1375,9 @@ void GaussNewtonDDP::runImpl(scalar_t initTime, const vector_t& initState, scala
 
     if (isConverged) {
       std::cerr << convergenceInfo << std::endl;
+    } else if (isTimeBudgetExhausted) {
+      std::cerr << "The algorithm has terminated as: \n";
+      std::cerr << "    * The time budget (i.e., " << getTimeBudget() << " [s]) does not allow another iteration." << std::endl;
     } else if (totalNumIterations_ - initIteration == ddpSettings_.maxNumIterations_) {
       std::cerr << "The algorithm has terminated as: \n";
       std::cerr << "    * The maximum number of iterations (i.e., " << ddpSettings_.maxNumIterations_ << ") has reached." << std::endl;
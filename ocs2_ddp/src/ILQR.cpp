@@ -70,6 +70,17 @@ ILQR::ILQR(ddp::Settings ddpSettings, const RolloutBase& rollout, const OptimalC
     riccatiEquationsPtrStock_.back()->setRiskSensitiveCoefficient(settings().riskSensitiveCoeff_);
   }  // end of i loop
 
+  if (settings().useRiccatiScan_ &&
+      (settings().strategy_ != search_strategy::Type::LINE_SEARCH || !numerics::almost_eq(settings().riskSensitiveCoeff_, 0.0))) {
+    throw std::runtime_error(
+        "[ILQR] The Riccati scan (ddp::Settings::useRiccatiScan_) is only supported by the risk-neutral line-search strategy!");
+  }
+  if (settings().useRiccatiScan_ && settings().lineSearch_.hessianCorrectionStrategy != hessian_correction::Strategy::DIAGONAL_SHIFT) {
+    throw std::runtime_error("[ILQR] The Riccati scan (ddp::Settings::useRiccatiScan_) does not support the Hessian correction strategy " +
+                             hessian_correction::toString(settings().lineSearch_.hessianCorrectionStrategy) +
+                             "! Use DIAGONAL_SHIFT instead.");
+  }
+
   Eigen::initParallel();
 }
 
@@ -85,8 +96,7 @@ void ILQR::approximateIntermediateLQ(const DualSolution& dualSolution, PrimalDat
   const auto& multiplierTrajectory = dualSolution.intermediates;
   auto& modelDataTrajectory = primalData.modelDataTrajectory;
 
-  modelDataTrajectory.clear();
-  modelDataTrajectory.resize(timeTrajectory.size());
+  resizeTrajectory(timeTrajectory.size(), modelDataTrajectory, primalData.spareModelDataTrajectory);
 
   nextTimeIndex_ = 0;
   nextTaskId_ = 0;
@@ -103,7 +113,7 @@ void ILQR::approximateIntermediateLQ(const DualSolution& dualSolution, PrimalDat
                                       inputTrajectory[timeIndex], multiplierTrajectory[timeIndex], continuousTimeModelData);
 
       // checking the numerical properties
-      if (settings().checkNumericalStability_) {
+      if (checkNumericalStabilityAt(timeIndex, primalData.primalSolution)) {
         const auto errSize = checkSize(continuousTimeModelData, stateTrajectory[timeIndex].rows(), inputTrajectory[timeIndex].rows());
         if (!errSize.empty()) {
           throw std::runtime_error("[ILQR::approximateIntermediateLQ] Mismatch in dimensions at intermediate time: " +
@@ -144,6 +154,8 @@ void ILQR::discreteLQWorker(SystemDynamicsBase& system, scalar_t time, const vec
   modelData.dynamicsBias.setZero(modelData.stateDim);
   modelData.dynamics = sensitivityDiscretizer_(system, time, state, input, timeStep);
   modelData.dynamics.f.setZero(modelData.stateDim);
+  // the sensitivity discretization preserves the block-triangular structure of the continuous-time Jacobian
+  modelData.dynamicsStructure = continuousTimeModelData.dynamicsStructure;
 
   // quadratic approximation to the cost function
   modelData.cost = continuousTimeModelData.cost;
@@ -167,17 +179,19 @@ void ILQR::calculateControllerWorker(size_t timeIndex, const PrimalDataContainer
   const auto& EvProjected = dualData.projectedModelDataTrajectory[timeIndex].stateInputEqConstraint.f;
   const auto& CmProjected = dualData.projectedModelDataTrajectory[timeIndex].stateInputEqConstraint.dfdx;
 
-  const auto& Qu = dualData.riccatiModificationTrajectory[timeIndex].constraintNullProjector_;
+  const auto& riccatiModification = dualData.riccatiModificationTrajectory[timeIndex];
 
   // feedback gains
   dstController.gainArray_[timeIndex] = -CmProjected;
-  dstController.gainArray_[timeIndex].noalias() += Qu * projectedKmTrajectoryStock_[timeIndex];
+  riccati_modification::addNullProjectorProduct(riccatiModification, projectedKmTrajectoryStock_[timeIndex],
+                                                dstController.gainArray_[timeIndex]);
 
   // bias input
   dstController.biasArray_[timeIndex] = nominalInput;
   dstController.biasArray_[timeIndex].noalias() -= dstController.gainArray_[timeIndex] * nominalState;
   dstController.deltaBiasArray_[timeIndex] = -EvProjected;
-  dstController.deltaBiasArray_[timeIndex].noalias() += Qu * projectedLvTrajectoryStock_[timeIndex];
+  riccati_modification::addNullProjectorProduct(riccatiModification, projectedLvTrajectoryStock_[timeIndex],
+                                                dstController.deltaBiasArray_[timeIndex]);
 }
 
 /******************************************************************************************************/
@@ -188,8 +202,8 @@ scalar_t ILQR::solveSequentialRiccatiEquations(const ScalarFunctionQuadraticAppr
   projectedLvTrajectoryStock_.resize(N);
   projectedKmTrajectoryStock_.resize(N);
 
-  nominalDualData_.riccatiModificationTrajectory.resize(N);
-  nominalDualData_.projectedModelDataTrajectory.resize(N);
+  resizeTrajectory(N, nominalDualData_.riccatiModificationTrajectory, nominalDualData_.spareRiccatiModificationTrajectory);
+  resizeTrajectory(N, nominalDualData_.projectedModelDataTrajectory, nominalDualData_.spareProjectedModelDataTrajectory);
 
   const auto& finalModelData = nominalPrimalData_.modelDataTrajectory.back();
   auto& finalRiccatiModification = nominalDualData_.riccatiModificationTrajectory.back();
@@ -208,7 +222,120 @@ scalar_t ILQR::solveSequentialRiccatiEquations(const ScalarFunctionQuadraticAppr
   finalProjectedKmFinal = -finalProjectedModelData.cost.dfdux - finalRiccatiModification.deltaGm_;
   finalProjectedKmFinal.noalias() -= finalProjectedModelData.dynamics.dfdu.transpose() * finalValueFunction.dfdxx;
 
-  return solveSequentialRiccatiEquationsImpl(finalValueFunction);
+  if (settings().useRiccatiScan_) {
+    return solveRiccatiEquationsByScan(finalValueFunction);
+  } else {
+    return solveSequentialRiccatiEquationsImpl(finalValueFunction);
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+scalar_t ILQR::solveRiccatiEquationsByScan(const ScalarFunctionQuadraticApproximation& finalValueFunction) {
+  const auto& postEventIndices = nominalPrimalData_.primalSolution.postEventIndices_;
+  const auto& modelDataTrajectory = nominalPrimalData_.modelDataTrajectory;
+  const size_t N = nominalPrimalData_.primalSolution.timeTrajectory_.size();
+
+  auto& valueFunctionTrajectory = nominalDualData_.valueFunctionTrajectory;
+  resizeTrajectory(N, valueFunctionTrajectory, nominalDualData_.spareValueFunctionTrajectory);
+  valueFunctionTrajectory.back() = finalValueFunction;
+
+  // the index of the event which follows each time step, or -1
+  std::vector<int> eventIndices(N, -1);
+  for (size_t i = 0; i < postEventIndices.size(); i++) {
+    if (postEventIndices[i] > 0 && postEventIndices[i] + 1 < N) {
+      eventIndices[postEventIndices[i] - 1] = i;
+    }
+  }
+
+  // the scan elements of all time steps
+  std::vector<riccati_scan::Element> elements(N);
+  elements.back() = riccati_scan::createFinalElement(finalValueFunction.dfdxx, finalValueFunction.dfdx);
+
+  nextTimeIndex_ = 0;
+  auto elementTask = [&]() {
+    ModelData projectedModelData;
+    riccati_modification::Data riccatiModification;
+
+    size_t timeIndex;
+    while ((timeIndex = nextTimeIndex_++) + 1 < N) {
+      if (eventIndices[timeIndex] >= 0) {
+        elements[timeIndex] = riccati_scan::createEventElement(nominalPrimalData_.modelDataEventTimes[eventIndices[timeIndex]]);
+      } else {
+        // the projected LQ problem does not depend on the Hessian which is used for the projection
+        const auto& modelData = modelDataTrajectory[timeIndex];
+        const matrix_t SmZero = matrix_t::Zero(modelData.stateDim, modelData.stateDim);
+        computeProjectionAndRiccatiModification(modelData, SmZero, projectedModelData, riccatiModification);
+        elements[timeIndex] = riccati_scan::createIntermediateElement(projectedModelData, riccatiModification.deltaQm_);
+      }
+    }
+  };
+  runParallel(elementTask, settings().nThreads_);
+
+  // the Hessian and the gradient of the value function
+  riccati_scan::suffixScan(threadPool(), settings().nThreads_, elements);
+
+  // the controller terms and the value function increments
+  scalar_array_t deltaValues(N, 0.0);
+  nextTimeIndex_ = 0;
+  nextTaskId_ = 0;
+  auto controllerTask = [&]() {
+    const size_t taskId = nextTaskId_++;  // assign task ID (atomic)
+    matrix_t SmTemp;
+    vector_t SvTemp;
+
+    size_t timeIndex;
+    while ((timeIndex = nextTimeIndex_++) + 1 < N) {
+      auto& projectedLv = projectedLvTrajectoryStock_[timeIndex];
+      auto& projectedKm = projectedKmTrajectoryStock_[timeIndex];
+      auto& projectedModelData = nominalDualData_.projectedModelDataTrajectory[timeIndex];
+      auto& riccatiModification = nominalDualData_.riccatiModificationTrajectory[timeIndex];
+      const auto& modelData = modelDataTrajectory[timeIndex];
+      const auto& SmNext = elements[timeIndex + 1].J;
+      const auto& SvNext = elements[timeIndex + 1].eta;
+
+      auto& valueFunction = valueFunctionTrajectory[timeIndex];
+      valueFunction.dfdxx = elements[timeIndex].J;
+      valueFunction.dfdx = elements[timeIndex].eta;
+
+      if (eventIndices[timeIndex] >= 0) {
+        const auto& jumpModelData = nominalPrimalData_.modelDataEventTimes[eventIndices[timeIndex]];
+        deltaValues[timeIndex] = std::get<2>(riccatiTransversalityConditions(jumpModelData, SmNext, SvNext, 0.0));
+
+        // the pre-event time step is treated as a final time step
+        const matrix_t SmDummy = matrix_t::Zero(modelData.stateDim, modelData.stateDim);
+        computeProjectionAndRiccatiModification(modelData, SmDummy, projectedModelData, riccatiModification);
+
+        // projected feedforward
+        projectedLv = -projectedModelData.cost.dfdu - riccatiModification.deltaGv_;
+        projectedLv.noalias() -= projectedModelData.dynamics.dfdu.transpose() * valueFunction.dfdx;
+
+        // projected feedback
+        projectedKm = -projectedModelData.cost.dfdux - riccatiModification.deltaGm_;
+        projectedKm.noalias() -= projectedModelData.dynamics.dfdu.transpose() * valueFunction.dfdxx;
+
+      } else {
+        computeProjectionAndRiccatiModification(modelData, SmNext, projectedModelData, riccatiModification);
+        riccatiEquationsPtrStock_[taskId]->computeMap(projectedModelData, riccatiModification, SmNext, SvNext, 0.0, projectedKm,
+                                                      projectedLv, SmTemp, SvTemp, deltaValues[timeIndex]);
+      }
+    }
+  };
+  runParallel(controllerTask, settings().nThreads_);
+
+  // the constant term of the value function
+  for (int k = N - 2; k >= 0; k--) {
+    valueFunctionTrajectory[k].f = valueFunctionTrajectory[k + 1].f + deltaValues[k];
+  }
+
+  // testing the numerical stability of the Riccati equations
+  if (settings().checkNumericalStability_) {
+    checkValueFunctionNumericalStability();
+  }
+
+  // average time step
+  return (finalTime_ - initTime_) / static_cast<scalar_t>(N);
 }
 
 /******************************************************************************************************/
@@ -221,6 +348,28 @@ matrix_t ILQR::computeHamiltonianHessian(const ModelData& modelData, const matri
   return searchStrategyPtr_->augmentHamiltonianHessian(modelData, Hm);
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void ILQR::addShootingDefect(size_t timeIndex, const vector_t& defect, ModelData& modelData) const {
+  // the discrete-time transition to the shooting node directly includes the defect
+  modelData.dynamicsBias += defect;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+vector_t ILQR::propagateStateIncrement(size_t timeIndex, const vector_t& deltaState) const {
+  const auto& modelData = nominalPrimalData_.modelDataTrajectory[timeIndex];
+  vector_t deltaInput = unoptimizedController_.deltaBiasArray_[timeIndex];
+  deltaInput.noalias() += unoptimizedController_.gainArray_[timeIndex] * deltaState;
+
+  vector_t nextDeltaState = modelData.dynamicsBias;
+  nextDeltaState.noalias() += modelData.dynamics.dfdx * deltaState;
+  nextDeltaState.noalias() += modelData.dynamics.dfdu * deltaInput;
+  return nextDeltaState;
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
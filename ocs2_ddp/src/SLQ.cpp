@@ -84,8 +84,7 @@ void SLQ::approximateIntermediateLQ(const DualSolution& dualSolution, PrimalData
   const auto& multiplierTrajectory = dualSolution.intermediates;
   auto& modelDataTrajectory = primalData.modelDataTrajectory;
 
-  modelDataTrajectory.clear();
-  modelDataTrajectory.resize(timeTrajectory.size());
+  resizeTrajectory(timeTrajectory.size(), modelDataTrajectory, primalData.spareModelDataTrajectory);
 
   nextTimeIndex_ = 0;
   nextTaskId_ = 0;
@@ -100,7 +99,7 @@ void SLQ::approximateIntermediateLQ(const DualSolution& dualSolution, PrimalData
                                       inputTrajectory[timeIndex], multiplierTrajectory[timeIndex], modelDataTrajectory[timeIndex]);
 
       // checking the numerical properties
-      if (settings().checkNumericalStability_) {
+      if (checkNumericalStabilityAt(timeIndex, primalData.primalSolution)) {
         const auto errSize =
             checkSize(modelDataTrajectory[timeIndex], stateTrajectory[timeIndex].rows(), inputTrajectory[timeIndex].rows());
         if (!errSize.empty()) {
@@ -143,11 +142,11 @@ void SLQ::calculateControllerWorker(size_t timeIndex, const PrimalDataContainer&
   // CmProjected
   const matrix_t& CmProjected = dualData.projectedModelDataTrajectory[timeIndex].stateInputEqConstraint.dfdx;
   // projector
-  const matrix_t& Qu = dualData.riccatiModificationTrajectory[timeIndex].constraintNullProjector_;
+  const auto& riccatiModification = dualData.riccatiModificationTrajectory[timeIndex];
   // deltaGm, projected feedback
-  matrix_t projectedKm = dualData.riccatiModificationTrajectory[timeIndex].deltaGm_;
+  matrix_t projectedKm = riccatiModification.deltaGm_;
   // deltaGv, projected feedforward
-  vector_t projectedLv = dualData.riccatiModificationTrajectory[timeIndex].deltaGv_;
+  vector_t projectedLv = riccatiModification.deltaGv_;
 
   // projectedKm = projectedPm + projectedBm^t * Sm
   projectedKm = -(projectedKm + projectedPm);
@@ -159,13 +158,13 @@ void SLQ::calculateControllerWorker(size_t timeIndex, const PrimalDataContainer&
 
   // feedback gains
   dstController.gainArray_[timeIndex] = -CmProjected;
-  dstController.gainArray_[timeIndex].noalias() += Qu * projectedKm;
+  riccati_modification::addNullProjectorProduct(riccatiModification, projectedKm, dstController.gainArray_[timeIndex]);
 
   // bias input
   dstController.biasArray_[timeIndex] = nominalInput;
   dstController.biasArray_[timeIndex].noalias() -= dstController.gainArray_[timeIndex] * nominalState;
   dstController.deltaBiasArray_[timeIndex] = -EvProjected;
-  dstController.deltaBiasArray_[timeIndex].noalias() += Qu * projectedLv;
+  riccati_modification::addNullProjectorProduct(riccatiModification, projectedLv, dstController.deltaBiasArray_[timeIndex]);
 }
 
 /******************************************************************************************************/
@@ -176,8 +175,8 @@ scalar_t SLQ::solveSequentialRiccatiEquations(const ScalarFunctionQuadraticAppro
   // number of the intermediate LQ variables
   const size_t N = nominalPrimalData_.primalSolution.timeTrajectory_.size();
 
-  nominalDualData_.riccatiModificationTrajectory.resize(N);
-  nominalDualData_.projectedModelDataTrajectory.resize(N);
+  resizeTrajectory(N, nominalDualData_.riccatiModificationTrajectory, nominalDualData_.spareRiccatiModificationTrajectory);
+  resizeTrajectory(N, nominalDualData_.projectedModelDataTrajectory, nominalDualData_.spareProjectedModelDataTrajectory);
 
   if (N > 0) {
     // perform the computeRiccatiModificationTerms for partition i
@@ -207,6 +206,41 @@ matrix_t SLQ::computeHamiltonianHessian(const ModelData& modelData, const matrix
   return searchStrategyPtr_->augmentHamiltonianHessian(modelData, modelData.cost.dfduu);
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void SLQ::addShootingDefect(size_t timeIndex, const vector_t& defect, ModelData& modelData) const {
+  // The Riccati equations interpolate the dynamics bias linearly between the time stamps. Therefore, the bias at timeIndex acts on
+  // both of its neighboring intervals and it is scaled such that its integral over time equals the defect.
+  const auto& timeTrajectory = nominalPrimalData_.primalSolution.timeTrajectory_;
+  const scalar_t previousTime = (timeIndex > 0) ? timeTrajectory[timeIndex - 1] : timeTrajectory[timeIndex];
+  const scalar_t biasIntegralWeight = 0.5 * (timeTrajectory[timeIndex + 1] - previousTime);
+  modelData.dynamicsBias += defect / biasIntegralWeight;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+vector_t SLQ::propagateStateIncrement(size_t timeIndex, const vector_t& deltaState) const {
+  const auto& timeTrajectory = nominalPrimalData_.primalSolution.timeTrajectory_;
+  const auto& modelData = nominalPrimalData_.modelDataTrajectory[timeIndex];
+  const auto& nextModelData = nominalPrimalData_.modelDataTrajectory[timeIndex + 1];
+  const auto& gain = unoptimizedController_.gainArray_[timeIndex];
+  const auto& deltaBias = unoptimizedController_.deltaBiasArray_[timeIndex];
+  const scalar_t timeStep = timeTrajectory[timeIndex + 1] - timeTrajectory[timeIndex];
+
+  // The closed-loop dynamics is stiff for the large time steps of the adaptive rollout. Therefore, it is integrated by the implicit
+  // Euler method while the bias is integrated by the trapezoidal rule, consistent with its linear interpolation in the Riccati equations.
+  matrix_t closedLoopDynamics = modelData.dynamics.dfdx;
+  closedLoopDynamics.noalias() += modelData.dynamics.dfdu * gain;
+  const matrix_t implicitEulerMatrix = matrix_t::Identity(deltaState.size(), deltaState.size()) - timeStep * closedLoopDynamics;
+
+  vector_t rhs = deltaState;
+  rhs.noalias() += timeStep * (modelData.dynamics.dfdu * deltaBias);
+  rhs += (0.5 * timeStep) * (modelData.dynamicsBias + nextModelData.dynamicsBias);
+  return implicitEulerMatrix.partialPivLu().solve(rhs);
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -215,8 +215,8 @@ void ContinuousTimeRiccatiEquations::computeFlowMapSLQ(std::pair<int, scalar_t>
   creCache.projectedLv_ = -(creCache.projectedGv_ + creCache.projectedLv_);
 
   // precomputation
-  // [COMPLEXITY: nx^3 + nx^2 * np]
-  creCache.SmTrans_projectedAm_.noalias() = Sm.transpose() * creCache.projectedAm_;
+  // [COMPLEXITY: nx^3 + nx^2 * np] (Sm is symmetric and the known blocks of Am are skipped)
+  multiplyStateJacobian(Sm, creCache.projectedAm_, interpolateDynamicsStructure(indexAlpha), creCache.SmTrans_projectedAm_);
   creCache.projectedKm_T_projectedGm_.noalias() = creCache.projectedKm_.transpose() * creCache.projectedGm_;
   if (!reducedFormRiccati_) {
     // Rm
@@ -291,6 +291,20 @@ void ContinuousTimeRiccatiEquations::computeFlowMapSLQ(std::pair<int, scalar_t>
   }
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+DynamicsStructure ContinuousTimeRiccatiEquations::interpolateDynamicsStructure(std::pair<int, scalar_t> indexAlpha) const {
+  const auto& structure = (*projectedModelDataPtr_)[indexAlpha.first].dynamicsStructure;
+  // the structure is kept only if both ends of the interpolation interval share it
+  const bool isLastIndex = indexAlpha.first + 1 >= static_cast<int>(projectedModelDataPtr_->size());
+  if (isLastIndex || structure == (*projectedModelDataPtr_)[indexAlpha.first + 1].dynamicsStructure) {
+    return structure;
+  } else {
+    return DynamicsStructure();
+  }
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -69,7 +69,7 @@ void DiscreteTimeRiccatiEquations::computeMapILQR(const ModelData& projectedMode
                                                   scalar_t& s) const {
   // precomputation (1)
   dreCache.Sm_projectedHv_.noalias() = SmNext * projectedModelData.dynamicsBias;
-  dreCache.Sm_projectedAm_.noalias() = SmNext * projectedModelData.dynamics.dfdx;
+  multiplyStateJacobian(SmNext, projectedModelData.dynamics.dfdx, projectedModelData.dynamicsStructure, dreCache.Sm_projectedAm_);
   dreCache.Sm_projectedBm_.noalias() = SmNext * projectedModelData.dynamics.dfdu;
   dreCache.Sv_plus_Sm_projectedHv_ = SvNext + dreCache.Sm_projectedHv_;
 
@@ -103,7 +103,9 @@ void DiscreteTimeRiccatiEquations::computeMapILQR(const ModelData& projectedMode
   // = Qm + deltaQm
   Sm = projectedModelData.cost.dfdxx + riccatiModification.deltaQm_;
   // += Am^T * Sm * Am
-  Sm.noalias() += dreCache.Sm_projectedAm_.transpose() * projectedModelData.dynamics.dfdx;
+  multiplyStateJacobianTranspose(projectedModelData.dynamics.dfdx, dreCache.Sm_projectedAm_, projectedModelData.dynamicsStructure,
+                                 dreCache.projectedAm_T_Sm_projectedAm_);
+  Sm += dreCache.projectedAm_T_Sm_projectedAm_;
   if (reducedFormRiccati_) {
     // += Km^T * Gm + Gm^T * Km
     Sm += dreCache.projectedKm_T_projectedGm_;
@@ -0,0 +1,185 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include "ocs2_ddp/riccati_equations/DiscreteTimeRiccatiScan.h"
+
+#include <algorithm>
+#include <atomic>
+#include <stdexcept>
+
+namespace ocs2 {
+namespace riccati_scan {
+
+namespace {
+/** Runs function(index) for all indices in [0, numIndices) on nThreads parallel tasks. */
+template <typename Function>
+void parallelFor(ThreadPool& threadPool, size_t nThreads, size_t numIndices, Function function) {
+  std::atomic_size_t nextIndex{0};
+  auto task = [&](int) {
+    size_t index;
+    while ((index = nextIndex++) < numIndices) {
+      function(index);
+    }
+  };
+  threadPool.runParallel(task, std::max<size_t>(std::min(nThreads, numIndices), 1));
+}
+}  // unnamed namespace
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+Element createIntermediateElement(const ModelData& projectedModelData, const matrix_t& deltaQm) {
+  const auto& Am = projectedModelData.dynamics.dfdx;
+  const auto& Bm = projectedModelData.dynamics.dfdu;
+  const auto& Pm = projectedModelData.cost.dfdux;
+  const auto& Rv = projectedModelData.cost.dfdu;
+
+  // the input is eliminated by the change of variable u = v - inv(Rm) * (Pm * x + Rv)
+  const Eigen::LLT<matrix_t> RmLlt(projectedModelData.cost.dfduu);
+  if (RmLlt.info() != Eigen::Success) {
+    throw std::runtime_error("[riccati_scan::createIntermediateElement] The input cost Hessian is not positive definite!");
+  }
+  const matrix_t RmInvPm = RmLlt.solve(Pm);
+  const vector_t RmInvRv = RmLlt.solve(Rv);
+  const matrix_t RmInvBmT = RmLlt.solve(Bm.transpose());
+
+  Element element;
+  element.A = Am;
+  element.A.noalias() -= Bm * RmInvPm;
+  element.b = projectedModelData.dynamicsBias;
+  element.b.noalias() -= Bm * RmInvRv;
+  element.C.noalias() = Bm * RmInvBmT;
+  element.eta = projectedModelData.cost.dfdx;
+  element.eta.noalias() -= Pm.transpose() * RmInvRv;
+  element.J = projectedModelData.cost.dfdxx + deltaQm;
+  element.J.noalias() -= Pm.transpose() * RmInvPm;
+  return element;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+Element createEventElement(const ModelData& jumpModelData) {
+  const auto postEventStateDim = jumpModelData.dynamics.dfdx.rows();
+
+  Element element;
+  element.A = jumpModelData.dynamics.dfdx;
+  element.b = jumpModelData.dynamicsBias;
+  element.C.setZero(postEventStateDim, postEventStateDim);
+  element.eta = jumpModelData.cost.dfdx;
+  element.J = jumpModelData.cost.dfdxx;
+  return element;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+Element createFinalElement(const matrix_t& Sm, const vector_t& Sv) {
+  // there is no state after the final time, hence the end state has zero dimension
+  Element element;
+  element.A.setZero(0, Sm.rows());
+  element.b.setZero(0);
+  element.C.setZero(0, 0);
+  element.eta = Sv;
+  element.J = Sm;
+  return element;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void combine(const Element& first, const Element& second, Element& result) {
+  // M = I + C1 * J2
+  matrix_t M = matrix_t::Identity(second.J.rows(), second.J.cols());
+  M.noalias() += first.C * second.J;
+  const Eigen::PartialPivLU<matrix_t> MLu(M);
+
+  const matrix_t MInvA1 = MLu.solve(first.A);
+  const matrix_t MInvC1 = MLu.solve(first.C);
+  vector_t b1_minus_C1Eta2 = first.b;
+  b1_minus_C1Eta2.noalias() -= first.C * second.eta;
+  const vector_t MInvB = MLu.solve(b1_minus_C1Eta2);
+
+  // inv(I + J2 * C1) * (eta2 + J2 * b1) = w - J2 * inv(M) * C1 * w, where w = eta2 + J2 * b1
+  vector_t w = second.eta;
+  w.noalias() += second.J * first.b;
+  const vector_t MInvC1w = MInvC1 * w;
+  w.noalias() -= second.J * MInvC1w;
+
+  // J = J1 + A1^T * J2 * inv(M) * A1
+  const matrix_t J2MInvA1 = second.J * MInvA1;
+  matrix_t J = first.J;
+  J.noalias() += first.A.transpose() * J2MInvA1;
+  // eta = eta1 + A1^T * inv(I + J2 * C1) * (eta2 + J2 * b1)
+  vector_t eta = first.eta;
+  eta.noalias() += first.A.transpose() * w;
+  // C = C2 + A2 * inv(M) * C1 * A2^T
+  const matrix_t A2MInvC1 = second.A * MInvC1;
+  matrix_t C = second.C;
+  C.noalias() += A2MInvC1 * second.A.transpose();
+
+  // A = A2 * inv(M) * A1, b = b2 + A2 * inv(M) * (b1 - C1 * eta2). The first element is not used anymore.
+  result.A.noalias() = second.A * MInvA1;
+  result.b = second.b;
+  result.b.noalias() += second.A * MInvB;
+  result.C = 0.5 * (C + C.transpose());
+  result.eta = std::move(eta);
+  result.J = 0.5 * (J + J.transpose());
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void suffixScan(ThreadPool& threadPool, size_t nThreads, std::vector<Element>& elements) {
+  const size_t N = elements.size();
+
+  // up-sweep: the element i, a multiple of 2d, becomes the combination of the elements [i, i + 2d)
+  size_t d = 1;
+  for (; d < N; d *= 2) {
+    const size_t stride = 2 * d;
+    const size_t numMerges = (N + d - 1) / stride;
+    parallelFor(threadPool, nThreads, numMerges, [&](size_t m) {
+      const size_t i = m * stride;
+      combine(elements[i], elements[i + d], elements[i]);
+    });
+  }
+
+  // down-sweep: after the level d, the elements at multiples of d are the combination of the elements [i, N)
+  for (d /= 4; d > 0; d /= 2) {
+    const size_t stride = 2 * d;
+    const size_t numMerges = (N - 1) / stride;
+    parallelFor(threadPool, nThreads, numMerges, [&](size_t m) {
+      const size_t j = m * stride + d;
+      combine(elements[j], elements[j + d], elements[j]);
+    });
+  }
+}
+
+}  // namespace riccati_scan
+}  // namespace ocs2
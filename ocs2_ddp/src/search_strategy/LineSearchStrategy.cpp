@@ -83,15 +83,20 @@ size_t LineSearchStrategy::maxNumOfSearches() const {
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
-void LineSearchStrategy::computeSolution(size_t taskId, scalar_t stepLength, search_strategy::Solution& solution) {
+void LineSearchStrategy::computeSolution(size_t taskId, scalar_t stepLength, search_strategy::Solution& solution, bool parallelMetrics) {
   auto& problem = optimalControlProblemRefStock_[taskId];
   auto& rollout = rolloutRefStock_[taskId];
 
   // compute primal solution
   solution.primalSolution.modeSchedule_ = *lineSearchInputRef_.modeSchedulePtr;
   incrementController(stepLength, *lineSearchInputRef_.unoptimizedControllerPtr, getLinearController(solution.primalSolution));
-  solution.avgTimeStep = rolloutTrajectory(rollout, lineSearchInputRef_.timePeriodPtr->first, *lineSearchInputRef_.initStatePtr,
-                                           lineSearchInputRef_.timePeriodPtr->second, solution.primalSolution);
+  if (rolloutFunction_) {
+    solution.avgTimeStep = rolloutFunction_(stepLength, solution.primalSolution, solution.shootingDefects);
+  } else {
+    solution.avgTimeStep = rolloutTrajectory(rollout, lineSearchInputRef_.timePeriodPtr->first, *lineSearchInputRef_.initStatePtr,
+                                             lineSearchInputRef_.timePeriodPtr->second, solution.primalSolution);
+    solution.shootingDefects.clear();
+  }
 
   // adjust dual solution only if it is required
   const DualSolution* adjustedDualSolutionPtr = lineSearchInputRef_.dualSolutionPtr;
@@ -111,10 +116,16 @@ void LineSearchStrategy::computeSolution(size_t taskId, scalar_t stepLength, sea
   initializeDualSolution(problem, solution.primalSolution, *adjustedDualSolutionPtr, solution.dualSolution);
 
   // compute problem metrics
-  computeRolloutMetrics(problem, solution.primalSolution, solution.dualSolution, solution.problemMetrics);
+  if (parallelMetrics) {
+    computeRolloutMetrics(threadPoolRef_, optimalControlProblemRefStock_, solution.primalSolution, solution.dualSolution,
+                          solution.problemMetrics);
+  } else {
+    computeRolloutMetrics(problem, solution.primalSolution, solution.dualSolution, solution.problemMetrics);
+  }
 
   // compute performanceIndex
-  solution.performanceIndex = computeRolloutPerformanceIndex(solution.primalSolution.timeTrajectory_, solution.problemMetrics);
+  solution.performanceIndex =
+      computeRolloutPerformanceIndex(solution.primalSolution.timeTrajectory_, solution.problemMetrics, solution.shootingDefects);
   solution.performanceIndex.merit = meritFunc_(solution.performanceIndex);
 
   // display
@@ -140,11 +151,12 @@ bool LineSearchStrategy::run(const std::pair<scalar_t, scalar_t>& timePeriod, co
   lineSearchInputRef_.modeSchedulePtr = &modeSchedule;
   bestSolutionRef_ = &solutionRef;
 
-  // perform a rollout with steplength zero.
+  // perform a rollout with steplength zero. The thread pool is still idle, therefore the metrics are computed in parallel.
   constexpr size_t taskId = 0;
   constexpr scalar_t stepLength = 0.0;
+  constexpr bool parallelMetrics = true;
   try {
-    computeSolution(taskId, stepLength, workersSolution_[taskId]);
+    computeSolution(taskId, stepLength, workersSolution_[taskId], parallelMetrics);
     baselineMerit_ = workersSolution_[taskId].performanceIndex.merit;
     unoptimizedControllerUpdateIS_ = computeControllerUpdateIS(unoptimizedController);
 
@@ -164,8 +176,15 @@ bool LineSearchStrategy::run(const std::pair<scalar_t, scalar_t>& timePeriod, co
   nextTaskId_ = 0;
   alphaExpNext_ = 0;
   alphaProcessed_ = std::vector<bool>(maxNumOfSearches(), false);
-  auto task = [&](int) { lineSearchTask(nextTaskId_++); };
-  threadPoolRef_.runParallel(task, threadPoolRef_.numThreads());
+  // The custom rollout uses the thread pool. With fewer step lengths than workers, the idle workers are better used for the metrics.
+  // In both cases, the step lengths are tried one by one on this thread and the metrics are computed on the thread pool.
+  isSequentialSearch_ = static_cast<bool>(rolloutFunction_) || alphaProcessed_.size() < threadPoolRef_.numThreads() + 1;
+  if (isSequentialSearch_) {
+    lineSearchTask(nextTaskId_++);
+  } else {
+    auto task = [&](int) { lineSearchTask(nextTaskId_++); };
+    threadPoolRef_.runParallel(task, threadPoolRef_.numThreads());
+  }
 
   // revitalize all integrators
   for (RolloutBase& rollout : rolloutRefStock_) {
@@ -209,8 +228,17 @@ void LineSearchStrategy::lineSearchTask(const size_t taskId) {
       break;
     }
 
+    // stop if the time budget is exhausted. The best candidate so far (at least the zero step) is kept.
+    if (hasDeadlineExpired()) {
+      if (baseSettings_.displayInfo) {
+        printString("    [Thread " + std::to_string(taskId) + "] rollout with step length " + std::to_string(stepLength) +
+                    " is skipped: The time budget is exhausted!\n");
+      }
+      break;
+    }
+
     try {
-      computeSolution(taskId, stepLength, workersSolution_[taskId]);
+      computeSolution(taskId, stepLength, workersSolution_[taskId], isSequentialSearch_);
     } catch (const std::exception& error) {
       if (baseSettings_.displayInfo) {
         printString("    [Thread " + std::to_string(taskId) + "] rollout with step length " + std::to_string(stepLength) +
@@ -281,7 +309,8 @@ std::pair<bool, std::string> LineSearchStrategy::checkConvergence(bool unreliabl
   const scalar_t relCost = std::abs(currentTotalCost - previousTotalCost);
   const bool isCostFunctionConverged = relCost <= baseSettings_.minRelCost;
   const bool isConstraintsSatisfied = currentPerformanceIndex.equalityConstraintsSSE <= baseSettings_.constraintTolerance;
-  const bool isOptimizationConverged = isCostFunctionConverged && isConstraintsSatisfied;
+  const bool isDynamicsSatisfied = currentPerformanceIndex.dynamicsViolationSSE <= baseSettings_.constraintTolerance;
+  const bool isOptimizationConverged = isCostFunctionConverged && isConstraintsSatisfied && isDynamicsSatisfied;
 
   // convergence info
   std::stringstream infoStream;
@@ -293,6 +322,11 @@ std::pair<bool, std::string> LineSearchStrategy::checkConvergence(bool unreliabl
 
     infoStream << "    * The SSE of equality constraints (i.e., " << currentPerformanceIndex.equalityConstraintsSSE
                << ") has reached to its minimum value (" << baseSettings_.constraintTolerance << ").";
+
+    if (currentPerformanceIndex.dynamicsViolationSSE > 0.0) {
+      infoStream << "\n    * The SSE of the shooting defects (i.e., " << currentPerformanceIndex.dynamicsViolationSSE
+                 << ") has reached to its minimum value (" << baseSettings_.constraintTolerance << ").";
+    }
   }
 
   return {isOptimizationConverged, infoStream.str()};
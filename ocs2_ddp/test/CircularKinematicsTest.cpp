@@ -209,6 +209,39 @@ TEST_P(CircularKinematicsTest, ILQR) {
   performanceIndexTest(ddpSettings, performanceIndex);
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+TEST_P(CircularKinematicsTest, ILQR_RiccatiScan) {
+  const auto algorithm = ocs2::ddp::Algorithm::ILQR;
+
+  // ddp settings
+  auto ddpSettings = getSettings(algorithm, getNumThreads(), getSearchStrategy());
+  ddpSettings.useRiccatiScan_ = true;
+  // the scan only supports the diagonal shift
+  ddpSettings.lineSearch_.hessianCorrectionStrategy = ocs2::hessian_correction::Strategy::DIAGONAL_SHIFT;
+  ddpSettings.lineSearch_.hessianCorrectionMultiple = 1e-2;
+
+  // dynamics and rollout
+  const ocs2::CircularKinematicsSystem systemDynamics;
+  const ocs2::TimeTriggeredRollout rollout(systemDynamics, rolloutSettings(algorithm));
+
+  // instantiate
+  ocs2::ILQR ddp(ddpSettings, rollout, problem, *initializerPtr);
+
+  if (ddpSettings.displayInfo_ || ddpSettings.displayShortSummary_) {
+    std::cerr << "\n" << getTestName(ddpSettings) << " with Riccati scan\n";
+  }
+
+  // run ddp
+  ddp.run(startTime, initState, finalTime);
+  // get performance index
+  const auto performanceIndex = ddp.getPerformanceIndeces();
+
+  // performanceIndeces test
+  performanceIndexTest(ddpSettings, performanceIndex);
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -376,3 +376,40 @@ INSTANTIATE_TEST_CASE_P(Exp0ParamCase, Exp0Param,
                           name += std::get<1>(info.param) == 1 ? "SINGLE_THREAD" : "MULTI_THREAD";
                           return name;
                         });
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+TEST_F(Exp0, ddp_time_budget) {
+  // ddp settings
+  const auto ddpSettings = getSettings(ocs2::ddp::Algorithm::SLQ, 2, ocs2::search_strategy::Type::LINE_SEARCH);
+
+  // dynamics and rollout
+  ocs2::EXP0_System systemDynamics(referenceManagerPtr);
+  ocs2::TimeTriggeredRollout rollout(systemDynamics, rolloutSettings());
+
+  // instantiate
+  ocs2::SLQ ddp(ddpSettings, rollout, problem, *initializerPtr);
+  ddp.setReferenceManager(referenceManagerPtr);
+
+  // without a time budget
+  ddp.run(startTime, initState, finalTime);
+  const auto numIterations = ddp.getNumIterations();
+  EXPECT_EQ(ddp.getTimeBudgetStatistics().numRuns, 1);
+  EXPECT_EQ(ddp.getTimeBudgetStatistics().numTerminatedRuns, 0);
+  EXPECT_EQ(ddp.getTimeBudgetStatistics().numOverruns, 0);
+
+  // with a time budget which does not allow a second iteration
+  ddp.reset();
+  ddp.setTimeBudget(1e-6);
+  ddp.run(startTime, initState, finalTime);
+  EXPECT_LT(ddp.getNumIterations(), numIterations);
+  EXPECT_EQ(ddp.getTimeBudgetStatistics().numRuns, 2);
+  EXPECT_EQ(ddp.getTimeBudgetStatistics().numTerminatedRuns, 1);
+  EXPECT_EQ(ddp.getTimeBudgetStatistics().numOverruns, 1);
+
+  // the solution is still delivered over the whole horizon
+  const auto solution = ddp.primalSolution(finalTime);
+  EXPECT_DOUBLE_EQ(solution.timeTrajectory_.back(), finalTime) << "MESSAGE: SLQ failed in policy final time of trajectory!";
+  EXPECT_FALSE(solution.controllerPtr_->empty());
+}
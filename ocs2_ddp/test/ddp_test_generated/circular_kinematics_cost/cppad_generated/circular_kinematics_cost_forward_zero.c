@@ -0,0 +1,43 @@
+#include <math.h>
+#include <stdio.h>
+
+typedef struct Array {
+    void* data;
+    unsigned long size;
+    int sparse;
+    const unsigned long* idx;
+    unsigned long nnz;
+} Array;
+
+struct LangCAtomicFun {
+    void* libModel;
+    int (*forward)(void* libModel,
+                   int atomicIndex,
+                   int q,
+                   int p,
+                   const Array tx[],
+                   Array* ty);
+    int (*reverse)(void* libModel,
+                   int atomicIndex,
+                   int p,
+                   const Array tx[],
+                   Array* px,
+                   const Array py[]);
+};
+
+void circular_kinematics_cost_forward_zero(double const *const * in,
+                                           double*const * out,
+                                           struct LangCAtomicFun atomicFun) {
+   //independent variables
+   const double* x = in[0];
+
+   //dependent variables
+   double* y = out[0];
+
+   // auxiliary variables
+   double v[1];
+
+   v[0] = -1 + x[1] * x[4] - x[2] * x[3];
+   y[0] = 0.5 * v[0] * v[0] + 0.005 * (x[3] * x[3] + x[4] * x[4]);
+}
+
@@ -0,0 +1,12 @@
+void circular_kinematics_cost_info(const char** baseName,
+                                   unsigned long* m,
+                                   unsigned long* n,
+                                   unsigned int* indCount,
+                                   unsigned int* depCount) {
+   *baseName = "double  d";
+   *m = 1;
+   *n = 5;
+   *depCount = 1; // number of dependent array variables
+   *indCount = 1; // number of independent array variables
+}
+
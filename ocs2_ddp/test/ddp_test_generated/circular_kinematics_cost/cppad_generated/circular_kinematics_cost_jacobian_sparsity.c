@@ -0,0 +1,9 @@
+void circular_kinematics_cost_jacobian_sparsity(unsigned long const** row,
+                                                unsigned long const** col,
+                                                unsigned long* nnz) {
+   static unsigned long const rows[4] = {0,0,0,0};
+   static unsigned long const cols[4] = {1,2,3,4};
+   *row = rows;
+   *col = cols;
+   *nnz = 4;
+}
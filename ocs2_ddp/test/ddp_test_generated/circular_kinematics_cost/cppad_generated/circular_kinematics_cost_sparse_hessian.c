@@ -0,0 +1,66 @@
+#include <math.h>
+#include <stdio.h>
+
+typedef struct Array {
+    void* data;
+    unsigned long size;
+    int sparse;
+    const unsigned long* idx;
+    unsigned long nnz;
+} Array;
+
+struct LangCAtomicFun {
+    void* libModel;
+    int (*forward)(void* libModel,
+                   int atomicIndex,
+                   int q,
+                   int p,
+                   const Array tx[],
+                   Array* ty);
+    int (*reverse)(void* libModel,
+                   int atomicIndex,
+                   int p,
+                   const Array tx[],
+                   Array* px,
+                   const Array py[]);
+};
+
+void circular_kinematics_cost_sparse_hessian(double const *const * in,
+                                             double*const * out,
+                                             struct LangCAtomicFun atomicFun) {
+   //independent variables
+   const double* x = in[0];
+   const double* mult = in[1];
+
+   //dependent variables
+   double* hess = out[0];
+
+   // auxiliary variables
+   double v[4];
+
+   v[0] = mult[0] * 0.5;
+   v[1] = v[0] * x[4] + v[0] * x[4];
+   hess[0] = v[1] * x[4];
+   v[2] = 0 - v[1];
+   hess[1] = v[2] * x[3];
+   hess[2] = v[2] * x[2];
+   v[2] = -1 + x[1] * x[4] - x[2] * x[3];
+   hess[3] = v[0] * v[2] + v[0] * v[2] + v[1] * x[1];
+   v[1] = mult[0] * 0.5;
+   v[0] = 0 - x[3];
+   v[0] = v[1] * v[0] + v[1] * v[0];
+   v[3] = 0 - v[0];
+   hess[4] = v[3] * x[3];
+   hess[5] = 0 - (v[1] * v[2] + v[1] * v[2]) + v[3] * x[2];
+   hess[6] = v[0] * x[1];
+   v[0] = mult[0] * 0.5;
+   v[3] = 0 - x[2];
+   v[3] = v[0] * v[3] + v[0] * v[3];
+   v[0] = mult[0] * 0.005;
+   hess[7] = (0 - v[3]) * x[2] + v[0] + v[0];
+   hess[8] = v[3] * x[1];
+   v[3] = mult[0] * 0.5;
+   v[0] = mult[0] * 0.005;
+   hess[9] = (v[3] * x[1] + v[3] * x[1]) * x[1] + v[0] + v[0];
+}
+
@@ -0,0 +1,48 @@
+#include <math.h>
+#include <stdio.h>
+
+typedef struct Array {
+    void* data;
+    unsigned long size;
+    int sparse;
+    const unsigned long* idx;
+    unsigned long nnz;
+} Array;
+
+struct LangCAtomicFun {
+    void* libModel;
+    int (*forward)(void* libModel,
+                   int atomicIndex,
+                   int q,
+                   int p,
+                   const Array tx[],
+                   Array* ty);
+    int (*reverse)(void* libModel,
+                   int atomicIndex,
+                   int p,
+                   const Array tx[],
+                   Array* px,
+                   const Array py[]);
+};
+
+void circular_kinematics_cost_sparse_jacobian(double const *const * in,
+                                              double*const * out,
+                                              struct LangCAtomicFun atomicFun) {
+   //independent variables
+   const double* x = in[0];
+
+   //dependent variables
+   double* jac = out[0];
+
+   // auxiliary variables
+   double v[2];
+
+   v[0] = -1 + x[1] * x[4] - x[2] * x[3];
+   v[0] = 0.5 * v[0] + 0.5 * v[0];
+   jac[0] = v[0] * x[4];
+   v[1] = 0 - v[0];
+   jac[1] = v[1] * x[3];
+   jac[2] = v[1] * x[2] + 0.005 * x[3] + 0.005 * x[3];
+   jac[3] = v[0] * x[1] + 0.005 * x[4] + 0.005 * x[4];
+}
+
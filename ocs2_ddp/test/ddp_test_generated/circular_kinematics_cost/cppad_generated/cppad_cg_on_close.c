@@ -0,0 +1,3 @@
+void cppad_cg_on_close() {
+}
+
@@ -0,0 +1,182 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+
+#include <ocs2_core/misc/Benchmark.h>
+
+#include <ocs2_ddp/DDP_Data.h>
+
+namespace {
+// number of heap allocations of this executable
+std::atomic<size_t> numAllocations{0};
+}  // unnamed namespace
+
+// Counts all heap allocations, including the ones of Eigen and operator new, by interposing glibc's malloc.
+extern "C" void* __libc_malloc(size_t size);
+extern "C" void* malloc(size_t size) {
+  ++numAllocations;
+  return __libc_malloc(size);
+}
+
+using namespace ocs2;
+
+class DdpDataTest : public testing::Test {
+ protected:
+  static constexpr size_t stateDim = 12;
+  static constexpr size_t inputDim = 6;
+  static constexpr size_t numNodes = 200;
+
+  /** Refills the value function and model data trajectories in place, as the LQ approximation and the Riccati solver do. */
+  static void fillInPlace(PrimalDataContainer& primalData, DualDataContainer& dualData) {
+    for (auto& modelData : primalData.modelDataTrajectory) {
+      modelData.dynamicsBias.setZero(stateDim);
+      modelData.dynamics.setZero(stateDim, stateDim, inputDim);
+      modelData.cost.setZero(stateDim, inputDim);
+    }
+    for (auto& valueFunction : dualData.valueFunctionTrajectory) {
+      valueFunction.setZero(stateDim, 0);
+    }
+  }
+
+  /** Prepares the nominal containers of a new iteration with the given horizon length. */
+  static void runIteration(size_t length, PrimalDataContainer& nominalPrimalData, DualDataContainer& nominalDualData,
+                           PrimalDataContainer& cachedPrimalData, DualDataContainer& cachedDualData) {
+    nominalPrimalData.swap(cachedPrimalData);
+    nominalDualData.swap(cachedDualData);
+    resizeTrajectory(length, nominalPrimalData.modelDataTrajectory, nominalPrimalData.spareModelDataTrajectory);
+    resizeTrajectory(length, nominalDualData.valueFunctionTrajectory, nominalDualData.spareValueFunctionTrajectory);
+    fillInPlace(nominalPrimalData, nominalDualData);
+  }
+
+  PrimalDataContainer nominalPrimalData, cachedPrimalData;
+  DualDataContainer nominalDualData, cachedDualData;
+};
+
+constexpr size_t DdpDataTest::stateDim;
+constexpr size_t DdpDataTest::inputDim;
+constexpr size_t DdpDataTest::numNodes;
+
+TEST_F(DdpDataTest, resizeTrajectoryKeepsNodes) {
+  auto& trajectory = nominalDualData.valueFunctionTrajectory;
+  auto& spareNodes = nominalDualData.spareValueFunctionTrajectory;
+  resizeTrajectory(numNodes, trajectory, spareNodes);
+  for (auto& valueFunction : trajectory) {
+    valueFunction.setZero(stateDim, 0);
+  }
+
+  // shrinking parks the tail nodes
+  resizeTrajectory(numNodes / 2, trajectory, spareNodes);
+  ASSERT_EQ(trajectory.size(), numNodes / 2);
+  ASSERT_EQ(spareNodes.size(), numNodes - numNodes / 2);
+
+  // growing takes them back, keeping their memory, before default constructing new nodes
+  resizeTrajectory(numNodes + 1, trajectory, spareNodes);
+  ASSERT_EQ(trajectory.size(), numNodes + 1);
+  EXPECT_TRUE(spareNodes.empty());
+  for (size_t k = 0; k < numNodes; k++) {
+    EXPECT_EQ(trajectory[k].dfdxx.rows(), stateDim);
+  }
+  EXPECT_EQ(trajectory.back().dfdxx.size(), 0);
+}
+
+TEST_F(DdpDataTest, noAllocationInSteadyState) {
+  // horizon lengths of consecutive MPC iterations
+  const std::vector<size_t> lengths{numNodes, numNodes - 7, numNodes + 3, numNodes - 20, numNodes + 1};
+
+  // warm-up: each buffer has to reach the longest horizon
+  for (int i = 0; i < 2; i++) {
+    for (const auto length : lengths) {
+      runIteration(length, nominalPrimalData, nominalDualData, cachedPrimalData, cachedDualData);
+    }
+  }
+
+  const size_t numAllocationsBefore = numAllocations;
+  for (int i = 0; i < 10; i++) {
+    for (const auto length : lengths) {
+      runIteration(length, nominalPrimalData, nominalDualData, cachedPrimalData, cachedDualData);
+    }
+  }
+  EXPECT_EQ(numAllocations - numAllocationsBefore, 0);
+}
+
+TEST_F(DdpDataTest, DISABLED_benchmark) {
+  constexpr size_t numRepetitions = 50;
+  const std::vector<size_t> lengths{numNodes, numNodes - 7, numNodes + 3};
+
+  benchmark::RepeatedTimer clearTimer;
+  benchmark::RepeatedTimer recycleTimer;
+  size_t numClearAllocations = 0;
+  size_t numRecycleAllocations = 0;
+  for (size_t i = 0; i < numRepetitions; i++) {
+    for (const auto length : lengths) {
+      // clear followed by resize
+      const size_t numAllocationsBefore = numAllocations;
+      clearTimer.startTimer();
+      cachedPrimalData.swap(nominalPrimalData);
+      cachedDualData.swap(nominalDualData);
+      nominalPrimalData.modelDataTrajectory.clear();
+      nominalPrimalData.modelDataTrajectory.resize(length);
+      nominalDualData.valueFunctionTrajectory.clear();
+      nominalDualData.valueFunctionTrajectory.resize(length);
+      fillInPlace(nominalPrimalData, nominalDualData);
+      clearTimer.endTimer();
+      numClearAllocations += numAllocations - numAllocationsBefore;
+    }
+  }
+
+  nominalPrimalData.clear();
+  cachedPrimalData.clear();
+  nominalDualData.clear();
+  cachedDualData.clear();
+  for (int i = 0; i < 2; i++) {  // warm-up
+    for (const auto length : lengths) {
+      runIteration(length, nominalPrimalData, nominalDualData, cachedPrimalData, cachedDualData);
+    }
+  }
+  for (size_t i = 0; i < numRepetitions; i++) {
+    for (const auto length : lengths) {
+      const size_t numAllocationsBefore = numAllocations;
+      recycleTimer.startTimer();
+      runIteration(length, nominalPrimalData, nominalDualData, cachedPrimalData, cachedDualData);
+      recycleTimer.endTimer();
+      numRecycleAllocations += numAllocations - numAllocationsBefore;
+    }
+  }
+
+  const auto numIterations = static_cast<double>(numRepetitions * lengths.size());
+  std::cerr << "\n########################################################################\n";
+  std::cerr << "Preparing the DDP data of " << numNodes << " nodes (" << stateDim << " states, " << inputDim << " inputs)\n";
+  std::cerr << "clear and resize:  " << clearTimer.getAverageInMilliseconds() << " [ms], "
+            << static_cast<double>(numClearAllocations) / numIterations << " allocations per iteration\n";
+  std::cerr << "resizeTrajectory:  " << recycleTimer.getAverageInMilliseconds() << " [ms], "
+            << static_cast<double>(numRecycleAllocations) / numIterations << " allocations per iteration\n";
+}
@@ -27,11 +27,25 @@ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
 OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 ******************************************************************************/
 
+#include <algorithm>
 #include <iostream>
 
 #include <gtest/gtest.h>
 
+#include <ocs2_core/augmented_lagrangian/AugmentedLagrangian.h>
+#include <ocs2_core/initialization/DefaultInitializer.h>
+#include <ocs2_core/misc/Benchmark.h>
+#include <ocs2_core/misc/LinearAlgebra.h>
+#include <ocs2_core/penalties/augmented/QuadraticPenalty.h>
+#include <ocs2_oc/approximate_model/ChangeOfInputVariables.h>
+#include <ocs2_oc/oc_problem/OptimalControlProblemHelperFunction.h>
+#include <ocs2_oc/rollout/TimeTriggeredRollout.h>
+#include <ocs2_oc/synchronized_module/ReferenceManager.h>
+#include <ocs2_oc/test/testProblemsGeneration.h>
+
 #include <ocs2_ddp/DDP_HelperFunctions.h>
+#include <ocs2_ddp/ILQR.h>
+#include <ocs2_ddp/SLQ.h>
 
 using namespace ocs2;
 
@@ -99,3 +113,418 @@ TEST(extractPrimalSolution, eventAtInitTime) {
   //  std::cerr << ">>>>>> Test 3\n" << PrimalSolutionTest3 << "\n";
   EXPECT_EQ(PrimalSolutionTest3.timeTrajectory_.size(), 1);
 }
+
+TEST(isNumericalStabilityCheckNode, strideAndRotation) {
+  constexpr size_t numNodes = 20;
+  constexpr size_t stride = 3;
+  const size_array_t postEventIndices{7, 12};
+
+  // the final node and the nodes around the events are always checked
+  const auto isAlwaysChecked = [](size_t k) { return k == 6 || k == 7 || k == 11 || k == 12 || k == numNodes - 1; };
+
+  std::vector<bool> isCovered(numNodes, false);
+  for (size_t iteration = 0; iteration < stride; iteration++) {
+    for (size_t k = 0; k < numNodes; k++) {
+      const bool isChecked = isNumericalStabilityCheckNode(k, numNodes, postEventIndices, iteration, stride);
+      EXPECT_EQ(isChecked, isAlwaysChecked(k) || (k + iteration) % stride == 0) << "node: " << k << ", iteration: " << iteration;
+      isCovered[k] = isCovered[k] || isChecked;
+    }
+  }
+  // the checked nodes rotate such that every node is checked within stride iterations
+  EXPECT_TRUE(std::all_of(isCovered.cbegin(), isCovered.cend(), [](bool covered) { return covered; }));
+
+  // with a stride of one, all the nodes are checked
+  for (size_t k = 0; k < numNodes; k++) {
+    EXPECT_TRUE(isNumericalStabilityCheckNode(k, numNodes, size_array_t(), 5, 1));
+  }
+}
+
+class ParallelRolloutMetricsTest : public testing::Test {
+ protected:
+  static constexpr size_t numThreads = 4;
+  static constexpr size_t numTime = 2000;
+  static constexpr size_t numEvents = 5;
+  static constexpr int stateDim = 12;
+  static constexpr int inputDim = 6;
+  static constexpr int numConstraints = 4;
+
+  ParallelRolloutMetricsTest()
+      : threadPool(numThreads - 1), targetTrajectories({0.0}, {vector_t::Random(stateDim)}, {vector_t::Random(inputDim)}) {
+    std::srand(0);
+
+    // optimal control problem with costs and Lagrangians on all the time points
+    OptimalControlProblem problem;
+    problem.targetTrajectoriesPtr = &targetTrajectories;
+    problem.costPtr->add("cost", getOcs2Cost(getRandomCost(stateDim, inputDim)));
+    problem.preJumpCostPtr->add("preJumpCost", getOcs2StateCost(getRandomCost(stateDim, 0)));
+    problem.finalCostPtr->add("finalCost", getOcs2StateCost(getRandomCost(stateDim, 0)));
+    const augmented::QuadraticPenalty::Config penaltyConfig(10.0, 1.0);
+    problem.equalityLagrangianPtr->add(
+        "equality", create(getOcs2Constraints(getRandomConstraints(stateDim, inputDim, numConstraints)),
+                           augmented::QuadraticPenalty::create(penaltyConfig)));
+    problem.preJumpEqualityLagrangianPtr->add(
+        "preJumpEquality", create(getOcs2StateOnlyConstraints(getRandomConstraints(stateDim, 0, numConstraints)),
+                                  augmented::QuadraticPenalty::create(penaltyConfig)));
+    problemStock.assign(numThreads, problem);
+    problemRefStock.assign(problemStock.begin(), problemStock.end());
+
+    // rollout with events at equal intervals
+    for (size_t k = 0; k < numTime; k++) {
+      primalSolution.timeTrajectory_.push_back(k * 1e-3);
+      primalSolution.stateTrajectory_.push_back(vector_t::Random(stateDim));
+      primalSolution.inputTrajectory_.push_back(vector_t::Random(inputDim));
+    }
+    for (size_t i = 1; i <= numEvents; i++) {
+      primalSolution.postEventIndices_.push_back(i * numTime / (numEvents + 1));
+    }
+
+    initializeDualSolution(problemStock.front(), primalSolution, DualSolution(), dualSolution);
+  }
+
+  ThreadPool threadPool;
+  TargetTrajectories targetTrajectories;
+  std::vector<OptimalControlProblem> problemStock;
+  std::vector<std::reference_wrapper<OptimalControlProblem>> problemRefStock;
+  PrimalSolution primalSolution;
+  DualSolution dualSolution;
+};
+
+constexpr size_t ParallelRolloutMetricsTest::numThreads;
+constexpr size_t ParallelRolloutMetricsTest::numTime;
+constexpr size_t ParallelRolloutMetricsTest::numEvents;
+constexpr int ParallelRolloutMetricsTest::stateDim;
+constexpr int ParallelRolloutMetricsTest::inputDim;
+constexpr int ParallelRolloutMetricsTest::numConstraints;
+
+TEST_F(ParallelRolloutMetricsTest, sameAsSequential) {
+  ProblemMetrics sequentialMetrics;
+  computeRolloutMetrics(problemStock.front(), primalSolution, dualSolution, sequentialMetrics);
+  ProblemMetrics parallelMetrics;
+  computeRolloutMetrics(threadPool, problemRefStock, primalSolution, dualSolution, parallelMetrics);
+
+  ASSERT_EQ(sequentialMetrics.intermediates.size(), parallelMetrics.intermediates.size());
+  ASSERT_EQ(sequentialMetrics.preJumps.size(), parallelMetrics.preJumps.size());
+  const auto sequentialPerformance = computeRolloutPerformanceIndex(primalSolution.timeTrajectory_, sequentialMetrics);
+  const auto parallelPerformance = computeRolloutPerformanceIndex(primalSolution.timeTrajectory_, parallelMetrics);
+  EXPECT_DOUBLE_EQ(sequentialPerformance.cost, parallelPerformance.cost);
+  EXPECT_DOUBLE_EQ(sequentialPerformance.equalityLagrangian, parallelPerformance.equalityLagrangian);
+  for (size_t i = 0; i < numEvents; i++) {
+    EXPECT_DOUBLE_EQ(sequentialMetrics.preJumps[i].cost, parallelMetrics.preJumps[i].cost);
+  }
+
+  // dual update
+  DualSolution sequentialDualSolution = dualSolution;
+  updateDualSolution(problemStock.front(), primalSolution, sequentialMetrics, sequentialDualSolution);
+  DualSolution parallelDualSolution = dualSolution;
+  updateDualSolution(threadPool, problemRefStock, primalSolution, parallelMetrics, parallelDualSolution);
+
+  for (size_t k = 0; k < numTime; k++) {
+    EXPECT_TRUE(sequentialDualSolution.intermediates[k].stateInputEq.front().lagrangian.isApprox(
+        parallelDualSolution.intermediates[k].stateInputEq.front().lagrangian));
+    EXPECT_DOUBLE_EQ(sequentialMetrics.intermediates[k].stateInputEqLagrangian.front().penalty,
+                     parallelMetrics.intermediates[k].stateInputEqLagrangian.front().penalty);
+  }
+  for (size_t i = 0; i < numEvents; i++) {
+    EXPECT_TRUE(
+        sequentialDualSolution.preJumps[i].stateEq.front().lagrangian.isApprox(parallelDualSolution.preJumps[i].stateEq.front().lagrangian));
+  }
+}
+
+TEST_F(ParallelRolloutMetricsTest, DISABLED_benchmark) {
+  constexpr size_t numRepetitions = 50;
+
+  benchmark::RepeatedTimer sequentialTimer;
+  benchmark::RepeatedTimer parallelTimer;
+  ProblemMetrics problemMetrics;
+  DualSolution updatedDualSolution;
+  for (size_t i = 0; i < numRepetitions; i++) {
+    // metrics and dual update of the zero step of the line search
+    updatedDualSolution = dualSolution;
+    sequentialTimer.startTimer();
+    computeRolloutMetrics(problemStock.front(), primalSolution, updatedDualSolution, problemMetrics);
+    updateDualSolution(problemStock.front(), primalSolution, problemMetrics, updatedDualSolution);
+    sequentialTimer.endTimer();
+
+    updatedDualSolution = dualSolution;
+    parallelTimer.startTimer();
+    computeRolloutMetrics(threadPool, problemRefStock, primalSolution, updatedDualSolution, problemMetrics);
+    updateDualSolution(threadPool, problemRefStock, primalSolution, problemMetrics, updatedDualSolution);
+    parallelTimer.endTimer();
+  }
+
+  std::cerr << "\n########################################################################\n";
+  std::cerr << "Rollout metrics and dual update of " << numTime << " time points\n";
+  std::cerr << "Sequential:           " << sequentialTimer.getAverageInMilliseconds() << " [ms]\n";
+  std::cerr << "Parallel (" << numThreads << " threads): " << parallelTimer.getAverageInMilliseconds() << " [ms]\n";
+}
+
+class LineSearchTest : public testing::Test {
+ protected:
+  static constexpr scalar_t timeStep = 1e-3;
+  static constexpr scalar_t finalTime = 2.0;
+  static constexpr int stateDim = 12;
+  static constexpr int inputDim = 6;
+  static constexpr int numConstraints = 4;
+
+  LineSearchTest() : initializer(inputDim) {
+    std::srand(0);
+
+    // constrained linear-quadratic problem with augmented Lagrangian terms on all the time points such that the metrics are costly
+    problem.dynamicsPtr = getOcs2Dynamics(getRandomDynamics(stateDim, inputDim));
+    auto cost = getRandomCost(stateDim, inputDim);
+    cost.dfduu += matrix_t::Identity(inputDim, inputDim);
+    problem.costPtr->add("cost", getOcs2Cost(cost));
+    problem.finalCostPtr->add("finalCost", getOcs2StateCost(getRandomCost(stateDim, 0)));
+    const augmented::QuadraticPenalty::Config penaltyConfig(10.0, 1.0);
+    problem.equalityLagrangianPtr->add(
+        "equality", create(getOcs2Constraints(getRandomConstraints(stateDim, inputDim, numConstraints)),
+                           augmented::QuadraticPenalty::create(penaltyConfig)));
+
+    const TargetTrajectories targetTrajectories({0.0}, {vector_t::Zero(stateDim)}, {vector_t::Zero(inputDim)});
+    referenceManagerPtr = std::make_shared<ReferenceManager>(std::vector<TargetTrajectories>{targetTrajectories}, targetTrajectories);
+    initState = vector_t::Random(stateDim);
+
+    rollout::Settings rolloutSettings;
+    rolloutSettings.timeStep = timeStep;
+    rolloutSettings.integratorType = IntegratorType::RK4;
+    rolloutPtr.reset(new TimeTriggeredRollout(*problem.dynamicsPtr, rolloutSettings));
+  }
+
+  /** Settings with a line search of the step lengths 1, 0.5, ... down to minStepLength */
+  ddp::Settings getSettings(size_t nThreads, scalar_t minStepLength) const {
+    ddp::Settings settings;
+    settings.algorithm_ = ddp::Algorithm::SLQ;
+    settings.nThreads_ = nThreads;
+    settings.displayInfo_ = false;
+    settings.displayShortSummary_ = false;
+    settings.checkNumericalStability_ = false;
+    settings.timeStep_ = timeStep;
+    settings.backwardPassIntegratorType_ = IntegratorType::RK4;
+    settings.maxNumIterations_ = 5;
+    settings.minRelCost_ = 0.0;
+    settings.lineSearch_.minStepLength = minStepLength;
+    settings.lineSearch_.maxStepLength = 1.0;
+    settings.lineSearch_.contractionRate = 0.5;
+    return settings;
+  }
+
+  std::unique_ptr<SLQ> getSolver(size_t nThreads, scalar_t minStepLength) const {
+    std::unique_ptr<SLQ> solverPtr(new SLQ(getSettings(nThreads, minStepLength), *rolloutPtr, problem, initializer));
+    solverPtr->setReferenceManager(referenceManagerPtr);
+    return solverPtr;
+  }
+
+  OptimalControlProblem problem;
+  std::shared_ptr<ReferenceManager> referenceManagerPtr;
+  std::unique_ptr<TimeTriggeredRollout> rolloutPtr;
+  const DefaultInitializer initializer;
+  vector_t initState;
+};
+
+constexpr scalar_t LineSearchTest::timeStep;
+constexpr scalar_t LineSearchTest::finalTime;
+constexpr int LineSearchTest::stateDim;
+constexpr int LineSearchTest::inputDim;
+constexpr int LineSearchTest::numConstraints;
+
+TEST_F(LineSearchTest, fewStepLengths) {
+  constexpr size_t nThreads = 4;
+  // two step lengths are tried one by one with parallel metrics, while six step lengths are tried concurrently
+  auto sequentialSearchSolverPtr = getSolver(nThreads, 0.5);
+  sequentialSearchSolverPtr->run(0.0, initState, finalTime);
+  auto concurrentSearchSolverPtr = getSolver(nThreads, 0.03);
+  concurrentSearchSolverPtr->run(0.0, initState, finalTime);
+
+  // the largest step length is accepted in all the iterations of this problem, therefore both searches take the same steps
+  const auto& sequentialSearchLog = sequentialSearchSolverPtr->getIterationsLog();
+  const auto& concurrentSearchLog = concurrentSearchSolverPtr->getIterationsLog();
+  ASSERT_EQ(sequentialSearchLog.size(), concurrentSearchLog.size());
+  for (size_t i = 0; i < sequentialSearchLog.size(); i++) {
+    EXPECT_DOUBLE_EQ(sequentialSearchLog[i].merit, concurrentSearchLog[i].merit);
+  }
+}
+
+TEST_F(LineSearchTest, DISABLED_benchmark) {
+  constexpr size_t numRepetitions = 10;
+
+  std::cerr << "\n########################################################################\n";
+  std::cerr << "Line search of two step lengths on " << static_cast<size_t>(finalTime / timeStep) << " time points\n";
+  for (const size_t nThreads : {1, 2, 4}) {
+    auto solverPtr = getSolver(nThreads, 0.5);
+    // the solver is not reset, since that also resets its benchmarking timers
+    for (size_t i = 0; i < numRepetitions; i++) {
+      solverPtr->run(0.0, initState, finalTime);
+    }
+    // the benchmarking info includes the average latency of the search strategy
+    std::cerr << nThreads << " threads:\n" << solverPtr->getBenchmarkingInfo() << "\n";
+  }
+}
+
+class UnconstrainedProjectionTest : public ::testing::Test {
+ protected:
+  static constexpr size_t numNodes = 100;
+  static constexpr int stateDim = 24;
+  static constexpr int inputDim = 24;
+
+  UnconstrainedProjectionTest() : modelDataTrajectory(numNodes), riccatiModificationTrajectory(numNodes) {
+    for (size_t k = 0; k < numNodes; k++) {
+      auto& modelData = modelDataTrajectory[k];
+      modelData.stateDim = stateDim;
+      modelData.inputDim = inputDim;
+      modelData.dynamics = getRandomDynamics(stateDim, inputDim);
+      modelData.dynamicsBias = vector_t::Random(stateDim);
+      modelData.cost = getRandomCost(stateDim, inputDim);
+
+      // no state-input equality constraint: Pu is the upper-triangular factor of inv(Hm)
+      auto& riccatiModification = riccatiModificationTrajectory[k];
+      riccatiModification.hamiltonianHessian_ = modelData.cost.dfduu;
+      riccatiModification.constraintRangeProjector_.setZero(inputDim, 0);
+      LinearAlgebra::computeInverseMatrixUUT(riccatiModification.hamiltonianHessian_, riccatiModification.constraintNullProjector_);
+    }
+  }
+
+  std::vector<ModelData> modelDataTrajectory;
+  std::vector<riccati_modification::Data> riccatiModificationTrajectory;
+};
+
+constexpr size_t UnconstrainedProjectionTest::numNodes;
+constexpr int UnconstrainedProjectionTest::stateDim;
+constexpr int UnconstrainedProjectionTest::inputDim;
+
+TEST_F(UnconstrainedProjectionTest, sameAsDense) {
+  const auto& modelData = modelDataTrajectory.front();
+  const auto& riccatiModification = riccatiModificationTrajectory.front();
+  ASSERT_TRUE(riccati_modification::hasTriangularNullProjector(riccatiModification));
+
+  // dense change of input variables
+  ModelData denseProjectedModelData = modelData;
+  changeOfInputVariables(denseProjectedModelData.dynamics, riccatiModification.constraintNullProjector_);
+  changeOfInputVariables(denseProjectedModelData.cost, riccatiModification.constraintNullProjector_);
+
+  ModelData projectedModelData;
+  projectUnconstrainedLQ(modelData, riccatiModification.constraintNullProjector_, projectedModelData);
+
+  EXPECT_TRUE(projectedModelData.dynamics.dfdx.isApprox(denseProjectedModelData.dynamics.dfdx));
+  EXPECT_TRUE(projectedModelData.dynamics.dfdu.isApprox(denseProjectedModelData.dynamics.dfdu));
+  EXPECT_TRUE(projectedModelData.dynamicsBias.isApprox(denseProjectedModelData.dynamicsBias));
+  EXPECT_DOUBLE_EQ(projectedModelData.cost.f, denseProjectedModelData.cost.f);
+  EXPECT_TRUE(projectedModelData.cost.dfdx.isApprox(denseProjectedModelData.cost.dfdx));
+  EXPECT_TRUE(projectedModelData.cost.dfdu.isApprox(denseProjectedModelData.cost.dfdu));
+  EXPECT_TRUE(projectedModelData.cost.dfdxx.isApprox(denseProjectedModelData.cost.dfdxx));
+  EXPECT_TRUE(projectedModelData.cost.dfdux.isApprox(denseProjectedModelData.cost.dfdux));
+  EXPECT_TRUE(projectedModelData.cost.dfduu.isApprox(denseProjectedModelData.cost.dfduu));
+  // Pu^T * Hm * Pu = I
+  EXPECT_TRUE(projectedModelData.cost.dfduu.isApprox(matrix_t::Identity(inputDim, inputDim), 1e-9));
+
+  // controller products
+  const matrix_t projectedKm = matrix_t::Random(inputDim, stateDim);
+  matrix_t gain = matrix_t::Random(inputDim, stateDim);
+  const matrix_t denseGain = gain + riccatiModification.constraintNullProjector_ * projectedKm;
+  riccati_modification::addNullProjectorProduct(riccatiModification, projectedKm, gain);
+  EXPECT_TRUE(gain.isApprox(denseGain));
+}
+
+TEST_F(UnconstrainedProjectionTest, DISABLED_benchmark) {
+  constexpr size_t numRepetitions = 50;
+  const matrix_t projectedKm = matrix_t::Random(inputDim, stateDim);
+  const vector_t projectedLv = vector_t::Random(inputDim);
+
+  benchmark::RepeatedTimer denseTimer;
+  benchmark::RepeatedTimer triangularTimer;
+  ModelData projectedModelData;
+  matrix_t gain;
+  vector_t deltaBias;
+  for (size_t i = 0; i < numRepetitions; i++) {
+    // projection of the LQ approximation and the controller products of all nodes
+    denseTimer.startTimer();
+    for (size_t k = 0; k < numNodes; k++) {
+      const auto& Pu = riccatiModificationTrajectory[k].constraintNullProjector_;
+      projectedModelData.dynamics = modelDataTrajectory[k].dynamics;
+      projectedModelData.dynamicsBias = modelDataTrajectory[k].dynamicsBias;
+      changeOfInputVariables(projectedModelData.dynamics, Pu);
+      projectedModelData.cost = modelDataTrajectory[k].cost;
+      changeOfInputVariables(projectedModelData.cost, Pu);
+      gain.setZero(inputDim, stateDim);
+      gain.noalias() += Pu * projectedKm;
+      deltaBias.setZero(inputDim);
+      deltaBias.noalias() += Pu * projectedLv;
+    }
+    denseTimer.endTimer();
+
+    triangularTimer.startTimer();
+    for (size_t k = 0; k < numNodes; k++) {
+      const auto& riccatiModification = riccatiModificationTrajectory[k];
+      projectUnconstrainedLQ(modelDataTrajectory[k], riccatiModification.constraintNullProjector_, projectedModelData);
+      gain.setZero(inputDim, stateDim);
+      riccati_modification::addNullProjectorProduct(riccatiModification, projectedKm, gain);
+      deltaBias.setZero(inputDim);
+      riccati_modification::addNullProjectorProduct(riccatiModification, projectedLv, deltaBias);
+    }
+    triangularTimer.endTimer();
+  }
+
+  std::cerr << "\n########################################################################\n";
+  std::cerr << "Projection and controller products of " << numNodes << " unconstrained nodes (" << stateDim << " states, " << inputDim
+            << " inputs)\n";
+  std::cerr << "Dense projector:      " << denseTimer.getAverageInMilliseconds() << " [ms]\n";
+  std::cerr << "Triangular projector: " << triangularTimer.getAverageInMilliseconds() << " [ms]\n";
+}
+
+TEST_F(UnconstrainedProjectionTest, DISABLED_solverIterationBenchmark) {
+  constexpr size_t numRepetitions = 10;
+  constexpr scalar_t timeStep = 0.01;
+  const scalar_t finalTime = numNodes * timeStep;
+
+  // unconstrained linear-quadratic problem on the same grid as the kernel benchmark
+  OptimalControlProblem problem;
+  problem.dynamicsPtr = getOcs2Dynamics(getRandomDynamics(stateDim, inputDim));
+  auto cost = getRandomCost(stateDim, inputDim);
+  cost.dfduu += matrix_t::Identity(inputDim, inputDim);
+  problem.costPtr->add("cost", getOcs2Cost(cost));
+  problem.finalCostPtr->add("finalCost", getOcs2StateCost(getRandomCost(stateDim, 0)));
+
+  const TargetTrajectories targetTrajectories({0.0}, {vector_t::Zero(stateDim)}, {vector_t::Zero(inputDim)});
+  auto referenceManagerPtr = std::make_shared<ReferenceManager>(std::vector<TargetTrajectories>{targetTrajectories}, targetTrajectories);
+  const vector_t initState = vector_t::Random(stateDim);
+  const DefaultInitializer initializer(inputDim);
+
+  rollout::Settings rolloutSettings;
+  rolloutSettings.timeStep = timeStep;
+  rolloutSettings.integratorType = IntegratorType::RK4;
+  const TimeTriggeredRollout rollout(*problem.dynamicsPtr, rolloutSettings);
+
+  std::cerr << "\n########################################################################\n";
+  std::cerr << "Solver iterations on " << numNodes << " unconstrained nodes (" << stateDim << " states, " << inputDim << " inputs)\n";
+  for (const auto algorithm : {ddp::Algorithm::SLQ, ddp::Algorithm::ILQR}) {
+    ddp::Settings settings;
+    settings.algorithm_ = algorithm;
+    settings.nThreads_ = 1;
+    settings.displayInfo_ = false;
+    settings.displayShortSummary_ = false;
+    settings.checkNumericalStability_ = false;
+    settings.timeStep_ = timeStep;
+    settings.backwardPassIntegratorType_ = IntegratorType::RK4;
+    settings.maxNumIterations_ = 5;
+    settings.minRelCost_ = 0.0;
+
+    std::unique_ptr<GaussNewtonDDP> solverPtr;
+    if (algorithm == ddp::Algorithm::SLQ) {
+      solverPtr.reset(new SLQ(settings, rollout, problem, initializer));
+    } else {
+      solverPtr.reset(new ILQR(settings, rollout, problem, initializer));
+    }
+    solverPtr->setReferenceManager(referenceManagerPtr);
+
+    benchmark::RepeatedTimer solveTimer;
+    size_t numIterations = 0;
+    for (size_t i = 0; i < numRepetitions; i++) {
+      solverPtr->reset();
+      solveTimer.startTimer();
+      solverPtr->run(0.0, initState, finalTime);
+      solveTimer.endTimer();
+      numIterations += solverPtr->getIterationsLog().size();
+    }
+    std::cerr << ddp::toAlgorithmName(algorithm) << " iteration: "
+              << solveTimer.getTotalInMilliseconds() / static_cast<scalar_t>(numIterations) << " [ms]\n";
+  }
+}
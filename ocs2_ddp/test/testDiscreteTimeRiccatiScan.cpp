@@ -0,0 +1,302 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <iostream>
+#include <stdexcept>
+
+#include <ocs2_core/cost/StateInputCost.h>
+#include <ocs2_core/dynamics/LinearSystemDynamics.h>
+#include <ocs2_core/initialization/DefaultInitializer.h>
+#include <ocs2_core/misc/Benchmark.h>
+#include <ocs2_core/misc/LinearAlgebra.h>
+#include <ocs2_core/misc/randomMatrices.h>
+#include <ocs2_core/thread_support/ThreadPool.h>
+#include <ocs2_ddp/ILQR.h>
+#include <ocs2_ddp/riccati_equations/DiscreteTimeRiccatiScan.h>
+#include <ocs2_ddp/riccati_equations/RiccatiTransversalityConditions.h>
+#include <ocs2_oc/oc_problem/OptimalControlProblem.h>
+#include <ocs2_oc/rollout/TimeTriggeredRollout.h>
+
+namespace {
+
+/** A random discrete-time LQ problem with an event at every eventPeriod time steps. */
+struct DiscreteLqProblem {
+  DiscreteLqProblem(size_t stateDim, size_t inputDim, size_t N, size_t eventPeriod) {
+    modelDataTrajectory.resize(N);
+    isPreEvent.resize(N, false);
+    for (size_t k = 0; k + 1 < N; k++) {
+      auto& modelData = modelDataTrajectory[k];
+      modelData.stateDim = stateDim;
+      modelData.inputDim = inputDim;
+      modelData.dynamics.dfdx = 0.95 * ocs2::matrix_t::Identity(stateDim, stateDim) + 0.02 * ocs2::matrix_t::Random(stateDim, stateDim);
+      modelData.dynamics.dfdu = 0.1 * ocs2::matrix_t::Random(stateDim, inputDim);
+      modelData.dynamicsBias = 0.1 * ocs2::vector_t::Random(stateDim);
+      modelData.cost.dfdxx = 0.1 * ocs2::LinearAlgebra::generateSPDmatrix<ocs2::matrix_t>(stateDim);
+      modelData.cost.dfdx = 0.1 * ocs2::vector_t::Random(stateDim);
+      modelData.cost.dfduu = 0.1 * ocs2::LinearAlgebra::generateSPDmatrix<ocs2::matrix_t>(inputDim);
+      modelData.cost.dfdux = 0.01 * ocs2::matrix_t::Random(inputDim, stateDim);
+      modelData.cost.dfdu = 0.1 * ocs2::vector_t::Random(inputDim);
+      // an event instead of an intermediate time step
+      isPreEvent[k] = (eventPeriod > 0 && k > 0 && k % eventPeriod == 0);
+      if (isPreEvent[k]) {
+        modelData.cost.dfduu.resize(0, 0);
+        modelData.dynamics.dfdu.resize(stateDim, 0);
+      }
+    }
+    Sm = ocs2::LinearAlgebra::generateSPDmatrix<ocs2::matrix_t>(stateDim);
+    Sv = ocs2::vector_t::Random(stateDim);
+  }
+
+  std::vector<ocs2::riccati_scan::Element> createElements() const {
+    std::vector<ocs2::riccati_scan::Element> elements(modelDataTrajectory.size());
+    for (size_t k = 0; k + 1 < elements.size(); k++) {
+      const auto& modelData = modelDataTrajectory[k];
+      elements[k] = isPreEvent[k] ? ocs2::riccati_scan::createEventElement(modelData)
+                                  : ocs2::riccati_scan::createIntermediateElement(modelData, deltaQm(modelData.stateDim));
+    }
+    elements.back() = ocs2::riccati_scan::createFinalElement(Sm, Sv);
+    return elements;
+  }
+
+  /** The sequential Riccati recursion. */
+  void solveSequential(ocs2::matrix_array_t& SmTrajectory, ocs2::vector_array_t& SvTrajectory) const {
+    const size_t N = modelDataTrajectory.size();
+    SmTrajectory.resize(N);
+    SvTrajectory.resize(N);
+    SmTrajectory.back() = Sm;
+    SvTrajectory.back() = Sv;
+    for (int k = N - 2; k >= 0; k--) {
+      const auto& modelData = modelDataTrajectory[k];
+      const auto& SmNext = SmTrajectory[k + 1];
+      const auto& SvNext = SvTrajectory[k + 1];
+      if (isPreEvent[k]) {
+        ocs2::scalar_t s;
+        std::tie(SmTrajectory[k], SvTrajectory[k], s) = ocs2::riccatiTransversalityConditions(modelData, SmNext, SvNext, 0.0);
+        continue;
+      }
+      const auto& A = modelData.dynamics.dfdx;
+      const auto& B = modelData.dynamics.dfdu;
+      const ocs2::matrix_t Hm = modelData.cost.dfduu + B.transpose() * SmNext * B;
+      const ocs2::matrix_t Gm = modelData.cost.dfdux + B.transpose() * SmNext * A;
+      const ocs2::vector_t SvPlusSmHv = SvNext + SmNext * modelData.dynamicsBias;
+      const ocs2::vector_t Gv = modelData.cost.dfdu + B.transpose() * SvPlusSmHv;
+      const Eigen::LLT<ocs2::matrix_t> HmLlt(Hm);
+      SmTrajectory[k] = modelData.cost.dfdxx + deltaQm(modelData.stateDim) + A.transpose() * SmNext * A - Gm.transpose() * HmLlt.solve(Gm);
+      SvTrajectory[k] = modelData.cost.dfdx + A.transpose() * SvPlusSmHv - Gm.transpose() * HmLlt.solve(Gv);
+    }
+  }
+
+  static ocs2::matrix_t deltaQm(size_t stateDim) { return 1e-3 * ocs2::matrix_t::Identity(stateDim, stateDim); }
+
+  std::vector<ocs2::ModelData> modelDataTrajectory;
+  std::vector<bool> isPreEvent;
+  ocs2::matrix_t Sm;
+  ocs2::vector_t Sv;
+};
+
+/** A quadratic cost which regulates the state and the input to zero. */
+class RegulatorCost final : public ocs2::StateInputCost {
+ public:
+  RegulatorCost* clone() const override { return new RegulatorCost(*this); }
+
+  ocs2::scalar_t getValue(ocs2::scalar_t time, const ocs2::vector_t& x, const ocs2::vector_t& u, const ocs2::TargetTrajectories&,
+                          const ocs2::PreComputation&) const override {
+    return 0.5 * x.squaredNorm() + 0.05 * u.squaredNorm();
+  }
+
+  ocs2::ScalarFunctionQuadraticApproximation getQuadraticApproximation(ocs2::scalar_t time, const ocs2::vector_t& x,
+                                                                       const ocs2::vector_t& u,
+                                                                       const ocs2::TargetTrajectories& targetTrajectories,
+                                                                       const ocs2::PreComputation& preComp) const override {
+    ocs2::ScalarFunctionQuadraticApproximation L;
+    L.f = getValue(time, x, u, targetTrajectories, preComp);
+    L.dfdx = x;
+    L.dfdu = 0.1 * u;
+    L.dfdxx.setIdentity(x.size(), x.size());
+    L.dfdux.setZero(u.size(), x.size());
+    L.dfduu = 0.1 * ocs2::matrix_t::Identity(u.size(), u.size());
+    return L;
+  }
+};
+
+}  // unnamed namespace
+
+TEST(testDiscreteTimeRiccatiScan, matchesSequentialRecursion) {
+  constexpr size_t stateDim = 4;
+  constexpr size_t inputDim = 2;
+  constexpr ocs2::scalar_t precision = 1e-9;
+
+  for (const size_t N : {1, 2, 3, 7, 64, 101}) {
+    for (const size_t nThreads : {1, 3}) {
+      const DiscreteLqProblem problem(stateDim, inputDim, N, 20);
+
+      ocs2::matrix_array_t SmTrajectory;
+      ocs2::vector_array_t SvTrajectory;
+      problem.solveSequential(SmTrajectory, SvTrajectory);
+
+      ocs2::ThreadPool threadPool(nThreads - 1);
+      auto elements = problem.createElements();
+      ocs2::riccati_scan::suffixScan(threadPool, nThreads, elements);
+
+      for (size_t k = 0; k < N; k++) {
+        EXPECT_TRUE(elements[k].J.isApprox(SmTrajectory[k], precision)) << "N: " << N << ", time step: " << k;
+        EXPECT_TRUE(elements[k].eta.isApprox(SvTrajectory[k], precision)) << "N: " << N << ", time step: " << k;
+      }
+    }
+  }
+}
+
+TEST(testDiscreteTimeRiccatiScan, rejectsIndefiniteInputHessian) {
+  constexpr size_t stateDim = 4;
+  constexpr size_t inputDim = 2;
+  const DiscreteLqProblem problem(stateDim, inputDim, 2, 20);
+
+  auto modelData = problem.modelDataTrajectory.front();
+  const ocs2::matrix_t deltaQm = ocs2::matrix_t::Zero(stateDim, stateDim);
+  ASSERT_NO_THROW(ocs2::riccati_scan::createIntermediateElement(modelData, deltaQm));
+
+  modelData.cost.dfduu = -ocs2::matrix_t::Identity(inputDim, inputDim);
+  EXPECT_THROW(ocs2::riccati_scan::createIntermediateElement(modelData, deltaQm), std::runtime_error);
+}
+
+TEST(testDiscreteTimeRiccatiScan, ilqrMatchesRecursion) {
+  // double integrator
+  const ocs2::matrix_t A = (ocs2::matrix_t(2, 2) << 0.0, 1.0, 0.0, 0.0).finished();
+  const ocs2::matrix_t B = (ocs2::matrix_t(2, 1) << 0.0, 1.0).finished();
+  const ocs2::LinearSystemDynamics dynamics(A, B);
+
+  ocs2::OptimalControlProblem problem;
+  problem.dynamicsPtr.reset(dynamics.clone());
+  problem.costPtr->add("regulator", std::unique_ptr<ocs2::StateInputCost>(new RegulatorCost));
+
+  ocs2::rollout::Settings rolloutSettings;
+  rolloutSettings.timeStep = 0.01;
+  rolloutSettings.integratorType = ocs2::IntegratorType::RK4;
+  const ocs2::TimeTriggeredRollout rollout(dynamics, rolloutSettings);
+  const ocs2::DefaultInitializer initializer(1);
+
+  // the recursion runs on a single thread, since otherwise it uses the value function of the previous iteration
+  ocs2::ddp::Settings ddpSettings;
+  ddpSettings.algorithm_ = ocs2::ddp::Algorithm::ILQR;
+  ddpSettings.nThreads_ = 1;
+  ddpSettings.displayInfo_ = false;
+  ddpSettings.displayShortSummary_ = false;
+  ddpSettings.timeStep_ = 0.01;
+  ddpSettings.backwardPassIntegratorType_ = ocs2::IntegratorType::RK4;
+  ddpSettings.maxNumIterations_ = 5;
+  auto scanDdpSettings = ddpSettings;
+  scanDdpSettings.nThreads_ = 3;
+  scanDdpSettings.useRiccatiScan_ = true;
+  scanDdpSettings.checkNumericalStability_ = true;
+
+  ocs2::ILQR ilqr(ddpSettings, rollout, problem, initializer);
+  ocs2::ILQR scanIlqr(scanDdpSettings, rollout, problem, initializer);
+
+  const ocs2::vector_t initState = (ocs2::vector_t(2) << 1.0, 0.0).finished();
+  ilqr.run(0.0, initState, 5.0);
+  scanIlqr.run(0.0, initState, 5.0);
+
+  const auto& primalSolution = ilqr.primalSolution(5.0);
+  const auto& scanPrimalSolution = scanIlqr.primalSolution(5.0);
+  EXPECT_NEAR(scanIlqr.getPerformanceIndeces().cost, ilqr.getPerformanceIndeces().cost, 1e-9);
+  ASSERT_EQ(scanPrimalSolution.stateTrajectory_.size(), primalSolution.stateTrajectory_.size());
+  for (size_t k = 0; k < primalSolution.stateTrajectory_.size(); k++) {
+    EXPECT_LT((scanPrimalSolution.stateTrajectory_[k] - primalSolution.stateTrajectory_[k]).norm(), 1e-9) << "time step: " << k;
+    EXPECT_LT((scanPrimalSolution.inputTrajectory_[k] - primalSolution.inputTrajectory_[k]).norm(), 1e-9) << "time step: " << k;
+  }
+}
+
+TEST(testDiscreteTimeRiccatiScan, ilqrRejectsUnsupportedSettings) {
+  const ocs2::matrix_t A = (ocs2::matrix_t(2, 2) << 0.0, 1.0, 0.0, 0.0).finished();
+  const ocs2::matrix_t B = (ocs2::matrix_t(2, 1) << 0.0, 1.0).finished();
+  const ocs2::LinearSystemDynamics dynamics(A, B);
+
+  ocs2::OptimalControlProblem problem;
+  problem.dynamicsPtr.reset(dynamics.clone());
+  problem.costPtr->add("regulator", std::unique_ptr<ocs2::StateInputCost>(new RegulatorCost));
+
+  const ocs2::TimeTriggeredRollout rollout(dynamics, ocs2::rollout::Settings());
+  const ocs2::DefaultInitializer initializer(1);
+
+  ocs2::ddp::Settings ddpSettings;
+  ddpSettings.algorithm_ = ocs2::ddp::Algorithm::ILQR;
+  ddpSettings.useRiccatiScan_ = true;
+  EXPECT_NO_THROW(ocs2::ILQR(ddpSettings, rollout, problem, initializer));
+
+  for (const auto strategy : {ocs2::hessian_correction::Strategy::CHOLESKY_MODIFICATION,
+                              ocs2::hessian_correction::Strategy::EIGENVALUE_MODIFICATION,
+                              ocs2::hessian_correction::Strategy::GERSHGORIN_MODIFICATION}) {
+    auto unsupportedSettings = ddpSettings;
+    unsupportedSettings.lineSearch_.hessianCorrectionStrategy = strategy;
+    EXPECT_THROW(ocs2::ILQR(unsupportedSettings, rollout, problem, initializer), std::runtime_error)
+        << ocs2::hessian_correction::toString(strategy);
+  }
+
+  auto riskSensitiveSettings = ddpSettings;
+  riskSensitiveSettings.riskSensitiveCoeff_ = 1e-3;
+  EXPECT_THROW(ocs2::ILQR(riskSensitiveSettings, rollout, problem, initializer), std::runtime_error);
+}
+
+TEST(testDiscreteTimeRiccatiScan, DISABLED_scalingBenchmark) {
+  constexpr size_t stateDim = 12;
+  constexpr size_t inputDim = 4;
+  constexpr size_t numRepeats = 10;
+
+  std::cerr << "\n### Riccati scan vs. sequential recursion (stateDim: " << stateDim << ", inputDim: " << inputDim << ")\n";
+  std::cerr << "    N    sequential [ms]    scan (#threads: [ms])\n";
+  for (const size_t N : {64, 256, 1024}) {
+    const DiscreteLqProblem problem(stateDim, inputDim, N, 0);
+
+    ocs2::benchmark::RepeatedTimer sequentialTimer;
+    ocs2::matrix_array_t SmTrajectory;
+    ocs2::vector_array_t SvTrajectory;
+    for (size_t i = 0; i < numRepeats; i++) {
+      sequentialTimer.startTimer();
+      problem.solveSequential(SmTrajectory, SvTrajectory);
+      sequentialTimer.endTimer();
+    }
+    std::cerr << "  " << N << "    " << sequentialTimer.getAverageInMilliseconds() << "    ";
+
+    for (const size_t nThreads : {1, 2, 4}) {
+      ocs2::ThreadPool threadPool(nThreads - 1);
+      ocs2::benchmark::RepeatedTimer scanTimer;
+      for (size_t i = 0; i < numRepeats; i++) {
+        auto elements = problem.createElements();
+        scanTimer.startTimer();
+        ocs2::riccati_scan::suffixScan(threadPool, nThreads, elements);
+        scanTimer.endTimer();
+        ASSERT_TRUE(elements.front().J.isApprox(SmTrajectory.front(), 1e-6));
+      }
+      std::cerr << nThreads << ": " << scanTimer.getAverageInMilliseconds() << "  ";
+    }
+    std::cerr << "\n";
+  }
+}
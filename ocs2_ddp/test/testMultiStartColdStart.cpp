@@ -0,0 +1,278 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <iostream>
+#include <memory>
+
+#include <ocs2_core/cost/StateInputCost.h>
+#include <ocs2_core/dynamics/LinearSystemDynamics.h>
+#include <ocs2_core/initialization/DefaultInitializer.h>
+#include <ocs2_core/misc/Benchmark.h>
+#include <ocs2_core/misc/LinearInterpolation.h>
+#include <ocs2_ddp/GaussNewtonDDP_MPC.h>
+#include <ocs2_ddp/ILQR.h>
+#include <ocs2_mpc/MpcTrace.h>
+#include <ocs2_mpc/MultiStartColdStart.h>
+#include <ocs2_oc/oc_problem/OptimalControlProblem.h>
+#include <ocs2_oc/rollout/TimeTriggeredRollout.h>
+#include <ocs2_oc/synchronized_module/ReferenceManager.h>
+
+namespace {
+
+/** Double-well cost on a single integrator. The well at x = -1 is deeper than the one at x = +1. */
+class DoubleWellCost final : public ocs2::StateInputCost {
+ public:
+  DoubleWellCost* clone() const override { return new DoubleWellCost(*this); }
+
+  ocs2::scalar_t getValue(ocs2::scalar_t time, const ocs2::vector_t& x, const ocs2::vector_t& u, const ocs2::TargetTrajectories&,
+                          const ocs2::PreComputation&) const override {
+    const ocs2::scalar_t s = x(0) * x(0) - 1.0;
+    return s * s + tilt * x(0) + 0.5 * r * u(0) * u(0);
+  }
+
+  ocs2::ScalarFunctionQuadraticApproximation getQuadraticApproximation(ocs2::scalar_t time, const ocs2::vector_t& x,
+                                                                       const ocs2::vector_t& u,
+                                                                       const ocs2::TargetTrajectories& targetTrajectories,
+                                                                       const ocs2::PreComputation& preComp) const override {
+    ocs2::ScalarFunctionQuadraticApproximation L;
+    L.f = getValue(time, x, u, targetTrajectories, preComp);
+    L.dfdx = (ocs2::vector_t(1) << 4.0 * x(0) * (x(0) * x(0) - 1.0) + tilt).finished();
+    L.dfdu = (ocs2::vector_t(1) << r * u(0)).finished();
+    // Gauss-Newton like convexification of the state Hessian
+    L.dfdxx = (ocs2::matrix_t(1, 1) << std::max(12.0 * x(0) * x(0) - 4.0, 1e-3)).finished();
+    L.dfdux = ocs2::matrix_t::Zero(1, 1);
+    L.dfduu = (ocs2::matrix_t(1, 1) << r).finished();
+    return L;
+  }
+
+ private:
+  static constexpr ocs2::scalar_t tilt = 0.3;
+  static constexpr ocs2::scalar_t r = 0.1;
+};
+
+constexpr ocs2::scalar_t DoubleWellCost::tilt;
+constexpr ocs2::scalar_t DoubleWellCost::r;
+
+/** Initializes the trajectories by applying a constant input. */
+class ConstantInputInitializer final : public ocs2::Initializer {
+ public:
+  explicit ConstantInputInitializer(ocs2::scalar_t input) : input_(input) {}
+  ConstantInputInitializer* clone() const override { return new ConstantInputInitializer(*this); }
+
+  void compute(ocs2::scalar_t time, const ocs2::vector_t& state, ocs2::scalar_t nextTime, ocs2::vector_t& input,
+               ocs2::vector_t& nextState) override {
+    input = ocs2::vector_t::Constant(1, input_);
+    nextState = state + (nextTime - time) * input;
+  }
+
+ private:
+  ocs2::scalar_t input_;
+};
+
+/** Counts the updates of the references. */
+class CountingReferenceManager final : public ocs2::ReferenceManager {
+ public:
+  size_t numUpdates = 0;
+
+ private:
+  void modifyReferences(ocs2::scalar_t initTime, ocs2::scalar_t finalTime, const ocs2::vector_t& initState,
+                        ocs2::TargetTrajectories& targetTrajectories, ocs2::ModeSchedule& modeSchedule) override {
+    numUpdates++;
+  }
+};
+
+}  // namespace
+
+class MultiStartColdStartTest : public testing::Test {
+ protected:
+  MultiStartColdStartTest()
+      : dynamics(ocs2::matrix_t::Zero(1, 1), ocs2::matrix_t::Identity(1, 1)), rollout(dynamics, getRolloutSettings()) {
+    problem.dynamicsPtr.reset(dynamics.clone());
+    problem.costPtr->add("doubleWell", std::unique_ptr<ocs2::StateInputCost>(new DoubleWellCost));
+
+    mpcSettings.timeHorizon_ = finalTime - initTime;
+    mpcSettings.debugPrint_ = false;
+
+    ddpSettings.algorithm_ = ocs2::ddp::Algorithm::ILQR;
+    ddpSettings.nThreads_ = 1;
+    ddpSettings.displayInfo_ = false;
+    ddpSettings.displayShortSummary_ = false;
+    ddpSettings.timeStep_ = 0.01;
+    ddpSettings.backwardPassIntegratorType_ = ocs2::IntegratorType::RK4;
+    ddpSettings.maxNumIterations_ = 50;
+    ddpSettings.minRelCost_ = 1e-6;
+    ddpSettings.lineSearch_.minStepLength = 1e-3;
+  }
+
+  static ocs2::rollout::Settings getRolloutSettings() {
+    ocs2::rollout::Settings rolloutSettings;
+    rolloutSettings.timeStep = 0.01;
+    rolloutSettings.integratorType = ocs2::IntegratorType::RK4;
+    return rolloutSettings;
+  }
+
+  std::unique_ptr<ocs2::MultiStartColdStart> getMultiStartColdStart() const {
+    const auto factory = [this](size_t startIndex) {
+      return std::unique_ptr<ocs2::SolverBase>(
+          new ocs2::ILQR(ddpSettings, rollout, problem, ConstantInputInitializer(startInputs[startIndex])));
+    };
+    return std::unique_ptr<ocs2::MultiStartColdStart>(new ocs2::MultiStartColdStart(startInputs.size(), factory));
+  }
+
+  const ocs2::scalar_t initTime = 0.0;
+  const ocs2::scalar_t finalTime = 3.0;
+  const ocs2::vector_t initState = ocs2::vector_t::Constant(1, 0.3);  // in the basin of the shallow well
+  const std::vector<ocs2::scalar_t> startInputs{0.0, -1.0, 1.0, -0.5};
+
+  ocs2::LinearSystemDynamics dynamics;
+  ocs2::TimeTriggeredRollout rollout;
+  ocs2::OptimalControlProblem problem;
+  ocs2::mpc::Settings mpcSettings;
+  ocs2::ddp::Settings ddpSettings;
+};
+
+TEST_F(MultiStartColdStartTest, selectsBestStart) {
+  auto multiStartColdStartPtr = getMultiStartColdStart();
+  ocs2::ReferenceManager referenceManager;
+  const auto bestStart = multiStartColdStartPtr->run(initTime, initState, finalTime, referenceManager);
+
+  const auto& performances = multiStartColdStartPtr->getPerformanceIndeces();
+  ASSERT_EQ(performances.size(), startInputs.size());
+  for (const auto& performance : performances) {
+    EXPECT_GE(performance.merit, performances[bestStart].merit);
+  }
+  // the zero input start converges to the shallow well
+  EXPECT_LT(performances[bestStart].merit, performances[0].merit);
+  EXPECT_LT(multiStartColdStartPtr->getBestPrimalSolution().stateTrajectory_.back()(0), 0.0);
+}
+
+TEST_F(MultiStartColdStartTest, updatesReferencesOnce) {
+  const ocs2::DefaultInitializer initializer(1);
+  ocs2::GaussNewtonDDP_MPC mpc(mpcSettings, ddpSettings, rollout, problem, initializer);
+  auto referenceManagerPtr = std::make_shared<CountingReferenceManager>();
+  mpc.getSolverPtr()->setReferenceManager(referenceManagerPtr);
+  mpc.setMultiStartColdStart(getMultiStartColdStart());
+
+  // the starts and the MPC solver share the references of the first iteration
+  ASSERT_TRUE(mpc.run(initTime, initState));
+  EXPECT_EQ(referenceManagerPtr->numUpdates, 1);
+  // the MPC solver is warm started from the best start which has converged to the deep well
+  const auto solution = mpc.getSolverPtr()->primalSolution(mpc.getSolverPtr()->getFinalTime());
+  EXPECT_LT(solution.stateTrajectory_.back()(0), 0.0);
+
+  ASSERT_TRUE(mpc.run(initTime + 0.1, initState));
+  EXPECT_EQ(referenceManagerPtr->numUpdates, 2);
+}
+
+TEST_F(MultiStartColdStartTest, replaysRecordedTrace) {
+  const std::string filePath = "/tmp/ocs2_multi_start_trace_test.bin";
+  const ocs2::DefaultInitializer initializer(1);
+  ocs2::GaussNewtonDDP_MPC mpc(mpcSettings, ddpSettings, rollout, problem, initializer);
+  mpc.setMultiStartColdStart(getMultiStartColdStart());
+  mpc.setTraceRecorder(std::make_shared<ocs2::MpcTraceRecorder>(filePath));
+  const ocs2::TargetTrajectories frameTargetTrajectories({initTime}, {ocs2::vector_t::Ones(1)}, {ocs2::vector_t::Zero(1)});
+  mpc.getSolverPtr()->getReferenceManager().setFrameTargetTrajectories(frameTargetTrajectories, 0);
+
+  // a few MPC iterations along the predicted trajectory
+  std::vector<ocs2::PrimalSolution> solutions;
+  ocs2::SystemObservation observation;
+  observation.time = initTime;
+  observation.state = initState;
+  observation.input = ocs2::vector_t::Zero(1);
+  for (size_t i = 0; i < 4; i++) {
+    ASSERT_TRUE(mpc.run(observation));
+    solutions.push_back(mpc.getSolverPtr()->primalSolution(mpc.getSolverPtr()->getFinalTime()));
+    const auto& solution = solutions.back();
+    observation.time += 0.1;
+    observation.state = ocs2::LinearInterpolation::interpolate(observation.time, solution.timeTrajectory_, solution.stateTrajectory_);
+    observation.input = ocs2::LinearInterpolation::interpolate(observation.time, solution.timeTrajectory_, solution.inputTrajectory_);
+  }
+  mpc.setTraceRecorder(nullptr);  // closes the trace file
+
+  // the replay reproduces the MPC solutions: the first iteration from the recorded best start, the others from the previous solution
+  ocs2::ILQR solver(ddpSettings, rollout, problem, initializer);
+  const auto callback = [&](size_t index, const ocs2::MpcTraceRecord& record, const ocs2::SolverBase& replayedSolver) {
+    EXPECT_EQ(record.continuesPreviousRecord, index > 0);
+    EXPECT_EQ(ocs2::hasWarmStart(record), index == 0);
+    EXPECT_EQ(record.observation.input.size(), 1);
+    const auto& referenceManager = replayedSolver.getReferenceManager();
+    ASSERT_EQ(referenceManager.getNumTargetFrames(), 1);
+    EXPECT_EQ(referenceManager.getFrameTargetTrajectories(0).stateTrajectory, frameTargetTrajectories.stateTrajectory);
+    const auto solution = replayedSolver.primalSolution(replayedSolver.getFinalTime());
+    EXPECT_EQ(solution.timeTrajectory_, solutions[index].timeTrajectory_);
+    EXPECT_EQ(solution.stateTrajectory_, solutions[index].stateTrajectory_);
+  };
+  EXPECT_EQ(ocs2::replayMpcTrace(filePath, solver, callback), solutions.size());
+  std::remove(filePath.c_str());
+}
+
+TEST_F(MultiStartColdStartTest, DISABLED_benchmark) {
+  constexpr size_t numRepetitions = 20;
+
+  const ocs2::DefaultInitializer initializer(1);
+  ocs2::GaussNewtonDDP_MPC singleStartMpc(mpcSettings, ddpSettings, rollout, problem, initializer);
+  ocs2::GaussNewtonDDP_MPC multiStartMpc(mpcSettings, ddpSettings, rollout, problem, initializer);
+  auto multiStartColdStartPtr = getMultiStartColdStart();
+  const auto& multiStartColdStart = *multiStartColdStartPtr;
+  multiStartMpc.setMultiStartColdStart(std::move(multiStartColdStartPtr));
+
+  ocs2::benchmark::RepeatedTimer singleStartTimer;
+  ocs2::benchmark::RepeatedTimer multiStartTimer;
+  ocs2::scalar_t singleStartMerit = 0.0;
+  ocs2::scalar_t multiStartMerit = 0.0;
+  for (size_t i = 0; i < numRepetitions; i++) {
+    singleStartMpc.reset();
+    singleStartTimer.startTimer();
+    singleStartMpc.run(initTime, initState);
+    singleStartTimer.endTimer();
+    singleStartMerit = singleStartMpc.getSolverPtr()->getPerformanceIndeces().merit;
+
+    multiStartMpc.reset();
+    multiStartTimer.startTimer();
+    multiStartMpc.run(initTime, initState);
+    multiStartTimer.endTimer();
+    multiStartMerit = multiStartMpc.getSolverPtr()->getPerformanceIndeces().merit;
+  }
+
+  EXPECT_LT(multiStartMerit, singleStartMerit);
+
+  std::cerr << "\n########################################################################\n";
+  std::cerr << "First MPC solve from " << startInputs.size() << " starts\n";
+  std::cerr << "Single start: " << singleStartTimer.getAverageInMilliseconds() << " [ms], merit: " << singleStartMerit << "\n";
+  std::cerr << "Multi start:  " << multiStartTimer.getAverageInMilliseconds() << " [ms], merit: " << multiStartMerit << "\n";
+  std::cerr << "Merit of the starts:";
+  for (const auto& performance : multiStartColdStart.getPerformanceIndeces()) {
+    std::cerr << " " << performance.merit;
+  }
+  std::cerr << "\n";
+}
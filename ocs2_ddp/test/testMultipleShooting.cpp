@@ -0,0 +1,148 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <memory>
+
+#include <ocs2_core/cost/QuadraticStateCost.h>
+#include <ocs2_core/cost/QuadraticStateInputCost.h>
+#include <ocs2_core/dynamics/SystemDynamicsBase.h>
+#include <ocs2_core/initialization/DefaultInitializer.h>
+#include <ocs2_ddp/ILQR.h>
+#include <ocs2_ddp/SLQ.h>
+#include <ocs2_oc/oc_problem/OptimalControlProblem.h>
+#include <ocs2_oc/rollout/TimeTriggeredRollout.h>
+#include <ocs2_oc/synchronized_module/ReferenceManager.h>
+
+namespace {
+
+/** Torque-actuated pendulum: x = [angle, angular velocity], u = torque. */
+class PendulumDynamics final : public ocs2::SystemDynamicsBase {
+ public:
+  PendulumDynamics* clone() const override { return new PendulumDynamics(*this); }
+
+  ocs2::vector_t computeFlowMap(ocs2::scalar_t t, const ocs2::vector_t& x, const ocs2::vector_t& u, const ocs2::PreComputation&) override {
+    return (ocs2::vector_t(2) << x(1), -std::sin(x(0)) + u(0)).finished();
+  }
+
+  ocs2::VectorFunctionLinearApproximation linearApproximation(ocs2::scalar_t t, const ocs2::vector_t& x, const ocs2::vector_t& u,
+                                                              const ocs2::PreComputation& preComp) override {
+    ocs2::VectorFunctionLinearApproximation dynamics;
+    dynamics.f = computeFlowMap(t, x, u, preComp);
+    dynamics.dfdx = (ocs2::matrix_t(2, 2) << 0.0, 1.0, -std::cos(x(0)), 0.0).finished();
+    dynamics.dfdu = (ocs2::matrix_t(2, 1) << 0.0, 1.0).finished();
+    return dynamics;
+  }
+};
+
+}  // unnamed namespace
+
+class MultipleShootingTest : public testing::TestWithParam<ocs2::ddp::Algorithm> {
+ protected:
+  static constexpr ocs2::scalar_t timeStep = 0.01;
+
+  MultipleShootingTest() : initializer(1) {
+    problem.dynamicsPtr.reset(new PendulumDynamics);
+    const ocs2::matrix_t Q = (ocs2::matrix_t(2, 2) << 10.0, 0.0, 0.0, 1.0).finished();
+    const ocs2::matrix_t R = ocs2::matrix_t::Constant(1, 1, 0.1);
+    problem.costPtr->add("cost", std::unique_ptr<ocs2::StateInputCost>(new ocs2::QuadraticStateInputCost(Q, R)));
+    problem.finalCostPtr->add("finalCost", std::unique_ptr<ocs2::StateCost>(new ocs2::QuadraticStateCost(100.0 * Q)));
+
+    // swing the pendulum up to a displaced angle
+    const ocs2::TargetTrajectories targetTrajectories({startTime}, {(ocs2::vector_t(2) << 1.0, 0.0).finished()}, {ocs2::vector_t::Zero(1)});
+    referenceManagerPtr = std::make_shared<ocs2::ReferenceManager>(std::vector<ocs2::TargetTrajectories>{targetTrajectories},
+                                                                   targetTrajectories);
+  }
+
+  ocs2::ddp::Settings getSettings(size_t numShootingSegments) const {
+    ocs2::ddp::Settings ddpSettings;
+    ddpSettings.algorithm_ = GetParam();
+    ddpSettings.nThreads_ = 4;
+    ddpSettings.displayInfo_ = false;
+    ddpSettings.displayShortSummary_ = false;
+    ddpSettings.absTolODE_ = 1e-9;
+    ddpSettings.relTolODE_ = 1e-7;
+    ddpSettings.maxNumStepsPerSecond_ = 10000;
+    ddpSettings.timeStep_ = timeStep;
+    ddpSettings.backwardPassIntegratorType_ =
+        (ddpSettings.algorithm_ == ocs2::ddp::Algorithm::SLQ) ? ocs2::IntegratorType::ODE45 : ocs2::IntegratorType::RK4;
+    ddpSettings.maxNumIterations_ = 30;
+    ddpSettings.minRelCost_ = 1e-6;
+    ddpSettings.strategy_ = ocs2::search_strategy::Type::LINE_SEARCH;
+    ddpSettings.numShootingSegments_ = numShootingSegments;
+    return ddpSettings;
+  }
+
+  ocs2::PerformanceIndex solve(size_t numShootingSegments) const {
+    const auto ddpSettings = getSettings(numShootingSegments);
+
+    ocs2::rollout::Settings rolloutSettings;
+    rolloutSettings.timeStep = timeStep;
+    rolloutSettings.integratorType = ocs2::IntegratorType::RK4;
+    const PendulumDynamics dynamics;
+    const ocs2::TimeTriggeredRollout rollout(dynamics, rolloutSettings);
+
+    std::unique_ptr<ocs2::GaussNewtonDDP> solverPtr;
+    if (ddpSettings.algorithm_ == ocs2::ddp::Algorithm::SLQ) {
+      solverPtr.reset(new ocs2::SLQ(ddpSettings, rollout, problem, initializer));
+    } else {
+      solverPtr.reset(new ocs2::ILQR(ddpSettings, rollout, problem, initializer));
+    }
+    solverPtr->setReferenceManager(referenceManagerPtr);
+    solverPtr->run(startTime, initState, finalTime);
+    return solverPtr->getPerformanceIndeces();
+  }
+
+  const ocs2::scalar_t startTime = 0.0;
+  const ocs2::scalar_t finalTime = 3.0;
+  const ocs2::vector_t initState = ocs2::vector_t::Zero(2);
+
+  ocs2::OptimalControlProblem problem;
+  ocs2::DefaultInitializer initializer;
+  std::shared_ptr<ocs2::ReferenceManager> referenceManagerPtr;
+};
+
+constexpr ocs2::scalar_t MultipleShootingTest::timeStep;
+
+TEST_P(MultipleShootingTest, convergence) {
+  const auto singleShooting = solve(1);
+  const auto multipleShooting = solve(8);
+
+  // the multiple-shooting solution closes its defects (up to the accuracy of the rollout integrator) and reaches the same optimum
+  EXPECT_LT(multipleShooting.dynamicsViolationSSE, 1e-6);
+  EXPECT_NEAR(multipleShooting.cost, singleShooting.cost, 1e-3 * singleShooting.cost);
+}
+
+INSTANTIATE_TEST_CASE_P(MultipleShootingTestCase, MultipleShootingTest,
+                        testing::ValuesIn({ocs2::ddp::Algorithm::SLQ, ocs2::ddp::Algorithm::ILQR}),
+                        [](const testing::TestParamInfo<MultipleShootingTest::ParamType>& info) {
+                          return ocs2::ddp::toAlgorithmName(info.param);
+                        });
@@ -51,8 +51,10 @@ class FrankWolfeDescentDirection {
    * Constructor.
    *
    * @param [in] display:
+   * @param [in] warmStart: If true, the linear program is kept between the calls of run(). As long as the constraint Jacobians do
+   * not change, only the cost and the bounds are updated and the dual simplex is warm-started from the previous basis.
    */
-  explicit FrankWolfeDescentDirection(bool display);
+  explicit FrankWolfeDescentDirection(bool display, bool warmStart = true);
 
   /**
    * Default destructor.
@@ -84,18 +86,42 @@ class FrankWolfeDescentDirection {
   void instantiateGLPK();
 
   /**
-   * Sets up Frank-Wolfe linear program.
+   * Checks whether the linear program of the previous call can be reused, i.e. the number of parameters and the constraint
+   * Jacobians have not changed.
+   *
+   * @param [in] parameterDim: The number of parameters.
+   * @param [in] dgdx: The Jacobian of the domain equality constraints.
+   * @param [in] dhdx: The Jacobian of the domain inequality constraints.
+   */
+  bool isLPReusable(size_t parameterDim, const matrix_t& dgdx, const matrix_t& dhdx) const;
+
+  /**
+   * Sets up the variables and the constraint matrix of the Frank-Wolfe linear program.
+   *
+   * @param [in] parameterDim: The number of parameters.
+   * @param [in] dgdx: The Jacobian of the domain equality constraints.
+   * @param [in] dhdx: The Jacobian of the domain inequality constraints.
+   */
+  void setupLP(size_t parameterDim, const matrix_t& dgdx, const matrix_t& dhdx);
+
+  /**
+   * Updates the cost and the bounds of the Frank-Wolfe linear program.
    *
-   * @param [in] parameter: The value of parameter vector.
    * @param [in] gradient: The gradient at the current parameter vector.
    * @param [in] maxGradientInverse: descent directions element-wise maximum inverse, \f$ e_v \f$.
-   * @param [in] nlpConstraintsPtr: A pointer to the NLP constraints.
+   * @param [in] g: The domain equality constraints at the current parameter vector.
+   * @param [in] h: The domain inequality constraints at the current parameter vector.
    */
-  void setupLP(const vector_t& parameter, const vector_t& gradient, const vector_t& maxGradientInverse, NLP_Constraints* nlpConstraintsPtr);
+  void updateLP(const vector_t& gradient, const vector_t& maxGradientInverse, const vector_t& g, const vector_t& h);
 
   /***********
    * Variables
    **********/
+  bool warmStart_;
+  bool isLPInitialized_ = false;
+  matrix_t cachedDgdx_;
+  matrix_t cachedDhdx_;
+
   std::unique_ptr<glp_prob, void (*)(glp_prob*)> lpPtr_;
   std::unique_ptr<glp_smcp> lpOptionsPtr_;
 };
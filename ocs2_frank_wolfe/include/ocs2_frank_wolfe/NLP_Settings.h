@@ -44,7 +44,8 @@ class NLP_Settings {
         minRelCost_(1e-6),
         maxLearningRate_(1.0),
         minLearningRate_(0.05),
-        useAscendingLineSearchNLP_(true) {}
+        useAscendingLineSearchNLP_(true),
+        warmStartLP_(true) {}
 
   /** This value determines to display the log output.*/
   bool displayInfo_;
@@ -62,6 +63,11 @@ class NLP_Settings {
    * - \b Descending: The step size eventually decreases from the minimum value to the maximum.
    * */
   bool useAscendingLineSearchNLP_;
+  /**
+   * This value determines whether the Frank-Wolfe linear program is kept between iterations. If the constraint Jacobians do not
+   * change, only the cost and the bounds are updated and the dual simplex is warm-started from the previous basis.
+   */
+  bool warmStartLP_;
 };
 
 }  // namespace ocs2
@@ -34,8 +34,8 @@ namespace ocs2 {
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
-FrankWolfeDescentDirection::FrankWolfeDescentDirection(bool display)
-    : lpPtr_(glp_create_prob(), glp_delete_prob), lpOptionsPtr_(new glp_smcp) {
+FrankWolfeDescentDirection::FrankWolfeDescentDirection(bool display, bool warmStart)
+    : warmStart_(warmStart), lpPtr_(glp_create_prob(), glp_delete_prob), lpOptionsPtr_(new glp_smcp) {
   // set LP options
   glp_init_smcp(lpOptionsPtr_.get());
   if (!display) lpOptionsPtr_->msg_lev = GLP_MSG_ERR;
@@ -58,16 +58,68 @@ void FrankWolfeDescentDirection::instantiateGLPK() {
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
-void FrankWolfeDescentDirection::setupLP(const vector_t& parameter, const vector_t& gradient, const vector_t& maxGradientInverse,
-                                         NLP_Constraints* nlpConstraintsPtr) {
-  const size_t parameterDim = parameter.size();
+bool FrankWolfeDescentDirection::isLPReusable(size_t parameterDim, const matrix_t& dgdx, const matrix_t& dhdx) const {
+  if (!warmStart_ || !isLPInitialized_) return false;
+  if (static_cast<size_t>(glp_get_num_cols(lpPtr_.get())) != parameterDim) return false;
+  if (dgdx.rows() != cachedDgdx_.rows() || dgdx.cols() != cachedDgdx_.cols() || dgdx != cachedDgdx_) return false;
+  if (dhdx.rows() != cachedDhdx_.rows() || dhdx.cols() != cachedDhdx_.cols() || dhdx != cachedDhdx_) return false;
+  return true;
+}
 
-  // return if there is no parameter
-  if (parameterDim == 0) return;
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void FrankWolfeDescentDirection::setupLP(size_t parameterDim, const matrix_t& dgdx, const matrix_t& dhdx) {
+  const size_t numEqualities = dgdx.rows();
+  const size_t numInequalities = dhdx.rows();
 
   // set parameters limits
   glp_add_cols(lpPtr_.get(), parameterDim);
 
+  // set the total number of constraint limits
+  if (numEqualities + numInequalities > 0) glp_add_rows(lpPtr_.get(), numEqualities + numInequalities);
+  scalar_array_t values{0.1};     // 0 index is not used!
+  std::vector<int> xIndices{-1};  // 0 index is not used!
+  std::vector<int> yIndices{-1};  // 0 index is not used!
+
+  // domain equality constraints
+  for (size_t i = 0; i < numEqualities; i++) {
+    for (size_t j = 0; j < parameterDim; j++) {
+      if (!numerics::almost_eq(dgdx(i, j), 0.0)) {
+        values.push_back(dgdx(i, j));
+        xIndices.push_back(i + 1);
+        yIndices.push_back(j + 1);
+      }
+    }
+  }
+
+  // domain inequality constraints (placed after the equality rows)
+  for (size_t i = 0; i < numInequalities; i++) {
+    for (size_t j = 0; j < parameterDim; j++) {
+      if (!numerics::almost_eq(dhdx(i, j), 0.0)) {
+        values.push_back(dhdx(i, j));
+        xIndices.push_back(numEqualities + i + 1);
+        yIndices.push_back(j + 1);
+      }
+    }
+  }
+
+  // set the constraint coefficients
+  glp_load_matrix(lpPtr_.get(), values.size() - 1, xIndices.data(), yIndices.data(), values.data());
+
+  // cache the constraint matrix for the next call
+  cachedDgdx_ = dgdx;
+  cachedDhdx_ = dhdx;
+  isLPInitialized_ = true;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void FrankWolfeDescentDirection::updateLP(const vector_t& gradient, const vector_t& maxGradientInverse, const vector_t& g,
+                                          const vector_t& h) {
+  const size_t parameterDim = gradient.size();
+
   // set the LP cost function of Frank-Wolfe algorithm
   for (size_t i = 0; i < parameterDim; i++) glp_set_obj_coef(lpPtr_.get(), i + 1, gradient(i));
 
@@ -89,6 +141,32 @@ void FrankWolfeDescentDirection::setupLP(const vector_t& parameter, const vector
 
   }  // end of i loop
 
+  // domain equality constraints
+  for (size_t i = 0; i < g.size(); i++) {
+    glp_set_row_bnds(lpPtr_.get(), i + 1, GLP_FX, -g(i), -g(i));
+  }
+
+  // domain inequality constraints
+  for (size_t i = 0; i < h.size(); i++) {
+    glp_set_row_bnds(lpPtr_.get(), g.size() + i + 1, GLP_LO, -h(i), 0.0);
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void FrankWolfeDescentDirection::run(const vector_t& parameter, const vector_t& gradient, const vector_t& maxGradientInverse,
+                                     NLP_Constraints* nlpConstraintsPtr, vector_t& fwDescentDirection) {
+  if (gradient.size() != parameter.size()) throw std::runtime_error("The gradient vector size is incompatible to the parameter size.");
+  if (maxGradientInverse.size() != gradient.size())
+    throw std::runtime_error("The gradient limit size is incompatible to the gradient size.");
+
+  const size_t parameterDim = parameter.size();
+  fwDescentDirection.setZero(parameterDim);
+
+  // return if there is no parameter
+  if (parameterDim == 0) return;
+
   // set the current parameter vector.
   nlpConstraintsPtr->setCurrentParameter(parameter);
 
@@ -105,6 +183,7 @@ void FrankWolfeDescentDirection::setupLP(const vector_t& parameter, const vector
     throw std::runtime_error(
         "calculateLinearEqualityConstraint: The number of rows of Jacobian matrix "
         "should be equal to the number of equality constraints.");
+  if (g.size() == 0) dgdx.resize(0, parameterDim);
 
   // get domain inequality constraints
   vector_t h;
@@ -119,62 +198,31 @@ void FrankWolfeDescentDirection::setupLP(const vector_t& parameter, const vector
     throw std::runtime_error(
         "calculateLinearInequalityConstraint: The number of rows of Jacobian matrix "
         "should be equal to the number of inequality constraints.");
+  if (h.size() == 0) dhdx.resize(0, parameterDim);
 
-  // set the total number of constraint limits
-  glp_add_rows(lpPtr_.get(), g.size() + h.size());
-  scalar_array_t values{0.1};     // 0 index is not used!
-  std::vector<int> xIndices{-1};  // 0 index is not used!
-  std::vector<int> yIndices{-1};  // 0 index is not used!
-
-  // domain equality constraints
-  for (size_t i = 0; i < g.size(); i++) {
-    for (size_t j = 0; j < parameterDim; j++) {
-      if (!numerics::almost_eq(dgdx(i, j), 0.0)) {
-        values.push_back(dgdx(i, j));
-        xIndices.push_back(i + 1);
-        yIndices.push_back(j + 1);
-      }
-    }
-    glp_set_row_bnds(lpPtr_.get(), i + 1, GLP_FX, -g(i), -g(i));
+  // setup LP. The constraint matrix and the basis of the previous call are kept if the constraint Jacobians are unchanged.
+  const bool isWarmStarted = isLPReusable(parameterDim, dgdx, dhdx);
+  if (!isWarmStarted) {
+    instantiateGLPK();
+    setupLP(parameterDim, dgdx, dhdx);
   }
-
-  // domain inequality constraints
-  for (size_t i = 0; i < h.size(); i++) {
-    for (size_t j = 0; j < parameterDim; j++) {
-      if (!numerics::almost_eq(dhdx(i, j), 0.0)) {
-        values.push_back(dhdx(i, j));
-        xIndices.push_back(i + 1);
-        yIndices.push_back(j + 1);
-      }
-    }
-    glp_set_row_bnds(lpPtr_.get(), i + 1, GLP_LO, -h(i), 0.0);
+  updateLP(gradient, maxGradientInverse, g, h);
+
+  // solve LP. Only the cost and the bounds change between the calls, hence the previous basis stays dual feasible in most cases.
+  // GLP_DUALP falls back to the primal simplex if the dual simplex fails.
+  lpOptionsPtr_->meth = isWarmStarted ? GLP_DUALP : GLP_PRIMAL;
+  const int lpReturnCode = glp_simplex(lpPtr_.get(), lpOptionsPtr_.get());
+  if (isWarmStarted && (lpReturnCode != 0 || glp_get_status(lpPtr_.get()) != GLP_OPT)) {
+    // the warm start has not found the optimum, solve the LP from scratch as without the warm start
+    instantiateGLPK();
+    setupLP(parameterDim, dgdx, dhdx);
+    updateLP(gradient, maxGradientInverse, g, h);
+    lpOptionsPtr_->meth = GLP_PRIMAL;
+    glp_simplex(lpPtr_.get(), lpOptionsPtr_.get());
   }
 
-  // set the constraint coefficients
-  glp_load_matrix(lpPtr_.get(), g.size() + h.size(), xIndices.data(), yIndices.data(), values.data());
-}
-
-/******************************************************************************************************/
-/******************************************************************************************************/
-/******************************************************************************************************/
-void FrankWolfeDescentDirection::run(const vector_t& parameter, const vector_t& gradient, const vector_t& maxGradientInverse,
-                                     NLP_Constraints* nlpConstraintsPtr, vector_t& fwDescentDirection) {
-  if (gradient.size() != parameter.size()) throw std::runtime_error("The gradient vector size is incompatible to the parameter size.");
-  if (maxGradientInverse.size() != gradient.size())
-    throw std::runtime_error("The gradient limit size is incompatible to the gradient size.");
-
-  // instantiate GLPK
-  instantiateGLPK();
-
-  // setup LP
-  setupLP(parameter, gradient, maxGradientInverse, nlpConstraintsPtr);
-
-  // solve LP
-  glp_simplex(lpPtr_.get(), lpOptionsPtr_.get());
-
   // get the solution
-  fwDescentDirection.resize(parameter.size());
-  for (size_t i = 0; i < parameter.size(); i++) fwDescentDirection(i) = glp_get_col_prim(lpPtr_.get(), i + 1);
+  for (size_t i = 0; i < parameterDim; i++) fwDescentDirection(i) = glp_get_col_prim(lpPtr_.get(), i + 1);
 
   // test
   if (gradient.dot(fwDescentDirection) > 0) throw std::runtime_error("Frank-Wolfe does not produce a descent direction.");
@@ -36,7 +36,8 @@ namespace ocs2 {
 /******************************************************************************************************/
 GradientDescent::GradientDescent(const NLP_Settings& nlpSettings)
 
-    : nlpSettings_(nlpSettings), frankWolfeDescentDirectionPtr_(new FrankWolfeDescentDirection(nlpSettings.displayInfo_)) {
+    : nlpSettings_(nlpSettings),
+      frankWolfeDescentDirectionPtr_(new FrankWolfeDescentDirection(nlpSettings.displayInfo_, nlpSettings.warmStartLP_)) {
   CleanFmtDisplay_ = Eigen::IOFormat(3, 0, ", ", "\n", "[", "]");
 }
 
@@ -0,0 +1,199 @@
+/******************************************************************************
+Copyright (c) 2017, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <gtest/gtest.h>
+#include <iostream>
+
+#include <ocs2_core/misc/Benchmark.h>
+
+#include "ocs2_frank_wolfe/GradientDescent.h"
+
+using namespace ocs2;
+
+/*
+ * A switching-time like problem: the parameters are event times which should be close to the desired ones
+ * while respecting t0 <= x_1 <= x_2 <= ... <= x_n <= tf.
+ */
+class EventTimesCost final : public NLP_Cost {
+ public:
+  explicit EventTimesCost(vector_t desiredEventTimes) : desiredEventTimes_(std::move(desiredEventTimes)) {}
+  ~EventTimesCost() = default;
+
+  size_t setCurrentParameter(const vector_t& x) override {
+    x_ = x;
+    return 0;
+  }
+
+  bool getCost(size_t id, scalar_t& f) override {
+    f = 0.5 * (x_ - desiredEventTimes_).squaredNorm();
+    return true;
+  }
+
+  void getCostDerivative(size_t id, vector_t& g) override { g = x_ - desiredEventTimes_; }
+
+  void getCostSecondDerivative(size_t id, matrix_t& H) override { H.setIdentity(x_.size(), x_.size()); }
+
+  void clearCache() override {}
+
+ private:
+  vector_t x_;
+  vector_t desiredEventTimes_;
+};
+
+class EventTimesConstraints final : public NLP_Constraints {
+ public:
+  EventTimesConstraints(size_t numEventTimes, scalar_t initTime, scalar_t finalTime) {
+    Cm_.setZero(numEventTimes + 1, numEventTimes);
+    Dv_.setZero(numEventTimes + 1);
+    // x_1 - t0 >= 0
+    Cm_(0, 0) = 1.0;
+    Dv_(0) = -initTime;
+    // x_{i+1} - x_i >= 0
+    for (size_t i = 1; i < numEventTimes; i++) {
+      Cm_(i, i - 1) = -1.0;
+      Cm_(i, i) = 1.0;
+    }
+    // tf - x_n >= 0
+    Cm_(numEventTimes, numEventTimes - 1) = -1.0;
+    Dv_(numEventTimes) = finalTime;
+  }
+
+  ~EventTimesConstraints() = default;
+
+  void setCurrentParameter(const vector_t& x) override { x_ = x; }
+
+  void getLinearInequalityConstraint(vector_t& h) override { h = Cm_ * x_ + Dv_; }
+
+  void getLinearInequalityConstraintDerivative(matrix_t& dhdx) override { dhdx = Cm_; }
+
+ private:
+  vector_t x_;
+  matrix_t Cm_;
+  vector_t Dv_;
+};
+
+TEST(FrankWolfeWarmStartTest, descentDirection) {
+  constexpr size_t numEventTimes = 8;
+  EventTimesConstraints constraints(numEventTimes, 0.0, 1.0);
+  const vector_t maxGradientInverse = vector_t::Constant(numEventTimes, 10.0);
+
+  FrankWolfeDescentDirection coldStarted(false, false);
+  FrankWolfeDescentDirection warmStarted(false, true);
+
+  vector_t parameter = vector_t::LinSpaced(numEventTimes, 0.1, 0.9);
+  for (size_t i = 0; i < 20; i++) {
+    const vector_t gradient = vector_t::Random(numEventTimes);
+    vector_t coldDirection, warmDirection;
+    coldStarted.run(parameter, gradient, maxGradientInverse, &constraints, coldDirection);
+    warmStarted.run(parameter, gradient, maxGradientInverse, &constraints, warmDirection);
+
+    EXPECT_TRUE(warmDirection.isApprox(coldDirection, 1e-6)) << "cold: " << coldDirection.transpose() << "\n"
+                                                              << "warm: " << warmDirection.transpose();
+    // take a feasible step
+    parameter += 0.1 * coldDirection;
+  }
+}
+
+TEST(FrankWolfeWarmStartTest, infeasibleLP) {
+  constexpr size_t numEventTimes = 4;
+  EventTimesConstraints constraints(numEventTimes, 0.0, 1.0);
+  const vector_t maxGradientInverse = vector_t::Constant(numEventTimes, 10.0);
+
+  FrankWolfeDescentDirection coldStarted(false, false);
+  FrankWolfeDescentDirection warmStarted(false, true);
+
+  // returns an empty direction if the solver has thrown
+  auto run = [&](FrankWolfeDescentDirection& solver, const vector_t& parameter, const vector_t& gradient) {
+    vector_t direction;
+    try {
+      solver.run(parameter, gradient, maxGradientInverse, &constraints, direction);
+    } catch (const std::runtime_error&) {
+      direction.resize(0);
+    }
+    return direction;
+  };
+
+  const vector_t feasibleParameter = vector_t::LinSpaced(numEventTimes, 0.2, 0.8);
+  // x_1 = -1 can not be recovered within the step bounds of 0.1, hence the LP is infeasible
+  vector_t infeasibleParameter = feasibleParameter;
+  infeasibleParameter(0) = -1.0;
+
+  for (const auto& parameter : {feasibleParameter, infeasibleParameter, feasibleParameter}) {
+    const vector_t gradient = vector_t::Random(numEventTimes);
+    const vector_t coldDirection = run(coldStarted, parameter, gradient);
+    const vector_t warmDirection = run(warmStarted, parameter, gradient);
+    ASSERT_EQ(warmDirection.size(), coldDirection.size());
+    EXPECT_TRUE(warmDirection.isApprox(coldDirection, 1e-6)) << "cold: " << coldDirection.transpose() << "\n"
+                                                              << "warm: " << warmDirection.transpose();
+  }
+}
+
+TEST(FrankWolfeWarmStartTest, DISABLED_upperLevelBenchmark) {
+  constexpr size_t numEventTimes = 16;
+  constexpr size_t numRepeats = 10;
+
+  NLP_Settings nlpSettings;
+  nlpSettings.displayInfo_ = false;
+  nlpSettings.maxIterations_ = 100;
+  nlpSettings.minRelCost_ = 1e-9;
+  nlpSettings.maxLearningRate_ = 1.0;
+  nlpSettings.minLearningRate_ = 1e-4;
+  nlpSettings.useAscendingLineSearchNLP_ = false;
+
+  // the desired event times are not ordered, hence the ordering constraints become active
+  const vector_t desiredEventTimes = 0.5 * (vector_t::Random(numEventTimes) + vector_t::Ones(numEventTimes));
+  const vector_t initParameters = vector_t::LinSpaced(numEventTimes, 0.05, 0.95);
+  const vector_t maxGradientInverse = vector_t::Constant(numEventTimes, 0.1);
+
+  auto solve = [&](bool warmStartLP, benchmark::RepeatedTimer& timer) {
+    nlpSettings.warmStartLP_ = warmStartLP;
+    scalar_t cost = 0.0;
+    for (size_t i = 0; i < numRepeats; i++) {
+      GradientDescent nlpSolver(nlpSettings);
+      EventTimesCost eventTimesCost(desiredEventTimes);
+      EventTimesConstraints eventTimesConstraints(numEventTimes, 0.0, 1.0);
+      timer.startTimer();
+      nlpSolver.run(initParameters, maxGradientInverse, &eventTimesCost, &eventTimesConstraints);
+      timer.endTimer();
+      nlpSolver.getCost(cost);
+    }
+    return cost;
+  };
+
+  benchmark::RepeatedTimer coldStartTimer;
+  benchmark::RepeatedTimer warmStartTimer;
+  const scalar_t coldStartCost = solve(false, coldStartTimer);
+  const scalar_t warmStartCost = solve(true, warmStartTimer);
+
+  std::cerr << "Upper-level loop with " << numEventTimes << " event times\n";
+  std::cerr << "  cold-started LP: " << coldStartTimer.getAverageInMilliseconds() << " [ms], cost: " << coldStartCost << "\n";
+  std::cerr << "  warm-started LP: " << warmStartTimer.getAverageInMilliseconds() << " [ms], cost: " << warmStartCost << "\n";
+
+  EXPECT_NEAR(warmStartCost, coldStartCost, 1e-6);
+}
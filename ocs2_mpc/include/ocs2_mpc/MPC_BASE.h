@@ -29,12 +29,17 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #pragma once
 
+#include <memory>
+
 #include <ocs2_core/Types.h>
 #include <ocs2_core/misc/Benchmark.h>
 
 #include <ocs2_oc/oc_solver/SolverBase.h>
 
 #include "ocs2_mpc/MPC_Settings.h"
+#include "ocs2_mpc/MpcTrace.h"
+#include "ocs2_mpc/MultiStartColdStart.h"
+#include "ocs2_mpc/SystemObservation.h"
 
 namespace ocs2 {
 
@@ -67,6 +72,14 @@ class MPC_BASE {
    */
   virtual bool run(scalar_t currentTime, const vector_t& currentState);
 
+  /**
+   * Runs MPC for the time and state of the given observation. Same as run(currentTime, currentState), but the input of the
+   * observation is recorded as well if a trace recorder is set.
+   *
+   * @param [in] observation: The current observation.
+   */
+  bool run(const SystemObservation& observation);
+
   /** Gets a pointer to the underlying solver used in the MPC. */
   virtual SolverBase* getSolverPtr() = 0;
 
@@ -79,6 +92,27 @@ class MPC_BASE {
   /** Gets the MPC settings. */
   const mpc::Settings& settings() const { return mpcSettings_; }
 
+  /**
+   * Sets a recorder which records the inputs of every MPC iteration (observation, references, and warm start) such that
+   * they can be replayed offline by replayMpcTrace. Pass nullptr to stop recording.
+   *
+   * @param [in] traceRecorderPtr: The trace recorder.
+   */
+  void setTraceRecorder(std::shared_ptr<MpcTraceRecorder> traceRecorderPtr) {
+    traceRecorderPtr_ = std::move(traceRecorderPtr);
+    isPreviousIterationRecorded_ = false;
+  }
+
+  /**
+   * Sets a multi-start initialization which replaces the cold start of the first MPC iteration (and of the first one after a
+   * reset). The MPC solver is then warm started from the best start. Pass nullptr to use the regular cold start.
+   *
+   * @param [in] multiStartColdStartPtr: The multi-start initialization.
+   */
+  void setMultiStartColdStart(std::unique_ptr<MultiStartColdStart> multiStartColdStartPtr) {
+    multiStartColdStartPtr_ = std::move(multiStartColdStartPtr);
+  }
+
  protected:
   /**
    * Solves the optimal control problem for the given state and time period ([initTime,finalTime]).
@@ -93,10 +127,35 @@ class MPC_BASE {
   bool isFirstMpcRun() const { return initRun_; }
 
  private:
+  /** Runs MPC for the given time and state. The input is only recorded in the trace. */
+  bool runMpc(scalar_t currentTime, const vector_t& currentState, const vector_t& currentInput);
+
+  /**
+   * Sets the warm start of the trace record before the solver run. The warm start is only copied from the solver if the
+   * previous iteration is not recorded; otherwise the replay reproduces it from the previous record.
+   */
+  void setTraceWarmStart();
+
+  /** Records the inputs of the latest MPC iteration. The warm start is already set in traceRecord_. */
+  void recordTrace(scalar_t currentTime, const vector_t& currentState, const vector_t& currentInput, scalar_t finalTime);
+
+  /**
+   * Runs the multi-start initialization on the references which the MPC solver has activated for its first iteration and returns
+   * the best start as the initial guess of the MPC solver.
+   */
+  const PrimalSolution& runMultiStartColdStart(scalar_t initTime, const vector_t& initState, scalar_t finalTime,
+                                               const ReferenceManagerInterface& referenceManager);
+
   bool initRun_ = true;
   const mpc::Settings mpcSettings_;
 
   benchmark::RepeatedTimer mpcTimer_;
+
+  std::shared_ptr<MpcTraceRecorder> traceRecorderPtr_;
+  MpcTraceRecord traceRecord_;
+  bool isPreviousIterationRecorded_ = false;
+
+  std::unique_ptr<MultiStartColdStart> multiStartColdStartPtr_;
 };
 
 }  // namespace ocs2
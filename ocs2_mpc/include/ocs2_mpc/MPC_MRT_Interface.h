@@ -67,6 +67,18 @@ class MPC_MRT_Interface final : public MRT_BASE {
   ReferenceManagerInterface& getReferenceManager();
   const ReferenceManagerInterface& getReferenceManager() const;
 
+  /**
+   * Enables the compensation of the MPC solve latency. Instead of the current observation, the MPC is solved from the state that
+   * the system is predicted to reach once the new policy is delivered. The prediction rolls out the latest MPC policy from the
+   * current observation over the expected latency, i.e. the average duration of the previous advanceMpc() calls.
+   *
+   * @param [in] rollout: The rollout which is used for the prediction. A copy of it is stored.
+   */
+  void enableLatencyCompensation(const RolloutBase& rollout);
+
+  /** Disables the compensation of the MPC solve latency. */
+  void disableLatencyCompensation();
+
   /**
    * Advance the mpc module for one iteration. The evaluation methods can be called while this method is running. They will evaluate the
    * control law that was up-to-date at the last updatePolicy() call.
@@ -123,12 +135,26 @@ class MPC_MRT_Interface final : public MRT_BASE {
    */
   void copyToBuffer(const SystemObservation& mpcInitObservation);
 
+  /**
+   * Predicts the observation after the given latency by rolling out the latest MPC policy. The observation is not modified if the
+   * rollout fails.
+   *
+   * @param [in] latency: The prediction horizon.
+   * @param [in, out] observation: The current observation which is advanced to the predicted one.
+   */
+  void predictObservation(scalar_t latency, SystemObservation& observation);
+
   MPC_BASE& mpc_;
   benchmark::RepeatedTimer mpcTimer_;
 
   // MPC inputs
   SystemObservation currentObservation_;
   std::mutex observationMutex_;
+
+  // latency compensation
+  std::unique_ptr<RolloutBase> latencyRolloutPtr_;
+  std::unique_ptr<ControllerBase> latestControllerPtr_;
+  ModeSchedule latestModeSchedule_;
 };
 
 }  // namespace ocs2
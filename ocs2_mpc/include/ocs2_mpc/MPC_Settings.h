@@ -56,6 +56,12 @@ struct Settings {
    * or the given operating trajectories (cold start). */
   bool coldStart_ = false;
 
+  /**
+   * The wall-clock time budget (in seconds) of each MPC iteration. The solver stops iterating once another iteration is not
+   * expected to fit in the budget and returns its best iterate. Any non-positive number disables the time budget.
+   */
+  scalar_t timeBudget_ = -1;
+
   /**
    * MPC loop frequency in Hz. This setting is only used in Dummy_Loop for testing. If set to a
    * positive number, THe MPC loop will be simulated to run by the given frequency (note that this
@@ -0,0 +1,179 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <cstdio>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <ocs2_core/Types.h>
+#include <ocs2_core/reference/ModeSchedule.h>
+#include <ocs2_core/reference/TargetTrajectories.h>
+#include <ocs2_oc/oc_data/PrimalSolution.h>
+#include <ocs2_oc/oc_solver/SolverBase.h>
+
+#include "ocs2_mpc/MPC_Settings.h"
+#include "ocs2_mpc/SystemObservation.h"
+
+namespace ocs2 {
+
+/**
+ * All the inputs of a single MPC iteration: the observation the solver was started from, the references it tracked, and
+ * the warm start it was initialized with. This is sufficient to replay the iteration offline.
+ */
+struct MpcTraceRecord {
+  /** The MPC settings. Only the ones which affect the solver run are recorded: coldStart_ and timeBudget_. */
+  mpc::Settings mpcSettings;
+  SystemObservation observation;
+  scalar_t finalTime = 0.0;
+  TargetTrajectories targetTrajectories;
+  /** The TargetTrajectories of the target frames, see ReferenceManagerInterface::getFrameTargetTrajectories(). */
+  std::vector<TargetTrajectories> frameTargetTrajectories;
+  ModeSchedule modeSchedule;
+  /**
+   * Whether the solver is warm started from its solution of the previous record. The warm start is then not recorded, since
+   * the replay continues from its own solution of the previous record.
+   */
+  bool continuesPreviousRecord = false;
+  /**
+   * The warm start of the solver. It is empty (no trajectories and no controller) for a cold start and for a record which
+   * continues the previous one.
+   */
+  PrimalSolution warmStart;
+};
+
+/** Whether the record carries a warm start or the solver has been cold started. */
+bool hasWarmStart(const MpcTraceRecord& record);
+
+/**
+ * Appends MpcTraceRecords to a binary trace file. Each record is serialized into a reused buffer and written with a single
+ * call, such that recording does not allocate in the steady state. All floating point data is stored in double precision
+ * so that the replay reproduces the recorded solver inputs bit by bit.
+ *
+ * The file starts with a header (magic number and format version) followed by the records, each one prefixed with its
+ * payload size in bytes.
+ */
+class MpcTraceRecorder {
+ public:
+  /**
+   * Constructor. Creates (or truncates) the trace file.
+   *
+   * @param [in] filePath: The path to the trace file.
+   */
+  explicit MpcTraceRecorder(const std::string& filePath);
+
+  /** Destructor. Flushes and closes the trace file. */
+  ~MpcTraceRecorder();
+
+  MpcTraceRecorder(const MpcTraceRecorder&) = delete;
+  MpcTraceRecorder& operator=(const MpcTraceRecorder&) = delete;
+
+  /** Appends a record to the trace file. */
+  void record(const MpcTraceRecord& record);
+
+  /** Flushes the written records to the file. */
+  void flush();
+
+  /** Number of the records written so far. */
+  size_t getNumRecords() const { return numRecords_; }
+
+ private:
+  std::FILE* filePtr_ = nullptr;
+  std::vector<char> fileBuffer_;
+  std::vector<char> recordBuffer_;
+  size_t numRecords_ = 0;
+};
+
+/**
+ * Reads a trace file written by MpcTraceRecorder. The file is memory mapped and the records are decoded sequentially
+ * directly from the mapped memory. A truncated trailing record (e.g. when the recording process was killed) is ignored.
+ */
+class MpcTraceReader {
+ public:
+  /**
+   * Constructor. Maps the trace file and verifies its header.
+   *
+   * @param [in] filePath: The path to the trace file.
+   */
+  explicit MpcTraceReader(const std::string& filePath);
+
+  /** Destructor. Unmaps the trace file. */
+  ~MpcTraceReader();
+
+  MpcTraceReader(const MpcTraceReader&) = delete;
+  MpcTraceReader& operator=(const MpcTraceReader&) = delete;
+
+  /**
+   * Decodes the next record of the trace.
+   *
+   * @param [out] record: The decoded record. The memory of its containers is reused.
+   * @return false if the end of the trace is reached.
+   */
+  bool readNext(MpcTraceRecord& record);
+
+  /** Moves back to the first record of the trace. */
+  void rewind();
+
+ private:
+  const char* data_ = nullptr;
+  size_t size_ = 0;
+  size_t offset_ = 0;
+};
+
+/**
+ * The callback of replayMpcTrace which is called after each replayed iteration.
+ *
+ * @param [in] index: The index of the record in the trace.
+ * @param [in] record: The replayed record.
+ * @param [in] solver: The solver after solving the recorded problem.
+ */
+using MpcTraceReplayCallback = std::function<void(size_t index, const MpcTraceRecord& record, const SolverBase& solver)>;
+
+/**
+ * Replays a recorded MPC trace on the given solver, e.g. GaussNewtonDDP or MultipleShootingSolver. For each record, the
+ * solver is run from the recorded observation, with the recorded references and the recorded time budget. A record which
+ * continues the previous one is solved from the solver's solution of the previous record, as in the MPC loop. Otherwise,
+ * the solver is reset and initialized with the recorded warm start (or cold started, e.g. for the coldStart_ setting).
+ * The solver's ReferenceManager is replaced by a plain ReferenceManager such that the recorded ModeSchedule and
+ * TargetTrajectories (including the ones of the target frames) are not modified before the solver run. Therefore the solver should not have synchronized modules
+ * that modify the references.
+ *
+ * @throws std::runtime_error if the first record continues a previous one, i.e. the trace is not complete.
+ *
+ * @param [in] filePath: The path to the trace file.
+ * @param [in] solver: The solver to replay the trace on.
+ * @param [in] callback: The callback which is called after each replayed iteration.
+ * @return The number of the replayed records.
+ */
+size_t replayMpcTrace(const std::string& filePath, SolverBase& solver, const MpcTraceReplayCallback& callback = nullptr);
+
+}  // namespace ocs2
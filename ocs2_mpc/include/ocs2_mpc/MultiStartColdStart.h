@@ -0,0 +1,111 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <ocs2_core/Types.h>
+#include <ocs2_core/thread_support/ThreadPool.h>
+
+#include <ocs2_oc/oc_data/PrimalSolution.h>
+#include <ocs2_oc/oc_solver/PerformanceIndex.h>
+#include <ocs2_oc/oc_solver/SolverBase.h>
+#include <ocs2_oc/synchronized_module/ReferenceManagerInterface.h>
+
+namespace ocs2 {
+
+/**
+ * Multi-start initialization for the cold start of MPC. The optimal control problem is solved from several diversified
+ * initial guesses concurrently, each on its own solver instance, under a shared wall-clock time budget. The solution with
+ * the lowest merit is then used to warm start the regular MPC solver.
+ *
+ * The starts are diversified by the solver factory, e.g. by giving each solver a different Initializer. The solvers should
+ * be of the same type as the MPC solver such that their primal solution is a valid warm start for it.
+ */
+class MultiStartColdStart {
+ public:
+  /** Creates the solver of the start with the given index. */
+  using solver_factory_t = std::function<std::unique_ptr<SolverBase>(size_t startIndex)>;
+
+  /**
+   * Constructor
+   *
+   * @param [in] numStarts: The number of the starts.
+   * @param [in] solverFactory: The factory which creates the solver of each start.
+   * @param [in] timeBudget: The wall-clock time budget shared by all the starts in seconds. A non-positive value disables it.
+   * @param [in] threadPriority: The priority of the threads which run the starts.
+   */
+  MultiStartColdStart(size_t numStarts, const solver_factory_t& solverFactory, scalar_t timeBudget = 0.0, int threadPriority = 50);
+
+  /**
+   * Solves the optimal control problem from all the starts concurrently and selects the one with the lowest merit.
+   *
+   * @param [in] initTime: The initial time.
+   * @param [in] initState: The initial state.
+   * @param [in] finalTime: The final time.
+   * @param [in] referenceManager: The reference manager of the MPC solver. Its preSolverRun() must have already been called for
+   * this horizon, since all the starts read the same active references from it and do not update them.
+   * @return The index of the best start.
+   */
+  size_t run(scalar_t initTime, const vector_t& initState, scalar_t finalTime, const ReferenceManagerInterface& referenceManager);
+
+  /** Gets the number of the starts. */
+  size_t getNumStarts() const { return solvers_.size(); }
+
+  /** Gets the primal solution of the best start of the latest run. */
+  const PrimalSolution& getBestPrimalSolution() const { return bestPrimalSolution_; }
+
+  /**
+   * Gets the final performance index of each start of the latest run. The merit of a start which has thrown is set to
+   * infinity.
+   */
+  const std::vector<PerformanceIndex>& getPerformanceIndeces() const { return performanceIndeces_; }
+
+  /** Gets the error message of each start of the latest run. It is empty for the starts which have not thrown. */
+  const std::vector<std::string>& getErrorMessages() const { return errorMessages_; }
+
+  /** Gets the wall-clock time of the latest run in seconds. */
+  scalar_t getRunTime() const { return runTime_; }
+
+ private:
+  std::vector<std::unique_ptr<SolverBase>> solvers_;
+  const scalar_t timeBudget_;
+  ThreadPool threadPool_;
+
+  PrimalSolution bestPrimalSolution_;
+  std::vector<PerformanceIndex> performanceIndeces_;
+  std::vector<std::string> errorMessages_;
+  scalar_t runTime_ = 0.0;
+};
+
+}  // namespace ocs2
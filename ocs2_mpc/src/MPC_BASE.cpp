@@ -45,12 +45,28 @@ void MPC_BASE::reset() {
   initRun_ = true;
   mpcTimer_.reset();
   getSolverPtr()->reset();
+  getSolverPtr()->resetTimeBudgetStatistics();
+  isPreviousIterationRecorded_ = false;
 }
 
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
 bool MPC_BASE::run(scalar_t currentTime, const vector_t& currentState) {
+  return runMpc(currentTime, currentState, vector_t());
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+bool MPC_BASE::run(const SystemObservation& observation) {
+  return runMpc(observation.time, observation.state, observation.input);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+bool MPC_BASE::runMpc(scalar_t currentTime, const vector_t& currentState, const vector_t& currentInput) {
   // check if the current time exceeds the solver final limit
   if (!initRun_ && currentTime >= getSolverPtr()->getFinalTime()) {
     std::cerr << "WARNING: The MPC time-horizon is smaller than the MPC starting time.\n";
@@ -71,8 +87,29 @@ bool MPC_BASE::run(scalar_t currentTime, const vector_t& currentState) {
     mpcTimer_.startTimer();
   }
 
+  // the warm start should be recorded before the solver overwrites it
+  if (traceRecorderPtr_ != nullptr) {
+    setTraceWarmStart();
+  }
+
   // calculate the MPC policy
+  getSolverPtr()->setTimeBudget(mpcSettings_.timeBudget_);
+  const bool useMultiStartColdStart = initRun_ && multiStartColdStartPtr_ != nullptr;
+  if (useMultiStartColdStart) {
+    getSolverPtr()->setInitialGuessProvider([this](scalar_t initTime, const vector_t& initState, scalar_t finalTime,
+                                                   const ReferenceManagerInterface& referenceManager) -> const PrimalSolution& {
+      return runMultiStartColdStart(initTime, initState, finalTime, referenceManager);
+    });
+  }
   calculateController(currentTime, currentState, finalTime);
+  // the MPC solver is warm started from the best start which the replay cannot reproduce
+  if (useMultiStartColdStart && traceRecorderPtr_ != nullptr) {
+    traceRecord_.warmStart = multiStartColdStartPtr_->getBestPrimalSolution();
+  }
+
+  if (traceRecorderPtr_ != nullptr) {
+    recordTrace(currentTime, currentState, currentInput, finalTime);
+  }
 
   // set initRun flag to false
   initRun_ = false;
@@ -84,9 +121,73 @@ bool MPC_BASE::run(scalar_t currentTime, const vector_t& currentState) {
     std::cerr << "\n###   Maximum : " << mpcTimer_.getMaxIntervalInMilliseconds() << "[ms].";
     std::cerr << "\n###   Average : " << mpcTimer_.getAverageInMilliseconds() << "[ms].";
     std::cerr << "\n###   Latest  : " << mpcTimer_.getLastIntervalInMilliseconds() << "[ms]." << std::endl;
+    if (mpcSettings_.timeBudget_ > 0.0) {
+      std::cerr << "### Time Budget Statistics\n" << getSolverPtr()->getTimeBudgetStatistics();
+    }
   }
 
   return true;
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void MPC_BASE::setTraceWarmStart() {
+  const bool coldStart = initRun_ || mpcSettings_.coldStart_;
+  traceRecord_.continuesPreviousRecord = !coldStart && isPreviousIterationRecorded_;
+  if (coldStart || traceRecord_.continuesPreviousRecord) {
+    traceRecord_.warmStart.clear();
+  } else {
+    getSolverPtr()->getPrimalSolution(getSolverPtr()->getFinalTime(), &traceRecord_.warmStart);
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void MPC_BASE::recordTrace(scalar_t currentTime, const vector_t& currentState, const vector_t& currentInput, scalar_t finalTime) {
+  // the references are read after the solver run such that they are the ones that the solver has used
+  const auto& referenceManager = getSolverPtr()->getReferenceManager();
+  traceRecord_.mpcSettings = mpcSettings_;
+  traceRecord_.modeSchedule = referenceManager.getModeSchedule();
+  traceRecord_.targetTrajectories = referenceManager.getTargetTrajectories();
+  traceRecord_.frameTargetTrajectories.resize(referenceManager.getNumTargetFrames());
+  for (size_t i = 0; i < traceRecord_.frameTargetTrajectories.size(); i++) {
+    traceRecord_.frameTargetTrajectories[i] = referenceManager.getFrameTargetTrajectories(i);
+  }
+  traceRecord_.observation.mode = traceRecord_.modeSchedule.modeAtTime(currentTime);
+  traceRecord_.observation.time = currentTime;
+  traceRecord_.observation.state = currentState;
+  traceRecord_.observation.input = currentInput;
+  traceRecord_.finalTime = finalTime;
+
+  traceRecorderPtr_->record(traceRecord_);
+  isPreviousIterationRecorded_ = true;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+const PrimalSolution& MPC_BASE::runMultiStartColdStart(scalar_t initTime, const vector_t& initState, scalar_t finalTime,
+                                                       const ReferenceManagerInterface& referenceManager) {
+  const auto bestStart = multiStartColdStartPtr_->run(initTime, initState, finalTime, referenceManager);
+
+  if (mpcSettings_.debugPrint_) {
+    std::cerr << "\n### Multi-start cold start took " << multiStartColdStartPtr_->getRunTime() * 1e+3 << " [ms].";
+    std::cerr << "\n### Merit of the starts:";
+    for (const auto& performance : multiStartColdStartPtr_->getPerformanceIndeces()) {
+      std::cerr << " " << performance.merit;
+    }
+    const auto& errorMessages = multiStartColdStartPtr_->getErrorMessages();
+    for (size_t i = 0; i < errorMessages.size(); i++) {
+      if (!errorMessages[i].empty()) {
+        std::cerr << "\n### Start " << i << " has failed: " << errorMessages[i];
+      }
+    }
+    std::cerr << "\n### Warm starting from start " << bestStart << ".\n";
+  }
+
+  return multiStartColdStartPtr_->getBestPrimalSolution();
+}
+
 }  // namespace ocs2
@@ -29,6 +29,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "ocs2_mpc/MPC_MRT_Interface.h"
 
+#include <algorithm>
+
 #include <ocs2_core/control/FeedforwardController.h>
 #include <ocs2_core/control/LinearController.h>
 
@@ -48,6 +50,22 @@ void MPC_MRT_Interface::resetMpcNode(const TargetTrajectories& initTargetTraject
   mpc_.reset();
   mpc_.getSolverPtr()->getReferenceManager().setTargetTrajectories(initTargetTrajectories);
   mpcTimer_.reset();
+  latestControllerPtr_.reset();
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void MPC_MRT_Interface::enableLatencyCompensation(const RolloutBase& rollout) {
+  latencyRolloutPtr_.reset(rollout.clone());
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void MPC_MRT_Interface::disableLatencyCompensation() {
+  latencyRolloutPtr_.reset();
+  latestControllerPtr_.reset();
 }
 
 /******************************************************************************************************/
@@ -85,7 +103,12 @@ void MPC_MRT_Interface::advanceMpc() {
     currentObservation = currentObservation_;
   }
 
-  bool controllerIsUpdated = mpc_.run(currentObservation.time, currentObservation.state);
+  // solve from the state at which the new policy is expected to be delivered
+  if (latencyRolloutPtr_ != nullptr && latestControllerPtr_ != nullptr && mpcTimer_.getNumTimedIntervals() > 0) {
+    predictObservation(mpcTimer_.getAverageInMilliseconds() * 1e-3, currentObservation);
+  }
+
+  bool controllerIsUpdated = mpc_.run(currentObservation);
   if (!controllerIsUpdated) {
     return;
   }
@@ -123,6 +146,12 @@ void MPC_MRT_Interface::copyToBuffer(const SystemObservation& mpcInitObservation
       (mpc_.settings().solutionTimeWindow_ < 0) ? mpc_.getSolverPtr()->getFinalTime() : startTime + mpc_.settings().solutionTimeWindow_;
   mpc_.getSolverPtr()->getPrimalSolution(finalTime, primalSolutionPtr.get());
 
+  // the system is going to track this policy during the next MPC iteration
+  if (latencyRolloutPtr_ != nullptr) {
+    latestControllerPtr_.reset(primalSolutionPtr->controllerPtr_->clone());
+    latestModeSchedule_ = primalSolutionPtr->modeSchedule_;
+  }
+
   // command
   std::unique_ptr<CommandData> commandPtr(new CommandData);
   commandPtr->mpcInitObservation_ = mpcInitObservation;
@@ -135,6 +164,36 @@ void MPC_MRT_Interface::copyToBuffer(const SystemObservation& mpcInitObservation
   this->moveToBuffer(std::move(commandPtr), std::move(primalSolutionPtr), std::move(performanceIndicesPtr));
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void MPC_MRT_Interface::predictObservation(scalar_t latency, SystemObservation& observation) {
+  const scalar_t finalTime = std::min(observation.time + latency, mpc_.getSolverPtr()->getFinalTime());
+  if (finalTime <= observation.time) {
+    return;
+  }
+
+  scalar_array_t timeTrajectory;
+  size_array_t postEventIndices;
+  vector_array_t stateTrajectory, inputTrajectory;
+  try {
+    const vector_t predictedState = latencyRolloutPtr_->run(observation.time, observation.state, finalTime, latestControllerPtr_.get(),
+                                                            latestModeSchedule_, timeTrajectory, postEventIndices, stateTrajectory,
+                                                            inputTrajectory);
+    observation.state = predictedState;
+  } catch (const std::exception& error) {
+    std::cerr << "[MPC_MRT_Interface::predictObservation] WARNING: The latency compensation is skipped as the rollout failed: "
+              << error.what() << "\n";
+    return;
+  }
+
+  observation.time = finalTime;
+  observation.mode = latestModeSchedule_.modeAtTime(finalTime);
+  if (!inputTrajectory.empty()) {
+    observation.input = inputTrajectory.back();
+  }
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -0,0 +1,474 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include "ocs2_mpc/MpcTrace.h"
+
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <ocs2_core/control/FeedforwardController.h>
+#include <ocs2_core/control/LinearController.h>
+#include <ocs2_oc/synchronized_module/ReferenceManager.h>
+
+namespace ocs2 {
+
+namespace {
+
+constexpr char traceMagic[8] = {'O', 'C', 'S', '2', 'T', 'R', 'C', 'E'};
+constexpr uint32_t traceVersion = 4;
+constexpr size_t traceHeaderSize = sizeof(traceMagic) + sizeof(traceVersion);
+constexpr size_t fileBufferSize = 1 << 20;
+
+enum class TraceControllerTag : uint8_t { NONE, LINEAR, FEEDFORWARD };
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void writeBytes(std::vector<char>& buffer, const void* data, size_t numBytes) {
+  const char* bytes = static_cast<const char*>(data);
+  buffer.insert(buffer.end(), bytes, bytes + numBytes);
+}
+
+template <typename T>
+void writeValue(std::vector<char>& buffer, T value) {
+  writeBytes(buffer, &value, sizeof(T));
+}
+
+void writeSize(std::vector<char>& buffer, size_t size) {
+  writeValue<uint64_t>(buffer, static_cast<uint64_t>(size));
+}
+
+void writeVector(std::vector<char>& buffer, const vector_t& v) {
+  writeSize(buffer, v.size());
+  writeBytes(buffer, v.data(), v.size() * sizeof(scalar_t));
+}
+
+void writeMatrix(std::vector<char>& buffer, const matrix_t& m) {
+  writeSize(buffer, m.rows());
+  writeSize(buffer, m.cols());
+  writeBytes(buffer, m.data(), m.size() * sizeof(scalar_t));
+}
+
+template <typename T>
+void writeStdVector(std::vector<char>& buffer, const std::vector<T>& array) {
+  writeSize(buffer, array.size());
+  for (const auto& v : array) {
+    writeValue<T>(buffer, v);
+  }
+}
+
+void writeVectorArray(std::vector<char>& buffer, const vector_array_t& array) {
+  writeSize(buffer, array.size());
+  for (const auto& v : array) {
+    writeVector(buffer, v);
+  }
+}
+
+void writeMatrixArray(std::vector<char>& buffer, const matrix_array_t& array) {
+  writeSize(buffer, array.size());
+  for (const auto& m : array) {
+    writeMatrix(buffer, m);
+  }
+}
+
+void writeTargetTrajectories(std::vector<char>& buffer, const TargetTrajectories& targetTrajectories) {
+  writeStdVector(buffer, targetTrajectories.timeTrajectory);
+  writeVectorArray(buffer, targetTrajectories.stateTrajectory);
+  writeVectorArray(buffer, targetTrajectories.inputTrajectory);
+}
+
+void writeController(std::vector<char>& buffer, const ControllerBase* controllerPtr) {
+  const auto* linearControllerPtr = dynamic_cast<const LinearController*>(controllerPtr);
+  const auto* feedforwardControllerPtr = dynamic_cast<const FeedforwardController*>(controllerPtr);
+  if (linearControllerPtr != nullptr) {
+    writeValue(buffer, TraceControllerTag::LINEAR);
+    writeStdVector(buffer, linearControllerPtr->timeStamp_);
+    writeVectorArray(buffer, linearControllerPtr->biasArray_);
+    writeVectorArray(buffer, linearControllerPtr->deltaBiasArray_);
+    writeMatrixArray(buffer, linearControllerPtr->gainArray_);
+  } else if (feedforwardControllerPtr != nullptr) {
+    writeValue(buffer, TraceControllerTag::FEEDFORWARD);
+    writeStdVector(buffer, feedforwardControllerPtr->timeStamp_);
+    writeVectorArray(buffer, feedforwardControllerPtr->uffArray_);
+  } else {
+    // other controller types are not recorded; the replay then relies on the recorded trajectories
+    writeValue(buffer, TraceControllerTag::NONE);
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+/** Decodes the payload of a record in place. Throws if the payload is shorter than the encoded data. */
+class TraceCursor {
+ public:
+  TraceCursor(const char* data, size_t size) : data_(data), size_(size) {}
+
+  void readBytes(void* data, size_t numBytes) {
+    if (numBytes > size_ - offset_) {
+      throw std::runtime_error("[MpcTraceReader] The trace file is corrupted!");
+    }
+    std::memcpy(data, data_ + offset_, numBytes);
+    offset_ += numBytes;
+  }
+
+  template <typename T>
+  T readValue() {
+    T value;
+    readBytes(&value, sizeof(T));
+    return value;
+  }
+
+  size_t readSize() { return static_cast<size_t>(readValue<uint64_t>()); }
+
+  void readVector(vector_t& v) {
+    v.resize(readSize());
+    readBytes(v.data(), v.size() * sizeof(scalar_t));
+  }
+
+  void readMatrix(matrix_t& m) {
+    const size_t rows = readSize();
+    const size_t cols = readSize();
+    m.resize(rows, cols);
+    readBytes(m.data(), m.size() * sizeof(scalar_t));
+  }
+
+  template <typename T>
+  void readStdVector(std::vector<T>& array) {
+    array.resize(readSize());
+    readBytes(array.data(), array.size() * sizeof(T));
+  }
+
+  void readVectorArray(vector_array_t& array) {
+    array.resize(readSize());
+    for (auto& v : array) {
+      readVector(v);
+    }
+  }
+
+  void readMatrixArray(matrix_array_t& array) {
+    array.resize(readSize());
+    for (auto& m : array) {
+      readMatrix(m);
+    }
+  }
+
+  void readTargetTrajectories(TargetTrajectories& targetTrajectories) {
+    readStdVector(targetTrajectories.timeTrajectory);
+    readVectorArray(targetTrajectories.stateTrajectory);
+    readVectorArray(targetTrajectories.inputTrajectory);
+  }
+
+  void readController(std::unique_ptr<ControllerBase>& controllerPtr) {
+    switch (readValue<TraceControllerTag>()) {
+      case TraceControllerTag::LINEAR: {
+        auto* linearControllerPtr = dynamic_cast<LinearController*>(controllerPtr.get());
+        if (linearControllerPtr == nullptr) {
+          linearControllerPtr = new LinearController();
+          controllerPtr.reset(linearControllerPtr);
+        }
+        readStdVector(linearControllerPtr->timeStamp_);
+        readVectorArray(linearControllerPtr->biasArray_);
+        readVectorArray(linearControllerPtr->deltaBiasArray_);
+        readMatrixArray(linearControllerPtr->gainArray_);
+        break;
+      }
+      case TraceControllerTag::FEEDFORWARD: {
+        auto* feedforwardControllerPtr = dynamic_cast<FeedforwardController*>(controllerPtr.get());
+        if (feedforwardControllerPtr == nullptr) {
+          feedforwardControllerPtr = new FeedforwardController();
+          controllerPtr.reset(feedforwardControllerPtr);
+        }
+        readStdVector(feedforwardControllerPtr->timeStamp_);
+        readVectorArray(feedforwardControllerPtr->uffArray_);
+        break;
+      }
+      case TraceControllerTag::NONE:
+        controllerPtr.reset();
+        break;
+      default:
+        throw std::runtime_error("[MpcTraceReader] Unknown controller type in the trace file!");
+    }
+  }
+
+ private:
+  const char* data_;
+  size_t size_;
+  size_t offset_ = 0;
+};
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void serializeRecord(std::vector<char>& buffer, const MpcTraceRecord& record) {
+  // settings
+  writeValue(buffer, record.mpcSettings.coldStart_);
+  writeValue(buffer, record.mpcSettings.timeBudget_);
+
+  // observation
+  writeSize(buffer, record.observation.mode);
+  writeValue(buffer, record.observation.time);
+  writeVector(buffer, record.observation.state);
+  writeVector(buffer, record.observation.input);
+  writeValue(buffer, record.finalTime);
+
+  // references
+  writeTargetTrajectories(buffer, record.targetTrajectories);
+  writeSize(buffer, record.frameTargetTrajectories.size());
+  for (const auto& frameTargetTrajectories : record.frameTargetTrajectories) {
+    writeTargetTrajectories(buffer, frameTargetTrajectories);
+  }
+  writeStdVector(buffer, record.modeSchedule.eventTimes);
+  writeStdVector(buffer, record.modeSchedule.modeSequence);
+
+  // warm start
+  writeValue(buffer, record.continuesPreviousRecord);
+  const auto& warmStart = record.warmStart;
+  writeStdVector(buffer, warmStart.timeTrajectory_);
+  writeVectorArray(buffer, warmStart.stateTrajectory_);
+  writeVectorArray(buffer, warmStart.inputTrajectory_);
+  writeStdVector(buffer, warmStart.postEventIndices_);
+  writeStdVector(buffer, warmStart.modeSchedule_.eventTimes);
+  writeStdVector(buffer, warmStart.modeSchedule_.modeSequence);
+  writeController(buffer, warmStart.controllerPtr_.get());
+}
+
+void deserializeRecord(TraceCursor& cursor, MpcTraceRecord& record) {
+  // settings
+  record.mpcSettings.coldStart_ = cursor.readValue<bool>();
+  record.mpcSettings.timeBudget_ = cursor.readValue<scalar_t>();
+
+  // observation
+  record.observation.mode = cursor.readSize();
+  record.observation.time = cursor.readValue<scalar_t>();
+  cursor.readVector(record.observation.state);
+  cursor.readVector(record.observation.input);
+  record.finalTime = cursor.readValue<scalar_t>();
+
+  // references
+  cursor.readTargetTrajectories(record.targetTrajectories);
+  record.frameTargetTrajectories.resize(cursor.readSize());
+  for (auto& frameTargetTrajectories : record.frameTargetTrajectories) {
+    cursor.readTargetTrajectories(frameTargetTrajectories);
+  }
+  cursor.readStdVector(record.modeSchedule.eventTimes);
+  cursor.readStdVector(record.modeSchedule.modeSequence);
+
+  // warm start
+  record.continuesPreviousRecord = cursor.readValue<bool>();
+  auto& warmStart = record.warmStart;
+  cursor.readStdVector(warmStart.timeTrajectory_);
+  cursor.readVectorArray(warmStart.stateTrajectory_);
+  cursor.readVectorArray(warmStart.inputTrajectory_);
+  cursor.readStdVector(warmStart.postEventIndices_);
+  cursor.readStdVector(warmStart.modeSchedule_.eventTimes);
+  cursor.readStdVector(warmStart.modeSchedule_.modeSequence);
+  cursor.readController(warmStart.controllerPtr_);
+}
+
+}  // unnamed namespace
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+bool hasWarmStart(const MpcTraceRecord& record) {
+  const auto& warmStart = record.warmStart;
+  const bool hasController = warmStart.controllerPtr_ != nullptr && !warmStart.controllerPtr_->empty();
+  return hasController || !warmStart.timeTrajectory_.empty();
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+MpcTraceRecorder::MpcTraceRecorder(const std::string& filePath) : fileBuffer_(fileBufferSize) {
+  filePtr_ = std::fopen(filePath.c_str(), "wb");
+  if (filePtr_ == nullptr) {
+    throw std::runtime_error("[MpcTraceRecorder] Could not open the trace file " + filePath);
+  }
+  std::setvbuf(filePtr_, fileBuffer_.data(), _IOFBF, fileBuffer_.size());
+
+  recordBuffer_.reserve(fileBufferSize);
+  writeBytes(recordBuffer_, traceMagic, sizeof(traceMagic));
+  writeValue(recordBuffer_, traceVersion);
+  if (std::fwrite(recordBuffer_.data(), 1, recordBuffer_.size(), filePtr_) != recordBuffer_.size()) {
+    throw std::runtime_error("[MpcTraceRecorder] Could not write to the trace file " + filePath);
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+MpcTraceRecorder::~MpcTraceRecorder() {
+  std::fclose(filePtr_);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void MpcTraceRecorder::record(const MpcTraceRecord& record) {
+  // reserve the size prefix and fill it in after serialization
+  recordBuffer_.clear();
+  writeSize(recordBuffer_, 0);
+  serializeRecord(recordBuffer_, record);
+  const uint64_t payloadSize = recordBuffer_.size() - sizeof(uint64_t);
+  std::memcpy(recordBuffer_.data(), &payloadSize, sizeof(uint64_t));
+
+  if (std::fwrite(recordBuffer_.data(), 1, recordBuffer_.size(), filePtr_) != recordBuffer_.size()) {
+    throw std::runtime_error("[MpcTraceRecorder] Could not write to the trace file!");
+  }
+  numRecords_++;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void MpcTraceRecorder::flush() {
+  std::fflush(filePtr_);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+MpcTraceReader::MpcTraceReader(const std::string& filePath) {
+  const int fd = ::open(filePath.c_str(), O_RDONLY);
+  if (fd < 0) {
+    throw std::runtime_error("[MpcTraceReader] Could not open the trace file " + filePath);
+  }
+  struct stat fileStat;
+  if (::fstat(fd, &fileStat) != 0 || static_cast<size_t>(fileStat.st_size) < traceHeaderSize) {
+    ::close(fd);
+    throw std::runtime_error("[MpcTraceReader] " + filePath + " is not a trace file!");
+  }
+
+  size_ = static_cast<size_t>(fileStat.st_size);
+  void* mappedPtr = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+  ::close(fd);
+  if (mappedPtr == MAP_FAILED) {
+    throw std::runtime_error("[MpcTraceReader] Could not map the trace file " + filePath);
+  }
+  ::madvise(mappedPtr, size_, MADV_SEQUENTIAL);
+  data_ = static_cast<const char*>(mappedPtr);
+
+  uint32_t version;
+  std::memcpy(&version, data_ + sizeof(traceMagic), sizeof(version));
+  if (std::memcmp(data_, traceMagic, sizeof(traceMagic)) != 0 || version != traceVersion) {
+    ::munmap(const_cast<char*>(data_), size_);
+    throw std::runtime_error("[MpcTraceReader] " + filePath + " is not a trace file of version " + std::to_string(traceVersion) + "!");
+  }
+  offset_ = traceHeaderSize;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+MpcTraceReader::~MpcTraceReader() {
+  ::munmap(const_cast<char*>(data_), size_);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+bool MpcTraceReader::readNext(MpcTraceRecord& record) {
+  if (size_ - offset_ < sizeof(uint64_t)) {
+    return false;
+  }
+  uint64_t payloadSize;
+  std::memcpy(&payloadSize, data_ + offset_, sizeof(uint64_t));
+  const size_t payloadOffset = offset_ + sizeof(uint64_t);
+  if (payloadSize > size_ - payloadOffset) {
+    // truncated trailing record
+    return false;
+  }
+
+  TraceCursor cursor(data_ + payloadOffset, payloadSize);
+  deserializeRecord(cursor, record);
+  offset_ = payloadOffset + payloadSize;
+  return true;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void MpcTraceReader::rewind() {
+  offset_ = traceHeaderSize;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+size_t replayMpcTrace(const std::string& filePath, SolverBase& solver, const MpcTraceReplayCallback& callback) {
+  MpcTraceReader reader(filePath);
+
+  std::shared_ptr<ReferenceManager> referenceManagerPtr;
+
+  size_t numRecords = 0;
+  MpcTraceRecord record;
+  while (reader.readNext(record)) {
+    const size_t numTargetFrames = record.frameTargetTrajectories.size();
+    if (referenceManagerPtr == nullptr || referenceManagerPtr->getNumTargetFrames() != numTargetFrames) {
+      referenceManagerPtr = std::make_shared<ReferenceManager>(std::vector<TargetTrajectories>(numTargetFrames));
+      solver.setReferenceManager(referenceManagerPtr);
+    }
+    for (size_t i = 0; i < numTargetFrames; i++) {
+      referenceManagerPtr->setFrameTargetTrajectories(record.frameTargetTrajectories[i], i);
+    }
+    referenceManagerPtr->setTargetTrajectories(record.targetTrajectories);
+    referenceManagerPtr->setModeSchedule(record.modeSchedule);
+    solver.setTimeBudget(record.mpcSettings.timeBudget_);
+
+    if (record.continuesPreviousRecord) {
+      if (numRecords == 0) {
+        throw std::runtime_error("[replayMpcTrace] The first record of the trace continues a previous record which is not recorded!");
+      }
+      solver.run(record.observation.time, record.observation.state, record.finalTime);
+    } else {
+      solver.reset();
+      if (hasWarmStart(record)) {
+        solver.run(record.observation.time, record.observation.state, record.finalTime, record.warmStart);
+      } else {
+        solver.run(record.observation.time, record.observation.state, record.finalTime);
+      }
+    }
+
+    if (callback) {
+      callback(numRecords, record, solver);
+    }
+    numRecords++;
+  }
+
+  return numRecords;
+}
+
+}  // namespace ocs2
@@ -0,0 +1,143 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include "ocs2_mpc/MultiStartColdStart.h"
+
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <limits>
+
+namespace ocs2 {
+
+namespace {
+
+/**
+ * Forwards to the reference manager of the MPC solver without updating its references, such that all the starts can read
+ * the same active references concurrently. The references cannot be modified by the starts.
+ */
+class FrozenReferenceManager final : public ReferenceManagerInterface {
+ public:
+  explicit FrozenReferenceManager(const ReferenceManagerInterface& referenceManager) : referenceManager_(referenceManager) {}
+  ~FrozenReferenceManager() override = default;
+
+  void preSolverRun(scalar_t initTime, scalar_t finalTime, const vector_t& initState) override {}
+
+  const ModeSchedule& getModeSchedule() const override { return referenceManager_.getModeSchedule(); }
+  void setModeSchedule(const ModeSchedule& modeSchedule) override { throwReadOnly(); }
+  void setModeSchedule(ModeSchedule&& modeSchedule) override { throwReadOnly(); }
+
+  const TargetTrajectories& getTargetTrajectories() const override { return referenceManager_.getTargetTrajectories(); }
+  void setTargetTrajectories(const TargetTrajectories& targetTrajectories) override { throwReadOnly(); }
+  void setTargetTrajectories(TargetTrajectories&& targetTrajectories) override { throwReadOnly(); }
+
+  size_t getNumTargetFrames() const override { return referenceManager_.getNumTargetFrames(); }
+  const TargetTrajectories& getFrameTargetTrajectories(const int& targetFrameIndex) const override {
+    return referenceManager_.getFrameTargetTrajectories(targetFrameIndex);
+  }
+  void setFrameTargetTrajectories(const TargetTrajectories& targetTrajectories, int targetFrameIndex) override { throwReadOnly(); }
+  void setFrameTargetTrajectories(TargetTrajectories&& targetTrajectories, int targetFrameIndex) override { throwReadOnly(); }
+
+  bool isForceAdaptationActive() const override { return referenceManager_.isForceAdaptationActive(); }
+  void switchForceAdaptationStatus() override { throwReadOnly(); }
+
+ private:
+  static void throwReadOnly() { throw std::runtime_error("[MultiStartColdStart] The starts cannot modify the references!"); }
+
+  const ReferenceManagerInterface& referenceManager_;
+};
+
+}  // namespace
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+MultiStartColdStart::MultiStartColdStart(size_t numStarts, const solver_factory_t& solverFactory, scalar_t timeBudget, int threadPriority)
+    : timeBudget_(timeBudget), threadPool_(std::max(numStarts, size_t(1)) - 1, threadPriority) {
+  if (numStarts == 0) {
+    throw std::runtime_error("[MultiStartColdStart] The number of the starts must be positive!");
+  }
+
+  solvers_.reserve(numStarts);
+  for (size_t i = 0; i < numStarts; i++) {
+    solvers_.push_back(solverFactory(i));
+    if (solvers_.back() == nullptr) {
+      throw std::runtime_error("[MultiStartColdStart] The solver factory returned a nullptr for start " + std::to_string(i) + "!");
+    }
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+size_t MultiStartColdStart::run(scalar_t initTime, const vector_t& initState, scalar_t finalTime,
+                                const ReferenceManagerInterface& referenceManager) {
+  const auto startTime = std::chrono::steady_clock::now();
+
+  const size_t numStarts = solvers_.size();
+  performanceIndeces_.assign(numStarts, PerformanceIndex());
+  errorMessages_.assign(numStarts, std::string());
+
+  const auto frozenReferenceManagerPtr = std::make_shared<FrozenReferenceManager>(referenceManager);
+
+  std::atomic_size_t nextStartId{0};
+  auto task = [&](int) {
+    size_t i;
+    while ((i = nextStartId++) < numStarts) {
+      auto& solver = *solvers_[i];
+      try {
+        solver.reset();
+        solver.setReferenceManager(frozenReferenceManagerPtr);
+        solver.setTimeBudget(timeBudget_);
+        solver.run(initTime, initState, finalTime);
+        performanceIndeces_[i] = solver.getPerformanceIndeces();
+      } catch (const std::exception& e) {
+        errorMessages_[i] = e.what();
+        performanceIndeces_[i].merit = std::numeric_limits<scalar_t>::infinity();
+      }
+    }
+  };
+  threadPool_.runParallel(task, static_cast<int>(numStarts));
+
+  size_t bestStart = 0;
+  for (size_t i = 1; i < numStarts; i++) {
+    if (performanceIndeces_[i].merit < performanceIndeces_[bestStart].merit) {
+      bestStart = i;
+    }
+  }
+  if (!std::isfinite(performanceIndeces_[bestStart].merit)) {
+    throw std::runtime_error("[MultiStartColdStart] All the starts have failed! Start 0: " + errorMessages_[0]);
+  }
+  solvers_[bestStart]->getPrimalSolution(finalTime, &bestPrimalSolution_);
+
+  runTime_ = std::chrono::duration<scalar_t>(std::chrono::steady_clock::now() - startTime).count();
+  return bestStart;
+}
+
+}  // namespace ocs2
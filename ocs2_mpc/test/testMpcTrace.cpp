@@ -0,0 +1,191 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <fstream>
+
+#include <ocs2_core/control/FeedforwardController.h>
+#include <ocs2_core/control/LinearController.h>
+
+#include <ocs2_mpc/MpcTrace.h>
+
+using namespace ocs2;
+
+namespace {
+
+MpcTraceRecord getRandomRecord(size_t numPoints, bool linearController) {
+  constexpr size_t stateDim = 4;
+  constexpr size_t inputDim = 2;
+
+  MpcTraceRecord record;
+  record.mpcSettings.coldStart_ = true;
+  record.mpcSettings.timeBudget_ = 0.01;
+  record.observation.mode = 1;
+  record.observation.time = 0.123;
+  record.observation.state = vector_t::Random(stateDim);
+  record.observation.input = vector_t::Random(inputDim);
+  record.finalTime = record.observation.time + 0.7;
+  record.targetTrajectories = TargetTrajectories({0.0, 1.0}, {vector_t::Random(stateDim), vector_t::Random(stateDim)},
+                                                 {vector_t::Random(inputDim), vector_t::Random(inputDim)});
+  record.frameTargetTrajectories = {TargetTrajectories(),
+                                    TargetTrajectories({0.2}, {vector_t::Random(stateDim)}, {vector_t::Random(inputDim)})};
+  record.modeSchedule = ModeSchedule({0.1, 0.5}, {0, 1, 2});
+
+  auto& warmStart = record.warmStart;
+  warmStart.modeSchedule_ = ModeSchedule({0.4}, {1, 2});
+  warmStart.postEventIndices_ = {numPoints / 2};
+  matrix_array_t gainArray;
+  for (size_t i = 0; i < numPoints; i++) {
+    warmStart.timeTrajectory_.push_back(static_cast<scalar_t>(i) / numPoints);
+    warmStart.stateTrajectory_.push_back(vector_t::Random(stateDim));
+    warmStart.inputTrajectory_.push_back(vector_t::Random(inputDim));
+    gainArray.push_back(matrix_t::Random(inputDim, stateDim));
+  }
+  if (linearController) {
+    warmStart.controllerPtr_.reset(new LinearController(warmStart.timeTrajectory_, warmStart.inputTrajectory_, gainArray));
+  } else {
+    warmStart.controllerPtr_.reset(new FeedforwardController(warmStart.timeTrajectory_, warmStart.inputTrajectory_));
+  }
+
+  return record;
+}
+
+void expectEqual(const MpcTraceRecord& lhs, const MpcTraceRecord& rhs) {
+  EXPECT_EQ(lhs.mpcSettings.coldStart_, rhs.mpcSettings.coldStart_);
+  EXPECT_EQ(lhs.mpcSettings.timeBudget_, rhs.mpcSettings.timeBudget_);
+  EXPECT_EQ(lhs.observation.mode, rhs.observation.mode);
+  EXPECT_EQ(lhs.observation.time, rhs.observation.time);
+  EXPECT_TRUE(lhs.observation.state == rhs.observation.state);
+  EXPECT_TRUE(lhs.observation.input == rhs.observation.input);
+  EXPECT_EQ(lhs.finalTime, rhs.finalTime);
+  EXPECT_EQ(lhs.targetTrajectories.timeTrajectory, rhs.targetTrajectories.timeTrajectory);
+  EXPECT_EQ(lhs.targetTrajectories.stateTrajectory, rhs.targetTrajectories.stateTrajectory);
+  EXPECT_EQ(lhs.targetTrajectories.inputTrajectory, rhs.targetTrajectories.inputTrajectory);
+  ASSERT_EQ(lhs.frameTargetTrajectories.size(), rhs.frameTargetTrajectories.size());
+  for (size_t i = 0; i < lhs.frameTargetTrajectories.size(); i++) {
+    EXPECT_EQ(lhs.frameTargetTrajectories[i].timeTrajectory, rhs.frameTargetTrajectories[i].timeTrajectory);
+    EXPECT_EQ(lhs.frameTargetTrajectories[i].stateTrajectory, rhs.frameTargetTrajectories[i].stateTrajectory);
+    EXPECT_EQ(lhs.frameTargetTrajectories[i].inputTrajectory, rhs.frameTargetTrajectories[i].inputTrajectory);
+  }
+  EXPECT_EQ(lhs.modeSchedule.eventTimes, rhs.modeSchedule.eventTimes);
+  EXPECT_EQ(lhs.modeSchedule.modeSequence, rhs.modeSchedule.modeSequence);
+
+  EXPECT_EQ(lhs.continuesPreviousRecord, rhs.continuesPreviousRecord);
+  EXPECT_EQ(lhs.warmStart.timeTrajectory_, rhs.warmStart.timeTrajectory_);
+  EXPECT_EQ(lhs.warmStart.stateTrajectory_, rhs.warmStart.stateTrajectory_);
+  EXPECT_EQ(lhs.warmStart.inputTrajectory_, rhs.warmStart.inputTrajectory_);
+  EXPECT_EQ(lhs.warmStart.postEventIndices_, rhs.warmStart.postEventIndices_);
+  EXPECT_EQ(lhs.warmStart.modeSchedule_.eventTimes, rhs.warmStart.modeSchedule_.eventTimes);
+  EXPECT_EQ(lhs.warmStart.modeSchedule_.modeSequence, rhs.warmStart.modeSchedule_.modeSequence);
+
+  ASSERT_EQ(lhs.warmStart.controllerPtr_ == nullptr, rhs.warmStart.controllerPtr_ == nullptr);
+  if (lhs.warmStart.controllerPtr_ != nullptr) {
+    ASSERT_EQ(lhs.warmStart.controllerPtr_->getType(), rhs.warmStart.controllerPtr_->getType());
+    for (const auto t : lhs.warmStart.timeTrajectory_) {
+      const vector_t x = vector_t::Random(lhs.observation.state.size());
+      EXPECT_TRUE(lhs.warmStart.controllerPtr_->computeInput(t, x) == rhs.warmStart.controllerPtr_->computeInput(t, x));
+    }
+  }
+}
+
+}  // unnamed namespace
+
+class MpcTraceTest : public testing::Test {
+ protected:
+  const std::string filePath = "/tmp/ocs2_mpc_trace_test.bin";
+
+  ~MpcTraceTest() override { std::remove(filePath.c_str()); }
+};
+
+TEST_F(MpcTraceTest, roundTrip) {
+  std::vector<MpcTraceRecord> records;
+  records.push_back(getRandomRecord(20, true));
+  records.push_back(getRandomRecord(5, false));
+  records.push_back(getRandomRecord(0, true));
+  records.back().warmStart.clear();
+  records.back().continuesPreviousRecord = true;
+
+  {
+    MpcTraceRecorder recorder(filePath);
+    for (const auto& r : records) {
+      recorder.record(r);
+    }
+    EXPECT_EQ(recorder.getNumRecords(), records.size());
+  }
+
+  MpcTraceReader reader(filePath);
+  MpcTraceRecord record;
+  for (int pass = 0; pass < 2; pass++) {
+    for (const auto& r : records) {
+      ASSERT_TRUE(reader.readNext(record));
+      expectEqual(r, record);
+    }
+    EXPECT_FALSE(reader.readNext(record));
+    reader.rewind();
+  }
+
+  EXPECT_TRUE(hasWarmStart(records[0]));
+  EXPECT_FALSE(hasWarmStart(records[2]));
+}
+
+TEST_F(MpcTraceTest, truncatedTrace) {
+  const auto record = getRandomRecord(10, true);
+  {
+    MpcTraceRecorder recorder(filePath);
+    recorder.record(record);
+    recorder.record(record);
+  }
+
+  // drop the last bytes of the file as if the recording process was interrupted
+  std::string content;
+  {
+    std::ifstream file(filePath, std::ios::binary);
+    content.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+  }
+  {
+    std::ofstream file(filePath, std::ios::binary | std::ios::trunc);
+    file.write(content.data(), content.size() - 10);
+  }
+
+  MpcTraceReader reader(filePath);
+  MpcTraceRecord readRecord;
+  ASSERT_TRUE(reader.readNext(readRecord));
+  expectEqual(record, readRecord);
+  EXPECT_FALSE(reader.readNext(readRecord));
+}
+
+TEST_F(MpcTraceTest, invalidFile) {
+  {
+    std::ofstream file(filePath, std::ios::binary | std::ios::trunc);
+    file << "not a trace file";
+  }
+  EXPECT_THROW(MpcTraceReader reader(filePath), std::runtime_error);
+}
@@ -29,6 +29,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #pragma once
 
+#include <functional>
 #include <iostream>
 #include <memory>
 #include <mutex>
@@ -36,12 +37,14 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <ocs2_core/Types.h>
 #include <ocs2_core/control/ControllerBase.h>
+#include <ocs2_core/misc/Deadline.h>
 
 #include <ocs2_oc/oc_data/DualSolution.h>
 #include <ocs2_oc/oc_data/PrimalSolution.h>
 #include <ocs2_oc/oc_data/ProblemMetrics.h>
 #include <ocs2_oc/oc_problem/OptimalControlProblem.h>
 #include <ocs2_oc/oc_solver/PerformanceIndex.h>
+#include <ocs2_oc/oc_solver/TimeBudgetStatistics.h>
 #include <ocs2_oc/synchronized_module/ReferenceManagerInterface.h>
 #include <ocs2_oc/synchronized_module/SolverSynchronizedModule.h>
 #include "ocs2_oc/synchronized_module/AugmentedLagrangianObserver.h"
@@ -53,6 +56,11 @@ namespace ocs2 {
  */
 class SolverBase {
  public:
+  /** Computes an initial guess on the references which the reference manager has activated for the run. */
+  using initial_guess_provider_t =
+      std::function<const PrimalSolution&(scalar_t initTime, const vector_t& initState, scalar_t finalTime,
+                                          const ReferenceManagerInterface& referenceManager)>;
+
   /**
    * Constructor.
    */
@@ -102,6 +110,32 @@ class SolverBase {
    */
   void run(scalar_t initTime, const vector_t& initState, scalar_t finalTime, const PrimalSolution& primalSolution);
 
+  /**
+   * Sets a provider of the initial guess for the next run(initTime, initState, finalTime). It is called once the reference manager and
+   * the synchronized modules are updated for that run, such that the initial guess can be computed on the same references without
+   * updating them again. The time budget of the run starts after the provider returns. The provider is only used for one run.
+   *
+   * @param [in] initialGuessProvider: The provider of the initial guess.
+   */
+  void setInitialGuessProvider(initial_guess_provider_t initialGuessProvider) { initialGuessProvider_ = std::move(initialGuessProvider); }
+
+  /**
+   * Sets the wall-clock time budget of each run. The solvers check the budget between iterations and inside their search
+   * strategies, and return their best iterate once another iteration is not expected to fit in the remaining time.
+   *
+   * @param [in] timeBudget: The time budget in seconds. A non-positive value disables the time budget.
+   */
+  void setTimeBudget(scalar_t timeBudget) { timeBudget_ = timeBudget; }
+
+  /** Gets the wall-clock time budget of each run in seconds. */
+  scalar_t getTimeBudget() const { return timeBudget_; }
+
+  /** Gets the statistics of the runs with respect to the time budget. */
+  const TimeBudgetStatistics& getTimeBudgetStatistics() const { return timeBudgetStatistics_; }
+
+  /** Resets the statistics of the runs with respect to the time budget. */
+  void resetTimeBudgetStatistics() { timeBudgetStatistics_ = TimeBudgetStatistics(); }
+
   /**
    * Sets the ReferenceManager which manages both ModeSchedule and TargetTrajectories. This module updates before SynchronizedModules.
    */
@@ -254,6 +288,13 @@ class SolverBase {
    */
   void printString(const std::string& text) const;
 
+ protected:
+  /** The deadline of the current run based on the time budget. */
+  const Deadline& getDeadline() const { return deadline_; }
+
+  /** The solver should call this method when it terminates the current run early due to the time budget. */
+  void reportTimeBudgetTermination() { isTerminatedByTimeBudget_ = true; }
+
  private:
   virtual void runImpl(scalar_t initTime, const vector_t& initState, scalar_t finalTime) = 0;
 
@@ -265,6 +306,8 @@ class SolverBase {
 
   void postRun();
 
+  void updateTimeBudgetStatistics();
+
   /***********
    * Variables
    ***********/
@@ -272,6 +315,12 @@ class SolverBase {
   std::shared_ptr<ReferenceManagerInterface> referenceManagerPtr_;  // this pointer cannot be nullptr
   std::vector<std::shared_ptr<SolverSynchronizedModule>> synchronizedModules_;
   std::vector<std::unique_ptr<AugmentedLagrangianObserver>> augmentedLagrangianObservers_;
+  initial_guess_provider_t initialGuessProvider_;
+
+  scalar_t timeBudget_ = -1.0;
+  Deadline deadline_;
+  bool isTerminatedByTimeBudget_ = false;
+  TimeBudgetStatistics timeBudgetStatistics_;
 };
 
 }  // namespace ocs2
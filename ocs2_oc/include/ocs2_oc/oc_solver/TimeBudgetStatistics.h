@@ -0,0 +1,63 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <ostream>
+
+#include <ocs2_core/Types.h>
+
+namespace ocs2 {
+
+/**
+ * Statistics of the solver runs with respect to the time budget (see SolverBase::setTimeBudget).
+ */
+struct TimeBudgetStatistics {
+  /** Number of the solver runs. */
+  size_t numRuns = 0;
+  /** Number of the runs that the solver terminated early in order to respect the time budget. */
+  size_t numTerminatedRuns = 0;
+  /** Number of the runs that took longer than the time budget. */
+  size_t numOverruns = 0;
+  /** The largest amount of time by which a run exceeded the time budget. */
+  scalar_t maxOverrunInMilliseconds = 0.0;
+  /** Duration of the latest run. */
+  scalar_t lastRunInMilliseconds = 0.0;
+};
+
+inline std::ostream& operator<<(std::ostream& stream, const TimeBudgetStatistics& statistics) {
+  stream << "Number of runs:           " << statistics.numRuns << '\n';
+  stream << "Early terminated runs:    " << statistics.numTerminatedRuns << '\n';
+  stream << "Runs over the budget:     " << statistics.numOverruns << '\n';
+  stream << "Maximum overrun:          " << statistics.maxOverrunInMilliseconds << " [ms]\n";
+  stream << "Latest run:               " << statistics.lastRunInMilliseconds << " [ms]\n";
+  return stream;
+}
+
+}  // namespace ocs2
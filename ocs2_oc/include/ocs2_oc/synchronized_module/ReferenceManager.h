@@ -66,6 +66,7 @@ class ReferenceManager : public ReferenceManagerInterface {
   }
 
   // Functions for TargetTrajectories that concern a target frame
+  size_t getNumTargetFrames() const override { return framesTargetTrajectories_.size(); }
   const TargetTrajectories& getFrameTargetTrajectories(const int& targetFrameIndex) const override {
       return framesTargetTrajectories_[targetFrameIndex].get(); }
   void setFrameTargetTrajectories(const TargetTrajectories& targetTrajectories, int targetFrameIndex) override {
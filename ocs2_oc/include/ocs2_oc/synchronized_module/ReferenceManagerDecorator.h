@@ -65,6 +65,7 @@ class ReferenceManagerDecorator : public ReferenceManagerInterface {
   }
 
   // Functions for TargetTrajectories that concern a target frame
+  size_t getNumTargetFrames() const override { return referenceManagerPtr_->getNumTargetFrames(); }
   const TargetTrajectories& getFrameTargetTrajectories(const int& targetFrameIndex) const override {
       return referenceManagerPtr_->getFrameTargetTrajectories(targetFrameIndex);
   }
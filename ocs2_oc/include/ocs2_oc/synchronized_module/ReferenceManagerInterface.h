@@ -92,6 +92,9 @@ class ReferenceManagerInterface {
   virtual void setTargetTrajectories(TargetTrajectories&& targetTrajectories) = 0;
 
   // Functions for TargetTrajectories that concern a target frame
+  /** Returns the number of the target frames. */
+  virtual size_t getNumTargetFrames() const = 0;
+
   /** Returns a const reference to the active TargetTrajectories. */
   virtual const TargetTrajectories& getFrameTargetTrajectories(const int& targetFrameIndex) const = 0;
 
@@ -52,13 +52,14 @@ void approximateIntermediateLQ(OptimalControlProblem& problem, const scalar_t ti
   // Dynamics
   modelData.dynamicsCovariance = problem.dynamicsPtr->dynamicsCovariance(time, state, input);
   modelData.dynamics = problem.dynamicsPtr->linearApproximation(time, state, input, preComputation);
+  modelData.dynamicsStructure = problem.dynamicsPtr->getDynamicsStructure();
 
   // Cost
   modelData.cost = ocs2::approximateCost(problem, time, state, input);
 
   // Equality constraints
   modelData.stateEqConstraint = problem.stateEqualityConstraintPtr->getLinearApproximation(time, state, preComputation);
-  modelData.stateInputEqConstraint = problem.equalityConstraintPtr->getLinearApproximation(time, state, input, preComputation);
+  problem.equalityConstraintPtr->fillLinearApproximation(time, state, input, preComputation, modelData.stateInputEqConstraint);
 
   // Lagrangians
   if (!problem.stateEqualityLagrangianPtr->empty()) {
@@ -99,6 +100,7 @@ void approximatePreJumpLQ(OptimalControlProblem& problem, const scalar_t& time,
 
   // Jump map
   modelData.dynamics = problem.dynamicsPtr->jumpMapLinearApproximation(time, state, preComputation);
+  modelData.dynamicsStructure = DynamicsStructure();
 
   // Pre-jump cost
   modelData.cost = approximateEventCost(problem, time, state);
@@ -137,6 +139,7 @@ void approximateFinalLQ(OptimalControlProblem& problem, const scalar_t& time, co
 
   // Dynamics
   modelData.dynamics = VectorFunctionLinearApproximation();
+  modelData.dynamicsStructure = DynamicsStructure();
 
   // state equality constraint
   modelData.stateEqConstraint = problem.finalEqualityConstraintPtr->getLinearApproximation(time, state, preComputation);
@@ -187,7 +190,7 @@ ScalarFunctionQuadraticApproximation approximateCost(const OptimalControlProblem
   auto cost = problem.costPtr->getQuadraticApproximation(time, state, input, targetTrajectories, preComputation);
 
   if (!problem.softConstraintPtr->empty()) {
-    cost += problem.softConstraintPtr->getQuadraticApproximation(time, state, input, targetTrajectories, preComputation);
+    problem.softConstraintPtr->addQuadraticApproximation(time, state, input, targetTrajectories, preComputation, cost);
   }
 
   // get the state only cost approximations
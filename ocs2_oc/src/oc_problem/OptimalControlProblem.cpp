@@ -94,6 +94,9 @@ OptimalControlProblem::OptimalControlProblem(const OptimalControlProblem& other)
       /* Misc. */
       preComputationPtr(other.preComputationPtr->clone()),
       targetTrajectoriesPtr(other.targetTrajectoriesPtr) {
+  if (other.fixedInputsPtr != nullptr) {
+    fixedInputsPtr.reset(other.fixedInputsPtr->clone());
+  }
   if (other.dynamicsPtr != nullptr) {
     dynamicsPtr.reset(other.dynamicsPtr->clone());
   }
@@ -129,6 +132,7 @@ void OptimalControlProblem::swap(OptimalControlProblem& other) noexcept {
   stateEqualityConstraintPtr.swap(other.stateEqualityConstraintPtr);
   preJumpEqualityConstraintPtr.swap(other.preJumpEqualityConstraintPtr);
   finalEqualityConstraintPtr.swap(other.finalEqualityConstraintPtr);
+  fixedInputsPtr.swap(other.fixedInputsPtr);
 
   /* Lagrangians */
   equalityLagrangianPtr.swap(other.equalityLagrangianPtr);
@@ -27,6 +27,7 @@ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
 OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 ******************************************************************************/
 
+#include <algorithm>
 #include <iostream>
 #include <mutex>
 
@@ -48,8 +49,17 @@ SolverBase::SolverBase() : referenceManagerPtr_(new ReferenceManager) {}
 /******************************************************************************************************/
 void SolverBase::run(scalar_t initTime, const vector_t& initState, scalar_t finalTime) {
   preRun(initTime, initState, finalTime);
-  runImpl(initTime, initState, finalTime);
+  if (initialGuessProvider_) {
+    const auto initialGuessProvider = std::move(initialGuessProvider_);
+    initialGuessProvider_ = nullptr;
+    const auto& initialGuess = initialGuessProvider(initTime, initState, finalTime, *referenceManagerPtr_);
+    deadline_.start(timeBudget_);
+    runImpl(initTime, initState, finalTime, initialGuess);
+  } else {
+    runImpl(initTime, initState, finalTime);
+  }
   postRun();
+  updateTimeBudgetStatistics();
 }
 
 /******************************************************************************************************/
@@ -59,6 +69,7 @@ void SolverBase::run(scalar_t initTime, const vector_t& initState, scalar_t fina
   preRun(initTime, initState, finalTime);
   runImpl(initTime, initState, finalTime, externalControllerPtr);
   postRun();
+  updateTimeBudgetStatistics();
 }
 
 /******************************************************************************************************/
@@ -68,6 +79,7 @@ void SolverBase::run(scalar_t initTime, const vector_t& initState, scalar_t fina
   preRun(initTime, initState, finalTime);
   runImpl(initTime, initState, finalTime, primalSolution);
   postRun();
+  updateTimeBudgetStatistics();
 }
 
 /******************************************************************************************************/
@@ -91,6 +103,9 @@ void SolverBase::printString(const std::string& text) const {
 /******************************************************************************************************/
 /******************************************************************************************************/
 void SolverBase::preRun(scalar_t initTime, const vector_t& initState, scalar_t finalTime) {
+  deadline_.start(timeBudget_);
+  isTerminatedByTimeBudget_ = false;
+
   referenceManagerPtr_->preSolverRun(initTime, finalTime, initState);
 
   for (auto& module : synchronizedModules_) {
@@ -114,4 +129,23 @@ void SolverBase::postRun() {
   }
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void SolverBase::updateTimeBudgetStatistics() {
+  auto& stats = timeBudgetStatistics_;
+  stats.numRuns++;
+  stats.lastRunInMilliseconds = deadline_.getElapsedInMilliseconds();
+  if (isTerminatedByTimeBudget_) {
+    stats.numTerminatedRuns++;
+  }
+  if (deadline_.isActive()) {
+    const scalar_t overrun = -deadline_.getRemainingInMilliseconds();
+    if (overrun > 0.0) {
+      stats.numOverruns++;
+      stats.maxOverrunInMilliseconds = std::max(stats.maxOverrunInMilliseconds, overrun);
+    }
+  }
+}
+
 }  // namespace ocs2
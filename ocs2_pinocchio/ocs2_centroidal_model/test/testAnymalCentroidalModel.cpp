@@ -28,10 +28,13 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 ******************************************************************************/
 
 #include <gtest/gtest.h>
+#include <iostream>
 
 #include <pinocchio/multibody/data.hpp>
 #include <pinocchio/multibody/model.hpp>
 
+#include <ocs2_core/misc/Benchmark.h>
+
 #include "ocs2_centroidal_model/CentroidalModelRbdConversions.h"
 #include "ocs2_centroidal_model/FactoryFunctions.h"
 #include "ocs2_centroidal_model/ModelHelperFunctions.h"
@@ -123,6 +126,102 @@ TEST_P(TestAnymalCentroidalModel, dynamis_flowMap) {
   }
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+TEST_P(TestAnymalCentroidalModel, dynamics_sixDofContacts) {
+  const CentroidalModelType type = GetParam();
+  const size_t numJoints = pinocchioInterfacePtr->getModel().nq - 6;
+  // the hind feet take wrenches, such that their inputs follow the forces of the front feet
+  const auto info = createCentroidalModelInfo(*pinocchioInterfacePtr, type, getInitialState().tail(numJoints), {"LF_FOOT", "RF_FOOT"},
+                                              {"LH_FOOT", "RH_FOOT"});
+  ASSERT_EQ(info.inputDim, 2 * 3 + 2 * 6 + numJoints);
+
+  CentroidalModelPinocchioMapping mapping(info);
+  mapping.setPinocchioInterface(*pinocchioInterfacePtr);
+
+  // Analytical model
+  PinocchioCentroidalDynamics anymalDynamics(info);
+  anymalDynamics.setPinocchioInterface(*pinocchioInterfacePtr);
+
+  // CppAD model
+  const std::string modelName = "TestAnymal" + toString(type) + "SixDofContactsAd";
+  PinocchioCentroidalDynamicsAD anymalDynamicsAd(*pinocchioInterfacePtr, info, modelName);
+
+  for (size_t i = 0; i < numTests; i++) {
+    const scalar_t time = 0.0;
+    const vector_t state = 10.0 * vector_t::Random(info.stateDim);
+    const vector_t input = 10000.0 * vector_t::Random(info.inputDim);
+
+    const vector_t qPinocchio = mapping.getPinocchioJointPosition(state);
+    const vector_t vPinocchio = mapping.getPinocchioJointVelocity(state, input);
+    updateCentroidalDynamics(*pinocchioInterfacePtr, info, qPinocchio);
+    updateCentroidalDynamicsDerivatives(*pinocchioInterfacePtr, info, qPinocchio, vPinocchio);
+
+    const auto linearApproximation = anymalDynamics.getLinearApproximation(time, state, input);
+    const auto linearApproximationAd = anymalDynamicsAd.getLinearApproximation(time, state, input);
+
+    EXPECT_TRUE(linearApproximationAd.f.isApprox(linearApproximation.f, tol));
+    EXPECT_TRUE(linearApproximationAd.dfdx.isApprox(linearApproximation.dfdx, tol));
+    EXPECT_TRUE(linearApproximationAd.dfdu.isApprox(linearApproximation.dfdu, tol));
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+TEST_P(TestAnymalCentroidalModel, DISABLED_dynamics_benchmark) {
+  const CentroidalModelType type = GetParam();
+  auto mappingPtr = createMapping(type);
+  const auto& info = mappingPtr->getCentroidalModelInfo();
+
+  // Analytical model
+  PinocchioCentroidalDynamics anymalDynamics(createInfo(type));
+  anymalDynamics.setPinocchioInterface(*pinocchioInterfacePtr);
+
+  // CppAD model: code generation and loading of an already generated library
+  const std::string modelName = "TestAnymal" + toString(type) + "AdBenchmark";
+  benchmark::RepeatedTimer generationTimer, loadingTimer;
+  generationTimer.startTimer();
+  std::unique_ptr<PinocchioCentroidalDynamicsAD> anymalDynamicsAdPtr(
+      new PinocchioCentroidalDynamicsAD(*pinocchioInterfacePtr, createInfo(type), modelName, "/tmp/ocs2", true));
+  generationTimer.endTimer();
+  loadingTimer.startTimer();
+  anymalDynamicsAdPtr.reset(new PinocchioCentroidalDynamicsAD(*pinocchioInterfacePtr, createInfo(type), modelName, "/tmp/ocs2", false));
+  loadingTimer.endTimer();
+
+  benchmark::RepeatedTimer analyticalTimer, adTimer;
+  scalar_t maxError = 0.0;
+  for (size_t i = 0; i < numTests; i++) {
+    const scalar_t time = 0.0;
+    const vector_t state = 10.0 * vector_t::Random(anymal::STATE_DIM);
+    const vector_t input = 10000.0 * vector_t::Random(anymal::INPUT_DIM);
+
+    // the analytical timing includes the pinocchio kinematics and derivative computations
+    analyticalTimer.startTimer();
+    const vector_t qPinocchio = mappingPtr->getPinocchioJointPosition(state);
+    updateCentroidalDynamics(*pinocchioInterfacePtr, info, qPinocchio);
+    const vector_t vPinocchio = mappingPtr->getPinocchioJointVelocity(state, input);
+    updateCentroidalDynamicsDerivatives(*pinocchioInterfacePtr, info, qPinocchio, vPinocchio);
+    const auto linearApproximation = anymalDynamics.getLinearApproximation(time, state, input);
+    analyticalTimer.endTimer();
+
+    adTimer.startTimer();
+    const auto linearApproximationAd = anymalDynamicsAdPtr->getLinearApproximation(time, state, input);
+    adTimer.endTimer();
+
+    // the Jacobians are checked in dynamis_flowMap, here only their difference is reported
+    maxError = std::max(maxError, (linearApproximationAd.dfdx - linearApproximation.dfdx).lpNorm<Eigen::Infinity>());
+    maxError = std::max(maxError, (linearApproximationAd.dfdu - linearApproximation.dfdu).lpNorm<Eigen::Infinity>());
+  }
+
+  std::cerr << "[" << toString(type) << "] CppAD code generation [ms]: " << generationTimer.getTotalInMilliseconds() << "\n";
+  std::cerr << "[" << toString(type) << "] CppAD library loading [ms]: " << loadingTimer.getTotalInMilliseconds() << "\n";
+  std::cerr << "[" << toString(type) << "] Analytical linear approximation [ms]: " << analyticalTimer.getAverageInMilliseconds() << "\n";
+  std::cerr << "[" << toString(type) << "] CppAD linear approximation [ms]: " << adTimer.getAverageInMilliseconds() << "\n";
+  std::cerr << "[" << toString(type) << "] Maximum absolute Jacobian difference: " << maxError << "\n";
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -0,0 +1,124 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+ * Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+ * Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+ * Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <utility>
+#include <vector>
+
+#include <ocs2_core/Types.h>
+
+namespace ocs2 {
+
+/**
+ * Batched signed distance kernel for the sphere pairs of collision sphere groups.
+ *
+ * The spheres are partitioned into groups (e.g. the spheres approximating one primitive shape) which are attached to a single body.
+ * The sphere centers and radii are stored in structure-of-arrays form such that the distances between a sphere and all the spheres of
+ * another group are evaluated with vectorized array expressions. All the sphere pairs of a group pair are first pruned by the bounding
+ * spheres of the two groups.
+ *
+ * The signed distance of each sphere pair is clamped at the activation distance, i.e. min(distance, activationDistance). Therefore,
+ * the pruning is exact and the sphere pairs beyond the activation distance have a zero gradient.
+ */
+class SphereDistanceKernel {
+ public:
+  using vector3_t = Eigen::Matrix<scalar_t, 3, 1>;
+
+  /**
+   * Constructor
+   *
+   * @param [in] numSpheres: The number of spheres of each group. The spheres of a group are contiguous in the sphere arrays.
+   * @param [in] sphereRadii: The radius of each sphere.
+   * @param [in] groupPairs: The pairs of groups whose sphere pairs are evaluated.
+   * @param [in] activationDistance: The distance at which the sphere pair distances are clamped.
+   */
+  SphereDistanceKernel(size_array_t numSpheres, const scalar_array_t& sphereRadii, std::vector<std::pair<size_t, size_t>> groupPairs,
+                       scalar_t activationDistance);
+
+  /** Gets the number of the evaluated sphere pairs. */
+  size_t getNumSpherePairs() const { return numSpherePairs_; }
+
+  /** Gets the group pairs. */
+  const std::vector<std::pair<size_t, size_t>>& getGroupPairs() const { return groupPairs_; }
+
+  /**
+   * Sets the sphere centers in the world frame and updates the bounding spheres of the groups.
+   *
+   * @param [in] sphereCenters: The center of each sphere in the world frame.
+   */
+  void setSphereCenters(const std::vector<vector3_t>& sphereCenters);
+
+  /**
+   * Computes the clamped signed distance of all the sphere pairs. The sphere pairs of a group pair (a, b) are ordered as
+   * (a0, b0), (a0, b1), ..., (a1, b0), ...
+   *
+   * @note Requires setSphereCenters().
+   */
+  vector_t getValue() const;
+
+  /**
+   * Computes the clamped signed distance of all the sphere pairs and its Jacobian with respect to the generalized velocities.
+   *
+   * @note Requires setSphereCenters().
+   *
+   * @param [in] groupJacobians: The 6 x nv Jacobian of the body of each group expressed in the world frame at the body origin,
+   * with the linear part on top of the angular part (pinocchio::LOCAL_WORLD_ALIGNED).
+   * @param [in] groupOrigins: The origin of the body of each group in the world frame.
+   * @return The pair of the distances and their Jacobian.
+   */
+  std::pair<vector_t, matrix_t> getLinearApproximation(const std::vector<matrix_t>& groupJacobians,
+                                                       const std::vector<vector3_t>& groupOrigins) const;
+
+ private:
+  /** Whether the bounding spheres of the group pair are closer than the activation distance. */
+  bool isGroupPairActive(size_t groupPairIndex) const;
+
+  /** Computes the clamped distances of a group pair into its segment of the output. */
+  void computeGroupPairDistances(size_t groupPairIndex, vector_t& distances) const;
+
+  size_array_t numSpheres_;
+  size_array_t groupStart_;
+  std::vector<std::pair<size_t, size_t>> groupPairs_;
+  size_array_t groupPairStart_;
+  size_t numSpherePairs_ = 0;
+  scalar_t activationDistance_;
+
+  // structure-of-arrays sphere data
+  vector_t centersX_;
+  vector_t centersY_;
+  vector_t centersZ_;
+  vector_t radii_;
+
+  // bounding spheres of the groups
+  std::vector<vector3_t> boundingCenters_;
+  vector_t boundingRadii_;
+};
+
+}  // namespace ocs2
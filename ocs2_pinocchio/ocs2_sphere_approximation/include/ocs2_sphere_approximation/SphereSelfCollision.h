@@ -0,0 +1,102 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+ * Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+ * Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+ * Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <ocs2_pinocchio_interface/PinocchioInterface.h>
+
+#include <ocs2_sphere_approximation/PinocchioSphereInterface.h>
+#include <ocs2_sphere_approximation/SphereDistanceKernel.h>
+
+namespace ocs2 {
+
+/**
+ * Self-collision distances between the collision spheres of link pairs.
+ *
+ * The collision links are approximated with spheres by PinocchioSphereInterface and the distances of all the sphere pairs of the
+ * specified link pairs are evaluated in a batch by SphereDistanceKernel. Each sphere pair is a separate constraint. The distance of a
+ * sphere pair is clamped at the activation distance, which lets the kernel skip the primitive shape pairs whose bounding spheres are
+ * farther apart.
+ */
+class SphereSelfCollision {
+ public:
+  using vector3_t = Eigen::Matrix<scalar_t, 3, 1>;
+
+  /**
+   * Constructor
+   *
+   * @param [in] pinocchioSphereInterface: pinocchio sphere interface of the robot model
+   * @param [in] collisionLinkPairs: pairs of the names of the links to be checked. The links must be collision links of
+   * pinocchioSphereInterface, otherwise the pair is ignored.
+   * @param [in] minimumDistance: minimum allowed distance between each sphere pair
+   * @param [in] activationDistance: distance at which the sphere pair distances are clamped
+   */
+  SphereSelfCollision(PinocchioSphereInterface pinocchioSphereInterface,
+                      const std::vector<std::pair<std::string, std::string>>& collisionLinkPairs, scalar_t minimumDistance,
+                      scalar_t activationDistance);
+
+  /** Get the number of sphere pairs */
+  size_t getNumCollisionPairs() const { return kernel_.getNumSpherePairs(); }
+
+  /** Get the pinocchio sphere interface */
+  const PinocchioSphereInterface& getPinocchioSphereInterface() const { return pinocchioSphereInterface_; }
+
+  /**
+   * Evaluate the distance violation of each sphere pair.
+   *
+   * @note Requires updated forwardKinematics() on pinocchioInterface.
+   *
+   * @param [in] pinocchioInterface: pinocchio interface of the robot model
+   * @return: The differences between the clamped distance of each sphere pair and the minimum distance
+   */
+  vector_t getValue(const PinocchioInterface& pinocchioInterface) const;
+
+  /**
+   * Evaluate the linear approximation of the distance violation of each sphere pair.
+   *
+   * @note Requires updated forwardKinematics(), updateGlobalPlacements() and computeJointJacobians() on pinocchioInterface.
+   *
+   * @param [in] pinocchioInterface: pinocchio interface of the robot model
+   * @return: The pair of the distance violation and its first derivative against q
+   */
+  std::pair<vector_t, matrix_t> getLinearApproximation(const PinocchioInterface& pinocchioInterface) const;
+
+ private:
+  PinocchioSphereInterface pinocchioSphereInterface_;
+  mutable SphereDistanceKernel kernel_;  // caches the sphere centers of the latest evaluation
+  size_array_t uniqueJointIds_;          // the parent joints of the primitive shapes
+  size_array_t shapeToUniqueJoint_;      // index of the parent joint of each primitive shape in uniqueJointIds_
+  scalar_t minimumDistance_;
+};
+
+}  // namespace ocs2
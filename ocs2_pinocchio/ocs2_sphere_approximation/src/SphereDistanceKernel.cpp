@@ -0,0 +1,226 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+ * Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+ * Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+ * Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include "ocs2_sphere_approximation/SphereDistanceKernel.h"
+
+#include <algorithm>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+
+namespace ocs2 {
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+SphereDistanceKernel::SphereDistanceKernel(size_array_t numSpheres, const scalar_array_t& sphereRadii,
+                                           std::vector<std::pair<size_t, size_t>> groupPairs, scalar_t activationDistance)
+    : numSpheres_(std::move(numSpheres)), groupPairs_(std::move(groupPairs)), activationDistance_(activationDistance) {
+  const size_t numGroups = numSpheres_.size();
+  groupStart_.resize(numGroups + 1, 0);
+  std::partial_sum(numSpheres_.begin(), numSpheres_.end(), groupStart_.begin() + 1);
+
+  const size_t numSpheresInTotal = groupStart_.back();
+  if (sphereRadii.size() != numSpheresInTotal) {
+    throw std::runtime_error("[SphereDistanceKernel] The number of sphere radii (" + std::to_string(sphereRadii.size()) +
+                             ") does not match the number of spheres (" + std::to_string(numSpheresInTotal) + ")!");
+  }
+  radii_ = Eigen::Map<const vector_t>(sphereRadii.data(), numSpheresInTotal);
+  centersX_.setZero(numSpheresInTotal);
+  centersY_.setZero(numSpheresInTotal);
+  centersZ_.setZero(numSpheresInTotal);
+
+  groupPairStart_.reserve(groupPairs_.size() + 1);
+  groupPairStart_.push_back(0);
+  for (const auto& groupPair : groupPairs_) {
+    if (groupPair.first >= numGroups || groupPair.second >= numGroups) {
+      throw std::runtime_error("[SphereDistanceKernel] Group pair (" + std::to_string(groupPair.first) + ", " +
+                               std::to_string(groupPair.second) + ") is out of range!");
+    }
+    numSpherePairs_ += numSpheres_[groupPair.first] * numSpheres_[groupPair.second];
+    groupPairStart_.push_back(numSpherePairs_);
+  }
+
+  boundingCenters_.resize(numGroups, vector3_t::Zero());
+  boundingRadii_.setZero(numGroups);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void SphereDistanceKernel::setSphereCenters(const std::vector<vector3_t>& sphereCenters) {
+  if (sphereCenters.size() != static_cast<size_t>(radii_.size())) {
+    throw std::runtime_error("[SphereDistanceKernel] The number of sphere centers (" + std::to_string(sphereCenters.size()) +
+                             ") does not match the number of spheres (" + std::to_string(radii_.size()) + ")!");
+  }
+
+  for (size_t i = 0; i < sphereCenters.size(); i++) {
+    centersX_[i] = sphereCenters[i].x();
+    centersY_[i] = sphereCenters[i].y();
+    centersZ_[i] = sphereCenters[i].z();
+  }
+
+  // bounding sphere of each group centered at the mean of its sphere centers
+  for (size_t g = 0; g < numSpheres_.size(); g++) {
+    const size_t start = groupStart_[g];
+    const size_t n = numSpheres_[g];
+    if (n == 0) {
+      continue;
+    }
+    const auto x = centersX_.segment(start, n).array();
+    const auto y = centersY_.segment(start, n).array();
+    const auto z = centersZ_.segment(start, n).array();
+    boundingCenters_[g] << x.mean(), y.mean(), z.mean();
+    boundingRadii_[g] = (((x - boundingCenters_[g].x()).square() + (y - boundingCenters_[g].y()).square() +
+                          (z - boundingCenters_[g].z()).square())
+                             .sqrt() +
+                         radii_.segment(start, n).array())
+                            .maxCoeff();
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+bool SphereDistanceKernel::isGroupPairActive(size_t groupPairIndex) const {
+  const auto a = groupPairs_[groupPairIndex].first;
+  const auto b = groupPairs_[groupPairIndex].second;
+  const scalar_t lowerBound = (boundingCenters_[b] - boundingCenters_[a]).norm() - boundingRadii_[a] - boundingRadii_[b];
+  return lowerBound < activationDistance_;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void SphereDistanceKernel::computeGroupPairDistances(size_t groupPairIndex, vector_t& distances) const {
+  const auto a = groupPairs_[groupPairIndex].first;
+  const auto b = groupPairs_[groupPairIndex].second;
+  const size_t startB = groupStart_[b];
+  const size_t nB = numSpheres_[b];
+
+  const auto xB = centersX_.segment(startB, nB).array();
+  const auto yB = centersY_.segment(startB, nB).array();
+  const auto zB = centersZ_.segment(startB, nB).array();
+  const auto rB = radii_.segment(startB, nB).array();
+
+  size_t offset = groupPairStart_[groupPairIndex];
+  for (size_t i = groupStart_[a]; i < groupStart_[a + 1]; i++) {
+    distances.segment(offset, nB).array() =
+        (((xB - centersX_[i]).square() + (yB - centersY_[i]).square() + (zB - centersZ_[i]).square()).sqrt() - rB - radii_[i])
+            .min(activationDistance_);
+    offset += nB;
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+vector_t SphereDistanceKernel::getValue() const {
+  vector_t distances(numSpherePairs_);
+  for (size_t p = 0; p < groupPairs_.size(); p++) {
+    if (isGroupPairActive(p)) {
+      computeGroupPairDistances(p, distances);
+    } else {
+      distances.segment(groupPairStart_[p], groupPairStart_[p + 1] - groupPairStart_[p]).setConstant(activationDistance_);
+    }
+  }
+  return distances;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+std::pair<vector_t, matrix_t> SphereDistanceKernel::getLinearApproximation(const std::vector<matrix_t>& groupJacobians,
+                                                                           const std::vector<vector3_t>& groupOrigins) const {
+  if (groupJacobians.size() != numSpheres_.size() || groupOrigins.size() != numSpheres_.size()) {
+    throw std::runtime_error("[SphereDistanceKernel] A Jacobian and an origin is required for each group!");
+  }
+  const auto nv = groupJacobians.empty() ? 0 : groupJacobians.front().cols();
+
+  vector_t distances(numSpherePairs_);
+  matrix_t jacobian = matrix_t::Zero(numSpherePairs_, nv);
+
+  // Each row of the Jacobian is w_b^T * J_b - w_a^T * J_a with w = [n; r x n], where n is the unit vector from the center of sphere a
+  // to the center of sphere b and r is the offset of the sphere center from the body origin. The rows of the active sphere pairs of a
+  // group pair are stacked such that the products with the body Jacobians are evaluated as matrix-matrix products.
+  Eigen::Matrix<scalar_t, Eigen::Dynamic, 6> weightsA;
+  Eigen::Matrix<scalar_t, Eigen::Dynamic, 6> weightsB;
+  size_array_t activeRows;
+  for (size_t p = 0; p < groupPairs_.size(); p++) {
+    const size_t pairStart = groupPairStart_[p];
+    const size_t numPairs = groupPairStart_[p + 1] - pairStart;
+    if (!isGroupPairActive(p)) {
+      distances.segment(pairStart, numPairs).setConstant(activationDistance_);
+      continue;
+    }
+    computeGroupPairDistances(p, distances);
+
+    const auto a = groupPairs_[p].first;
+    const auto b = groupPairs_[p].second;
+    weightsA.resize(numPairs, 6);
+    weightsB.resize(numPairs, 6);
+    activeRows.clear();
+    size_t row = pairStart;
+    for (size_t i = groupStart_[a]; i < groupStart_[a + 1]; i++) {
+      const vector3_t centerA(centersX_[i], centersY_[i], centersZ_[i]);
+      for (size_t j = groupStart_[b]; j < groupStart_[b + 1]; j++, row++) {
+        if (distances[row] >= activationDistance_) {
+          continue;
+        }
+        const vector3_t centerB(centersX_[j], centersY_[j], centersZ_[j]);
+        const vector3_t difference = centerB - centerA;
+        const scalar_t norm = difference.norm();
+        // the direction is undefined for coincident centers
+        const vector3_t n = norm > 0.0 ? vector3_t(difference / norm) : vector3_t::Zero();
+
+        const auto k = activeRows.size();
+        weightsA.block<1, 3>(k, 0) = n.transpose();
+        weightsA.block<1, 3>(k, 3) = (centerA - groupOrigins[a]).cross(n).transpose();
+        weightsB.block<1, 3>(k, 0) = n.transpose();
+        weightsB.block<1, 3>(k, 3) = (centerB - groupOrigins[b]).cross(n).transpose();
+        activeRows.push_back(row);
+      }
+    }
+
+    const auto numActive = activeRows.size();
+    if (numActive == 0) {
+      continue;
+    }
+    matrix_t activeJacobian(numActive, nv);
+    activeJacobian.noalias() = weightsB.topRows(numActive) * groupJacobians[b];
+    activeJacobian.noalias() -= weightsA.topRows(numActive) * groupJacobians[a];
+    for (size_t k = 0; k < numActive; k++) {
+      jacobian.row(activeRows[k]) = activeJacobian.row(k);
+    }
+  }
+
+  return {distances, jacobian};
+}
+
+}  // namespace ocs2
@@ -0,0 +1,125 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+ * Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+ * Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+ * Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <pinocchio/fwd.hpp>
+
+#include <pinocchio/algorithm/jacobian.hpp>
+#include <pinocchio/multibody/geometry.hpp>
+
+#include <algorithm>
+
+#include "ocs2_sphere_approximation/SphereSelfCollision.h"
+
+namespace ocs2 {
+
+namespace {
+
+/** Pairs of the primitive shapes of the collision link pairs. */
+std::vector<std::pair<size_t, size_t>> getPrimitiveShapePairs(const PinocchioSphereInterface& pinocchioSphereInterface,
+                                                              const std::vector<std::pair<std::string, std::string>>& collisionLinkPairs) {
+  const auto& shapeLinks = pinocchioSphereInterface.getCollisionLinkOfEachPrimitveShape();
+  std::vector<std::pair<size_t, size_t>> shapePairs;
+  for (const auto& linkPair : collisionLinkPairs) {
+    for (size_t i = 0; i < shapeLinks.size(); i++) {
+      if (shapeLinks[i] != linkPair.first) {
+        continue;
+      }
+      for (size_t j = 0; j < shapeLinks.size(); j++) {
+        if (shapeLinks[j] == linkPair.second) {
+          shapePairs.emplace_back(i, j);
+        }
+      }
+    }
+  }
+  return shapePairs;
+}
+
+}  // namespace
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+SphereSelfCollision::SphereSelfCollision(PinocchioSphereInterface pinocchioSphereInterface,
+                                         const std::vector<std::pair<std::string, std::string>>& collisionLinkPairs,
+                                         scalar_t minimumDistance, scalar_t activationDistance)
+    : pinocchioSphereInterface_(std::move(pinocchioSphereInterface)),
+      kernel_(pinocchioSphereInterface_.getNumSpheres(), pinocchioSphereInterface_.getSphereRadii(),
+              getPrimitiveShapePairs(pinocchioSphereInterface_, collisionLinkPairs), activationDistance),
+      minimumDistance_(minimumDistance) {
+  const auto& geometryModel = pinocchioSphereInterface_.getGeometryModel();
+  for (const auto geomObjId : pinocchioSphereInterface_.getGeomObjIds()) {
+    const size_t jointId = geometryModel.geometryObjects[geomObjId].parentJoint;
+    const auto it = std::find(uniqueJointIds_.begin(), uniqueJointIds_.end(), jointId);
+    shapeToUniqueJoint_.push_back(std::distance(uniqueJointIds_.begin(), it));
+    if (it == uniqueJointIds_.end()) {
+      uniqueJointIds_.push_back(jointId);
+    }
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+vector_t SphereSelfCollision::getValue(const PinocchioInterface& pinocchioInterface) const {
+  kernel_.setSphereCenters(pinocchioSphereInterface_.computeSphereCentersInWorldFrame(pinocchioInterface));
+  vector_t violations = kernel_.getValue();
+  violations.array() -= minimumDistance_;
+  return violations;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+std::pair<vector_t, matrix_t> SphereSelfCollision::getLinearApproximation(const PinocchioInterface& pinocchioInterface) const {
+  const auto& model = pinocchioInterface.getModel();
+  const auto& data = pinocchioInterface.getData();
+
+  // the Jacobian of each parent joint is computed once and shared by its primitive shapes
+  std::vector<matrix_t> jointJacobians(uniqueJointIds_.size(), matrix_t::Zero(6, model.nv));
+  for (size_t k = 0; k < uniqueJointIds_.size(); k++) {
+    pinocchio::getJointJacobian(model, data, uniqueJointIds_[k], pinocchio::ReferenceFrame::LOCAL_WORLD_ALIGNED, jointJacobians[k]);
+  }
+
+  const size_t numShapes = shapeToUniqueJoint_.size();
+  std::vector<matrix_t> shapeJacobians;
+  std::vector<vector3_t> shapeOrigins;
+  shapeJacobians.reserve(numShapes);
+  shapeOrigins.reserve(numShapes);
+  for (const auto k : shapeToUniqueJoint_) {
+    shapeJacobians.push_back(jointJacobians[k]);
+    shapeOrigins.emplace_back(data.oMi[uniqueJointIds_[k]].translation());
+  }
+
+  kernel_.setSphereCenters(pinocchioSphereInterface_.computeSphereCentersInWorldFrame(pinocchioInterface));
+  auto approximation = kernel_.getLinearApproximation(shapeJacobians, shapeOrigins);
+  approximation.first.array() -= minimumDistance_;
+  return approximation;
+}
+
+}  // namespace ocs2
@@ -0,0 +1,166 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+ * Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+ * Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+ * Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <algorithm>
+
+#include <gtest/gtest.h>
+
+#include <ocs2_sphere_approximation/SphereDistanceKernel.h>
+
+using namespace ocs2;
+using vector3_t = SphereDistanceKernel::vector3_t;
+
+class SphereDistanceKernelTest : public ::testing::Test {
+ protected:
+  static constexpr size_t numVelocities = 5;
+
+  SphereDistanceKernelTest() {
+    srand(0);
+    for (size_t g = 0; g < numSpheres.size(); g++) {
+      const scalar_t angle = 0.5 * static_cast<scalar_t>(g);
+      bodyOrigins.emplace_back(0.3 * vector3_t::Random() + vector3_t(0.3 * g, 0.0, 0.0));
+      bodyRotations.emplace_back(Eigen::AngleAxis<scalar_t>(angle, vector3_t::UnitZ()).toRotationMatrix());
+      linearJacobians.emplace_back(matrix_t::Random(3, numVelocities));
+      angularJacobians.emplace_back(matrix_t::Random(3, numVelocities));
+      for (size_t i = 0; i < numSpheres[g]; i++) {
+        sphereOffsets.emplace_back(0.3 * vector3_t::Random());
+        sphereRadii.push_back(0.05 + 0.1 * std::abs(vector3_t::Random().x()));
+        sphereGroup.push_back(g);
+      }
+    }
+  }
+
+  /** Sphere centers of rigid bodies whose origins and orientations move with the generalized coordinates q. */
+  std::vector<vector3_t> getSphereCenters(const vector_t& q) const {
+    std::vector<vector3_t> centers;
+    for (size_t i = 0; i < sphereOffsets.size(); i++) {
+      const auto g = sphereGroup[i];
+      const vector3_t origin = bodyOrigins[g] + linearJacobians[g] * q;
+      const vector3_t rotationVector = angularJacobians[g] * q;
+      const scalar_t angle = rotationVector.norm();
+      const matrix_t rotation =
+          angle > 0.0 ? matrix_t(Eigen::AngleAxis<scalar_t>(angle, rotationVector / angle).toRotationMatrix() * bodyRotations[g])
+                      : matrix_t(bodyRotations[g]);
+      centers.emplace_back(origin + rotation * sphereOffsets[i]);
+    }
+    return centers;
+  }
+
+  vector_t bruteForceDistances(const std::vector<vector3_t>& centers, scalar_t activationDistance) const {
+    std::vector<scalar_t> distances;
+    for (const auto& groupPair : groupPairs) {
+      for (size_t i = 0; i < centers.size(); i++) {
+        for (size_t j = 0; j < centers.size(); j++) {
+          if (sphereGroup[i] == groupPair.first && sphereGroup[j] == groupPair.second) {
+            const scalar_t d = (centers[j] - centers[i]).norm() - sphereRadii[i] - sphereRadii[j];
+            distances.push_back(std::min(d, activationDistance));
+          }
+        }
+      }
+    }
+    return Eigen::Map<vector_t>(distances.data(), distances.size());
+  }
+
+  const size_array_t numSpheres{3, 5, 1, 4};
+  const std::vector<std::pair<size_t, size_t>> groupPairs{{0, 1}, {0, 3}, {1, 2}, {2, 3}};
+
+  std::vector<vector3_t> bodyOrigins;
+  std::vector<matrix_t> bodyRotations;
+  std::vector<matrix_t> linearJacobians;
+  std::vector<matrix_t> angularJacobians;
+  std::vector<vector3_t> sphereOffsets;
+  scalar_array_t sphereRadii;
+  size_array_t sphereGroup;
+};
+
+constexpr size_t SphereDistanceKernelTest::numVelocities;
+
+TEST_F(SphereDistanceKernelTest, valueWithoutPruning) {
+  constexpr scalar_t activationDistance = 1e+6;
+  SphereDistanceKernel kernel(numSpheres, sphereRadii, groupPairs, activationDistance);
+  ASSERT_EQ(kernel.getNumSpherePairs(), 3 * 5 + 3 * 4 + 5 * 1 + 1 * 4);
+
+  const auto centers = getSphereCenters(vector_t::Zero(numVelocities));
+  kernel.setSphereCenters(centers);
+  EXPECT_TRUE(kernel.getValue().isApprox(bruteForceDistances(centers, activationDistance)));
+}
+
+TEST_F(SphereDistanceKernelTest, valueWithPruning) {
+  for (const scalar_t activationDistance : {-0.5, 0.0, 0.2, 0.5, 1.0}) {
+    SphereDistanceKernel kernel(numSpheres, sphereRadii, groupPairs, activationDistance);
+    const auto centers = getSphereCenters(vector_t::Random(numVelocities));
+    kernel.setSphereCenters(centers);
+    EXPECT_TRUE(kernel.getValue().isApprox(bruteForceDistances(centers, activationDistance))) << "activation: " << activationDistance;
+  }
+}
+
+TEST_F(SphereDistanceKernelTest, linearApproximation) {
+  constexpr scalar_t activationDistance = 0.5;
+  constexpr scalar_t eps = 1e-6;
+  SphereDistanceKernel kernel(numSpheres, sphereRadii, groupPairs, activationDistance);
+
+  const vector_t q0 = vector_t::Zero(numVelocities);
+  kernel.setSphereCenters(getSphereCenters(q0));
+
+  // at q = 0 the body Jacobians are the linear and angular Jacobians of the bodies
+  std::vector<matrix_t> groupJacobians;
+  for (size_t g = 0; g < numSpheres.size(); g++) {
+    matrix_t jacobian(6, numVelocities);
+    jacobian << linearJacobians[g], angularJacobians[g];
+    groupJacobians.push_back(jacobian);
+  }
+
+  vector_t f;
+  matrix_t dfdq;
+  std::tie(f, dfdq) = kernel.getLinearApproximation(groupJacobians, bodyOrigins);
+  EXPECT_TRUE(f.isApprox(kernel.getValue()));
+
+  matrix_t dfdqFiniteDifference(f.size(), numVelocities);
+  for (size_t k = 0; k < numVelocities; k++) {
+    kernel.setSphereCenters(getSphereCenters(q0 + eps * vector_t::Unit(numVelocities, k)));
+    const vector_t fPlus = kernel.getValue();
+    kernel.setSphereCenters(getSphereCenters(q0 - eps * vector_t::Unit(numVelocities, k)));
+    const vector_t fMinus = kernel.getValue();
+    dfdqFiniteDifference.col(k) = (fPlus - fMinus) / (2.0 * eps);
+  }
+
+  // the sphere pairs close to the activation distance are not differentiable
+  for (int i = 0; i < f.size(); i++) {
+    if (std::abs(f[i] - activationDistance) > 1e-3) {
+      EXPECT_TRUE(dfdq.row(i).isApprox(dfdqFiniteDifference.row(i), 1e-5)) << "sphere pair " << i;
+    }
+  }
+  EXPECT_LT((f.array() < activationDistance).count(), f.size());  // some sphere pairs are clamped
+  EXPECT_GT((f.array() < activationDistance).count(), 0);         // some sphere pairs are active
+}
+
+TEST_F(SphereDistanceKernelTest, invalidArguments) {
+  EXPECT_THROW(SphereDistanceKernel(numSpheres, scalar_array_t(2, 0.1), groupPairs, 0.5), std::runtime_error);
+  EXPECT_THROW(SphereDistanceKernel(numSpheres, sphereRadii, {{0, numSpheres.size()}}, 0.5), std::runtime_error);
+}
@@ -31,6 +31,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 // OCS2
 #include <ocs2_core/Types.h>
+#include <ocs2_core/cost/CostWeights.h>
 #include <ocs2_core/initialization/Initializer.h>
 #include <ocs2_ddp/DDP_Settings.h>
 #include <ocs2_mpc/MPC_Settings.h>
@@ -75,12 +76,16 @@ class DoubleIntegratorInterface final : public RobotInterface {
 
   const Initializer& getInitializer() const override { return *linearSystemInitializerPtr_; }
 
+  /** The diagonal [Q; R] weights of the intermediate cost. It is a nullptr unless runtimeCostWeights is set in the task file. */
+  std::shared_ptr<CostWeights> getCostWeightsPtr() const { return costWeightsPtr_; }
+
  private:
   ddp::Settings ddpSettings_;
   mpc::Settings mpcSettings_;
 
   OptimalControlProblem problem_;
   std::shared_ptr<ReferenceManager> referenceManagerPtr_;
+  std::shared_ptr<CostWeights> costWeightsPtr_;
 
   std::unique_ptr<RolloutBase> rolloutPtr_;
   std::unique_ptr<Initializer> linearSystemInitializerPtr_;
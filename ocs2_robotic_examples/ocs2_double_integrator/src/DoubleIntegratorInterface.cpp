@@ -34,6 +34,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <ocs2_core/cost/QuadraticStateCost.h>
 #include <ocs2_core/cost/QuadraticStateInputCost.h>
+#include <ocs2_core/cost/WeightedQuadraticStateInputCost.h>
 #include <ocs2_core/dynamics/LinearSystemDynamics.h>
 #include <ocs2_core/initialization/DefaultInitializer.h>
 #include <ocs2_core/misc/LoadData.h>
@@ -88,7 +89,20 @@ DoubleIntegratorInterface::DoubleIntegratorInterface(const std::string& taskFile
   std::cerr << "R:  \n" << R << "\n";
   std::cerr << "Q_final:\n" << Qf << "\n";
 
-  problem_.costPtr->add("cost", std::unique_ptr<StateInputCost>(new QuadraticStateInputCost(Q, R)));
+  bool runtimeCostWeights = false;
+  loadData::loadCppDataType(taskFile, "runtimeCostWeights", runtimeCostWeights);
+  if (runtimeCostWeights) {
+    if (!Q.isDiagonal() || !R.isDiagonal()) {
+      throw std::runtime_error("[DoubleIntegratorInterface] runtimeCostWeights requires diagonal Q and R!");
+    }
+    vector_t weights(STATE_DIM + INPUT_DIM);
+    weights << Q.diagonal(), R.diagonal();
+    costWeightsPtr_ = std::make_shared<CostWeights>(std::move(weights));
+    problem_.costPtr->add("cost", std::unique_ptr<StateInputCost>(new WeightedQuadraticStateInputCost(
+                                      costWeightsPtr_, STATE_DIM, INPUT_DIM, "double_integrator_cost", libraryFolder, true, verbose)));
+  } else {
+    problem_.costPtr->add("cost", std::unique_ptr<StateInputCost>(new QuadraticStateInputCost(Q, R)));
+  }
   problem_.finalCostPtr->add("finalCost", std::unique_ptr<StateCost>(new QuadraticStateCost(Qf)));
 
   // Dynamics
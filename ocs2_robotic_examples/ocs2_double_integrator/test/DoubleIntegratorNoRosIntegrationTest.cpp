@@ -37,6 +37,10 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <ocs2_core/thread_support/ExecuteAndSleep.h>
 #include <ocs2_ddp/GaussNewtonDDP_MPC.h>
 #include <ocs2_mpc/MPC_MRT_Interface.h>
+#include <ocs2_oc/synchronized_module/CostWeightsSynchronizedModule.h>
+
+#include <boost/filesystem/operations.hpp>
+#include <boost/property_tree/info_parser.hpp>
 
 using namespace ocs2;
 using namespace double_integrator;
@@ -57,8 +61,9 @@ class DoubleIntegratorIntegrationTest : public testing::Test {
     doubleIntegratorInterfacePtr->getReferenceManagerPtr()->setTargetTrajectories(std::move(targetTrajectories));
   }
 
-  std::unique_ptr<GaussNewtonDDP_MPC> getMpc(bool warmStart) {
-    auto& interface = *doubleIntegratorInterfacePtr;
+  std::unique_ptr<GaussNewtonDDP_MPC> getMpc(bool warmStart) { return getMpc(*doubleIntegratorInterfacePtr, warmStart); }
+
+  std::unique_ptr<GaussNewtonDDP_MPC> getMpc(DoubleIntegratorInterface& interface, bool warmStart) {
     auto mpcSettings = interface.mpcSettings();
     auto ddpSettings = interface.ddpSettings();
     if (!warmStart) {
@@ -118,6 +123,67 @@ TEST_F(DoubleIntegratorIntegrationTest, synchronousTracking) {
   ASSERT_NEAR(observation.state(0), goalState(0), tolerance);
 }
 
+TEST_F(DoubleIntegratorIntegrationTest, latencyCompensation) {
+  auto mpcPtr = getMpc(true);
+  MPC_MRT_Interface mpcInterface(*mpcPtr);
+  mpcInterface.enableLatencyCompensation(doubleIntegratorInterfacePtr->getRollout());
+  std::unique_ptr<RolloutBase> rolloutPtr(doubleIntegratorInterfacePtr->getRollout().clone());
+
+  SystemObservation observation;
+  observation.time = initTime;
+  observation.state = initState;
+  observation.input.setZero(INPUT_DIM);
+  mpcInterface.setCurrentObservation(observation);
+
+  // the policy which the system tracks while the MPC is solved
+  std::unique_ptr<ControllerBase> previousControllerPtr;
+  ModeSchedule previousModeSchedule;
+  size_t numCompensatedIterations = 0;
+
+  // run MPC for N iterations
+  auto time = initTime;
+  while (time < finalTime) {
+    // run MPC
+    mpcInterface.advanceMpc();
+    time += 1.0 / f_mpc;
+
+    if (mpcInterface.initialPolicyReceived()) {
+      size_t mode;
+      vector_t optimalState, optimalInput;
+
+      mpcInterface.updatePolicy();
+      mpcInterface.evaluatePolicy(time, vector_t::Zero(STATE_DIM), optimalState, optimalInput, mode);
+
+      // the MPC is solved from a predicted state, therefore it should not start before the observation
+      const auto& mpcInitObservation = mpcInterface.getCommand().mpcInitObservation_;
+      ASSERT_GE(mpcInitObservation.time, observation.time);
+
+      // the predicted state is the rollout of the previous policy from the observation over the latency
+      if (previousControllerPtr != nullptr && mpcInitObservation.time > observation.time) {
+        scalar_array_t timeTrajectory;
+        size_array_t postEventIndices;
+        vector_array_t stateTrajectory, inputTrajectory;
+        const vector_t predictedState =
+            rolloutPtr->run(observation.time, observation.state, mpcInitObservation.time, previousControllerPtr.get(), previousModeSchedule,
+                            timeTrajectory, postEventIndices, stateTrajectory, inputTrajectory);
+        EXPECT_LT((mpcInitObservation.state - predictedState).norm(), 1e-9) << "at time " << mpcInitObservation.time;
+        numCompensatedIterations++;
+      }
+      previousControllerPtr.reset(mpcInterface.getPolicy().controllerPtr_->clone());
+      previousModeSchedule = mpcInterface.getPolicy().modeSchedule_;
+
+      // use optimal state for the next observation:
+      observation.time = time;
+      observation.state = optimalState;
+      observation.input.setZero(INPUT_DIM);
+      mpcInterface.setCurrentObservation(observation);
+    }
+  }
+
+  ASSERT_NEAR(observation.state(0), goalState(0), tolerance);
+  EXPECT_GT(numCompensatedIterations, 0);
+}
+
 TEST_F(DoubleIntegratorIntegrationTest, coldStartMPC) {
   auto mpcPtr = getMpc(false);
   MPC_MRT_Interface mpcInterface(*mpcPtr);
@@ -153,6 +219,53 @@ TEST_F(DoubleIntegratorIntegrationTest, coldStartMPC) {
   ASSERT_NEAR(observation.state(0), goalState(0), tolerance);
 }
 
+TEST_F(DoubleIntegratorIntegrationTest, runtimeCostWeights) {
+  // the same task with the runtime tunable cost
+  const std::string taskFile = "/tmp/ocs2/double_integrator_runtime_weights/task.info";
+  boost::filesystem::create_directories("/tmp/ocs2/double_integrator_runtime_weights");
+  boost::property_tree::ptree pt;
+  boost::property_tree::read_info(ocs2::double_integrator::getPath() + "/config/mpc/task.info", pt);
+  pt.put("runtimeCostWeights", true);
+  boost::property_tree::write_info(taskFile, pt);
+
+  DoubleIntegratorInterface weightedInterface(taskFile, "/tmp/ocs2/double_integrator_runtime_weights", false);
+  weightedInterface.getReferenceManagerPtr()->setTargetTrajectories(
+      TargetTrajectories({initTime}, {goalState}, {vector_t::Zero(INPUT_DIM)}));
+  auto costWeightsPtr = weightedInterface.getCostWeightsPtr();
+  ASSERT_TRUE(costWeightsPtr != nullptr);
+  EXPECT_TRUE(doubleIntegratorInterfacePtr->getCostWeightsPtr() == nullptr);
+
+  auto getInitialInput = [&](GaussNewtonDDP_MPC& mpc) -> vector_t {
+    MPC_MRT_Interface mpcInterface(mpc);
+    SystemObservation observation;
+    observation.time = initTime;
+    observation.state = initState;
+    observation.input.setZero(INPUT_DIM);
+    mpcInterface.setCurrentObservation(observation);
+    mpcInterface.advanceMpc();
+    mpcInterface.updatePolicy();
+    size_t mode;
+    vector_t optimalState, optimalInput;
+    mpcInterface.evaluatePolicy(initTime, initState, optimalState, optimalInput, mode);
+    return optimalInput;
+  };
+
+  // same weights as the quadratic cost
+  auto mpcPtr = getMpc(true);
+  auto weightedMpcPtr = getMpc(weightedInterface, true);
+  weightedMpcPtr->getSolverPtr()->addSynchronizedModule(
+      std::make_shared<CostWeightsSynchronizedModule>(std::vector<std::shared_ptr<CostWeights>>{costWeightsPtr}));
+  const vector_t initialInput = getInitialInput(*mpcPtr);
+  EXPECT_TRUE(getInitialInput(*weightedMpcPtr).isApprox(initialInput, 1e-6));
+
+  // a larger input weight is applied in the next MPC iteration without regenerating the cost
+  vector_t weights = costWeightsPtr->getWeights();
+  weights.tail(INPUT_DIM) *= 100.0;
+  costWeightsPtr->setWeights(weights);
+  EXPECT_LT(getInitialInput(*weightedMpcPtr).norm(), initialInput.norm());
+  EXPECT_TRUE(costWeightsPtr->getWeights().isApprox(weights));
+}
+
 #ifdef NDEBUG
 TEST_F(DoubleIntegratorIntegrationTest, asynchronousTracking) {
   auto mpcPtr = getMpc(true);
@@ -29,8 +29,10 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <ros/init.h>
 #include <ros/package.h>
+#include <std_msgs/Float64MultiArray.h>
 
 #include <ocs2_ddp/GaussNewtonDDP_MPC.h>
+#include <ocs2_oc/synchronized_module/CostWeightsSynchronizedModule.h>
 #include <ocs2_ros_interfaces/mpc/MPC_ROS_Interface.h>
 #include <ocs2_ros_interfaces/synchronized_module/RosReferenceManager.h>
 
@@ -69,6 +71,21 @@ int main(int argc, char** argv) {
                                doubleIntegratorInterface.getInitializer());
   mpc.getSolverPtr()->setReferenceManager(rosReferenceManagerPtr);
 
+  // Runtime cost weights: the diagonal [Q; R] received on the topic is applied at the start of the next MPC iteration
+  ros::Subscriber costWeightsSubscriber;
+  if (auto costWeightsPtr = doubleIntegratorInterface.getCostWeightsPtr()) {
+    mpc.getSolverPtr()->addSynchronizedModule(std::make_shared<ocs2::CostWeightsSynchronizedModule>(
+        std::vector<std::shared_ptr<ocs2::CostWeights>>{costWeightsPtr}));
+    auto costWeightsCallback = [costWeightsPtr](const std_msgs::Float64MultiArray::ConstPtr& msg) {
+      try {
+        costWeightsPtr->setWeights(Eigen::Map<const ocs2::vector_t>(msg->data.data(), msg->data.size()));
+      } catch (const std::runtime_error& error) {
+        ROS_WARN_STREAM(error.what());
+      }
+    };
+    costWeightsSubscriber = nodeHandle.subscribe<std_msgs::Float64MultiArray>(robotName + "_cost_weights", 1, costWeightsCallback);
+  }
+
   // Launch MPC ROS node
   mpc_ros_t mpcNode(mpc, robotName);
   mpcNode.launchNodes(nodeHandle);
@@ -0,0 +1,66 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+ * Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+ * Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+ * Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <ocs2_centroidal_model/CentroidalModelInfo.h>
+#include <ocs2_core/constraint/FixedInputs.h>
+
+#include "ocs2_legged_robot/reference_manager/SwitchedModelReferenceManager.h"
+
+namespace ocs2 {
+namespace legged_robot {
+
+/**
+ * Declares the contact forces of the swing legs as fixed (zero) inputs. It describes the same structure as ZeroForceConstraint, which
+ * allows the solvers that support it to eliminate these inputs instead of projecting the constraints.
+ */
+class ZeroForceFixedInputs final : public FixedInputs {
+ public:
+  /*
+   * Constructor
+   * @param [in] referenceManager : Switched model ReferenceManager.
+   * @param [in] info : The centroidal model information.
+   */
+  ZeroForceFixedInputs(const SwitchedModelReferenceManager& referenceManager, CentroidalModelInfo info);
+
+  ~ZeroForceFixedInputs() override = default;
+  ZeroForceFixedInputs* clone() const override { return new ZeroForceFixedInputs(*this); }
+
+  size_array_t getIndices(scalar_t time) const override;
+
+ private:
+  ZeroForceFixedInputs(const ZeroForceFixedInputs& other) = default;
+
+  const SwitchedModelReferenceManager* referenceManagerPtr_;
+  const CentroidalModelInfo info_;
+};
+
+}  // namespace legged_robot
+}  // namespace ocs2
@@ -54,10 +54,12 @@ class LeggedRobotStateInputQuadraticCost final : public QuadraticStateInputCost
  private:
   LeggedRobotStateInputQuadraticCost(const LeggedRobotStateInputQuadraticCost& rhs) = default;
 
+  using QuadraticStateInputCost::getStateInputDeviation;
   std::pair<vector_t, vector_t> getStateInputDeviation(scalar_t time, const vector_t& state, const vector_t& input,
-                                                       const TargetTrajectories& targetTrajectories) const override {
-    const auto contactFlags = referenceManagerPtr_->getContactFlags(time);
-    const vector_t xNominal = targetTrajectories.getDesiredState(time);
+                                                       const TargetTrajectories& targetTrajectories,
+                                                       const PreComputation& preComp) const override {
+    const auto contactFlags = referenceManagerPtr_->getContactFlags(time, preComp);
+    const vector_t& xNominal = preComp.getDesiredState(time, targetTrajectories);
     const vector_t uNominal = weightCompensatingInput(info_, contactFlags);
     return {state - xNominal, input - uNominal};
   }
@@ -80,10 +82,10 @@ class LeggedRobotStateQuadraticCost final : public QuadraticStateCost {
  private:
   LeggedRobotStateQuadraticCost(const LeggedRobotStateQuadraticCost& rhs) = default;
 
-  vector_t getStateDeviation(scalar_t time, const vector_t& state, const TargetTrajectories& targetTrajectories) const override {
-    const auto contactFlags = referenceManagerPtr_->getContactFlags(time);
-    const vector_t xNominal = targetTrajectories.getDesiredState(time);
-    return state - xNominal;
+  using QuadraticStateCost::getStateDeviation;
+  vector_t getStateDeviation(scalar_t time, const vector_t& state, const TargetTrajectories& targetTrajectories,
+                             const PreComputation& preComp) const override {
+    return state - preComp.getDesiredState(time, targetTrajectories);
   }
 
   const CentroidalModelInfo info_;
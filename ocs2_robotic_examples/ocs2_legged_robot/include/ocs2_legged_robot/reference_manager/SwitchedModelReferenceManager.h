@@ -29,6 +29,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #pragma once
 
+#include <ocs2_core/PreComputation.h>
 #include <ocs2_core/thread_support/Synchronized.h>
 #include <ocs2_oc/synchronized_module/ReferenceManager.h>
 
@@ -50,6 +51,9 @@ class SwitchedModelReferenceManager : public ReferenceManager {
 
   contact_flag_t getContactFlags(scalar_t time) const;
 
+  /** Gets the contact flags from the references sampled by the solver if available, otherwise same as above. */
+  contact_flag_t getContactFlags(scalar_t time, const PreComputation& preComp) const;
+
   const std::shared_ptr<GaitSchedule>& getGaitSchedule() { return gaitSchedulePtr_; }
 
   const std::shared_ptr<SwingTrajectoryPlanner>& getSwingTrajectoryPlanner() { return swingTrajectoryPtr_; }
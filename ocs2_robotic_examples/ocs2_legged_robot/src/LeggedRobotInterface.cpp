@@ -50,8 +50,10 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "ocs2_legged_robot/constraint/FrictionConeConstraint.h"
 #include "ocs2_legged_robot/constraint/NormalVelocityConstraintCppAd.h"
 #include "ocs2_legged_robot/constraint/ZeroForceConstraint.h"
+#include "ocs2_legged_robot/constraint/ZeroForceFixedInputs.h"
 #include "ocs2_legged_robot/constraint/ZeroVelocityConstraintCppAd.h"
 #include "ocs2_legged_robot/cost/LeggedRobotQuadraticTrackingCost.h"
+#include "ocs2_legged_robot/dynamics/LeggedRobotDynamics.h"
 #include "ocs2_legged_robot/dynamics/LeggedRobotDynamicsAD.h"
 
 // Boost
@@ -143,7 +145,7 @@ void LeggedRobotInterface::setupOptimalConrolProblem(const std::string& taskFile
   loadData::loadCppDataType(taskFile, "legged_robot_interface.useAnalyticalGradientsDynamics", useAnalyticalGradientsDynamics);
   std::unique_ptr<SystemDynamicsBase> dynamicsPtr;
   if (useAnalyticalGradientsDynamics) {
-    throw std::runtime_error("[LeggedRobotInterface::setupOptimalConrolProblem] The analytical dynamics class is not yet implemented!");
+    dynamicsPtr.reset(new LeggedRobotDynamics(*pinocchioInterfacePtr_, centroidalModelInfo_));
   } else {
     const std::string modelName = "dynamics";
     dynamicsPtr.reset(new LeggedRobotDynamicsAD(*pinocchioInterfacePtr_, centroidalModelInfo_, modelName, modelSettings_));
@@ -191,6 +193,9 @@ void LeggedRobotInterface::setupOptimalConrolProblem(const std::string& taskFile
                                             getNormalVelocityConstraint(*eeKinematicsPtr, i, useAnalyticalGradientsConstraints));
   }
 
+  // the swing leg forces can be eliminated by the solvers which support it, instead of projecting the zero-force constraints
+  problemPtr_->fixedInputsPtr.reset(new ZeroForceFixedInputs(*referenceManagerPtr_, centroidalModelInfo_));
+
   // self-collision avoidance constraint
   bool activateSelfCollision = true;
   if (activateSelfCollision) {
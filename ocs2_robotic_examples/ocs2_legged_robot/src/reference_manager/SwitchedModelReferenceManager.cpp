@@ -48,6 +48,18 @@ contact_flag_t SwitchedModelReferenceManager::getContactFlags(scalar_t time) con
   return modeNumber2StanceLeg(this->getModeSchedule().modeAtTime(time));
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+contact_flag_t SwitchedModelReferenceManager::getContactFlags(scalar_t time, const PreComputation& preComp) const {
+  const auto* referenceSamplerPtr = preComp.getReferenceSampler();
+  if (referenceSamplerPtr != nullptr) {
+    return modeNumber2StanceLeg(referenceSamplerPtr->getMode(time, preComp.getReferenceCursor()));
+  } else {
+    return getContactFlags(time);
+  }
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
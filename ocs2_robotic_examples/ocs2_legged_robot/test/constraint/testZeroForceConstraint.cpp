@@ -35,6 +35,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "ocs2_legged_robot/common/ModelSettings.h"
 #include "ocs2_legged_robot/common/Types.h"
 #include "ocs2_legged_robot/constraint/ZeroForceConstraint.h"
+#include "ocs2_legged_robot/constraint/ZeroForceFixedInputs.h"
 #include "ocs2_legged_robot/test/AnymalFactoryFunctions.h"
 
 using namespace ocs2;
@@ -97,3 +98,30 @@ TEST_F(TestZeroForceConstraint, clone) {
   EXPECT_TRUE(approx.dfdx.isApprox(cloneApprox.dfdx));
   EXPECT_TRUE(approx.dfdu.isApprox(cloneApprox.dfdu));
 }
+
+TEST_F(TestZeroForceConstraint, fixedInputs) {
+  ZeroForceFixedInputs fixedInputs(*referenceManagerPtr, centroidalModelInfo);
+  std::unique_ptr<FixedInputs> fixedInputsPtr(fixedInputs.clone());
+
+  const vector_t x = vector_t::Random(centroidalModelInfo.stateDim);
+  for (scalar_t t = 0.0; t < 2.0; t += 0.1) {
+    const auto indices = fixedInputsPtr->getIndices(t);
+    EXPECT_TRUE(fixedInputsPtr->getValues(t).isZero());
+    EXPECT_EQ(fixedInputsPtr->getValues(t).size(), indices.size());
+
+    // the fixed inputs are the ones of the active zero-force constraints
+    vector_t u = vector_t::Random(centroidalModelInfo.inputDim);
+    for (const auto i : indices) {
+      u(i) = 0.0;
+    }
+    size_t numActive = 0;
+    for (size_t i = 0; i < centroidalModelInfo.numThreeDofContacts; i++) {
+      ZeroForceConstraint zeroForceConstraint(*referenceManagerPtr, i, centroidalModelInfo);
+      if (zeroForceConstraint.isActive(t)) {
+        EXPECT_TRUE(zeroForceConstraint.getValue(t, x, u, preComputation).isZero());
+        numActive++;
+      }
+    }
+    EXPECT_EQ(indices.size(), 3 * numActive);
+  }
+}
@@ -0,0 +1,96 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <gtest/gtest.h>
+#include <iostream>
+
+#include <ocs2_core/misc/LoadData.h>
+#include <ocs2_robotic_assets/package_path.h>
+#include <ocs2_sqp/MultipleShootingSolver.h>
+
+#include "ocs2_legged_robot/LeggedRobotInterface.h"
+#include "ocs2_legged_robot/gait/ModeSequenceTemplate.h"
+#include "ocs2_legged_robot/package_path.h"
+
+using namespace ocs2;
+using namespace legged_robot;
+
+namespace {
+
+const std::string URDF_FILE = ocs2::robotic_assets::getPath() + "/resources/anymal_c/urdf/anymal.urdf";
+const std::string TASK_FILE = ocs2::legged_robot::getPath() + "/config/mpc/task.info";
+const std::string REFERENCE_FILE = ocs2::legged_robot::getPath() + "/config/command/reference.info";
+const std::string GAIT_FILE = ocs2::legged_robot::getPath() + "/config/command/gait.info";
+
+/**
+ * Solves a trot, then switches to a flying trot within the horizon and solves again from the same initial state. Returns the number of
+ * SQP iterations after the gait switch.
+ */
+size_t solveGaitSwitch(bool useTrajectorySpreading) {
+  LeggedRobotInterface interface(TASK_FILE, URDF_FILE, REFERENCE_FILE);
+  const auto& info = interface.getCentroidalModelInfo();
+  const scalar_t initTime = 0.0;
+  const scalar_t finalTime = initTime + interface.mpcSettings().timeHorizon_;
+  const vector_t initState = interface.getInitialState();
+
+  auto settings = interface.sqpSettings();
+  settings.sqpIteration = 20;
+  settings.useTrajectorySpreading = useTrajectorySpreading;
+  settings.printSolverStatistics = false;
+  settings.printSolverStatus = false;
+  settings.printLinesearch = false;
+
+  MultipleShootingSolver solver(settings, interface.getOptimalControlProblem(), interface.getInitializer());
+  const auto referenceManagerPtr = interface.getSwitchedModelReferenceManagerPtr();
+  solver.setReferenceManager(referenceManagerPtr);
+  referenceManagerPtr->setTargetTrajectories(TargetTrajectories({initTime}, {initState}, {vector_t::Zero(info.inputDim)}));
+
+  const auto& gaitSchedulePtr = referenceManagerPtr->getGaitSchedule();
+  gaitSchedulePtr->insertModeSequenceTemplate(loadModeSequenceTemplate(GAIT_FILE, "trot", false), initTime, finalTime - initTime);
+  solver.run(initTime, initState, finalTime);
+
+  // the events within the horizon move
+  gaitSchedulePtr->insertModeSequenceTemplate(loadModeSequenceTemplate(GAIT_FILE, "flying_trot", false), initTime + 0.2,
+                                              finalTime - initTime);
+  solver.run(initTime, initState, finalTime);
+  return solver.getIterationsLog().size();
+}
+
+}  // unnamed namespace
+
+/** Reports the SQP iterations after a gait switch with and without spreading the previous solution over the new mode schedule. */
+TEST(testGaitSwitchWarmStart, DISABLED_sqpIterations) {
+  const auto numIterationsWithSpreading = solveGaitSwitch(true);
+  const auto numIterationsWithoutSpreading = solveGaitSwitch(false);
+
+  std::cerr << "\n########################################################################\n";
+  std::cerr << "SQP iterations after a trot to flying-trot switch\n";
+  std::cerr << "With trajectory spreading:    " << numIterationsWithSpreading << "\n";
+  std::cerr << "Without trajectory spreading: " << numIterationsWithoutSpreading << "\n";
+}
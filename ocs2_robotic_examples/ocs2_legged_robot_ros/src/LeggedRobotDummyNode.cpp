@@ -33,6 +33,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <ocs2_centroidal_model/CentroidalModelPinocchioMapping.h>
 #include <ocs2_legged_robot/LeggedRobotInterface.h>
 #include <ocs2_pinocchio_interface/PinocchioEndEffectorKinematics.h>
+#include <ocs2_ros_interfaces/mrt/AsyncDummyObserver.h>
 #include <ocs2_ros_interfaces/mrt/MRT_ROS_Dummy_Loop.h>
 #include <ocs2_ros_interfaces/mrt/MRT_ROS_Interface.h>
 
@@ -71,7 +72,9 @@ int main(int argc, char** argv) {
   // Dummy legged robot
   MRT_ROS_Dummy_Loop leggedRobotDummySimulator(mrt, interface.mpcSettings().mrtDesiredFrequency_,
                                                interface.mpcSettings().mpcDesiredFrequency_);
-  leggedRobotDummySimulator.subscribeObservers({leggedRobotVisualizer});
+  // the visualization runs on its own thread
+  const scalar_t visualizationFrequency = 100.0;
+  leggedRobotDummySimulator.subscribeObservers({std::make_shared<AsyncDummyObserver>(leggedRobotVisualizer, visualizationFrequency)});
 
   // Initial state
   SystemObservation initObservation;
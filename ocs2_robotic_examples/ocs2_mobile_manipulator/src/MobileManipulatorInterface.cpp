@@ -27,6 +27,7 @@ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
 OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 ******************************************************************************/
 
+#include <algorithm>
 #include <string>
 
 #include <pinocchio/fwd.hpp>  // forward declarations must be included first.
@@ -48,11 +49,13 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <ocs2_pinocchio_interface/urdf.h>
 #include <ocs2_self_collision/SelfCollisionConstraint.h>
 #include <ocs2_self_collision/SelfCollisionConstraintCppAd.h>
+#include <ocs2_sphere_approximation/PinocchioSphereInterface.h>
 
 #include "ocs2_mobile_manipulator/ManipulatorModelInfo.h"
 #include "ocs2_mobile_manipulator/MobileManipulatorPreComputation.h"
 #include "ocs2_mobile_manipulator/constraint/EndEffectorConstraint.h"
 #include "ocs2_mobile_manipulator/constraint/MobileManipulatorSelfCollisionConstraint.h"
+#include "ocs2_mobile_manipulator/constraint/MobileManipulatorSphereSelfCollisionConstraint.h"
 #include "ocs2_mobile_manipulator/cost/QuadraticInputCost.h"
 #include "ocs2_mobile_manipulator/dynamics/DefaultManipulatorDynamics.h"
 #include "ocs2_mobile_manipulator/dynamics/FloatingArmManipulatorDynamics.h"
@@ -304,6 +307,10 @@ std::unique_ptr<StateCost> MobileManipulatorInterface::getSelfCollisionConstrain
   scalar_t mu = 1e-2;
   scalar_t delta = 1e-3;
   scalar_t minimumDistance = 0.0;
+  bool useSphereApproximation = false;
+  scalar_t sphereMaxExcess = 0.05;
+  scalar_t sphereShrinkRatio = 0.7;
+  scalar_t sphereActivationDistance = 0.3;
 
   boost::property_tree::ptree pt;
   boost::property_tree::read_info(taskFile, pt);
@@ -314,8 +321,38 @@ std::unique_ptr<StateCost> MobileManipulatorInterface::getSelfCollisionConstrain
   loadData::loadPtreeValue(pt, minimumDistance, prefix + ".minimumDistance", true);
   loadData::loadStdVectorOfPair(taskFile, prefix + ".collisionObjectPairs", collisionObjectPairs, true);
   loadData::loadStdVectorOfPair(taskFile, prefix + ".collisionLinkPairs", collisionLinkPairs, true);
+  loadData::loadPtreeValue(pt, useSphereApproximation, prefix + ".useSphereApproximation", true);
+  if (useSphereApproximation) {
+    loadData::loadPtreeValue(pt, sphereMaxExcess, prefix + ".sphereMaxExcess", true);
+    loadData::loadPtreeValue(pt, sphereShrinkRatio, prefix + ".sphereShrinkRatio", true);
+    loadData::loadPtreeValue(pt, sphereActivationDistance, prefix + ".sphereActivationDistance", true);
+  }
   std::cerr << " #### =============================================================================\n";
 
+  std::unique_ptr<PenaltyBase> penalty(new RelaxedBarrierPenalty({mu, delta}));
+
+  if (useSphereApproximation) {
+    if (!usePreComputation) {
+      throw std::runtime_error("[MobileManipulatorInterface] The sphere approximation of the self-collision requires usePreComputation!");
+    }
+    std::vector<std::string> collisionLinks;
+    for (const auto& linkPair : collisionLinkPairs) {
+      for (const auto& link : {linkPair.first, linkPair.second}) {
+        if (std::find(collisionLinks.begin(), collisionLinks.end(), link) == collisionLinks.end()) {
+          collisionLinks.push_back(link);
+        }
+      }
+    }
+    const std::vector<scalar_t> maxExcesses(collisionLinks.size(), sphereMaxExcess);
+    PinocchioSphereInterface sphereInterface(pinocchioInterface, std::move(collisionLinks), maxExcesses, sphereShrinkRatio);
+    SphereSelfCollision sphereSelfCollision(std::move(sphereInterface), collisionLinkPairs, minimumDistance, sphereActivationDistance);
+    std::cerr << "SelfCollision: Testing for " << sphereSelfCollision.getNumCollisionPairs() << " collision sphere pairs\n";
+
+    std::unique_ptr<StateConstraint> constraint(new MobileManipulatorSphereSelfCollisionConstraint(
+        MobileManipulatorPinocchioMapping(manipulatorModelInfo_), std::move(sphereSelfCollision)));
+    return std::unique_ptr<StateCost>(new StateSoftConstraint(std::move(constraint), std::move(penalty)));
+  }
+
   PinocchioGeometryInterface geometryInterface(pinocchioInterface, collisionLinkPairs, collisionObjectPairs);
 
   const size_t numCollisionPairs = geometryInterface.getNumCollisionPairs();
@@ -331,8 +368,6 @@ std::unique_ptr<StateCost> MobileManipulatorInterface::getSelfCollisionConstrain
         "self_collision", libraryFolder, recompileLibraries, false));
   }
 
-  std::unique_ptr<PenaltyBase> penalty(new RelaxedBarrierPenalty({mu, delta}));
-
   return std::unique_ptr<StateCost>(new StateSoftConstraint(std::move(constraint), std::move(penalty)));
 }
 
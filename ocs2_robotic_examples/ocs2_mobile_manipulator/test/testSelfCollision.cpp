@@ -35,10 +35,12 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <gtest/gtest.h>
 
+#include <ocs2_core/misc/Benchmark.h>
 #include <ocs2_core/misc/LoadData.h>
 #include <ocs2_robotic_assets/package_path.h>
 #include <ocs2_self_collision/SelfCollision.h>
 #include <ocs2_self_collision/SelfCollisionCppAd.h>
+#include <ocs2_sphere_approximation/SphereSelfCollision.h>
 
 #include "ocs2_mobile_manipulator/FactoryFunctions.h"
 #include "ocs2_mobile_manipulator/MobileManipulatorInterface.h"
@@ -156,3 +158,51 @@ TEST_F(TestSelfCollision, testRandomJointPositions) {
     ASSERT_TRUE(Jd1.isApprox(Jd2));
   }
 }
+
+TEST_F(TestSelfCollision, DISABLED_sphereApproximationVsFclBenchmark) {
+  constexpr size_t numSamples = 1000;
+  const std::vector<std::pair<std::string, std::string>> collisionLinkPairs = {
+      {"arm_base", "ARM"}, {"arm_base", "ELBOW"}, {"arm_base", "WRIST_1"}};
+
+  SelfCollision selfCollision(PinocchioGeometryInterface(pinocchioInterface, collisionLinkPairs), minDistance);
+
+  const PinocchioSphereInterface sphereInterface(pinocchioInterface, {"arm_base", "ARM", "ELBOW", "WRIST_1"}, {0.05, 0.05, 0.05, 0.05},
+                                                 0.7);
+  // without clamping to compare the minimum distances, and with the pruning of the distant primitive shapes
+  SphereSelfCollision sphereSelfCollision(sphereInterface, collisionLinkPairs, minDistance, 1e+3);
+  SphereSelfCollision prunedSphereSelfCollision(sphereInterface, collisionLinkPairs, minDistance, 0.3);
+
+  benchmark::RepeatedTimer fclTimer;
+  benchmark::RepeatedTimer sphereTimer;
+  benchmark::RepeatedTimer prunedSphereTimer;
+  for (size_t i = 0; i < numSamples; i++) {
+    const vector_t q = vector_t::Random(9);
+    computeLinearApproximation(pinocchioInterface, q);
+
+    fclTimer.startTimer();
+    const auto fcl = selfCollision.getLinearApproximation(pinocchioInterface);
+    fclTimer.endTimer();
+
+    sphereTimer.startTimer();
+    const auto spheres = sphereSelfCollision.getLinearApproximation(pinocchioInterface);
+    sphereTimer.endTimer();
+
+    prunedSphereTimer.startTimer();
+    const auto prunedSpheres = prunedSphereSelfCollision.getLinearApproximation(pinocchioInterface);
+    prunedSphereTimer.endTimer();
+
+    // the spheres enclose the collision primitives, therefore their distances are conservative
+    ASSERT_LE(spheres.first.minCoeff(), fcl.first.minCoeff() + 1e-6);
+    ASSERT_DOUBLE_EQ(prunedSpheres.first.minCoeff(), std::min(spheres.first.minCoeff(), 0.3 - minDistance));
+  }
+
+  std::cerr << "\n########################################################################\n";
+  std::cerr << "Self-collision linear approximation of " << collisionLinkPairs.size() << " link pairs over " << numSamples
+            << " random configurations\n";
+  std::cerr << "FCL:                  " << fclTimer.getAverageInMilliseconds() << " [ms] for " << selfCollision.getNumCollisionPairs()
+            << " object pairs\n";
+  std::cerr << "Spheres:              " << sphereTimer.getAverageInMilliseconds() << " [ms] for "
+            << sphereSelfCollision.getNumCollisionPairs() << " sphere pairs\n";
+  std::cerr << "Spheres with pruning: " << prunedSphereTimer.getAverageInMilliseconds() << " [ms] for "
+            << prunedSphereSelfCollision.getNumCollisionPairs() << " sphere pairs\n";
+}
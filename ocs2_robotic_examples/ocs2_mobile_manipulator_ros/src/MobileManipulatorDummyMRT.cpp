@@ -32,6 +32,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <ocs2_mobile_manipulator_ros/MobileManipulatorDummyVisualization.h>
 
 #include <ocs2_mpc/SystemObservation.h>
+#include <ocs2_ros_interfaces/mrt/AsyncDummyObserver.h>
 #include <ocs2_ros_interfaces/mrt/MRT_ROS_Dummy_Loop.h>
 #include <ocs2_ros_interfaces/mrt/MRT_ROS_Interface.h>
 
@@ -69,7 +70,9 @@ int main(int argc, char** argv) {
 
   // Dummy MRT
   MRT_ROS_Dummy_Loop dummy(mrt, interface.mpcSettings().mrtDesiredFrequency_, interface.mpcSettings().mpcDesiredFrequency_);
-  dummy.subscribeObservers({dummyVisualization});
+  // the visualization runs on its own thread
+  const scalar_t visualizationFrequency = 100.0;
+  dummy.subscribeObservers({std::make_shared<AsyncDummyObserver>(dummyVisualization, visualizationFrequency)});
 
   // initial state
   SystemObservation initObservation;
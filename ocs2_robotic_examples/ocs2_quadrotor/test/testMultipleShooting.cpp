@@ -0,0 +1,138 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <iostream>
+#include <memory>
+
+#include <ocs2_core/misc/Benchmark.h>
+#include <ocs2_ddp/ILQR.h>
+#include <ocs2_ddp/SLQ.h>
+
+#include <ocs2_quadrotor/QuadrotorInterface.h>
+#include <ocs2_quadrotor/package_path.h>
+
+using namespace ocs2;
+using namespace quadrotor;
+
+class QuadrotorMultipleShootingTest : public testing::TestWithParam<ddp::Algorithm> {
+ protected:
+  struct Result {
+    PerformanceIndex performanceIndex;
+    size_t numIterations = 0;
+    scalar_t averageTimeInMilliseconds = 0.0;
+  };
+
+  QuadrotorMultipleShootingTest()
+      : quadrotorInterface(getPath() + "/config/mpc/task.info", getPath() + "/auto_generated"),
+        initState(quadrotorInterface.getInitialState()) {
+    // hover at a displaced position. The operating input of the initializer is the hover thrust.
+    vector_t hoverInput;
+    vector_t nextState;
+    std::unique_ptr<Initializer> initializerPtr(quadrotorInterface.getInitializer().clone());
+    initializerPtr->compute(initTime, initState, finalTime, hoverInput, nextState);
+    vector_t goalState = initState;
+    goalState.head<3>() << 1.0, -1.0, 2.0;
+    targetTrajectories = TargetTrajectories({initTime}, {goalState}, {hoverInput});
+  }
+
+  ddp::Settings getSettings(size_t numShootingSegments) {
+    auto settings = quadrotorInterface.ddpSettings();
+    settings.algorithm_ = GetParam();
+    settings.nThreads_ = 4;
+    settings.maxNumIterations_ = 30;
+    settings.minRelCost_ = 1e-3;
+    settings.displayInfo_ = false;
+    settings.displayShortSummary_ = false;
+    settings.numShootingSegments_ = numShootingSegments;
+    return settings;
+  }
+
+  /** Solves the problem from scratch and reports the performance of the last repetition and the average solve time. */
+  Result solve(size_t numShootingSegments, size_t numRepetitions = 5) {
+    std::unique_ptr<GaussNewtonDDP> solverPtr;
+    const auto settings = getSettings(numShootingSegments);
+    const auto& rollout = quadrotorInterface.getRollout();
+    const auto& problem = quadrotorInterface.getOptimalControlProblem();
+    const auto& initializer = quadrotorInterface.getInitializer();
+    if (settings.algorithm_ == ddp::Algorithm::SLQ) {
+      solverPtr.reset(new SLQ(settings, rollout, problem, initializer));
+    } else {
+      solverPtr.reset(new ILQR(settings, rollout, problem, initializer));
+    }
+    solverPtr->setReferenceManager(quadrotorInterface.getReferenceManagerPtr());
+    solverPtr->getReferenceManager().setTargetTrajectories(targetTrajectories);
+
+    Result result;
+    benchmark::RepeatedTimer timer;
+    for (size_t i = 0; i < numRepetitions; i++) {
+      solverPtr->reset();
+      timer.startTimer();
+      solverPtr->run(initTime, initState, finalTime);
+      timer.endTimer();
+    }
+    result.performanceIndex = solverPtr->getPerformanceIndeces();
+    result.numIterations = solverPtr->getIterationsLog().size();
+    result.averageTimeInMilliseconds = timer.getAverageInMilliseconds();
+    return result;
+  }
+
+  const scalar_t initTime = 0.0;
+  const scalar_t finalTime = 2.0;
+
+  QuadrotorInterface quadrotorInterface;
+  const vector_t initState;
+  TargetTrajectories targetTrajectories;
+};
+
+/** Compares the convergence and the wall time of single and multiple shooting. Run it with --gtest_also_run_disabled_tests. */
+TEST_P(QuadrotorMultipleShootingTest, DISABLED_benchmark) {
+  const auto singleShooting = solve(1);
+  const auto multipleShooting = solve(8);
+
+  // the multiple-shooting solution closes its defects (up to the accuracy of the rollout integrator) and reaches the same optimum
+  EXPECT_LT(multipleShooting.performanceIndex.dynamicsViolationSSE, 1e-2);
+  EXPECT_NEAR(multipleShooting.performanceIndex.cost, singleShooting.performanceIndex.cost,
+              1e-2 * singleShooting.performanceIndex.cost);
+
+  std::cerr << "\n########################################################################\n";
+  std::cerr << "Quadrotor " << ddp::toAlgorithmName(GetParam()) << "\n";
+  std::cerr << "Single shooting:   " << singleShooting.numIterations << " iterations, " << singleShooting.averageTimeInMilliseconds
+            << " [ms], cost: " << singleShooting.performanceIndex.cost << "\n";
+  std::cerr << "Multiple shooting: " << multipleShooting.numIterations << " iterations, " << multipleShooting.averageTimeInMilliseconds
+            << " [ms], cost: " << multipleShooting.performanceIndex.cost
+            << ", defects SSE: " << multipleShooting.performanceIndex.dynamicsViolationSSE << "\n";
+}
+
+INSTANTIATE_TEST_CASE_P(QuadrotorMultipleShootingTestCase, QuadrotorMultipleShootingTest,
+                        testing::ValuesIn({ddp::Algorithm::SLQ, ddp::Algorithm::ILQR}),
+                        [](const testing::TestParamInfo<QuadrotorMultipleShootingTest::ParamType>& info) {
+                          return ddp::toAlgorithmName(info.param);
+                        });
@@ -0,0 +1,133 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include <ocs2_core/Types.h>
+
+// MPC messages
+#include <ocs2_msgs/mpc_flattened_controller.h>
+
+namespace ocs2 {
+
+/**
+ * Settings of the incremental encoding of the MPC policy messages.
+ */
+struct IncrementalPolicySettings {
+  /**
+   * Constructor.
+   *
+   * @param [in] valueTolerance: A matched node is copied from the previous policy if none of its state, input, and controller values
+   * differs by more than this value. Consecutive MPC solutions are rarely identical, therefore a zero tolerance only copies the nodes
+   * which the solver has not changed at all. The tolerance is the largest error of the reconstructed policy which the MRT can accept.
+   */
+  explicit IncrementalPolicySettings(scalar_t valueTolerance) : valueTolerance(valueTolerance) {}
+
+  /** Every keyFrameInterval-th message is a self-contained key-frame. */
+  size_t keyFrameInterval = 10;
+  /** The nodes of two consecutive policies are matched if their time stamps differ by at most this value. */
+  scalar_t timeTolerance = 1e-9;
+  /** A matched node is copied from the previous policy if none of its values differs by more than this value. */
+  scalar_t valueTolerance;
+};
+
+/**
+ * Encodes the MPC policy messages incrementally. Consecutive MPC policies overlap for most of the horizon. Therefore only the nodes
+ * which differ from the previous policy (typically the new tail) and the changed references are transmitted. The encoder mirrors
+ * the policy as it is reconstructed by the receiver, such that an approximation error (for a non-zero value tolerance) does not
+ * accumulate.
+ *
+ * An incremental message which has no base policy on the receiver side is dropped by IncrementalPolicyDecoder. The receiver then
+ * requests a key-frame, upon which reset() should be called. The periodic key-frames bound the number of dropped messages if such a
+ * request is lost as well.
+ */
+class IncrementalPolicyEncoder {
+ public:
+  /**
+   * Constructor.
+   *
+   * @param [in] settings: The incremental encoding settings.
+   */
+  explicit IncrementalPolicyEncoder(IncrementalPolicySettings settings);
+
+  /** Resets the encoder such that the next message is a key-frame. */
+  void reset();
+
+  /**
+   * Encodes a complete policy message, as created by MPC_ROS_Interface, into an incremental one.
+   *
+   * @param [in, out] msg: The complete policy message which is replaced by the incremental one.
+   */
+  void encode(ocs2_msgs::mpc_flattened_controller& msg);
+
+ private:
+  /** Whether the node k of the message can be copied from the node j of the base policy. */
+  bool isNodeCopyable(const ocs2_msgs::mpc_flattened_controller& msg, size_t k, size_t j) const;
+
+  IncrementalPolicySettings settings_;
+  ocs2_msgs::mpc_flattened_controller base_;  // the previous policy as it is reconstructed by the receiver
+  std::vector<int> baseIndices_;              // the index of the copied base node for each node or -1
+  std::vector<uint32_t> copiedSegments_;
+  bool hasBase_ = false;
+  uint32_t sequence_ = 0;
+  size_t numSinceKeyFrame_ = 0;
+};
+
+/**
+ * Reconstructs the complete MPC policy messages from the incremental ones which are created by IncrementalPolicyEncoder. The complete
+ * messages are reconstructed into preallocated storage. A complete (non-incremental) message is passed through.
+ */
+class IncrementalPolicyDecoder {
+ public:
+  /** Drops the stored base policy. The incremental messages are ignored until the next key-frame. */
+  void reset();
+
+  /**
+   * Reconstructs the complete policy message.
+   *
+   * @param [in] msg: The received policy message.
+   * @return A pointer to the complete policy message which is valid until the next call, or nullptr if the base policy of the
+   * incremental message is not available.
+   * @throws std::runtime_error if the message is malformed. The stored base policy is kept in that case.
+   */
+  const ocs2_msgs::mpc_flattened_controller* decode(const ocs2_msgs::mpc_flattened_controller& msg);
+
+ private:
+  /** Throws if the message can not be reconstructed from the stored base policy. */
+  void validate(const ocs2_msgs::mpc_flattened_controller& msg) const;
+
+  ocs2_msgs::mpc_flattened_controller base_;
+  ocs2_msgs::mpc_flattened_controller next_;
+  bool hasBase_ = false;
+};
+
+}  // namespace ocs2
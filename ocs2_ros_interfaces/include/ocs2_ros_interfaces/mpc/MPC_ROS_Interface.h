@@ -41,6 +41,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <ros/callback_queue.h>
 #include <ros/ros.h>
 #include <ros/transport_hints.h>
+#include <std_msgs/Empty.h>
 
 #include <ocs2_msgs/mode_schedule.h>
 #include <ocs2_msgs/mpc_flattened_controller.h>
@@ -56,6 +57,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <ocs2_mpc/SystemObservation.h>
 #include <ocs2_oc/oc_data/PrimalSolution.h>
 
+#include "ocs2_ros_interfaces/common/IncrementalPolicyMsg.h"
+
 #define PUBLISH_THREAD
 
 namespace ocs2 {
@@ -102,6 +105,14 @@ class MPC_ROS_Interface {
    */
   void launchNodes(ros::NodeHandle& nodeHandle);
 
+  /**
+   * Enables the incremental encoding of the published policy messages. Only the nodes which differ from the previously published
+   * policy are transmitted. The messages are reconstructed by MRT_ROS_Interface.
+   *
+   * @param [in] settings: The incremental encoding settings.
+   */
+  void enableIncrementalPolicyMsgs(IncrementalPolicySettings settings);
+
  protected:
   /**
    * Callback to reset MPC.
@@ -127,6 +138,13 @@ class MPC_ROS_Interface {
    */
   void publisherWorker();
 
+  /**
+   * Publishes the MPC policy message. The message is incrementally encoded if it is enabled.
+   *
+   * @param [in] mpcPolicyMsg: The complete MPC policy message. It is modified by the incremental encoding.
+   */
+  void publishPolicyMsg(ocs2_msgs::mpc_flattened_controller& mpcPolicyMsg);
+
   /**
    * Updates the buffer variables from the MPC object. This method is automatically called by advanceMpc()
    *
@@ -142,6 +160,9 @@ class MPC_ROS_Interface {
    */
   void mpcObservationCallback(const ocs2_msgs::mpc_observation::ConstPtr& msg);
 
+  /** Handles a key-frame request of the MRT, which could not reconstruct a policy message. The next policy message is a key-frame. */
+  void requestPolicyKeyFrame();
+
  protected:
   /*
    * Variables
@@ -156,6 +177,7 @@ class MPC_ROS_Interface {
   ::ros::Subscriber mpcObservationSubscriber_;
   ::ros::Subscriber mpcTargetTrajectoriesSubscriber_;
   ::ros::Publisher mpcPolicyPublisher_;
+  ::ros::Subscriber policyKeyFrameRequestSubscriber_;
   ::ros::ServiceServer mpcResetServiceServer_;
 
   std::unique_ptr<CommandData> bufferCommandPtr_;
@@ -174,6 +196,8 @@ class MPC_ROS_Interface {
   std::mutex publisherMutex_;
   std::condition_variable msgReady_;
 
+  std::unique_ptr<IncrementalPolicyEncoder> policyEncoderPtr_;  // guarded by publisherMutex_
+
   benchmark::RepeatedTimer mpcTimer_;
 
   // MPC reset
@@ -0,0 +1,96 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include <ocs2_core/thread_support/LockFreeRingBuffer.h>
+
+#include "ocs2_ros_interfaces/mrt/DummyObserver.h"
+
+namespace ocs2 {
+
+/**
+ * Decorates a DummyObserver such that its update method is executed on a separate thread. The update method of this class,
+ * which is called in the dummy loop, decimates the calls to the given maximum frequency (measured in the observation time),
+ * copies a snapshot of the inputs into a preallocated slot of a lock-free queue, and returns. If the visualization thread
+ * falls behind and the queue is full, the snapshot is dropped. Therefore the timing of the dummy loop is not affected by the
+ * cost of the wrapped observer.
+ *
+ * The snapshot of the primal solution contains the time, state, and input trajectories, the post-event indices, and the mode
+ * schedule, but not the controller.
+ */
+class AsyncDummyObserver final : public DummyObserver {
+ public:
+  /**
+   * Constructor.
+   *
+   * @param [in] observerPtr: The wrapped observer which is updated on the visualization thread.
+   * @param [in] maxUpdateFrequency: The maximum update frequency in Hz measured in the observation time. A non-positive
+   * value disables the decimation.
+   * @param [in] queueCapacity: The number of preallocated snapshots.
+   */
+  AsyncDummyObserver(std::shared_ptr<DummyObserver> observerPtr, scalar_t maxUpdateFrequency, size_t queueCapacity = 2);
+
+  /** Destructor. Stops the visualization thread after the queued snapshots are processed. */
+  ~AsyncDummyObserver() override;
+
+  void update(const SystemObservation& observation, const PrimalSolution& primalSolution, const CommandData& command) override;
+
+  /** The number of snapshots which are dropped since the queue was full. */
+  size_t getNumDroppedSnapshots() const { return numDroppedSnapshots_; }
+
+ private:
+  struct Snapshot {
+    SystemObservation observation;
+    PrimalSolution primalSolution;
+    CommandData command;
+  };
+
+  void visualizationWorker();
+
+  std::shared_ptr<DummyObserver> observerPtr_;
+  const scalar_t minUpdateTimeDifference_;
+  scalar_t lastUpdateTime_;
+
+  LockFreeRingBuffer<Snapshot> snapshotQueue_;
+  std::atomic<size_t> numDroppedSnapshots_{0};
+
+  std::atomic_bool terminate_{false};
+  std::mutex workerMutex_;
+  std::condition_variable workerCondition_;
+  std::thread workerThread_;
+};
+
+}  // namespace ocs2
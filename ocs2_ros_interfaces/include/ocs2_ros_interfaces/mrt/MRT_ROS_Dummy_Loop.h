@@ -29,6 +29,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #pragma once
 
+#include <ocs2_core/misc/Benchmark.h>
+
 #include "ocs2_ros_interfaces/mrt/DummyObserver.h"
 #include "ocs2_ros_interfaces/mrt/MRT_ROS_Interface.h"
 
@@ -65,7 +67,8 @@ class MRT_ROS_Dummy_Loop {
 
   /**
    * Subscribe a set of observers to the dummy loop. Observers are updated in the provided order at the end of each timestep.
-   * The previous list of observers is overwritten.
+   * The previous list of observers is overwritten. Expensive observers (e.g. visualizers) can be wrapped in an AsyncDummyObserver
+   * such that they do not affect the timing of the loop. The time spent on updating the observers is reported when the loop ends.
    *
    * @param observers : vector of observers.
    */
@@ -94,11 +97,16 @@ class MRT_ROS_Dummy_Loop {
   /** Forward simulates the system from current observation*/
   SystemObservation forwardSimulation(const SystemObservation& currentObservation);
 
+  /** Updates the observers and measures the time spent on it */
+  void updateObservers(const SystemObservation& currentObservation);
+
   MRT_ROS_Interface& mrt_;
   std::vector<std::shared_ptr<DummyObserver>> observers_;
 
   scalar_t mrtDesiredFrequency_;
   scalar_t mpcDesiredFrequency_;
+
+  benchmark::RepeatedTimer observersTimer_;
 };
 
 }  // namespace ocs2
@@ -40,6 +40,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <ros/callback_queue.h>
 #include <ros/ros.h>
 #include <ros/transport_hints.h>
+#include <std_msgs/Empty.h>
 
 // MPC messages
 #include <ocs2_msgs/mpc_flattened_controller.h>
@@ -47,6 +48,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <ocs2_mpc/MRT_BASE.h>
 
+#include "ocs2_ros_interfaces/common/IncrementalPolicyMsg.h"
 #include "ocs2_ros_interfaces/common/RosMsgConversions.h"
 
 #define PUBLISH_THREAD
@@ -101,7 +103,7 @@ class MRT_ROS_Interface : public MRT_BASE {
  private:
   /**
    * Callback method to receive the MPC policy as well as the mode sequence.
-   * It only updates the policy variables with suffix (*Buffer_) variables.
+   * It only updates the policy variables with suffix (*Buffer_) variables. An incrementally encoded policy is reconstructed first.
    *
    * @param [in] msg: A constant pointer to the message
    */
@@ -129,8 +131,13 @@ class MRT_ROS_Interface : public MRT_BASE {
   // Publishers and subscribers
   ::ros::Publisher mpcObservationPublisher_;
   ::ros::Subscriber mpcPolicySubscriber_;
+  ::ros::Publisher policyKeyFrameRequestPublisher_;
   ::ros::ServiceClient mpcResetServiceClient_;
 
+  // Reconstructs the incrementally encoded policy messages
+  IncrementalPolicyDecoder policyDecoder_;
+  bool policyKeyFrameRequested_ = false;  // whether a key-frame has been requested since the last reconstructed policy
+
   // ROS messages
   ocs2_msgs::mpc_observation mpcObservationMsg_;
   ocs2_msgs::mpc_observation mpcObservationMsgBuffer_;
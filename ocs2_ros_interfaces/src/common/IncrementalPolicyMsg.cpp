@@ -0,0 +1,309 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include "ocs2_ros_interfaces/common/IncrementalPolicyMsg.h"
+
+#include <cmath>
+#include <stdexcept>
+#include <utility>
+
+namespace ocs2 {
+
+namespace {
+
+bool isAlmostEqual(const std::vector<float>& lhs, const std::vector<float>& rhs, scalar_t tolerance) {
+  if (lhs.size() != rhs.size()) {
+    return false;
+  }
+  for (size_t i = 0; i < lhs.size(); i++) {
+    if (std::abs(static_cast<scalar_t>(lhs[i]) - static_cast<scalar_t>(rhs[i])) > tolerance) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool isEqual(const ocs2_msgs::mode_schedule& lhs, const ocs2_msgs::mode_schedule& rhs) {
+  return lhs.eventTimes == rhs.eventTimes && lhs.modeSequence == rhs.modeSequence;
+}
+
+bool isEqual(const ocs2_msgs::mpc_target_trajectories& lhs, const ocs2_msgs::mpc_target_trajectories& rhs) {
+  if (lhs.timeTrajectory != rhs.timeTrajectory || lhs.stateTrajectory.size() != rhs.stateTrajectory.size() ||
+      lhs.inputTrajectory.size() != rhs.inputTrajectory.size()) {
+    return false;
+  }
+  for (size_t i = 0; i < lhs.stateTrajectory.size(); i++) {
+    if (lhs.stateTrajectory[i].value != rhs.stateTrajectory[i].value) {
+      return false;
+    }
+  }
+  for (size_t i = 0; i < lhs.inputTrajectory.size(); i++) {
+    if (lhs.inputTrajectory[i].value != rhs.inputTrajectory[i].value) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/** Copies the fields which are always transmitted. */
+void copyHeader(const ocs2_msgs::mpc_flattened_controller& src, ocs2_msgs::mpc_flattened_controller& dst) {
+  dst.controllerType = src.controllerType;
+  dst.initObservation = src.initObservation;
+  dst.timeTrajectory = src.timeTrajectory;
+  dst.postEventIndices = src.postEventIndices;
+  dst.performanceIndices = src.performanceIndices;
+  dst.sequence = src.sequence;
+}
+
+}  // unnamed namespace
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+IncrementalPolicyEncoder::IncrementalPolicyEncoder(IncrementalPolicySettings settings) : settings_(std::move(settings)) {}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void IncrementalPolicyEncoder::reset() {
+  hasBase_ = false;
+  numSinceKeyFrame_ = 0;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+bool IncrementalPolicyEncoder::isNodeCopyable(const ocs2_msgs::mpc_flattened_controller& msg, size_t k, size_t j) const {
+  const auto tol = settings_.valueTolerance;
+  return isAlmostEqual(msg.stateTrajectory[k].value, base_.stateTrajectory[j].value, tol) &&
+         isAlmostEqual(msg.inputTrajectory[k].value, base_.inputTrajectory[j].value, tol) &&
+         isAlmostEqual(msg.data[k].data, base_.data[j].data, tol);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void IncrementalPolicyEncoder::encode(ocs2_msgs::mpc_flattened_controller& msg) {
+  msg.sequence = ++sequence_;
+  msg.baseSequence = 0;
+  msg.copiedSegments.clear();
+  msg.modeScheduleFromBase = false;
+  msg.targetTrajectoriesFromBase = false;
+
+  const bool isKeyFrame = !hasBase_ || numSinceKeyFrame_ + 1 >= settings_.keyFrameInterval || msg.controllerType != base_.controllerType;
+  if (isKeyFrame) {
+    base_ = msg;
+    hasBase_ = true;
+    numSinceKeyFrame_ = 0;
+    return;
+  }
+  numSinceKeyFrame_++;
+
+  // match the nodes to the base nodes by their time stamps. Both time trajectories are sorted.
+  const size_t N = msg.timeTrajectory.size();
+  const size_t baseN = base_.timeTrajectory.size();
+  baseIndices_.assign(N, -1);
+  for (size_t k = 0, j = 0; k < N && j < baseN; k++) {
+    const scalar_t t = msg.timeTrajectory[k];
+    while (j < baseN && base_.timeTrajectory[j] < t - settings_.timeTolerance) {
+      j++;
+    }
+    if (j < baseN && base_.timeTrajectory[j] <= t + settings_.timeTolerance) {
+      if (isNodeCopyable(msg, k, j)) {
+        baseIndices_[k] = static_cast<int>(j);
+      }
+      j++;
+    }
+  }
+
+  // group the copied nodes into segments
+  copiedSegments_.clear();
+  for (size_t k = 0; k < N; k++) {
+    if (baseIndices_[k] < 0) {
+      continue;
+    }
+    const bool extendsSegment = k > 0 && baseIndices_[k - 1] >= 0 && baseIndices_[k] == baseIndices_[k - 1] + 1;
+    if (extendsSegment) {
+      copiedSegments_.back()++;
+    } else {
+      copiedSegments_.push_back(static_cast<uint32_t>(k));
+      copiedSegments_.push_back(static_cast<uint32_t>(baseIndices_[k]));
+      copiedSegments_.push_back(1);
+    }
+  }
+
+  // the receiver reconstructs the copied nodes from the base. Each base node is copied at most once, so it can be swapped.
+  for (size_t k = 0; k < N; k++) {
+    if (baseIndices_[k] >= 0) {
+      const size_t j = baseIndices_[k];
+      msg.stateTrajectory[k].value.swap(base_.stateTrajectory[j].value);
+      msg.inputTrajectory[k].value.swap(base_.inputTrajectory[j].value);
+      msg.data[k].data.swap(base_.data[j].data);
+    }
+  }
+  const bool modeScheduleFromBase = isEqual(msg.modeSchedule, base_.modeSchedule);
+  const bool targetTrajectoriesFromBase = isEqual(msg.planTargetTrajectories, base_.planTargetTrajectories);
+  const uint32_t baseSequence = base_.sequence;
+
+  // msg is now the reconstructed policy which becomes the next base. The storage of the old base is reused for the output.
+  std::swap(base_, msg);
+
+  copyHeader(base_, msg);
+  msg.baseSequence = baseSequence;
+  msg.copiedSegments = copiedSegments_;
+  msg.modeScheduleFromBase = modeScheduleFromBase;
+  msg.targetTrajectoriesFromBase = targetTrajectoriesFromBase;
+  if (modeScheduleFromBase) {
+    msg.modeSchedule = ocs2_msgs::mode_schedule();
+  } else {
+    msg.modeSchedule = base_.modeSchedule;
+  }
+  if (targetTrajectoriesFromBase) {
+    msg.planTargetTrajectories = ocs2_msgs::mpc_target_trajectories();
+  } else {
+    msg.planTargetTrajectories = base_.planTargetTrajectories;
+  }
+
+  // transmitted nodes
+  size_t numTransmitted = 0;
+  for (size_t k = 0; k < N; k++) {
+    numTransmitted += (baseIndices_[k] < 0) ? 1 : 0;
+  }
+  msg.stateTrajectory.resize(numTransmitted);
+  msg.inputTrajectory.resize(numTransmitted);
+  msg.data.resize(numTransmitted);
+  for (size_t k = 0, i = 0; k < N; k++) {
+    if (baseIndices_[k] < 0) {
+      msg.stateTrajectory[i].value = base_.stateTrajectory[k].value;
+      msg.inputTrajectory[i].value = base_.inputTrajectory[k].value;
+      msg.data[i].data = base_.data[k].data;
+      i++;
+    }
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void IncrementalPolicyDecoder::reset() {
+  hasBase_ = false;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void IncrementalPolicyDecoder::validate(const ocs2_msgs::mpc_flattened_controller& msg) const {
+  if (msg.copiedSegments.size() % 3 != 0) {
+    throw std::runtime_error("[IncrementalPolicyDecoder::decode] copiedSegments must consist of triples!");
+  }
+
+  const size_t N = msg.timeTrajectory.size();
+  const size_t numTransmitted = msg.stateTrajectory.size();
+  if (msg.inputTrajectory.size() != numTransmitted || msg.data.size() != numTransmitted) {
+    throw std::runtime_error("[IncrementalPolicyDecoder::decode] state, input, and data must have the same length!");
+  }
+
+  size_t numCopied = 0;
+  size_t end = 0;
+  size_t baseEnd = 0;
+  for (size_t s = 0; s < msg.copiedSegments.size(); s += 3) {
+    const size_t first = msg.copiedSegments[s];
+    const size_t baseFirst = msg.copiedSegments[s + 1];
+    const size_t length = msg.copiedSegments[s + 2];
+    if (first < end || first + length > N || baseFirst < baseEnd || baseFirst + length > base_.timeTrajectory.size()) {
+      throw std::runtime_error("[IncrementalPolicyDecoder::decode] Invalid copied segment!");
+    }
+    numCopied += length;
+    end = first + length;
+    baseEnd = baseFirst + length;
+  }
+  if (numCopied + numTransmitted != N) {
+    throw std::runtime_error("[IncrementalPolicyDecoder::decode] The number of transmitted nodes does not match the time trajectory!");
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+const ocs2_msgs::mpc_flattened_controller* IncrementalPolicyDecoder::decode(const ocs2_msgs::mpc_flattened_controller& msg) {
+  const bool isKeyFrame = msg.copiedSegments.empty() && !msg.modeScheduleFromBase && !msg.targetTrajectoriesFromBase;
+  if (!isKeyFrame && (!hasBase_ || msg.baseSequence != base_.sequence)) {
+    return nullptr;
+  }
+  validate(msg);
+
+  // the base nodes are moved into the new policy, therefore the base is invalid until the decoding is complete
+  hasBase_ = false;
+
+  copyHeader(msg, next_);
+  if (msg.modeScheduleFromBase) {
+    std::swap(next_.modeSchedule, base_.modeSchedule);
+  } else {
+    next_.modeSchedule = msg.modeSchedule;
+  }
+  if (msg.targetTrajectoriesFromBase) {
+    std::swap(next_.planTargetTrajectories, base_.planTargetTrajectories);
+  } else {
+    next_.planTargetTrajectories = msg.planTargetTrajectories;
+  }
+
+  const size_t N = msg.timeTrajectory.size();
+  next_.stateTrajectory.resize(N);
+  next_.inputTrajectory.resize(N);
+  next_.data.resize(N);
+
+  size_t k = 0;
+  size_t i = 0;
+  auto copyTransmittedNodes = [&](size_t end) {
+    for (; k < end; k++, i++) {
+      next_.stateTrajectory[k].value = msg.stateTrajectory[i].value;
+      next_.inputTrajectory[k].value = msg.inputTrajectory[i].value;
+      next_.data[k].data = msg.data[i].data;
+    }
+  };
+
+  for (size_t s = 0; s < msg.copiedSegments.size(); s += 3) {
+    const size_t first = msg.copiedSegments[s];
+    const size_t baseFirst = msg.copiedSegments[s + 1];
+    const size_t length = msg.copiedSegments[s + 2];
+    copyTransmittedNodes(first);
+    for (size_t n = 0; n < length; n++, k++) {
+      next_.stateTrajectory[k].value.swap(base_.stateTrajectory[baseFirst + n].value);
+      next_.inputTrajectory[k].value.swap(base_.inputTrajectory[baseFirst + n].value);
+      next_.data[k].data.swap(base_.data[baseFirst + n].data);
+    }
+  }
+  copyTransmittedNodes(N);
+
+  std::swap(base_, next_);
+  hasBase_ = true;
+  return &base_;
+}
+
+}  // namespace ocs2
@@ -69,6 +69,20 @@ void MPC_ROS_Interface::resetMpcNode(TargetTrajectories&& initTargetTrajectories
   resetRequestedEver_ = true;
   terminateThread_ = false;
   readyToPublish_ = false;
+
+  // the next policy message is a key-frame
+  std::lock_guard<std::mutex> publisherLock(publisherMutex_);
+  if (policyEncoderPtr_ != nullptr) {
+    policyEncoderPtr_->reset();
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void MPC_ROS_Interface::enableIncrementalPolicyMsgs(IncrementalPolicySettings settings) {
+  std::lock_guard<std::mutex> publisherLock(publisherMutex_);
+  policyEncoderPtr_.reset(new IncrementalPolicyEncoder(std::move(settings)));
 }
 
 /******************************************************************************************************/
@@ -177,6 +191,16 @@ ocs2_msgs::mpc_flattened_controller MPC_ROS_Interface::createMpcPolicyMsg(const
   return mpcPolicyMsg;
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void MPC_ROS_Interface::publishPolicyMsg(ocs2_msgs::mpc_flattened_controller& mpcPolicyMsg) {
+  if (policyEncoderPtr_ != nullptr) {
+    policyEncoderPtr_->encode(mpcPolicyMsg);
+  }
+  mpcPolicyPublisher_.publish(mpcPolicyMsg);
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -201,7 +225,7 @@ void MPC_ROS_Interface::publisherWorker() {
         createMpcPolicyMsg(*publisherPrimalSolutionPtr_, *publisherCommandPtr_, *publisherPerformanceIndicesPtr_);
 
     // publish the message
-    mpcPolicyPublisher_.publish(mpcPolicyMsg);
+    publishPolicyMsg(mpcPolicyMsg);
 
     readyToPublish_ = false;
     lk.unlock();
@@ -249,7 +273,7 @@ void MPC_ROS_Interface::mpcObservationCallback(const ocs2_msgs::mpc_observation:
   mpcTimer_.startTimer();
 
   // run MPC
-  bool controllerIsUpdated = mpc_.run(currentObservation.time, currentObservation.state);
+  bool controllerIsUpdated = mpc_.run(currentObservation);
   if (!controllerIsUpdated) {
     return;
   }
@@ -285,7 +309,8 @@ void MPC_ROS_Interface::mpcObservationCallback(const ocs2_msgs::mpc_observation:
 #else
   ocs2_msgs::mpc_flattened_controller mpcPolicyMsg =
       createMpcPolicyMsg(*bufferPrimalSolutionPtr_, *bufferCommandPtr_, *bufferPerformanceIndicesPtr_);
-  mpcPolicyPublisher_.publish(mpcPolicyMsg);
+  std::lock_guard<std::mutex> publisherLock(publisherMutex_);
+  publishPolicyMsg(mpcPolicyMsg);
 #endif
 }
 
@@ -324,6 +349,16 @@ void MPC_ROS_Interface::spin() {
   }
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void MPC_ROS_Interface::requestPolicyKeyFrame() {
+  std::lock_guard<std::mutex> publisherLock(publisherMutex_);
+  if (policyEncoderPtr_ != nullptr) {
+    policyEncoderPtr_->reset();
+  }
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -337,6 +372,10 @@ void MPC_ROS_Interface::launchNodes(ros::NodeHandle& nodeHandle) {
   // MPC publisher
   mpcPolicyPublisher_ = nodeHandle.advertise<ocs2_msgs::mpc_flattened_controller>(topicPrefix_ + "_mpc_policy", 1, true);
 
+  // key-frame requests of the incremental policy messages
+  policyKeyFrameRequestSubscriber_ = nodeHandle.subscribe<std_msgs::Empty>(
+      topicPrefix_ + "_mpc_policy_keyframe_request", 1, [this](const std_msgs::Empty::ConstPtr&) { requestPolicyKeyFrame(); });
+
   // MPC reset service server
   mpcResetServiceServer_ = nodeHandle.advertiseService(topicPrefix_ + "_mpc_reset", &MPC_ROS_Interface::resetMpcCallback, this);
 
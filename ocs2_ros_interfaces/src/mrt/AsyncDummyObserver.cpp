@@ -0,0 +1,115 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include "ocs2_ros_interfaces/mrt/AsyncDummyObserver.h"
+
+#include <chrono>
+#include <limits>
+
+namespace ocs2 {
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+AsyncDummyObserver::AsyncDummyObserver(std::shared_ptr<DummyObserver> observerPtr, scalar_t maxUpdateFrequency, size_t queueCapacity)
+    : observerPtr_(std::move(observerPtr)),
+      minUpdateTimeDifference_(maxUpdateFrequency > 0.0 ? 1.0 / maxUpdateFrequency : 0.0),
+      lastUpdateTime_(std::numeric_limits<scalar_t>::lowest()),
+      snapshotQueue_(queueCapacity) {
+  if (observerPtr_ == nullptr) {
+    throw std::runtime_error("[AsyncDummyObserver] observerPtr cannot be a nullptr!");
+  }
+  workerThread_ = std::thread([this]() { visualizationWorker(); });
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+AsyncDummyObserver::~AsyncDummyObserver() {
+  {
+    std::lock_guard<std::mutex> lock(workerMutex_);
+    terminate_ = true;
+  }
+  workerCondition_.notify_one();
+  workerThread_.join();
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void AsyncDummyObserver::update(const SystemObservation& observation, const PrimalSolution& primalSolution, const CommandData& command) {
+  // decimate, unless the time has jumped back (e.g. after a reset)
+  const scalar_t timeSinceLastUpdate = observation.time - lastUpdateTime_;
+  if (timeSinceLastUpdate >= 0.0 && timeSinceLastUpdate < minUpdateTimeDifference_) {
+    return;
+  }
+
+  Snapshot* snapshotPtr = snapshotQueue_.beginWrite();
+  if (snapshotPtr == nullptr) {
+    numDroppedSnapshots_++;
+    return;
+  }
+
+  // copy assignments reuse the memory of the slot
+  snapshotPtr->observation = observation;
+  snapshotPtr->primalSolution.timeTrajectory_ = primalSolution.timeTrajectory_;
+  snapshotPtr->primalSolution.stateTrajectory_ = primalSolution.stateTrajectory_;
+  snapshotPtr->primalSolution.inputTrajectory_ = primalSolution.inputTrajectory_;
+  snapshotPtr->primalSolution.postEventIndices_ = primalSolution.postEventIndices_;
+  snapshotPtr->primalSolution.modeSchedule_ = primalSolution.modeSchedule_;
+  snapshotPtr->command = command;
+  snapshotQueue_.commitWrite();
+  lastUpdateTime_ = observation.time;
+
+  // the worker also wakes up periodically, hence a missed notification only delays the update
+  workerCondition_.notify_one();
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void AsyncDummyObserver::visualizationWorker() {
+  constexpr std::chrono::milliseconds pollingPeriod(10);
+
+  while (true) {
+    Snapshot* snapshotPtr = snapshotQueue_.beginRead();
+    if (snapshotPtr != nullptr) {
+      observerPtr_->update(snapshotPtr->observation, snapshotPtr->primalSolution, snapshotPtr->command);
+      snapshotQueue_.commitRead();
+    } else if (terminate_ && snapshotQueue_.empty()) {
+      // a snapshot could have been committed between beginRead() and reading terminate_, hence the queue is checked again
+      break;
+    } else {
+      std::unique_lock<std::mutex> lock(workerMutex_);
+      workerCondition_.wait_for(lock, pollingPeriod, [this]() { return terminate_ || !snapshotQueue_.empty(); });
+    }
+  }
+}
+
+}  // namespace ocs2
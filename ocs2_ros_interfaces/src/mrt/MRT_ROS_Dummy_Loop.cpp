@@ -63,11 +63,17 @@ void MRT_ROS_Dummy_Loop::run(const SystemObservation& initObservation, const Tar
   ROS_INFO_STREAM("Initial policy has been received.");
 
   // Pick simulation loop mode
+  observersTimer_.reset();
   if (mpcDesiredFrequency_ > 0.0) {
     synchronizedDummyLoop(initObservation, initTargetTrajectories);
   } else {
     realtimeDummyLoop(initObservation, initTargetTrajectories);
   }
+
+  if (observersTimer_.getNumTimedIntervals() > 0) {
+    ROS_INFO_STREAM("Observers update time in the loop [ms]: average " << observersTimer_.getAverageInMilliseconds() << ", max "
+                                                                       << observersTimer_.getMaxIntervalInMilliseconds());
+  }
 }
 
 /******************************************************************************************************/
@@ -117,9 +123,7 @@ void MRT_ROS_Dummy_Loop::synchronizedDummyLoop(const SystemObservation& initObse
     }
 
     // Update observers
-    for (auto& observer : observers_) {
-      observer->update(currentObservation, mrt_.getPolicy(), mrt_.getCommand());
-    }
+    updateObservers(currentObservation);
 
     ++loopCounter;
     ros::spinOnce();
@@ -156,15 +160,24 @@ void MRT_ROS_Dummy_Loop::realtimeDummyLoop(const SystemObservation& initObservat
     mrt_.setCurrentObservation(currentObservation);
 
     // Update observers
-    for (auto& observer : observers_) {
-      observer->update(currentObservation, mrt_.getPolicy(), mrt_.getCommand());
-    }
+    updateObservers(currentObservation);
 
     ros::spinOnce();
     simRate.sleep();
   }
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void MRT_ROS_Dummy_Loop::updateObservers(const SystemObservation& currentObservation) {
+  observersTimer_.startTimer();
+  for (auto& observer : observers_) {
+    observer->update(currentObservation, mrt_.getPolicy(), mrt_.getCommand());
+  }
+  observersTimer_.endTimer();
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -189,11 +189,33 @@ void MRT_ROS_Interface::readPolicyMsg(const ocs2_msgs::mpc_flattened_controller&
 /******************************************************************************************************/
 /******************************************************************************************************/
 void MRT_ROS_Interface::mpcPolicyCallback(const ocs2_msgs::mpc_flattened_controller::ConstPtr& msg) {
+  // reconstruct the complete policy message
+  const ocs2_msgs::mpc_flattened_controller* policyMsgPtr = nullptr;
+  try {
+    policyMsgPtr = policyDecoder_.decode(*msg);
+    if (policyMsgPtr == nullptr) {
+      ROS_WARN_STREAM("[MRT_ROS_Interface] Dropped the incremental policy message " << msg->sequence << " since its base policy "
+                                                                                     << msg->baseSequence << " is not available.");
+    }
+  } catch (const std::exception& e) {
+    ROS_WARN_STREAM("[MRT_ROS_Interface] Dropped the policy message " << msg->sequence << ": " << e.what());
+  }
+
+  // the MPC publishes a key-frame upon request
+  if (policyMsgPtr == nullptr) {
+    if (!policyKeyFrameRequested_) {
+      policyKeyFrameRequestPublisher_.publish(std_msgs::Empty());
+      policyKeyFrameRequested_ = true;
+    }
+    return;
+  }
+  policyKeyFrameRequested_ = false;
+
   // read new policy and command from msg
   std::unique_ptr<CommandData> commandPtr(new CommandData);
   std::unique_ptr<PrimalSolution> primalSolutionPtr(new PrimalSolution);
   std::unique_ptr<PerformanceIndex> performanceIndicesPtr(new PerformanceIndex);
-  readPolicyMsg(*msg, *commandPtr, *primalSolutionPtr, *performanceIndicesPtr);
+  readPolicyMsg(*policyMsgPtr, *commandPtr, *primalSolutionPtr, *performanceIndicesPtr);
 
   this->moveToBuffer(std::move(commandPtr), std::move(primalSolutionPtr), std::move(performanceIndicesPtr));
 }
@@ -263,6 +285,9 @@ void MRT_ROS_Interface::launchNodes(ros::NodeHandle& nodeHandle) {
   ops.transport_hints = mrtTransportHints_;
   mpcPolicySubscriber_ = nodeHandle.subscribe(ops);
 
+  // key-frame requests of the incremental policy messages
+  policyKeyFrameRequestPublisher_ = nodeHandle.advertise<std_msgs::Empty>(topicPrefix_ + "_mpc_policy_keyframe_request", 1);
+
   // MPC reset service client
   mpcResetServiceClient_ = nodeHandle.serviceClient<ocs2_msgs::reset>(topicPrefix_ + "_mpc_reset");
 
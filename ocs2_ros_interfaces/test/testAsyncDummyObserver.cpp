@@ -0,0 +1,170 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <mutex>
+#include <thread>
+
+#include <ocs2_core/misc/Benchmark.h>
+
+#include "ocs2_ros_interfaces/mrt/AsyncDummyObserver.h"
+
+using namespace ocs2;
+
+namespace {
+
+/** An observer which records the observation times and takes a fixed time for each update. */
+class SlowObserver final : public DummyObserver {
+ public:
+  explicit SlowObserver(std::chrono::microseconds updateDuration) : updateDuration_(updateDuration) {}
+
+  void update(const SystemObservation& observation, const PrimalSolution& primalSolution, const CommandData& command) override {
+    std::this_thread::sleep_for(updateDuration_);
+    std::lock_guard<std::mutex> lock(mutex_);
+    times_.push_back(observation.time);
+    trajectorySizes_.push_back(primalSolution.stateTrajectory_.size());
+  }
+
+  scalar_array_t getTimes() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return times_;
+  }
+
+  size_array_t getTrajectorySizes() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return trajectorySizes_;
+  }
+
+ private:
+  const std::chrono::microseconds updateDuration_;
+  mutable std::mutex mutex_;
+  scalar_array_t times_;
+  size_array_t trajectorySizes_;
+};
+
+PrimalSolution getPrimalSolution(size_t numNodes) {
+  PrimalSolution primalSolution;
+  for (size_t i = 0; i < numNodes; i++) {
+    primalSolution.timeTrajectory_.push_back(0.01 * i);
+    primalSolution.stateTrajectory_.push_back(vector_t::Random(24));
+    primalSolution.inputTrajectory_.push_back(vector_t::Random(24));
+  }
+  return primalSolution;
+}
+
+}  // unnamed namespace
+
+TEST(testAsyncDummyObserver, decimation) {
+  auto slowObserverPtr = std::make_shared<SlowObserver>(std::chrono::microseconds(0));
+  const PrimalSolution primalSolution = getPrimalSolution(10);
+  const CommandData command;
+
+  {
+    // 4 Hz loop decimated to 1 Hz
+    AsyncDummyObserver asyncObserver(slowObserverPtr, 1.0, 100);
+    SystemObservation observation;
+    for (size_t i = 0; i < 100; i++) {
+      observation.time = 0.25 * i;
+      asyncObserver.update(observation, primalSolution, command);
+    }
+    ASSERT_EQ(asyncObserver.getNumDroppedSnapshots(), 0);
+  }  // destructor processes the remaining snapshots
+
+  const auto times = slowObserverPtr->getTimes();
+  ASSERT_EQ(times.size(), 25);
+  for (size_t i = 0; i < times.size(); i++) {
+    EXPECT_DOUBLE_EQ(times[i], static_cast<scalar_t>(i));
+  }
+  for (const auto size : slowObserverPtr->getTrajectorySizes()) {
+    EXPECT_EQ(size, primalSolution.stateTrajectory_.size());
+  }
+}
+
+TEST(testAsyncDummyObserver, dropsWhenQueueIsFull) {
+  const size_t numLoops = 10;
+  auto slowObserverPtr = std::make_shared<SlowObserver>(std::chrono::milliseconds(20));
+  const PrimalSolution primalSolution = getPrimalSolution(10);
+  const CommandData command;
+
+  size_t numDroppedSnapshots = 0;
+  {
+    AsyncDummyObserver asyncObserver(slowObserverPtr, -1.0, 1);
+    SystemObservation observation;
+    for (size_t i = 0; i < numLoops; i++) {
+      observation.time = 0.001 * i;
+      asyncObserver.update(observation, primalSolution, command);
+    }
+    numDroppedSnapshots = asyncObserver.getNumDroppedSnapshots();
+  }
+
+  // the observer cannot keep up, but the snapshots which are not dropped are processed in order
+  const auto times = slowObserverPtr->getTimes();
+  ASSERT_GT(numDroppedSnapshots, 0);
+  ASSERT_EQ(times.size() + numDroppedSnapshots, numLoops);
+  EXPECT_TRUE(std::is_sorted(times.begin(), times.end()));
+}
+
+TEST(testAsyncDummyObserver, loopTimingIsNotAffected) {
+  const size_t numLoops = 200;
+  const auto updateDuration = std::chrono::milliseconds(2);
+  const PrimalSolution primalSolution = getPrimalSolution(100);
+  const CommandData command;
+
+  auto syncObserverPtr = std::make_shared<SlowObserver>(updateDuration);
+  auto asyncObserverPtr = std::make_shared<AsyncDummyObserver>(std::make_shared<SlowObserver>(updateDuration), -1.0);
+
+  benchmark::RepeatedTimer syncTimer;
+  benchmark::RepeatedTimer asyncTimer;
+  SystemObservation observation;
+  for (size_t i = 0; i < numLoops; i++) {
+    observation.time = 0.0025 * i;
+
+    syncTimer.startTimer();
+    syncObserverPtr->update(observation, primalSolution, command);
+    syncTimer.endTimer();
+
+    asyncTimer.startTimer();
+    asyncObserverPtr->update(observation, primalSolution, command);
+    asyncTimer.endTimer();
+  }
+
+  EXPECT_LT(asyncTimer.getAverageInMilliseconds(), syncTimer.getAverageInMilliseconds());
+
+  std::cerr << "\n########################################################################\n";
+  std::cerr << "Observer update time in the loop:\n";
+  std::cerr << "Synchronous  [ms]: average " << syncTimer.getAverageInMilliseconds() << ", max " << syncTimer.getMaxIntervalInMilliseconds()
+            << "\n";
+  std::cerr << "Asynchronous [ms]: average " << asyncTimer.getAverageInMilliseconds() << ", max "
+            << asyncTimer.getMaxIntervalInMilliseconds() << "\n";
+  std::cerr << "Dropped snapshots: " << asyncObserverPtr->getNumDroppedSnapshots() << " out of " << numLoops << "\n";
+}
@@ -0,0 +1,332 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <iostream>
+
+#include <ros/serialization.h>
+
+#include <ocs2_core/misc/Benchmark.h>
+
+#include "ocs2_ros_interfaces/common/IncrementalPolicyMsg.h"
+
+using namespace ocs2;
+
+namespace {
+
+constexpr size_t stateDim = 24;
+constexpr size_t inputDim = 12;
+constexpr scalar_t dt = 0.01;
+
+/** A smooth value of the policy at time t, such that the overlapping nodes of two consecutive policies are identical. */
+float policyValue(scalar_t t, size_t i) {
+  return static_cast<float>(std::sin(t + 0.1 * i));
+}
+
+/** Creates a linear policy message on the time grid [k * dt, (k + numNodes - 1) * dt]. */
+ocs2_msgs::mpc_flattened_controller getPolicyMsg(size_t k, size_t numNodes) {
+  ocs2_msgs::mpc_flattened_controller msg;
+  msg.controllerType = ocs2_msgs::mpc_flattened_controller::CONTROLLER_LINEAR;
+  msg.initObservation.time = k * dt;
+  msg.initObservation.state.value.assign(stateDim, 0.5f);
+  msg.initObservation.input.value.assign(inputDim, 0.5f);
+  msg.modeSchedule.eventTimes = {0.5};
+  msg.modeSchedule.modeSequence = {0, 1};
+  msg.planTargetTrajectories.timeTrajectory = {0.0};
+  msg.planTargetTrajectories.stateTrajectory.resize(1);
+  msg.planTargetTrajectories.stateTrajectory[0].value.assign(stateDim, 1.0f);
+  msg.planTargetTrajectories.inputTrajectory.resize(1);
+  msg.planTargetTrajectories.inputTrajectory[0].value.assign(inputDim, 0.0f);
+
+  msg.timeTrajectory.resize(numNodes);
+  msg.stateTrajectory.resize(numNodes);
+  msg.inputTrajectory.resize(numNodes);
+  msg.data.resize(numNodes);
+  for (size_t n = 0; n < numNodes; n++) {
+    const scalar_t t = (k + n) * dt;
+    msg.timeTrajectory[n] = t;
+    msg.stateTrajectory[n].value.resize(stateDim);
+    for (size_t i = 0; i < stateDim; i++) {
+      msg.stateTrajectory[n].value[i] = policyValue(t, i);
+    }
+    msg.inputTrajectory[n].value.resize(inputDim);
+    for (size_t i = 0; i < inputDim; i++) {
+      msg.inputTrajectory[n].value[i] = policyValue(t, stateDim + i);
+    }
+    // bias and gain of the linear controller
+    msg.data[n].data.resize(inputDim + inputDim * stateDim);
+    for (size_t i = 0; i < msg.data[n].data.size(); i++) {
+      msg.data[n].data[i] = policyValue(t, i);
+    }
+  }
+  return msg;
+}
+
+template <typename Msg>
+void expectEqual(const std::vector<Msg>& lhs, const std::vector<Msg>& rhs) {
+  ASSERT_EQ(lhs.size(), rhs.size());
+  for (size_t i = 0; i < lhs.size(); i++) {
+    EXPECT_EQ(lhs[i].value, rhs[i].value);
+  }
+}
+
+void expectEqual(const std::vector<ocs2_msgs::controller_data>& lhs, const std::vector<ocs2_msgs::controller_data>& rhs) {
+  ASSERT_EQ(lhs.size(), rhs.size());
+  for (size_t i = 0; i < lhs.size(); i++) {
+    EXPECT_EQ(lhs[i].data, rhs[i].data);
+  }
+}
+
+void expectEqual(const ocs2_msgs::mpc_flattened_controller& lhs, const ocs2_msgs::mpc_flattened_controller& rhs) {
+  EXPECT_EQ(lhs.controllerType, rhs.controllerType);
+  EXPECT_EQ(lhs.initObservation.time, rhs.initObservation.time);
+  EXPECT_EQ(lhs.timeTrajectory, rhs.timeTrajectory);
+  EXPECT_EQ(lhs.postEventIndices, rhs.postEventIndices);
+  EXPECT_EQ(lhs.modeSchedule.eventTimes, rhs.modeSchedule.eventTimes);
+  EXPECT_EQ(lhs.modeSchedule.modeSequence, rhs.modeSchedule.modeSequence);
+  EXPECT_EQ(lhs.planTargetTrajectories.timeTrajectory, rhs.planTargetTrajectories.timeTrajectory);
+  expectEqual(lhs.planTargetTrajectories.stateTrajectory, rhs.planTargetTrajectories.stateTrajectory);
+  expectEqual(lhs.planTargetTrajectories.inputTrajectory, rhs.planTargetTrajectories.inputTrajectory);
+  expectEqual(lhs.stateTrajectory, rhs.stateTrajectory);
+  expectEqual(lhs.inputTrajectory, rhs.inputTrajectory);
+  expectEqual(lhs.data, rhs.data);
+}
+
+/** Serializes and deserializes the message in-process, as it is done by the ROS transport. */
+size_t transmit(const ocs2_msgs::mpc_flattened_controller& msg, std::vector<uint8_t>& buffer, ocs2_msgs::mpc_flattened_controller& received) {
+  const uint32_t length = ros::serialization::serializationLength(msg);
+  buffer.resize(length);
+  ros::serialization::OStream ostream(buffer.data(), length);
+  ros::serialization::serialize(ostream, msg);
+  ros::serialization::IStream istream(buffer.data(), length);
+  ros::serialization::deserialize(istream, received);
+  return length;
+}
+
+}  // unnamed namespace
+
+TEST(testIncrementalPolicyMsg, roundTrip) {
+  constexpr size_t numNodes = 101;
+  IncrementalPolicySettings settings(0.0);
+  settings.keyFrameInterval = 5;
+  IncrementalPolicyEncoder encoder(settings);
+  IncrementalPolicyDecoder decoder;
+
+  std::vector<uint8_t> buffer;
+  ocs2_msgs::mpc_flattened_controller received;
+  for (size_t k = 0; k < 12; k++) {
+    const auto expected = getPolicyMsg(k, numNodes);
+    auto msg = expected;
+    encoder.encode(msg);
+    transmit(msg, buffer, received);
+
+    // every keyFrameInterval-th message is complete, the others only contain the new tail node
+    const bool isKeyFrame = (k % settings.keyFrameInterval == 0);
+    EXPECT_EQ(received.copiedSegments.empty(), isKeyFrame);
+    EXPECT_EQ(received.stateTrajectory.size(), isKeyFrame ? numNodes : 1);
+
+    const auto* decodedPtr = decoder.decode(received);
+    ASSERT_NE(decodedPtr, nullptr);
+    expectEqual(*decodedPtr, expected);
+  }
+}
+
+TEST(testIncrementalPolicyMsg, changedNodes) {
+  IncrementalPolicyEncoder encoder(IncrementalPolicySettings(0.0));
+  IncrementalPolicyDecoder decoder;
+
+  auto msg = getPolicyMsg(0, 50);
+  encoder.encode(msg);
+  ASSERT_NE(decoder.decode(msg), nullptr);
+
+  // change a node in the middle of the overlap, the mode schedule, and the length of the horizon
+  auto expected = getPolicyMsg(3, 40);
+  expected.stateTrajectory[10].value[0] += 1.0f;
+  expected.modeSchedule.eventTimes = {0.6};
+  msg = expected;
+  encoder.encode(msg);
+  EXPECT_EQ(msg.stateTrajectory.size(), 1);
+  EXPECT_EQ(msg.copiedSegments.size(), 2 * 3);
+  EXPECT_FALSE(msg.modeScheduleFromBase);
+  EXPECT_TRUE(msg.targetTrajectoriesFromBase);
+
+  const auto* decodedPtr = decoder.decode(msg);
+  ASSERT_NE(decodedPtr, nullptr);
+  expectEqual(*decodedPtr, expected);
+}
+
+TEST(testIncrementalPolicyMsg, valueTolerance) {
+  constexpr float perturbation = 1e-4;
+  const auto getPerturbedPolicyMsg = [&](size_t k) {
+    auto msg = getPolicyMsg(k, 20);
+    for (auto& node : msg.stateTrajectory) {
+      node.value[0] += perturbation;
+    }
+    return msg;
+  };
+
+  for (const scalar_t valueTolerance : {0.0, 1e-3}) {
+    IncrementalPolicyEncoder encoder(IncrementalPolicySettings{valueTolerance});
+    IncrementalPolicyDecoder decoder;
+
+    auto msg = getPolicyMsg(0, 20);
+    encoder.encode(msg);
+    ASSERT_NE(decoder.decode(msg), nullptr);
+
+    // the overlap of the next solution is slightly different, e.g. since the solver has iterated on it
+    const auto expected = getPerturbedPolicyMsg(1);
+    msg = expected;
+    encoder.encode(msg);
+    const bool isCopied = valueTolerance > perturbation;
+    EXPECT_EQ(msg.stateTrajectory.size(), isCopied ? 1 : 20);
+
+    const auto* decodedPtr = decoder.decode(msg);
+    ASSERT_NE(decodedPtr, nullptr);
+    ASSERT_EQ(decodedPtr->stateTrajectory.size(), expected.stateTrajectory.size());
+    for (size_t n = 0; n < expected.stateTrajectory.size(); n++) {
+      for (size_t i = 0; i < stateDim; i++) {
+        EXPECT_NEAR(decodedPtr->stateTrajectory[n].value[i], expected.stateTrajectory[n].value[i], valueTolerance);
+      }
+    }
+  }
+}
+
+TEST(testIncrementalPolicyMsg, missingBase) {
+  IncrementalPolicySettings settings(0.0);
+  settings.keyFrameInterval = 3;
+  IncrementalPolicyEncoder encoder(settings);
+  IncrementalPolicyDecoder decoder;
+
+  auto msg = getPolicyMsg(0, 20);
+  encoder.encode(msg);
+  ASSERT_NE(decoder.decode(msg), nullptr);
+
+  // the second message is lost, therefore the third one can not be reconstructed
+  msg = getPolicyMsg(1, 20);
+  encoder.encode(msg);
+  msg = getPolicyMsg(2, 20);
+  encoder.encode(msg);
+  EXPECT_EQ(decoder.decode(msg), nullptr);
+
+  // the decoder resynchronizes on the next key-frame
+  const auto expected = getPolicyMsg(3, 20);
+  msg = expected;
+  encoder.encode(msg);
+  const auto* decodedPtr = decoder.decode(msg);
+  ASSERT_NE(decodedPtr, nullptr);
+  expectEqual(*decodedPtr, expected);
+}
+
+TEST(testIncrementalPolicyMsg, keyFrameRequest) {
+  IncrementalPolicyEncoder encoder(IncrementalPolicySettings(0.0));
+  IncrementalPolicyDecoder decoder;
+
+  auto msg = getPolicyMsg(0, 20);
+  encoder.encode(msg);
+  ASSERT_NE(decoder.decode(msg), nullptr);
+
+  // the second message is lost
+  msg = getPolicyMsg(1, 20);
+  encoder.encode(msg);
+  msg = getPolicyMsg(2, 20);
+  encoder.encode(msg);
+  EXPECT_EQ(decoder.decode(msg), nullptr);
+
+  // the receiver requests a key-frame, which is sent long before the periodic one
+  encoder.reset();
+  const auto expected = getPolicyMsg(3, 20);
+  msg = expected;
+  encoder.encode(msg);
+  EXPECT_TRUE(msg.copiedSegments.empty());
+  const auto* decodedPtr = decoder.decode(msg);
+  ASSERT_NE(decodedPtr, nullptr);
+  expectEqual(*decodedPtr, expected);
+}
+
+TEST(testIncrementalPolicyMsg, invalidSegments) {
+  IncrementalPolicyEncoder encoder(IncrementalPolicySettings(0.0));
+  IncrementalPolicyDecoder decoder;
+
+  auto msg = getPolicyMsg(0, 20);
+  encoder.encode(msg);
+  ASSERT_NE(decoder.decode(msg), nullptr);
+
+  const auto expected = getPolicyMsg(1, 20);
+  msg = expected;
+  encoder.encode(msg);
+  auto invalidMsg = msg;
+  invalidMsg.copiedSegments.back() += 5;
+  EXPECT_THROW(decoder.decode(invalidMsg), std::runtime_error);
+  invalidMsg = msg;
+  invalidMsg.stateTrajectory.pop_back();
+  invalidMsg.inputTrajectory.pop_back();
+  invalidMsg.data.pop_back();
+  EXPECT_THROW(decoder.decode(invalidMsg), std::runtime_error);
+
+  // the base policy is kept
+  const auto* decodedPtr = decoder.decode(msg);
+  ASSERT_NE(decodedPtr, nullptr);
+  expectEqual(*decodedPtr, expected);
+}
+
+TEST(testIncrementalPolicyMsg, DISABLED_benchmark) {
+  constexpr size_t numNodes = 101;
+  constexpr size_t numMsgs = 200;
+  IncrementalPolicyEncoder encoder(IncrementalPolicySettings(0.0));
+  IncrementalPolicyDecoder decoder;
+
+  std::vector<uint8_t> buffer;
+  ocs2_msgs::mpc_flattened_controller received;
+  size_t completeSize = 0;
+  size_t incrementalSize = 0;
+  benchmark::RepeatedTimer completeTimer;
+  benchmark::RepeatedTimer incrementalTimer;
+  for (size_t k = 0; k < numMsgs; k++) {
+    auto msg = getPolicyMsg(k, numNodes);
+
+    completeTimer.startTimer();
+    completeSize += transmit(msg, buffer, received);
+    completeTimer.endTimer();
+
+    incrementalTimer.startTimer();
+    encoder.encode(msg);
+    incrementalSize += transmit(msg, buffer, received);
+    const auto* decodedPtr = decoder.decode(received);
+    incrementalTimer.endTimer();
+    ASSERT_NE(decodedPtr, nullptr);
+  }
+
+  std::cerr << "\n###   Policy message with " << numNodes << " nodes, averaged over " << numMsgs << " messages"
+            << "\n###   Serialized size [bytes]  complete: " << completeSize / numMsgs << ", incremental: " << incrementalSize / numMsgs
+            << "\n###   Latency [ms]             complete: " << completeTimer.getAverageInMilliseconds()
+            << ", incremental: " << incrementalTimer.getAverageInMilliseconds() << "\n";
+  EXPECT_LT(incrementalSize, completeSize / 2);
+}
@@ -29,6 +29,12 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #pragma once
 
+#include <cassert>
+#include <memory>
+#include <vector>
+
+#include <Eigen/QR>
+
 #include <ocs2_core/Types.h>
 
 namespace ocs2 {
@@ -59,4 +65,116 @@ VectorFunctionLinearApproximation qrConstraintProjection(const VectorFunctionLin
  */
 VectorFunctionLinearApproximation luConstraintProjection(const VectorFunctionLinearApproximation& constraint);
 
+/**
+ * Returns the linear projection
+ *  u = Pu * \tilde{u} + Px * x + Pe
+ *
+ * s.t. u[fixedIndices] = fixedValues and C*x + D*u + e = 0 are satisfied for any \tilde{u}
+ *
+ * The fixed input components are eliminated by substitution, and the constraints are reduced to the free input components. The constraints
+ * which only act on the fixed components become trivial and are dropped; the remaining ones are projected with the LU decomposition.
+ * The rows of Pu and Px which correspond to the fixed components are zero.
+ *
+ * @throws std::runtime_error if a constraint which does not depend on the free components depends on the state or is not satisfied by
+ * the fixed values, since the projection cannot enforce it.
+ *
+ * @param constraint : C = dfdx, D = dfdu, e = f; It may be empty (no constraints).
+ * @param numStates : Number of states.
+ * @param numInputs : Number of inputs.
+ * @param fixedIndices : Indices of the fixed input components in ascending order.
+ * @param fixedValues : Values of the fixed input components.
+ * @return Px = dfdx, Pu = dfdu, Pe = f;
+ */
+VectorFunctionLinearApproximation fixedInputsConstraintProjection(const VectorFunctionLinearApproximation& constraint, size_t numStates,
+                                                                  size_t numInputs, const size_array_t& fixedIndices,
+                                                                  const vector_t& fixedValues);
+
+/**
+ * Computes the same projection as qrConstraintProjection in preallocated storage. Q is never formed: the Householder reflections of the
+ * QR decomposition of D^T are applied directly to [-inv(R^T) * [C, e], 0; 0, I], which gives [Px, Pe] = Q1 * -inv(R^T) * [C, e] and
+ * Pu = Q2. After the first call, no memory is allocated for the same constraint shape except for the returned matrices (and not even for
+ * those if they already have the right size).
+ *
+ * The number of constraints and inputs can be fixed at compile time for small problems. Then the dimensions of the constraint have to
+ * match the template arguments.
+ *
+ * @tparam NumConstraints : The number of constraints or Eigen::Dynamic.
+ * @tparam NumInputs : The number of inputs or Eigen::Dynamic.
+ */
+template <int NumConstraints = Eigen::Dynamic, int NumInputs = Eigen::Dynamic>
+class QrConstraintProjectionKernel {
+ public:
+  /**
+   * Computes the projection.
+   *
+   * @param [in] constraint : C = dfdx, D = dfdu, e = f;
+   * @param [out] projection : Px = dfdx, Pu = dfdu, Pe = f;
+   */
+  void compute(const VectorFunctionLinearApproximation& constraint, VectorFunctionLinearApproximation& projection) {
+    const auto numConstraints = constraint.dfdu.rows();
+    const auto numInputs = constraint.dfdu.cols();
+    const auto numStates = constraint.dfdx.cols();
+    assert(numConstraints <= numInputs);
+
+    qr_.compute(constraint.dfdu.transpose());
+
+    // rhs_ = [-inv(R^T) * [C, e], 0; 0, I]
+    const auto numFreeInputs = numInputs - numConstraints;
+    rhs_.setZero(numInputs, numStates + 1 + numFreeInputs);
+    rhs_.topLeftCorner(numConstraints, numStates) = -constraint.dfdx;
+    rhs_.col(numStates).head(numConstraints) = -constraint.f;
+    rhs_.bottomRightCorner(numFreeInputs, numFreeInputs).setIdentity();
+    qr_.matrixQR()
+        .topLeftCorner(numConstraints, numConstraints)
+        .template triangularView<Eigen::Upper>()
+        .transpose()
+        .solveInPlace(rhs_.topLeftCorner(numConstraints, numStates + 1));
+
+    // [Px, Pe, Pu] = Q * rhs_, in one sweep of the reflections over all the columns
+    qr_.householderQ().applyThisOnTheLeft(rhs_, workspace_);
+    projection.dfdx = rhs_.leftCols(numStates);
+    projection.f = rhs_.col(numStates);
+    projection.dfdu = rhs_.rightCols(numFreeInputs);
+  }
+
+ private:
+  Eigen::HouseholderQR<Eigen::Matrix<scalar_t, NumInputs, NumConstraints>> qr_;
+  Eigen::Matrix<scalar_t, NumInputs, Eigen::Dynamic> rhs_;
+  Eigen::Matrix<scalar_t, 1, Eigen::Dynamic> workspace_;
+};
+
+/**
+ * QR based constraint projection for a sequence of nodes. The nodes are grouped by the shape of their constraint (number of constraints
+ * and inputs), and each shape is computed with its own preallocated QrConstraintProjectionKernel. Since a problem typically has only a
+ * handful of distinct shapes (e.g. one per contact configuration), the storage is reused across the nodes and the iterations.
+ *
+ * This class is not thread-safe; use one instance per thread.
+ */
+class QrConstraintProjection {
+ public:
+  /**
+   * Returns the linear projection as qrConstraintProjection.
+   *
+   * @param [in] constraint : C = dfdx, D = dfdu, e = f;
+   * @param [out] projection : Px = dfdx, Pu = dfdu, Pe = f;
+   */
+  void compute(const VectorFunctionLinearApproximation& constraint, VectorFunctionLinearApproximation& projection);
+
+  /** Number of distinct constraint shapes with a preallocated kernel. */
+  size_t getNumShapes() const { return shapes_.size(); }
+
+  /** Releases the preallocated kernels. */
+  void clear() {
+    shapes_.clear();
+    kernels_.clear();
+  }
+
+ private:
+  QrConstraintProjectionKernel<>& getKernel(Eigen::Index numConstraints, Eigen::Index numInputs);
+
+  std::vector<std::pair<Eigen::Index, Eigen::Index>> shapes_;
+  std::vector<std::unique_ptr<QrConstraintProjectionKernel<>>> kernels_;
+  size_t lastShapeIndex_ = 0;
+};
+
 }  // namespace ocs2
\ No newline at end of file
@@ -31,6 +31,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <ocs2_core/Types.h>
 #include <ocs2_core/initialization/Initializer.h>
+#include <ocs2_core/reference/ModeSchedule.h>
 #include <ocs2_oc/oc_data/PrimalSolution.h>
 
 namespace ocs2 {
@@ -62,6 +63,15 @@ inline std::pair<vector_t, vector_t> initializeIntermediateNode(Initializer& ini
  */
 std::pair<vector_t, vector_t> initializeIntermediateNode(PrimalSolution& primalSolution, scalar_t t, scalar_t tNext, const vector_t& x);
 
+/**
+ * Adapts a previous solution to a new mode schedule with TrajectorySpreading, such that interpolating it for the state-input
+ * initialization respects the new event times.
+ *
+ * @param newModeSchedule : The mode schedule to adapt to
+ * @param primalSolution : previous solution, associated with PrimalSolution::modeSchedule_. The controller is not adjusted.
+ */
+void spreadPrimalSolution(const ModeSchedule& newModeSchedule, PrimalSolution& primalSolution);
+
 /**
  * Initialize the state jump at an event node.
  *
@@ -57,6 +57,9 @@ struct Settings {
   bool useFeedbackPolicy = true;     // true to use feedback, false to use feedforward
   bool createValueFunction = false;  // true to store the value function, false to ignore it
 
+  // Warm start
+  bool useTrajectorySpreading = true;  // Adapt the previous solution to the changes of the mode schedule before warm starting
+
   // QP subproblem solver settings
   hpipm_interface::Settings hpipmSettings = hpipm_interface::Settings();
 
@@ -68,6 +71,7 @@ struct Settings {
   scalar_t inequalityConstraintMu = 0.0;
   scalar_t inequalityConstraintDelta = 1e-6;
   bool projectStateInputEqualityConstraints = true;  // Use a projection method to resolve the state-input constraint Cx+Du+e
+  bool useQrConstraintProjection = false;            // Project with the QR instead of the LU decomposition (without fixed inputs)
 
   // Printing
   bool printSolverStatus = false;      // Print HPIPM status after solving the QP subproblem
@@ -32,6 +32,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <ocs2_core/initialization/Initializer.h>
 #include <ocs2_core/integration/SensitivityIntegrator.h>
 #include <ocs2_core/misc/Benchmark.h>
+#include <ocs2_core/reference/ReferenceSampler.h>
 #include <ocs2_core/thread_support/ThreadPool.h>
 
 #include <ocs2_oc/oc_problem/OptimalControlProblem.h>
@@ -39,6 +40,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <hpipm_catkin/HpipmInterface.h>
 
+#include "ocs2_sqp/ConstraintProjection.h"
 #include "ocs2_sqp/MultipleShootingSettings.h"
 #include "ocs2_sqp/MultipleShootingSolverStatus.h"
 #include "ocs2_sqp/TimeDiscretization.h"
@@ -169,8 +171,12 @@ class MultipleShootingSolver : public SolverBase {
   DynamicsDiscretizer discretizer_;
   DynamicsSensitivityDiscretizer sensitivityDiscretizer_;
   std::vector<OptimalControlProblem> ocpDefinitions_;
+  std::vector<QrConstraintProjection> qrConstraintProjections_;
   std::unique_ptr<Initializer> initializerPtr_;
 
+  // References sampled at the node times, shared by the workers during a solve
+  ReferenceSampler referenceSampler_;
+
   // Threading
   ThreadPool threadPool_;
 
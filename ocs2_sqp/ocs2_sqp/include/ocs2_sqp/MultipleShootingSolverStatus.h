@@ -50,12 +50,15 @@ struct StepInfo {
   // Performance result after the step
   PerformanceIndex performanceAfterStep;
   scalar_t totalConstraintViolationAfterStep;  // constraint metric used in the line search
+
+  // Whether the line search was stopped by the exhausted time budget
+  bool deadlineExpired = false;
 };
 
 std::string toString(const StepInfo::StepType& stepType);
 
 /** Different types of convergence */
-enum class Convergence { FALSE, ITERATIONS, STEPSIZE, METRICS, PRIMAL };
+enum class Convergence { FALSE, ITERATIONS, STEPSIZE, METRICS, PRIMAL, TIME_BUDGET };
 
 std::string toString(const Convergence& convergence);
 
@@ -34,6 +34,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <ocs2_oc/oc_problem/OptimalControlProblem.h>
 #include <ocs2_oc/oc_solver/PerformanceIndex.h>
 
+#include "ocs2_sqp/ConstraintProjection.h"
+
 namespace ocs2 {
 namespace multiple_shooting {
 
@@ -53,17 +55,20 @@ struct Transcription {
  *
  * @param optimalControlProblem : Definition of the optimal control problem
  * @param sensitivityDiscretizer : Integrator to use for creating the discrete dynamics.
- * @param projectStateInputEqualityConstraints
+ * @param projectStateInputEqualityConstraints : Project the state-input equality constraints and eliminate the fixed inputs.
  * @param t : Start of the discrete interval
  * @param dt : Duration of the interval
  * @param x : State at start of the interval
  * @param x_next : State at the end of the interval
  * @param u : Input, taken to be constant across the interval.
+ * @param qrConstraintProjectionPtr : If not nullptr, the state-input equality constraints without fixed inputs are projected with this
+ *                                    preallocated QR projection instead of the LU decomposition.
  * @return multiple shooting transcription for this node.
  */
 Transcription setupIntermediateNode(const OptimalControlProblem& optimalControlProblem,
                                     DynamicsSensitivityDiscretizer& sensitivityDiscretizer, bool projectStateInputEqualityConstraints,
-                                    scalar_t t, scalar_t dt, const vector_t& x, const vector_t& x_next, const vector_t& u);
+                                    scalar_t t, scalar_t dt, const vector_t& x, const vector_t& x_next, const vector_t& u,
+                                    QrConstraintProjection* qrConstraintProjectionPtr = nullptr);
 
 /**
  * Compute only the performance index for a single intermediate node.
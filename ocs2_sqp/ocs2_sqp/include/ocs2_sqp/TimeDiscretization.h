@@ -60,6 +60,9 @@ scalar_t getIntervalEnd(const AnnotatedTime& end);
 /** Computes the interval duration that respects interpolation rules around event times */
 scalar_t getIntervalDuration(const AnnotatedTime& start, const AnnotatedTime& end);
 
+/** Gets the times at which the nodes of the time discretization are evaluated, i.e. the interval starts */
+scalar_array_t getNodeTimes(const std::vector<AnnotatedTime>& timeDiscretization);
+
 /**
  * Decides on time discretization along the horizon. Tries to makes step of dt, but will also ensure that eventtimes are part of the
  * discretization.
@@ -29,6 +29,13 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "ocs2_sqp/ConstraintProjection.h"
 
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+
+#include <ocs2_core/NumericTraits.h>
+
 namespace ocs2 {
 
 VectorFunctionLinearApproximation qrConstraintProjection(const VectorFunctionLinearApproximation& constraint) {
@@ -64,4 +71,103 @@ VectorFunctionLinearApproximation luConstraintProjection(const VectorFunctionLin
   return projectionTerms;
 }
 
+VectorFunctionLinearApproximation fixedInputsConstraintProjection(const VectorFunctionLinearApproximation& constraint, size_t numStates,
+                                                                  size_t numInputs, const size_array_t& fixedIndices,
+                                                                  const vector_t& fixedValues) {
+  assert(fixedIndices.size() == static_cast<size_t>(fixedValues.size()));
+  const size_t numFixed = fixedIndices.size();
+  const size_t numFree = numInputs - numFixed;
+
+  // Indices of the free input components
+  size_array_t freeIndices;
+  freeIndices.reserve(numFree);
+  for (size_t i = 0, j = 0; i < numInputs; i++) {
+    if (j < numFixed && fixedIndices[j] == i) {
+      j++;
+    } else {
+      freeIndices.push_back(i);
+    }
+  }
+
+  // Substitute the fixed components: C*x + D_free*u_free + (e + D_fixed*u_fixed) = 0. Drop the rows that do not depend on u_free; these
+  // have to be satisfied by the fixed components alone.
+  const size_t numConstraints = constraint.f.size();
+  size_array_t reducedRows;
+  reducedRows.reserve(numConstraints);
+  for (size_t r = 0; r < numConstraints; r++) {
+    const bool dependsOnFreeInputs =
+        std::any_of(freeIndices.begin(), freeIndices.end(), [&](size_t i) { return constraint.dfdu(r, i) != 0.0; });
+    if (dependsOnFreeInputs) {
+      reducedRows.push_back(r);
+    } else {
+      scalar_t residual = constraint.f(r);
+      for (size_t j = 0; j < numFixed; j++) {
+        residual += constraint.dfdu(r, fixedIndices[j]) * fixedValues(j);
+      }
+      if (!constraint.dfdx.row(r).isZero() || std::abs(residual) > numeric_traits::limitEpsilon<scalar_t>()) {
+        throw std::runtime_error("[fixedInputsConstraintProjection] Constraint " + std::to_string(r) +
+                                 " does not depend on the free inputs and is not satisfied by the fixed inputs (residual: " +
+                                 std::to_string(residual) + ", depends on the state: " +
+                                 (constraint.dfdx.row(r).isZero() ? "no" : "yes") + ").");
+      }
+    }
+  }
+
+  // Projection of the free input components
+  VectorFunctionLinearApproximation freeProjection;
+  if (reducedRows.empty()) {
+    freeProjection.dfdu = matrix_t::Identity(numFree, numFree);
+    freeProjection.dfdx = matrix_t::Zero(numFree, numStates);
+    freeProjection.f = vector_t::Zero(numFree);
+  } else {
+    VectorFunctionLinearApproximation reducedConstraint(reducedRows.size(), numStates, numFree);
+    for (size_t k = 0; k < reducedRows.size(); k++) {
+      const size_t r = reducedRows[k];
+      reducedConstraint.dfdx.row(k) = constraint.dfdx.row(r);
+      reducedConstraint.f(k) = constraint.f(r);
+      for (size_t j = 0; j < numFixed; j++) {
+        reducedConstraint.f(k) += constraint.dfdu(r, fixedIndices[j]) * fixedValues(j);
+      }
+      for (size_t j = 0; j < numFree; j++) {
+        reducedConstraint.dfdu(k, j) = constraint.dfdu(r, freeIndices[j]);
+      }
+    }
+    freeProjection = luConstraintProjection(reducedConstraint);
+  }
+
+  // Reinsert the fixed components
+  VectorFunctionLinearApproximation projectionTerms = VectorFunctionLinearApproximation::Zero(numInputs, numStates, freeProjection.dfdu.cols());
+  for (size_t j = 0; j < numFree; j++) {
+    projectionTerms.dfdu.row(freeIndices[j]) = freeProjection.dfdu.row(j);
+    projectionTerms.dfdx.row(freeIndices[j]) = freeProjection.dfdx.row(j);
+    projectionTerms.f(freeIndices[j]) = freeProjection.f(j);
+  }
+  for (size_t j = 0; j < numFixed; j++) {
+    projectionTerms.f(fixedIndices[j]) = fixedValues(j);
+  }
+
+  return projectionTerms;
+}
+
+void QrConstraintProjection::compute(const VectorFunctionLinearApproximation& constraint, VectorFunctionLinearApproximation& projection) {
+  getKernel(constraint.dfdu.rows(), constraint.dfdu.cols()).compute(constraint, projection);
+}
+
+QrConstraintProjectionKernel<>& QrConstraintProjection::getKernel(Eigen::Index numConstraints, Eigen::Index numInputs) {
+  const auto shape = std::make_pair(numConstraints, numInputs);
+
+  // Consecutive nodes mostly share the shape
+  if (lastShapeIndex_ < shapes_.size() && shapes_[lastShapeIndex_] == shape) {
+    return *kernels_[lastShapeIndex_];
+  }
+
+  const auto it = std::find(shapes_.begin(), shapes_.end(), shape);
+  lastShapeIndex_ = std::distance(shapes_.begin(), it);
+  if (it == shapes_.end()) {
+    shapes_.push_back(shape);
+    kernels_.emplace_back(new QrConstraintProjectionKernel<>());
+  }
+  return *kernels_[lastShapeIndex_];
+}
+
 }  // namespace ocs2
\ No newline at end of file
@@ -29,7 +29,9 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "ocs2_sqp/MultipleShootingInitialization.h"
 
+#include <ocs2_core/NumericTraits.h>
 #include <ocs2_core/misc/LinearInterpolation.h>
+#include <ocs2_oc/trajectory_adjustment/TrajectorySpreading.h>
 
 namespace ocs2 {
 namespace multiple_shooting {
@@ -39,5 +41,36 @@ std::pair<vector_t, vector_t> initializeIntermediateNode(PrimalSolution& primalS
           LinearInterpolation::interpolate(tNext, primalSolution.timeTrajectory_, primalSolution.stateTrajectory_)};
 }
 
+void spreadPrimalSolution(const ModeSchedule& newModeSchedule, PrimalSolution& primalSolution) {
+  if (primalSolution.timeTrajectory_.empty()) {
+    return;
+  }
+
+  // The post-event nodes share the time of their pre-event nodes, while TrajectorySpreading expects them strictly after the event.
+  // The shift is only applied to a copy, such that the stored time trajectory keeps the solver's convention.
+  scalar_array_t spreadingTimeTrajectory = primalSolution.timeTrajectory_;
+  for (const auto postEventIndex : primalSolution.postEventIndices_) {
+    spreadingTimeTrajectory[postEventIndex] += numeric_traits::weakEpsilon<scalar_t>();
+  }
+
+  constexpr bool debugPrint = false;
+  TrajectorySpreading trajectorySpreading(debugPrint);
+  trajectorySpreading.set(primalSolution.modeSchedule_, newModeSchedule, spreadingTimeTrajectory);
+
+  // adjust modeSchedule, state, input, time, postEventIndices
+  primalSolution.modeSchedule_ = newModeSchedule;
+  trajectorySpreading.adjustTrajectory(primalSolution.stateTrajectory_);
+  trajectorySpreading.adjustTrajectory(primalSolution.inputTrajectory_);
+  trajectorySpreading.adjustTimeTrajectory(primalSolution.timeTrajectory_);
+  primalSolution.postEventIndices_ = trajectorySpreading.getPostEventIndices();
+
+  // restore the convention of post-event nodes sharing the (moved) event time. An event at the first node has no pre-event node.
+  for (const auto postEventIndex : primalSolution.postEventIndices_) {
+    if (postEventIndex > 0) {
+      primalSolution.timeTrajectory_[postEventIndex] = primalSolution.timeTrajectory_[postEventIndex - 1];
+    }
+  }
+}
+
 }  // namespace multiple_shooting
 }  // namespace ocs2
\ No newline at end of file
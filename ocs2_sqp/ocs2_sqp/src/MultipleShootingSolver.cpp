@@ -58,6 +58,9 @@ MultipleShootingSolver::MultipleShootingSolver(Settings settings, const OptimalC
   for (int w = 0; w < settings.nThreads; w++) {
     ocpDefinitions_.push_back(optimalControlProblem);
   }
+  if (settings.useQrConstraintProjection) {
+    qrConstraintProjections_.resize(settings.nThreads);
+  }
 
   // Operating points
   initializerPtr_.reset(initializer.clone());
@@ -151,28 +154,40 @@ void MultipleShootingSolver::runImpl(scalar_t initTime, const vector_t& initStat
   }
 
   // Determine time discretization, taking into account event times.
-  const auto& eventTimes = this->getReferenceManager().getModeSchedule().eventTimes;
-  const auto timeDiscretization = timeDiscretizationWithEvents(initTime, finalTime, settings_.dt, eventTimes);
+  const auto& modeSchedule = this->getReferenceManager().getModeSchedule();
+  const auto timeDiscretization = timeDiscretizationWithEvents(initTime, finalTime, settings_.dt, modeSchedule.eventTimes);
+
+  // Remap the previous solution onto the event structure of the new mode schedule
+  if (settings_.useTrajectorySpreading) {
+    multiple_shooting::spreadPrimalSolution(modeSchedule, primalSolution_);
+  }
 
   // Initialize the state and input
   vector_array_t x, u;
   initializeStateInputTrajectories(initState, timeDiscretization, x, u);
 
   // Initialize references
+  const auto& targetTrajectories = this->getReferenceManager().getTargetTrajectories();
+  referenceSampler_.update(getNodeTimes(timeDiscretization), targetTrajectories, this->getReferenceManager().getModeSchedule());
   for (auto& ocpDefinition : ocpDefinitions_) {
-    const auto& targetTrajectories = this->getReferenceManager().getTargetTrajectories();
     ocpDefinition.targetTrajectoriesPtr = &targetTrajectories;
+    ocpDefinition.preComputationPtr->setReferenceSampler(&referenceSampler_);
   }
 
   // Bookkeeping
   performanceIndeces_.clear();
 
+  // The duration of the iterations is used to predict whether another iteration fits in the time budget
+  benchmark::RepeatedTimer iterationTimer;
+
   int iter = 0;
   multiple_shooting::Convergence convergence = multiple_shooting::Convergence::FALSE;
   while (convergence == multiple_shooting::Convergence::FALSE) {
     if (settings_.printSolverStatus || settings_.printLinesearch) {
       std::cerr << "\nSQP iteration: " << iter << "\n";
     }
+    iterationTimer.startTimer();
+
     // Make QP approximation
     linearQuadraticApproximationTimer_.startTimer();
     const auto baselinePerformance = setupQuadraticSubproblem(timeDiscretization, initState, x, u);
@@ -194,6 +209,13 @@ void MultipleShootingSolver::runImpl(scalar_t initTime, const vector_t& initStat
     // Check convergence
     convergence = checkConvergence(iter, baselinePerformance, stepInfo);
 
+    // Stop if another iteration is not expected to fit in the time budget
+    iterationTimer.endTimer();
+    if (convergence == multiple_shooting::Convergence::FALSE && !getDeadline().canFit(iterationTimer.getMaxIntervalInMilliseconds())) {
+      convergence = multiple_shooting::Convergence::TIME_BUDGET;
+      reportTimeBudgetTermination();
+    }
+
     // Next iteration
     ++iter;
     ++totalNumIterations_;
@@ -203,6 +225,11 @@ void MultipleShootingSolver::runImpl(scalar_t initTime, const vector_t& initStat
   setPrimalSolution(timeDiscretization, std::move(x), std::move(u));
   computeControllerTimer_.endTimer();
 
+  // The sampled references are only valid during the solve
+  for (auto& ocpDefinition : ocpDefinitions_) {
+    ocpDefinition.preComputationPtr->setReferenceSampler(nullptr);
+  }
+
   ++numProblems_;
 
   if (settings_.printSolverStatus || settings_.printLinesearch) {
@@ -399,6 +426,7 @@ PerformanceIndex MultipleShootingSolver::setupQuadraticSubproblem(const std::vec
     OptimalControlProblem& ocpDefinition = ocpDefinitions_[workerId];
     PerformanceIndex workerPerformance;  // Accumulate performance in local variable
     const bool projection = settings_.projectStateInputEqualityConstraints;
+    QrConstraintProjection* qrConstraintProjectionPtr = settings_.useQrConstraintProjection ? &qrConstraintProjections_[workerId] : nullptr;
 
     int i = timeIndex++;
     while (i < N) {
@@ -414,8 +442,8 @@ PerformanceIndex MultipleShootingSolver::setupQuadraticSubproblem(const std::vec
         // Normal, intermediate node
         const scalar_t ti = getIntervalStart(time[i]);
         const scalar_t dt = getIntervalDuration(time[i], time[i + 1]);
-        auto result =
-            multiple_shooting::setupIntermediateNode(ocpDefinition, sensitivityDiscretizer_, projection, ti, dt, x[i], x[i + 1], u[i]);
+        auto result = multiple_shooting::setupIntermediateNode(ocpDefinition, sensitivityDiscretizer_, projection, ti, dt, x[i], x[i + 1],
+                                                               u[i], qrConstraintProjectionPtr);
         workerPerformance += result.performance;
         dynamics_[i] = std::move(result.dynamics);
         cost_[i] = std::move(result.cost);
@@ -589,6 +617,13 @@ multiple_shooting::StepInfo MultipleShootingSolver::takeStep(const PerformanceIn
       stepInfo.performanceAfterStep = performanceNew;
       stepInfo.totalConstraintViolationAfterStep = newConstraintViolation;
       return stepInfo;
+    } else if (getDeadline().hasExpired()) {  // Keep the current iterate if there is no time for a smaller step
+      if (settings_.printLinesearch) {
+        std::cerr << "Exiting linesearch early due to the exhausted time budget\n";
+      }
+      reportTimeBudgetTermination();
+      stepInfo.deadlineExpired = true;
+      break;
     } else {  // Try smaller step
       alpha *= settings_.alpha_decay;
 
@@ -621,7 +656,10 @@ multiple_shooting::StepInfo MultipleShootingSolver::takeStep(const PerformanceIn
 multiple_shooting::Convergence MultipleShootingSolver::checkConvergence(int iteration, const PerformanceIndex& baseline,
                                                                         const multiple_shooting::StepInfo& stepInfo) const {
   using Convergence = multiple_shooting::Convergence;
-  if ((iteration + 1) >= settings_.sqpIteration) {
+  if (stepInfo.deadlineExpired) {
+    // Stopped because the line search was cut by the time budget; the zero step does not indicate convergence
+    return Convergence::TIME_BUDGET;
+  } else if ((iteration + 1) >= settings_.sqpIteration) {
     // Converged because the next iteration would exceed the specified number of iterations
     return Convergence::ITERATIONS;
   } else if (stepInfo.stepSize < settings_.alpha_min) {
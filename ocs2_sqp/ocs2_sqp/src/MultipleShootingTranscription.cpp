@@ -39,7 +39,8 @@ namespace multiple_shooting {
 
 Transcription setupIntermediateNode(const OptimalControlProblem& optimalControlProblem,
                                     DynamicsSensitivityDiscretizer& sensitivityDiscretizer, bool projectStateInputEqualityConstraints,
-                                    scalar_t t, scalar_t dt, const vector_t& x, const vector_t& x_next, const vector_t& u) {
+                                    scalar_t t, scalar_t dt, const vector_t& x, const vector_t& x_next, const vector_t& u,
+                                    QrConstraintProjection* qrConstraintProjectionPtr) {
   // Results and short-hand notation
   Transcription transcription;
   auto& dynamics = transcription.dynamics;
@@ -69,15 +70,37 @@ Transcription setupIntermediateNode(const OptimalControlProblem& optimalControlP
     constraints = optimalControlProblem.equalityConstraintPtr->getLinearApproximation(t, x, u, *optimalControlProblem.preComputationPtr);
     if (constraints.f.size() > 0) {
       performance.equalityConstraintsSSE = dt * constraints.f.squaredNorm();
-      if (projectStateInputEqualityConstraints) {  // Handle equality constraints using projection.
-        // Projection stored instead of constraint, // TODO: benchmark between lu and qr method. LU seems slightly faster.
-        projection = luConstraintProjection(constraints);
-        constraints = VectorFunctionLinearApproximation();
+    }
+  }
+
+  if (projectStateInputEqualityConstraints) {  // Handle equality constraints using projection.
+    // Fixed inputs: du_{k}[fixed] = values - u_{k}[fixed]
+    size_array_t fixedIndices;
+    if (optimalControlProblem.fixedInputsPtr != nullptr) {
+      fixedIndices = optimalControlProblem.fixedInputsPtr->getIndices(t);
+    }
 
-        // Adapt dynamics and cost
-        changeOfInputVariables(dynamics, projection.dfdu, projection.dfdx, projection.f);
-        changeOfInputVariables(cost, projection.dfdu, projection.dfdx, projection.f);
+    // Projection stored instead of constraint
+    if (!fixedIndices.empty()) {
+      vector_t fixedDeltas = optimalControlProblem.fixedInputsPtr->getValues(t);
+      for (size_t j = 0; j < fixedIndices.size(); j++) {
+        fixedDeltas(j) -= u(fixedIndices[j]);
       }
+      projection = fixedInputsConstraintProjection(constraints, x.size(), u.size(), fixedIndices, fixedDeltas);
+    } else if (constraints.f.size() > 0) {
+      if (qrConstraintProjectionPtr != nullptr) {
+        qrConstraintProjectionPtr->compute(constraints, projection);
+      } else {
+        projection = luConstraintProjection(constraints);
+      }
+    }
+
+    if (projection.f.size() > 0) {
+      constraints = VectorFunctionLinearApproximation();
+
+      // Adapt dynamics and cost
+      changeOfInputVariables(dynamics, projection.dfdu, projection.dfdx, projection.f);
+      changeOfInputVariables(cost, projection.dfdu, projection.dfdx, projection.f);
     }
   }
 
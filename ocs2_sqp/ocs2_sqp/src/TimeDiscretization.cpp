@@ -57,6 +57,15 @@ scalar_t getIntervalDuration(const AnnotatedTime& start, const AnnotatedTime& en
   return getIntervalEnd(end) - getIntervalStart(start);
 }
 
+scalar_array_t getNodeTimes(const std::vector<AnnotatedTime>& timeDiscretization) {
+  scalar_array_t nodeTimes;
+  nodeTimes.reserve(timeDiscretization.size());
+  for (const auto& annotatedTime : timeDiscretization) {
+    nodeTimes.push_back(getIntervalStart(annotatedTime));
+  }
+  return nodeTimes;
+}
+
 std::vector<AnnotatedTime> timeDiscretizationWithEvents(scalar_t initTime, scalar_t finalTime, scalar_t dt,
                                                         const scalar_array_t& eventTimes, scalar_t dt_min) {
   assert(dt > 0);
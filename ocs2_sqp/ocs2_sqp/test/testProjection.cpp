@@ -29,10 +29,77 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <gtest/gtest.h>
 
+#include <array>
+#include <iostream>
+#include <numeric>
+#include <stdexcept>
+
 #include "ocs2_sqp/ConstraintProjection.h"
 
+#include <ocs2_core/misc/Benchmark.h>
+#include <ocs2_oc/approximate_model/ChangeOfInputVariables.h>
 #include <ocs2_oc/test/testProblemsGeneration.h>
 
+namespace {
+
+void checkProjection(const ocs2::VectorFunctionLinearApproximation& constraint, const ocs2::VectorFunctionLinearApproximation& projection) {
+  // range of Pu is in null-space of D
+  ASSERT_TRUE((constraint.dfdu * projection.dfdu).isZero());
+
+  // D * Px cancels the C term
+  ASSERT_TRUE((constraint.dfdx + constraint.dfdu * projection.dfdx).isZero());
+
+  // D * Pe cancels the e term
+  ASSERT_TRUE((constraint.f + constraint.dfdu * projection.f).isZero());
+}
+
+/**
+ * Constraints with the structure of a quadruped with 12 contact forces and 12 joint velocities as inputs: a stance leg has 3 foot velocity
+ * constraints on the joint velocities of the leg, a swing leg has 3 zero-force constraints and 1 normal velocity constraint.
+ */
+ocs2::VectorFunctionLinearApproximation getLeggedConstraints(int n, const std::array<bool, 4>& contactFlags) {
+  constexpr int m = 24;
+  const int nc = std::accumulate(contactFlags.begin(), contactFlags.end(), 0, [](int sum, bool contact) { return sum + (contact ? 3 : 4); });
+  ocs2::VectorFunctionLinearApproximation constraint = ocs2::VectorFunctionLinearApproximation::Zero(nc, n, m);
+  int row = 0;
+  for (int leg = 0; leg < 4; leg++) {
+    const int numVelocityConstraints = contactFlags[leg] ? 3 : 1;
+    if (!contactFlags[leg]) {
+      constraint.dfdu.block<3, 3>(row, 3 * leg).setIdentity();
+      constraint.f.segment<3>(row).setRandom();
+      row += 3;
+    }
+    constraint.dfdx.middleRows(row, numVelocityConstraints).setRandom();
+    constraint.dfdu.block(row, 12 + 3 * leg, numVelocityConstraints, 3).setRandom();
+    constraint.f.segment(row, numVelocityConstraints).setRandom();
+    row += numVelocityConstraints;
+  }
+  return constraint;
+}
+
+ocs2::size_array_t getSwingForceIndices(const std::array<bool, 4>& contactFlags) {
+  ocs2::size_array_t indices;
+  for (size_t leg = 0; leg < 4; leg++) {
+    if (!contactFlags[leg]) {
+      indices.insert(indices.end(), {3 * leg, 3 * leg + 1, 3 * leg + 2});
+    }
+  }
+  return indices;
+}
+
+/** Returns the deltas of the swing forces which set them to zero, i.e. du = -e for the zero-force constraints. */
+ocs2::vector_t getZeroForceDeltas(const ocs2::VectorFunctionLinearApproximation& constraint, const ocs2::size_array_t& fixedIndices) {
+  ocs2::vector_t fixedDeltas(fixedIndices.size());
+  for (size_t j = 0; j < fixedIndices.size(); j++) {
+    Eigen::Index row;
+    constraint.dfdu.col(fixedIndices[j]).maxCoeff(&row);
+    fixedDeltas(j) = -constraint.f(row);
+  }
+  return fixedDeltas;
+}
+
+}  // unnamed namespace
+
 TEST(test_projection, testProjectionQR) {
   const auto constraint = ocs2::getRandomConstraints(30, 20, 10);
 
@@ -61,4 +128,204 @@ TEST(test_projection, testProjectionLU) {
 
   // D * Pe cancels the e term
   ASSERT_TRUE((constraint.f + constraint.dfdu * projection.f).isZero());
-}
\ No newline at end of file
+}
+
+TEST(test_projection, testProjectionQRKernel) {
+  ocs2::QrConstraintProjection qrProjection;
+  ocs2::VectorFunctionLinearApproximation projection;
+
+  // alternate between shapes, as for the contact configurations of a legged robot
+  for (int nc : {10, 4, 10, 7, 4}) {
+    const auto constraint = ocs2::getRandomConstraints(30, 20, nc);
+    qrProjection.compute(constraint, projection);
+    checkProjection(constraint, projection);
+
+    // identical to the reference implementation
+    const auto reference = ocs2::qrConstraintProjection(constraint);
+    ASSERT_TRUE(projection.dfdu.isApprox(reference.dfdu));
+    ASSERT_TRUE(projection.dfdx.isApprox(reference.dfdx));
+    ASSERT_TRUE(projection.f.isApprox(reference.f));
+  }
+  ASSERT_EQ(qrProjection.getNumShapes(), 3);
+}
+
+TEST(test_projection, testProjectionQRFixedSizeKernel) {
+  const auto constraint = ocs2::getRandomConstraints(12, 6, 3);
+
+  ocs2::QrConstraintProjectionKernel<3, 6> kernel;
+  ocs2::VectorFunctionLinearApproximation projection;
+  kernel.compute(constraint, projection);
+  checkProjection(constraint, projection);
+
+  const auto reference = ocs2::qrConstraintProjection(constraint);
+  ASSERT_TRUE(projection.dfdu.isApprox(reference.dfdu));
+  ASSERT_TRUE(projection.dfdx.isApprox(reference.dfdx));
+  ASSERT_TRUE(projection.f.isApprox(reference.f));
+}
+
+TEST(test_projection, DISABLED_benchmarkProjection) {
+  // dimensions of a quadruped: 24 states, 24 inputs (contact forces and joint velocities), and up to 18 constraints
+  constexpr int n = 24;
+  constexpr int m = 24;
+  constexpr int numNodes = 100;
+  constexpr int numRepeats = 20;
+
+  std::vector<ocs2::VectorFunctionLinearApproximation> constraints;
+  for (int i = 0; i < numNodes; i++) {
+    constraints.push_back(ocs2::getRandomConstraints(n, m, (i % 25 < 12) ? 18 : 15));
+  }
+  std::vector<ocs2::VectorFunctionLinearApproximation> projections(numNodes);
+
+  ocs2::benchmark::RepeatedTimer qrTimer;
+  ocs2::benchmark::RepeatedTimer luTimer;
+  ocs2::benchmark::RepeatedTimer qrKernelTimer;
+  ocs2::QrConstraintProjection qrProjection;
+  for (int k = 0; k < numRepeats; k++) {
+    qrTimer.startTimer();
+    for (int i = 0; i < numNodes; i++) {
+      projections[i] = ocs2::qrConstraintProjection(constraints[i]);
+    }
+    qrTimer.endTimer();
+
+    luTimer.startTimer();
+    for (int i = 0; i < numNodes; i++) {
+      projections[i] = ocs2::luConstraintProjection(constraints[i]);
+    }
+    luTimer.endTimer();
+
+    qrKernelTimer.startTimer();
+    for (int i = 0; i < numNodes; i++) {
+      qrProjection.compute(constraints[i], projections[i]);
+    }
+    qrKernelTimer.endTimer();
+  }
+
+  std::cerr << "\n###   Constraint projection of " << numNodes << " nodes"
+            << "\n###   qrConstraintProjection : " << qrTimer.getAverageInMilliseconds() << " [ms]"
+            << "\n###   luConstraintProjection : " << luTimer.getAverageInMilliseconds() << " [ms]"
+            << "\n###   QrConstraintProjection : " << qrKernelTimer.getAverageInMilliseconds() << " [ms]\n";
+  checkProjection(constraints.back(), projections.back());
+}
+
+TEST(test_projection, testProjectionFixedInputs) {
+  constexpr int n = 24;
+  constexpr int m = 24;
+  const std::array<bool, 4> contactFlags{true, false, false, true};
+  const auto constraint = getLeggedConstraints(n, contactFlags);
+  const auto fixedIndices = getSwingForceIndices(contactFlags);
+  const auto fixedDeltas = getZeroForceDeltas(constraint, fixedIndices);
+
+  const auto projection = ocs2::fixedInputsConstraintProjection(constraint, n, m, fixedIndices, fixedDeltas);
+  checkProjection(constraint, projection);
+
+  // the fixed inputs do not depend on the state and the new inputs
+  for (size_t j = 0; j < fixedIndices.size(); j++) {
+    ASSERT_TRUE(projection.dfdu.row(fixedIndices[j]).isZero());
+    ASSERT_TRUE(projection.dfdx.row(fixedIndices[j]).isZero());
+    ASSERT_DOUBLE_EQ(projection.f(fixedIndices[j]), fixedDeltas(j));
+  }
+
+  // same null-space dimension as the projection of all constraints
+  const auto reference = ocs2::luConstraintProjection(constraint);
+  ASSERT_EQ(projection.dfdu.cols(), reference.dfdu.cols());
+
+  // without constraints, only the fixed inputs are eliminated
+  const auto selection = ocs2::fixedInputsConstraintProjection(ocs2::VectorFunctionLinearApproximation(), n, m, fixedIndices, fixedDeltas);
+  ASSERT_EQ(selection.dfdu.cols(), m - fixedIndices.size());
+  ASSERT_TRUE(selection.dfdx.isZero());
+}
+
+TEST(test_projection, testProjectionFixedInputsUnsatisfiedConstraint) {
+  constexpr int n = 24;
+  constexpr int m = 24;
+  const std::array<bool, 4> contactFlags{true, false, false, true};
+  const auto fixedIndices = getSwingForceIndices(contactFlags);
+  const auto constraint = getLeggedConstraints(n, contactFlags);
+
+  // the zero-force constraints are satisfied by the fixed inputs
+  const auto fixedDeltas = getZeroForceDeltas(constraint, fixedIndices);
+  ASSERT_NO_THROW(ocs2::fixedInputsConstraintProjection(constraint, n, m, fixedIndices, fixedDeltas));
+
+  // a row which only touches the fixed inputs but depends on the state cannot be enforced by the projection
+  Eigen::Index row;
+  constraint.dfdu.col(fixedIndices.front()).maxCoeff(&row);
+  auto stateDependentConstraint = constraint;
+  stateDependentConstraint.dfdx.row(row).setRandom();
+  ASSERT_THROW(ocs2::fixedInputsConstraintProjection(stateDependentConstraint, n, m, fixedIndices, fixedDeltas), std::runtime_error);
+
+  // neither can a row whose substituted residual is not zero
+  ocs2::vector_t wrongDeltas = fixedDeltas;
+  wrongDeltas(0) += 1.0;
+  ASSERT_THROW(ocs2::fixedInputsConstraintProjection(constraint, n, m, fixedIndices, wrongDeltas), std::runtime_error);
+}
+
+TEST(test_projection, DISABLED_benchmarkProjectionFixedInputs) {
+  constexpr int n = 24;
+  constexpr int m = 24;
+  constexpr int numRepeats = 20;
+
+  // contact flags (LF, RF, LH, RH) of the gait phases
+  const std::vector<std::pair<std::string, std::vector<std::array<bool, 4>>>> gaits{
+      {"trot", {{true, false, false, true}, {true, true, true, true}, {false, true, true, false}, {true, true, true, true}}},
+      {"pace", {{true, false, true, false}, {true, true, true, true}, {false, true, false, true}, {true, true, true, true}}}};
+
+  for (const auto& gait : gaits) {
+    // 100 nodes, spread over the gait phases
+    std::vector<ocs2::VectorFunctionLinearApproximation> constraints;
+    std::vector<ocs2::size_array_t> fixedIndices;
+    std::vector<ocs2::vector_t> fixedDeltas;
+    for (int i = 0; i < 100; i++) {
+      const auto& contactFlags = gait.second[(i / 10) % gait.second.size()];
+      constraints.push_back(getLeggedConstraints(n, contactFlags));
+      fixedIndices.push_back(getSwingForceIndices(contactFlags));
+      fixedDeltas.push_back(getZeroForceDeltas(constraints.back(), fixedIndices.back()));
+    }
+    const auto dynamics = ocs2::getRandomDynamics(n, m);
+    const auto cost = ocs2::getRandomCost(n, m);
+
+    ocs2::benchmark::RepeatedTimer luTimer;
+    ocs2::benchmark::RepeatedTimer fixedInputsTimer;
+    ocs2::benchmark::RepeatedTimer luSubproblemTimer;
+    ocs2::benchmark::RepeatedTimer fixedInputsSubproblemTimer;
+    std::vector<ocs2::VectorFunctionLinearApproximation> projections(constraints.size());
+    auto projectedDynamics = dynamics;
+    auto projectedCost = cost;
+    auto changeOfInputVariables = [&](ocs2::benchmark::RepeatedTimer& timer) {
+      timer.startTimer();
+      for (const auto& projection : projections) {
+        projectedDynamics = dynamics;
+        projectedCost = cost;
+        ocs2::changeOfInputVariables(projectedDynamics, projection.dfdu, projection.dfdx, projection.f);
+        ocs2::changeOfInputVariables(projectedCost, projection.dfdu, projection.dfdx, projection.f);
+      }
+      timer.endTimer();
+    };
+
+    for (int k = 0; k < numRepeats; k++) {
+      luTimer.startTimer();
+      for (size_t i = 0; i < constraints.size(); i++) {
+        projections[i] = ocs2::luConstraintProjection(constraints[i]);
+      }
+      luTimer.endTimer();
+      changeOfInputVariables(luSubproblemTimer);
+
+      fixedInputsTimer.startTimer();
+      for (size_t i = 0; i < constraints.size(); i++) {
+        // as in the transcription: the nodes without fixed inputs use the LU projection
+        if (fixedIndices[i].empty()) {
+          projections[i] = ocs2::luConstraintProjection(constraints[i]);
+        } else {
+          projections[i] = ocs2::fixedInputsConstraintProjection(constraints[i], n, m, fixedIndices[i], fixedDeltas[i]);
+        }
+      }
+      fixedInputsTimer.endTimer();
+      changeOfInputVariables(fixedInputsSubproblemTimer);
+    }
+
+    std::cerr << "\n###   100 nodes, " << gait.first << " gait: projection / change of input variables"
+              << "\n###   luConstraintProjection          : " << luTimer.getAverageInMilliseconds() << " / "
+              << luSubproblemTimer.getAverageInMilliseconds() << " [ms]"
+              << "\n###   fixedInputsConstraintProjection : " << fixedInputsTimer.getAverageInMilliseconds() << " / "
+              << fixedInputsSubproblemTimer.getAverageInMilliseconds() << " [ms]\n";
+  }
+}
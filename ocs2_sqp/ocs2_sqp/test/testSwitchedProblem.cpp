@@ -29,6 +29,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <gtest/gtest.h>
 
+#include "ocs2_sqp/MultipleShootingInitialization.h"
 #include "ocs2_sqp/MultipleShootingSolver.h"
 #include "ocs2_sqp/TimeDiscretization.h"
 
@@ -94,6 +95,71 @@ class SwitchedConstraint : public StateInputConstraint {
   std::vector<std::unique_ptr<ocs2::StateInputConstraint>> subsystemConstraintsPtr_;
 };
 
+/**
+ * Solves the switched problem with the event at firstEventTime, moves the event to secondEventTime, and solves again starting from the
+ * previous solution. Returns the number of SQP iterations of each solve.
+ */
+std::pair<size_t, size_t> solveWithModeScheduleChange(scalar_t firstEventTime, scalar_t secondEventTime, bool useTrajectorySpreading) {
+  constexpr int n = 3;
+  constexpr int m = 2;
+  std::srand(0);  // same random problem for all calls
+
+  ocs2::OptimalControlProblem problem;
+
+  // System
+  const auto dynamics = ocs2::getRandomDynamics(n, m);
+  const auto jumpMap = matrix_t::Random(n, n);
+  problem.dynamicsPtr.reset(new ocs2::LinearSystemDynamics(dynamics.dfdx, dynamics.dfdu, jumpMap));
+
+  // Cost
+  problem.costPtr->add("intermediateCost", ocs2::getOcs2Cost(ocs2::getRandomCost(n, m)));
+  problem.preJumpCostPtr->add("eventCost", ocs2::getOcs2StateCost(ocs2::getRandomCost(n, 0)));
+  problem.finalCostPtr->add("finalCost", ocs2::getOcs2StateCost(ocs2::getRandomCost(n, 0)));
+
+  // Reference Manager
+  const ocs2::TargetTrajectories targetTrajectories({0.0}, {ocs2::vector_t::Random(n)}, {ocs2::vector_t::Random(m)});
+  std::shared_ptr<ocs2::ReferenceManager> referenceManagerPtr(
+      new ocs2::ReferenceManager({targetTrajectories}, targetTrajectories, ocs2::ModeSchedule({firstEventTime}, {0, 1})));
+
+  problem.targetTrajectoriesPtr = &targetTrajectories;
+
+  // Constraint
+  problem.equalityConstraintPtr->add("switchedConstraint",
+                                     std::unique_ptr<StateInputConstraint>(new ocs2::SwitchedConstraint(referenceManagerPtr)));
+
+  ocs2::DefaultInitializer zeroInitializer(m);
+
+  // Solver settings
+  ocs2::multiple_shooting::Settings settings;
+  settings.dt = 0.05;
+  settings.sqpIteration = 20;
+  settings.projectStateInputEqualityConstraints = true;
+  settings.useTrajectorySpreading = useTrajectorySpreading;
+  settings.printSolverStatistics = false;
+  settings.printSolverStatus = false;
+  settings.printLinesearch = false;
+
+  const ocs2::scalar_t startTime = 0.0;
+  const ocs2::scalar_t finalTime = 1.0;
+  const ocs2::vector_t initState = ocs2::vector_t::Random(n);
+
+  ocs2::MultipleShootingSolver solver(settings, problem, zeroInitializer);
+  solver.setReferenceManager(referenceManagerPtr);
+
+  solver.run(startTime, initState, finalTime);
+  const size_t firstNumIterations = solver.getIterationsLog().size();
+
+  referenceManagerPtr->setModeSchedule(ocs2::ModeSchedule({secondEventTime}, {0, 1}));
+  solver.run(startTime, initState, finalTime);
+  const size_t secondNumIterations = solver.getIterationsLog().size();
+
+  constexpr double tol = 1e-9;
+  EXPECT_LT(solver.getIterationsLog().back().dynamicsViolationSSE, tol);
+  EXPECT_LT(solver.getIterationsLog().back().equalityConstraintsSSE, tol);
+
+  return {firstNumIterations, secondNumIterations};
+}
+
 std::pair<PrimalSolution, std::vector<PerformanceIndex>> solveWithEventTime(scalar_t eventTime) {
   constexpr int n = 3;
   constexpr int m = 2;
@@ -116,7 +182,7 @@ std::pair<PrimalSolution, std::vector<PerformanceIndex>> solveWithEventTime(scal
   // Reference Manager
   const ocs2::ModeSchedule modeSchedule({eventTime}, {0, 1});
   const ocs2::TargetTrajectories targetTrajectories({0.0}, {ocs2::vector_t::Random(n)}, {ocs2::vector_t::Random(m)});
-  std::shared_ptr<ocs2::ReferenceManager> referenceManagerPtr(new ocs2::ReferenceManager(targetTrajectories, modeSchedule));
+  std::shared_ptr<ocs2::ReferenceManager> referenceManagerPtr(new ocs2::ReferenceManager({targetTrajectories}, targetTrajectories, modeSchedule));
 
   problem.targetTrajectoriesPtr = &targetTrajectories;
 
@@ -268,3 +334,82 @@ TEST(test_switched_problem, event_at_end) {
     t_check += dt_check;
   }
 }
+
+TEST(test_switched_problem, warm_start_spreading_on_sqp_grid) {
+  // The event is postponed by five and then advanced by three time steps
+  for (const auto& eventTimes : {std::make_pair(0.1875, 0.4375), std::make_pair(0.4375, 0.2875)}) {
+    // A previous SQP solution whose inputs encode the active mode, with the pre- and post-event nodes of the SQP discretization
+    const ocs2::ModeSchedule oldModeSchedule({eventTimes.first}, {0, 1});
+    const ocs2::ModeSchedule newModeSchedule({eventTimes.second}, {0, 1});
+    const auto oldTime = ocs2::timeDiscretizationWithEvents(0.0, 1.0, 0.05, oldModeSchedule.eventTimes);
+
+    ocs2::PrimalSolution primalSolution;
+    primalSolution.modeSchedule_ = oldModeSchedule;
+    for (size_t i = 0; i < oldTime.size(); i++) {
+      const auto mode = oldModeSchedule.modeAtTime(ocs2::getIntervalStart(oldTime[i]));
+      primalSolution.timeTrajectory_.push_back(oldTime[i].time);
+      primalSolution.stateTrajectory_.push_back(ocs2::vector_t::Constant(1, mode));
+      primalSolution.inputTrajectory_.push_back(ocs2::vector_t::Constant(1, mode));
+      if (oldTime[i].event == ocs2::AnnotatedTime::Event::PreEvent) {
+        primalSolution.postEventIndices_.push_back(i + 1);
+      }
+    }
+
+    ocs2::multiple_shooting::spreadPrimalSolution(newModeSchedule, primalSolution);
+    ASSERT_EQ(primalSolution.postEventIndices_.size(), 1);
+    ASSERT_EQ(primalSolution.timeTrajectory_[primalSolution.postEventIndices_[0] - 1], eventTimes.second);
+    ASSERT_EQ(primalSolution.timeTrajectory_[primalSolution.postEventIndices_[0]], eventTimes.second);
+
+    // The interpolated warm start of the new discretization follows the new mode schedule
+    const auto newTime = ocs2::timeDiscretizationWithEvents(0.0, 1.0, 0.05, newModeSchedule.eventTimes);
+    for (const auto& annotatedTime : newTime) {
+      if (annotatedTime.event != ocs2::AnnotatedTime::Event::PreEvent) {
+        const auto time = ocs2::getIntervalStart(annotatedTime);
+        const auto input = ocs2::LinearInterpolation::interpolate(time, primalSolution.timeTrajectory_, primalSolution.inputTrajectory_);
+        EXPECT_DOUBLE_EQ(input(0), newModeSchedule.modeAtTime(time)) << "at time " << time;
+      }
+    }
+  }
+}
+
+TEST(test_switched_problem, warm_start_spreading_event_to_start) {
+  // The event is moved to the start of the horizon
+  const ocs2::ModeSchedule oldModeSchedule({0.4375}, {0, 1});
+  const ocs2::ModeSchedule newModeSchedule({0.0}, {0, 1});
+  const auto oldTime = ocs2::timeDiscretizationWithEvents(0.0, 1.0, 0.05, oldModeSchedule.eventTimes);
+
+  ocs2::PrimalSolution primalSolution;
+  primalSolution.modeSchedule_ = oldModeSchedule;
+  for (size_t i = 0; i < oldTime.size(); i++) {
+    const auto mode = oldModeSchedule.modeAtTime(ocs2::getIntervalStart(oldTime[i]));
+    primalSolution.timeTrajectory_.push_back(oldTime[i].time);
+    primalSolution.stateTrajectory_.push_back(ocs2::vector_t::Constant(1, mode));
+    primalSolution.inputTrajectory_.push_back(ocs2::vector_t::Constant(1, mode));
+    if (oldTime[i].event == ocs2::AnnotatedTime::Event::PreEvent) {
+      primalSolution.postEventIndices_.push_back(i + 1);
+    }
+  }
+
+  ocs2::multiple_shooting::spreadPrimalSolution(newModeSchedule, primalSolution);
+  ASSERT_EQ(primalSolution.timeTrajectory_.size(), primalSolution.inputTrajectory_.size());
+  ASSERT_TRUE(std::is_sorted(primalSolution.timeTrajectory_.begin(), primalSolution.timeTrajectory_.end()));
+  for (const auto postEventIndex : primalSolution.postEventIndices_) {
+    ASSERT_LT(postEventIndex, primalSolution.timeTrajectory_.size());
+  }
+
+  // the whole horizon is in the post-event mode
+  for (ocs2::scalar_t time = 0.05; time < 1.0; time += 0.05) {
+    const auto input = ocs2::LinearInterpolation::interpolate(time, primalSolution.timeTrajectory_, primalSolution.inputTrajectory_);
+    EXPECT_DOUBLE_EQ(input(0), 1.0) << "at time " << time;
+  }
+}
+
+TEST(test_switched_problem, mode_schedule_change) {
+  for (const auto& eventTimes : {std::make_pair(0.1875, 0.4375), std::make_pair(0.4375, 0.2875)}) {
+    const auto withSpreading = ocs2::solveWithModeScheduleChange(eventTimes.first, eventTimes.second, true);
+    const auto withoutSpreading = ocs2::solveWithModeScheduleChange(eventTimes.first, eventTimes.second, false);
+
+    EXPECT_EQ(withSpreading.first, withoutSpreading.first);
+    EXPECT_LE(withSpreading.second, withoutSpreading.second);
+  }
+}
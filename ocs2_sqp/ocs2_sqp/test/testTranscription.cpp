@@ -65,6 +65,29 @@ TEST(test_transcription, intermediate_performance) {
   ASSERT_TRUE(areIdentical(performance, transcription.performance));
 }
 
+TEST(test_transcription, intermediate_qr_projection) {
+  // optimal control problem
+  OptimalControlProblem problem = createCircularKinematicsProblem("/tmp/sqp_test_generated");
+
+  auto sensitivityDiscretizer = selectDynamicsSensitivityDiscretization(SensitivityIntegratorType::RK4);
+
+  scalar_t t = 0.5;
+  scalar_t dt = 0.1;
+  const vector_t x = (vector_t(2) << 1.0, 0.1).finished();
+  const vector_t x_next = (vector_t(2) << 1.1, 0.2).finished();
+  const vector_t u = (vector_t(2) << 0.1, 1.3).finished();
+  const auto unprojected = setupIntermediateNode(problem, sensitivityDiscretizer, false, t, dt, x, x_next, u);
+  QrConstraintProjection qrConstraintProjection;
+  const auto transcription = setupIntermediateNode(problem, sensitivityDiscretizer, true, t, dt, x, x_next, u, &qrConstraintProjection);
+
+  const auto projection = ocs2::qrConstraintProjection(unprojected.constraints);
+  ASSERT_TRUE(transcription.constraintsProjection.dfdu.isApprox(projection.dfdu));
+  ASSERT_TRUE(transcription.constraintsProjection.dfdx.isApprox(projection.dfdx));
+  ASSERT_TRUE(transcription.constraintsProjection.f.isApprox(projection.f));
+  ASSERT_EQ(transcription.constraints.f.size(), 0);
+  ASSERT_TRUE(areIdentical(unprojected.performance, transcription.performance));
+}
+
 TEST(test_transcription, terminal_performance) {
   int nx = 3;
 